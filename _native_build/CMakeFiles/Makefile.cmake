@@ -0,0 +1,90 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/include/OpenNESConfig.h.in"
+  "/root/repo/include/tests/TestResource.h.in"
+  "/root/repo/source/CMakeLists.txt"
+  "/root/repo/source/common/CMakeLists.txt"
+  "/root/repo/source/cpu/CMakeLists.txt"
+  "/root/repo/source/nes/CMakeLists.txt"
+  "/root/repo/source/opennes/CMakeLists.txt"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tests/common/CMakeLists.txt"
+  "/root/repo/tests/cpu/CMakeLists.txt"
+  "/root/repo/tests/memory/CMakeLists.txt"
+  "/root/repo/tests/nes/CMakeLists.txt"
+  "/root/repo/tests/opennes/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "include/OpenNESConfig.h"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/nes/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/cpu/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "source/opennes/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/tests/TestResource.h"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/cpu/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/memory/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/nes/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/opennes/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/unittests.dir/DependInfo.cmake"
+  "source/common/CMakeFiles/common.dir/DependInfo.cmake"
+  "source/nes/CMakeFiles/nes.dir/DependInfo.cmake"
+  "source/cpu/CMakeFiles/cpu.dir/DependInfo.cmake"
+  "source/opennes/CMakeFiles/opennes.dir/DependInfo.cmake"
+  "tests/CMakeFiles/catch.dir/DependInfo.cmake"
+  "tests/common/CMakeFiles/test_CommonTests.dir/DependInfo.cmake"
+  "tests/cpu/CMakeFiles/test_CpuTests.dir/DependInfo.cmake"
+  "tests/memory/CMakeFiles/test_MemoryTests.dir/DependInfo.cmake"
+  "tests/nes/CMakeFiles/test_NesTests.dir/DependInfo.cmake"
+  "tests/opennes/CMakeFiles/test_OpenNesTests.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,31 @@
+//===-- OpenNESConfig.h - OpenNES Project Configuration ---------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains macros pertaining to the current project build
+/// configuration.
+///
+//===----------------------------------------------------------------------===//
+#ifndef OPENNES_CONFIG_H
+#define OPENNES_CONFIG_H
+
+// Project version macros
+#define OPENNES_VERSION_MAJOR 0
+#define OPENNES_VERSION_MINOR 1
+#define OPENNES_VERSION_PATCH 0
+
+// Build type macros. This can be used for enabling and disabling code.
+#define __Debug__ 1
+#ifdef __Debug__
+  #define __DEBUG__ 1
+#else
+  #define __RELEASE__ 1
+#endif
+#undef __Debug__
+
+#endif // OPENNES_CONFIG_H
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/source
+# Build directory: /root/repo/_native_build/source
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("common")
+subdirs("nes")
+subdirs("cpu")
+subdirs("opennes")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libcommon.a"
+  "../../lib/libcommon.pdb"
+  "CMakeFiles/common.dir/BaseException.cpp.o"
+  "CMakeFiles/common.dir/BaseException.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/common.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
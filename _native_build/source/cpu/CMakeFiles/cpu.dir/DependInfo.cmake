@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/cpu/Mos6502.cpp" "source/cpu/CMakeFiles/cpu.dir/Mos6502.cpp.o" "gcc" "source/cpu/CMakeFiles/cpu.dir/Mos6502.cpp.o.d"
+  "/root/repo/source/cpu/Mos6502Disassembler.cpp" "source/cpu/CMakeFiles/cpu.dir/Mos6502Disassembler.cpp.o" "gcc" "source/cpu/CMakeFiles/cpu.dir/Mos6502Disassembler.cpp.o.d"
+  "/root/repo/source/cpu/Mos6502Mmu.cpp" "source/cpu/CMakeFiles/cpu.dir/Mos6502Mmu.cpp.o" "gcc" "source/cpu/CMakeFiles/cpu.dir/Mos6502Mmu.cpp.o.d"
+  "/root/repo/source/cpu/interpreter/InterpretedMos6502.cpp" "source/cpu/CMakeFiles/cpu.dir/interpreter/InterpretedMos6502.cpp.o" "gcc" "source/cpu/CMakeFiles/cpu.dir/interpreter/InterpretedMos6502.cpp.o.d"
+  "/root/repo/source/cpu/lockstep/LockstepMos6502.cpp" "source/cpu/CMakeFiles/cpu.dir/lockstep/LockstepMos6502.cpp.o" "gcc" "source/cpu/CMakeFiles/cpu.dir/lockstep/LockstepMos6502.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_native_build/source/common/CMakeFiles/common.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "../../lib/libcpu.a"
+  "../../lib/libcpu.pdb"
+  "CMakeFiles/cpu.dir/Mos6502.cpp.o"
+  "CMakeFiles/cpu.dir/Mos6502.cpp.o.d"
+  "CMakeFiles/cpu.dir/Mos6502Disassembler.cpp.o"
+  "CMakeFiles/cpu.dir/Mos6502Disassembler.cpp.o.d"
+  "CMakeFiles/cpu.dir/Mos6502Mmu.cpp.o"
+  "CMakeFiles/cpu.dir/Mos6502Mmu.cpp.o.d"
+  "CMakeFiles/cpu.dir/interpreter/InterpretedMos6502.cpp.o"
+  "CMakeFiles/cpu.dir/interpreter/InterpretedMos6502.cpp.o.d"
+  "CMakeFiles/cpu.dir/lockstep/LockstepMos6502.cpp.o"
+  "CMakeFiles/cpu.dir/lockstep/LockstepMos6502.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cpu.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
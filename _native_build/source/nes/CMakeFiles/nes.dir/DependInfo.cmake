@@ -0,0 +1,47 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/nes/Apu.cpp" "source/nes/CMakeFiles/nes.dir/Apu.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/Apu.cpp.o.d"
+  "/root/repo/source/nes/AudioRecorder.cpp" "source/nes/CMakeFiles/nes.dir/AudioRecorder.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/AudioRecorder.cpp.o.d"
+  "/root/repo/source/nes/AudioRing.cpp" "source/nes/CMakeFiles/nes.dir/AudioRing.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/AudioRing.cpp.o.d"
+  "/root/repo/source/nes/BatchRunner.cpp" "source/nes/CMakeFiles/nes.dir/BatchRunner.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/BatchRunner.cpp.o.d"
+  "/root/repo/source/nes/Cartridge.cpp" "source/nes/CMakeFiles/nes.dir/Cartridge.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/Cartridge.cpp.o.d"
+  "/root/repo/source/nes/CartridgeBuilder.cpp" "source/nes/CMakeFiles/nes.dir/CartridgeBuilder.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/CartridgeBuilder.cpp.o.d"
+  "/root/repo/source/nes/CartridgeMapper.cpp" "source/nes/CMakeFiles/nes.dir/CartridgeMapper.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/CartridgeMapper.cpp.o.d"
+  "/root/repo/source/nes/CartridgeMapperBuilder.cpp" "source/nes/CMakeFiles/nes.dir/CartridgeMapperBuilder.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/CartridgeMapperBuilder.cpp.o.d"
+  "/root/repo/source/nes/Console.cpp" "source/nes/CMakeFiles/nes.dir/Console.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/Console.cpp.o.d"
+  "/root/repo/source/nes/Controllers.cpp" "source/nes/CMakeFiles/nes.dir/Controllers.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/Controllers.cpp.o.d"
+  "/root/repo/source/nes/Cpu2A03.cpp" "source/nes/CMakeFiles/nes.dir/Cpu2A03.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/Cpu2A03.cpp.o.d"
+  "/root/repo/source/nes/CpuBus.cpp" "source/nes/CMakeFiles/nes.dir/CpuBus.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/CpuBus.cpp.o.d"
+  "/root/repo/source/nes/FrameSink.cpp" "source/nes/CMakeFiles/nes.dir/FrameSink.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/FrameSink.cpp.o.d"
+  "/root/repo/source/nes/ObservationStack.cpp" "source/nes/CMakeFiles/nes.dir/ObservationStack.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/ObservationStack.cpp.o.d"
+  "/root/repo/source/nes/ParallelRenderer.cpp" "source/nes/CMakeFiles/nes.dir/ParallelRenderer.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/ParallelRenderer.cpp.o.d"
+  "/root/repo/source/nes/Ppu.cpp" "source/nes/CMakeFiles/nes.dir/Ppu.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/Ppu.cpp.o.d"
+  "/root/repo/source/nes/Resampler.cpp" "source/nes/CMakeFiles/nes.dir/Resampler.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/Resampler.cpp.o.d"
+  "/root/repo/source/nes/RewindBuffer.cpp" "source/nes/CMakeFiles/nes.dir/RewindBuffer.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/RewindBuffer.cpp.o.d"
+  "/root/repo/source/nes/RomStore.cpp" "source/nes/CMakeFiles/nes.dir/RomStore.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/RomStore.cpp.o.d"
+  "/root/repo/source/nes/RunAhead.cpp" "source/nes/CMakeFiles/nes.dir/RunAhead.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/RunAhead.cpp.o.d"
+  "/root/repo/source/nes/TileCache.cpp" "source/nes/CMakeFiles/nes.dir/TileCache.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/TileCache.cpp.o.d"
+  "/root/repo/source/nes/VideoConverter.cpp" "source/nes/CMakeFiles/nes.dir/VideoConverter.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/VideoConverter.cpp.o.d"
+  "/root/repo/source/nes/mappers/CnRom.cpp" "source/nes/CMakeFiles/nes.dir/mappers/CnRom.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/mappers/CnRom.cpp.o.d"
+  "/root/repo/source/nes/mappers/Mmc1.cpp" "source/nes/CMakeFiles/nes.dir/mappers/Mmc1.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/mappers/Mmc1.cpp.o.d"
+  "/root/repo/source/nes/mappers/Mmc3.cpp" "source/nes/CMakeFiles/nes.dir/mappers/Mmc3.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/mappers/Mmc3.cpp.o.d"
+  "/root/repo/source/nes/mappers/NRom.cpp" "source/nes/CMakeFiles/nes.dir/mappers/NRom.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/mappers/NRom.cpp.o.d"
+  "/root/repo/source/nes/mappers/UxRom.cpp" "source/nes/CMakeFiles/nes.dir/mappers/UxRom.cpp.o" "gcc" "source/nes/CMakeFiles/nes.dir/mappers/UxRom.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_native_build/source/common/CMakeFiles/common.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/cpu/CMakeFiles/cpu.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,63 @@
+file(REMOVE_RECURSE
+  "../../lib/libnes.a"
+  "../../lib/libnes.pdb"
+  "CMakeFiles/nes.dir/Apu.cpp.o"
+  "CMakeFiles/nes.dir/Apu.cpp.o.d"
+  "CMakeFiles/nes.dir/AudioRecorder.cpp.o"
+  "CMakeFiles/nes.dir/AudioRecorder.cpp.o.d"
+  "CMakeFiles/nes.dir/AudioRing.cpp.o"
+  "CMakeFiles/nes.dir/AudioRing.cpp.o.d"
+  "CMakeFiles/nes.dir/BatchRunner.cpp.o"
+  "CMakeFiles/nes.dir/BatchRunner.cpp.o.d"
+  "CMakeFiles/nes.dir/Cartridge.cpp.o"
+  "CMakeFiles/nes.dir/Cartridge.cpp.o.d"
+  "CMakeFiles/nes.dir/CartridgeBuilder.cpp.o"
+  "CMakeFiles/nes.dir/CartridgeBuilder.cpp.o.d"
+  "CMakeFiles/nes.dir/CartridgeMapper.cpp.o"
+  "CMakeFiles/nes.dir/CartridgeMapper.cpp.o.d"
+  "CMakeFiles/nes.dir/CartridgeMapperBuilder.cpp.o"
+  "CMakeFiles/nes.dir/CartridgeMapperBuilder.cpp.o.d"
+  "CMakeFiles/nes.dir/Console.cpp.o"
+  "CMakeFiles/nes.dir/Console.cpp.o.d"
+  "CMakeFiles/nes.dir/Controllers.cpp.o"
+  "CMakeFiles/nes.dir/Controllers.cpp.o.d"
+  "CMakeFiles/nes.dir/Cpu2A03.cpp.o"
+  "CMakeFiles/nes.dir/Cpu2A03.cpp.o.d"
+  "CMakeFiles/nes.dir/CpuBus.cpp.o"
+  "CMakeFiles/nes.dir/CpuBus.cpp.o.d"
+  "CMakeFiles/nes.dir/FrameSink.cpp.o"
+  "CMakeFiles/nes.dir/FrameSink.cpp.o.d"
+  "CMakeFiles/nes.dir/ObservationStack.cpp.o"
+  "CMakeFiles/nes.dir/ObservationStack.cpp.o.d"
+  "CMakeFiles/nes.dir/ParallelRenderer.cpp.o"
+  "CMakeFiles/nes.dir/ParallelRenderer.cpp.o.d"
+  "CMakeFiles/nes.dir/Ppu.cpp.o"
+  "CMakeFiles/nes.dir/Ppu.cpp.o.d"
+  "CMakeFiles/nes.dir/Resampler.cpp.o"
+  "CMakeFiles/nes.dir/Resampler.cpp.o.d"
+  "CMakeFiles/nes.dir/RewindBuffer.cpp.o"
+  "CMakeFiles/nes.dir/RewindBuffer.cpp.o.d"
+  "CMakeFiles/nes.dir/RomStore.cpp.o"
+  "CMakeFiles/nes.dir/RomStore.cpp.o.d"
+  "CMakeFiles/nes.dir/RunAhead.cpp.o"
+  "CMakeFiles/nes.dir/RunAhead.cpp.o.d"
+  "CMakeFiles/nes.dir/TileCache.cpp.o"
+  "CMakeFiles/nes.dir/TileCache.cpp.o.d"
+  "CMakeFiles/nes.dir/VideoConverter.cpp.o"
+  "CMakeFiles/nes.dir/VideoConverter.cpp.o.d"
+  "CMakeFiles/nes.dir/mappers/CnRom.cpp.o"
+  "CMakeFiles/nes.dir/mappers/CnRom.cpp.o.d"
+  "CMakeFiles/nes.dir/mappers/Mmc1.cpp.o"
+  "CMakeFiles/nes.dir/mappers/Mmc1.cpp.o.d"
+  "CMakeFiles/nes.dir/mappers/Mmc3.cpp.o"
+  "CMakeFiles/nes.dir/mappers/Mmc3.cpp.o.d"
+  "CMakeFiles/nes.dir/mappers/NRom.cpp.o"
+  "CMakeFiles/nes.dir/mappers/NRom.cpp.o.d"
+  "CMakeFiles/nes.dir/mappers/UxRom.cpp.o"
+  "CMakeFiles/nes.dir/mappers/UxRom.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/opennes/OpenNesBatch.cpp" "source/opennes/CMakeFiles/opennes.dir/OpenNesBatch.cpp.o" "gcc" "source/opennes/CMakeFiles/opennes.dir/OpenNesBatch.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_native_build/source/nes/CMakeFiles/nes.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/cpu/CMakeFiles/cpu.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/common/CMakeFiles/common.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libopennes.pdb"
+  "../../lib/libopennes.so"
+  "CMakeFiles/opennes.dir/OpenNesBatch.cpp.o"
+  "CMakeFiles/opennes.dir/OpenNesBatch.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/opennes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../lib/libcatch.a"
+  "../lib/libcatch.pdb"
+  "CMakeFiles/catch.dir/Main.cpp.o"
+  "CMakeFiles/catch.dir/Main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/catch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../bin/tests/CommonTests"
+  "../../bin/tests/CommonTests.pdb"
+  "CMakeFiles/test_CommonTests.dir/TestCache.cpp.o"
+  "CMakeFiles/test_CommonTests.dir/TestCache.cpp.o.d"
+  "CMakeFiles/test_CommonTests.dir/TestException.cpp.o"
+  "CMakeFiles/test_CommonTests.dir/TestException.cpp.o.d"
+  "CMakeFiles/test_CommonTests.dir/TestStateBuffer.cpp.o"
+  "CMakeFiles/test_CommonTests.dir/TestStateBuffer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_CommonTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
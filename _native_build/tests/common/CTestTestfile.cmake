@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/common
+# Build directory: /root/repo/_native_build/tests/common
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(CommonTests "/root/repo/_native_build/bin/tests/CommonTests")
+set_tests_properties(CommonTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;43;add_test;/root/repo/tests/common/CMakeLists.txt;11;add_test_suite;/root/repo/tests/common/CMakeLists.txt;0;")
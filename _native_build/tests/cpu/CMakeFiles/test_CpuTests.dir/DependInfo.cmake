@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/cpu/TestInterpretedMos6502.cpp" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestInterpretedMos6502.cpp.o" "gcc" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestInterpretedMos6502.cpp.o.d"
+  "/root/repo/tests/cpu/TestLockstepMos6502.cpp" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestLockstepMos6502.cpp.o" "gcc" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestLockstepMos6502.cpp.o.d"
+  "/root/repo/tests/cpu/TestMos6502.cpp" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestMos6502.cpp.o" "gcc" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestMos6502.cpp.o.d"
+  "/root/repo/tests/cpu/TestMos6502Disassembler.cpp" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestMos6502Disassembler.cpp.o" "gcc" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestMos6502Disassembler.cpp.o.d"
+  "/root/repo/tests/cpu/TestMos6502Mmu.cpp" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestMos6502Mmu.cpp.o" "gcc" "tests/cpu/CMakeFiles/test_CpuTests.dir/TestMos6502Mmu.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_native_build/source/common/CMakeFiles/common.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/cpu/CMakeFiles/cpu.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/nes/CMakeFiles/nes.dir/DependInfo.cmake"
+  "/root/repo/_native_build/tests/CMakeFiles/catch.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "../../bin/tests/CpuTests"
+  "../../bin/tests/CpuTests.pdb"
+  "CMakeFiles/test_CpuTests.dir/TestInterpretedMos6502.cpp.o"
+  "CMakeFiles/test_CpuTests.dir/TestInterpretedMos6502.cpp.o.d"
+  "CMakeFiles/test_CpuTests.dir/TestLockstepMos6502.cpp.o"
+  "CMakeFiles/test_CpuTests.dir/TestLockstepMos6502.cpp.o.d"
+  "CMakeFiles/test_CpuTests.dir/TestMos6502.cpp.o"
+  "CMakeFiles/test_CpuTests.dir/TestMos6502.cpp.o.d"
+  "CMakeFiles/test_CpuTests.dir/TestMos6502Disassembler.cpp.o"
+  "CMakeFiles/test_CpuTests.dir/TestMos6502Disassembler.cpp.o.d"
+  "CMakeFiles/test_CpuTests.dir/TestMos6502Mmu.cpp.o"
+  "CMakeFiles/test_CpuTests.dir/TestMos6502Mmu.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_CpuTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/cpu
+# Build directory: /root/repo/_native_build/tests/cpu
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(CpuTests "/root/repo/_native_build/bin/tests/CpuTests")
+set_tests_properties(CpuTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;43;add_test;/root/repo/tests/cpu/CMakeLists.txt;15;add_test_suite;/root/repo/tests/cpu/CMakeLists.txt;0;")
@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/memory/TestArena.cpp" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestArena.cpp.o" "gcc" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestArena.cpp.o.d"
+  "/root/repo/tests/memory/TestIoPort.cpp" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestIoPort.cpp.o" "gcc" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestIoPort.cpp.o.d"
+  "/root/repo/tests/memory/TestMirroredRam.cpp" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestMirroredRam.cpp.o" "gcc" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestMirroredRam.cpp.o.d"
+  "/root/repo/tests/memory/TestRam.cpp" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestRam.cpp.o" "gcc" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestRam.cpp.o.d"
+  "/root/repo/tests/memory/TestReference.cpp" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestReference.cpp.o" "gcc" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestReference.cpp.o.d"
+  "/root/repo/tests/memory/TestRom.cpp" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestRom.cpp.o" "gcc" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestRom.cpp.o.d"
+  "/root/repo/tests/memory/TestWindow.cpp" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestWindow.cpp.o" "gcc" "tests/memory/CMakeFiles/test_MemoryTests.dir/TestWindow.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_native_build/source/common/CMakeFiles/common.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/cpu/CMakeFiles/cpu.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/nes/CMakeFiles/nes.dir/DependInfo.cmake"
+  "/root/repo/_native_build/tests/CMakeFiles/catch.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "../../bin/tests/MemoryTests"
+  "../../bin/tests/MemoryTests.pdb"
+  "CMakeFiles/test_MemoryTests.dir/TestArena.cpp.o"
+  "CMakeFiles/test_MemoryTests.dir/TestArena.cpp.o.d"
+  "CMakeFiles/test_MemoryTests.dir/TestIoPort.cpp.o"
+  "CMakeFiles/test_MemoryTests.dir/TestIoPort.cpp.o.d"
+  "CMakeFiles/test_MemoryTests.dir/TestMirroredRam.cpp.o"
+  "CMakeFiles/test_MemoryTests.dir/TestMirroredRam.cpp.o.d"
+  "CMakeFiles/test_MemoryTests.dir/TestRam.cpp.o"
+  "CMakeFiles/test_MemoryTests.dir/TestRam.cpp.o.d"
+  "CMakeFiles/test_MemoryTests.dir/TestReference.cpp.o"
+  "CMakeFiles/test_MemoryTests.dir/TestReference.cpp.o.d"
+  "CMakeFiles/test_MemoryTests.dir/TestRom.cpp.o"
+  "CMakeFiles/test_MemoryTests.dir/TestRom.cpp.o.d"
+  "CMakeFiles/test_MemoryTests.dir/TestWindow.cpp.o"
+  "CMakeFiles/test_MemoryTests.dir/TestWindow.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_MemoryTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
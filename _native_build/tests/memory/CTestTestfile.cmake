@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/memory
+# Build directory: /root/repo/_native_build/tests/memory
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(MemoryTests "/root/repo/_native_build/bin/tests/MemoryTests")
+set_tests_properties(MemoryTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;43;add_test;/root/repo/tests/memory/CMakeLists.txt;16;add_test_suite;/root/repo/tests/memory/CMakeLists.txt;0;")
@@ -0,0 +1,42 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/nes/TestApu.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestApu.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestApu.cpp.o.d"
+  "/root/repo/tests/nes/TestAudioRecorder.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestAudioRecorder.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestAudioRecorder.cpp.o.d"
+  "/root/repo/tests/nes/TestAudioRing.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestAudioRing.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestAudioRing.cpp.o.d"
+  "/root/repo/tests/nes/TestBatchRunner.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestBatchRunner.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestBatchRunner.cpp.o.d"
+  "/root/repo/tests/nes/TestCartridgeBuilder.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestCartridgeBuilder.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestCartridgeBuilder.cpp.o.d"
+  "/root/repo/tests/nes/TestConsole.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestConsole.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestConsole.cpp.o.d"
+  "/root/repo/tests/nes/TestControllers.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestControllers.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestControllers.cpp.o.d"
+  "/root/repo/tests/nes/TestCpu2A03.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestCpu2A03.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestCpu2A03.cpp.o.d"
+  "/root/repo/tests/nes/TestCpuBus.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestCpuBus.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestCpuBus.cpp.o.d"
+  "/root/repo/tests/nes/TestFrameSink.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestFrameSink.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestFrameSink.cpp.o.d"
+  "/root/repo/tests/nes/TestMappers.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestMappers.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestMappers.cpp.o.d"
+  "/root/repo/tests/nes/TestObservationStack.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestObservationStack.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestObservationStack.cpp.o.d"
+  "/root/repo/tests/nes/TestParallelRenderer.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestParallelRenderer.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestParallelRenderer.cpp.o.d"
+  "/root/repo/tests/nes/TestPpu.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestPpu.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestPpu.cpp.o.d"
+  "/root/repo/tests/nes/TestResampler.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestResampler.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestResampler.cpp.o.d"
+  "/root/repo/tests/nes/TestRewindBuffer.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestRewindBuffer.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestRewindBuffer.cpp.o.d"
+  "/root/repo/tests/nes/TestRomStore.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestRomStore.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestRomStore.cpp.o.d"
+  "/root/repo/tests/nes/TestRunAhead.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestRunAhead.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestRunAhead.cpp.o.d"
+  "/root/repo/tests/nes/TestTileCache.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestTileCache.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestTileCache.cpp.o.d"
+  "/root/repo/tests/nes/TestVideoConverter.cpp" "tests/nes/CMakeFiles/test_NesTests.dir/TestVideoConverter.cpp.o" "gcc" "tests/nes/CMakeFiles/test_NesTests.dir/TestVideoConverter.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_native_build/source/common/CMakeFiles/common.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/cpu/CMakeFiles/cpu.dir/DependInfo.cmake"
+  "/root/repo/_native_build/source/nes/CMakeFiles/nes.dir/DependInfo.cmake"
+  "/root/repo/_native_build/tests/CMakeFiles/catch.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
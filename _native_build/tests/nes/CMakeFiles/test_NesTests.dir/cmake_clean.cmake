@@ -0,0 +1,49 @@
+file(REMOVE_RECURSE
+  "../../bin/tests/NesTests"
+  "../../bin/tests/NesTests.pdb"
+  "CMakeFiles/test_NesTests.dir/TestApu.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestApu.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestAudioRecorder.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestAudioRecorder.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestAudioRing.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestAudioRing.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestBatchRunner.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestBatchRunner.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestCartridgeBuilder.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestCartridgeBuilder.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestConsole.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestConsole.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestControllers.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestControllers.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestCpu2A03.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestCpu2A03.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestCpuBus.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestCpuBus.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestFrameSink.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestFrameSink.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestMappers.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestMappers.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestObservationStack.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestObservationStack.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestParallelRenderer.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestParallelRenderer.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestPpu.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestPpu.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestResampler.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestResampler.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestRewindBuffer.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestRewindBuffer.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestRomStore.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestRomStore.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestRunAhead.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestRunAhead.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestTileCache.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestTileCache.cpp.o.d"
+  "CMakeFiles/test_NesTests.dir/TestVideoConverter.cpp.o"
+  "CMakeFiles/test_NesTests.dir/TestVideoConverter.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_NesTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/nes
+# Build directory: /root/repo/_native_build/tests/nes
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(NesTests "/root/repo/_native_build/bin/tests/NesTests")
+set_tests_properties(NesTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;43;add_test;/root/repo/tests/nes/CMakeLists.txt;30;add_test_suite;/root/repo/tests/nes/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/tests/OpenNesTests"
+  "../../bin/tests/OpenNesTests.pdb"
+  "CMakeFiles/test_OpenNesTests.dir/TestOpenNesBatch.cpp.o"
+  "CMakeFiles/test_OpenNesTests.dir/TestOpenNesBatch.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_OpenNesTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
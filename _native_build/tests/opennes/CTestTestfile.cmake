@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/opennes
+# Build directory: /root/repo/_native_build/tests/opennes
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(OpenNesTests "/root/repo/_native_build/bin/tests/OpenNesTests")
+set_tests_properties(OpenNesTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;43;add_test;/root/repo/tests/opennes/CMakeLists.txt;12;add_test_suite;/root/repo/tests/opennes/CMakeLists.txt;0;")
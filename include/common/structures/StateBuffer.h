@@ -0,0 +1,164 @@
+//===-- include/common/structures/StateBuffer.h - Saved States --*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the declarations of the StateWriter and StateReader
+/// classes, which lay saved states out as flat binary blobs.
+///
+//===----------------------------------------------------------------------===//
+#ifndef STATE_BUFFER_H
+#define STATE_BUFFER_H
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "common/structures/StructureException.h"
+
+namespace Structure {
+
+/// \class StateWriter
+/// \brief This class appends the fields of a saved state to a byte buffer.
+/// Fields are copied as they are laid out in memory, in host byte order, with
+/// no tags or padding between them, so the layout of a state is fixed by the
+/// order the fields are written in. The buffer keeps its capacity between
+/// states, so saving a state every frame does not allocate.
+class StateWriter {
+  public:
+    /// Start writing a state into a buffer, discarding its contents.
+    /// \param buffer The buffer to write into.
+    explicit StateWriter(std::vector<byte>& buffer) : buffer(buffer) {
+      buffer.clear();
+    }
+
+    /// Append a field.
+    /// \tparam T Type of the field, which must be trivially copyable.
+    /// \param value The field.
+    template<class T>
+    inline void write(const T& value);
+
+    /// Append a run of bytes.
+    /// \param data The bytes.
+    /// \param size Number of bytes.
+    inline void write(const void* data, std::size_t size);
+
+    /// Get the number of bytes written.
+    /// \returns The size of the state so far.
+    inline std::size_t getSize() const;
+
+  private:
+    /// The buffer written into.
+    std::vector<byte>& buffer;
+};
+
+/// \class StateReader
+/// \brief This class reads the fields of a saved state back out of a byte
+/// buffer, in the order a StateWriter wrote them.
+class StateReader {
+  public:
+    /// Start reading a state.
+    /// \param data The state.
+    /// \param size Number of bytes in the state.
+    StateReader(const byte* data, std::size_t size) :
+      data(data),
+      size(size),
+      offset(0) {}
+
+    /// Read a field.
+    /// \tparam T Type of the field, which must be trivially copyable.
+    /// \param value Receives the field.
+    /// \throws Exception::StructureException if the state is too short.
+    template<class T>
+    inline void read(T& value);
+
+    /// Read a field.
+    /// \tparam T Type of the field, which must be trivially copyable.
+    /// \returns The field.
+    /// \throws Exception::StructureException if the state is too short.
+    template<class T>
+    inline T read();
+
+    /// Read a run of bytes.
+    /// \param destination Receives the bytes.
+    /// \param count Number of bytes.
+    /// \throws Exception::StructureException if the state is too short.
+    inline void read(void* destination, std::size_t count);
+
+    /// Step over a run of bytes, to be copied straight out of the state by
+    /// the caller.
+    /// \param count Number of bytes.
+    /// \returns The bytes, which live as long as the state.
+    /// \throws Exception::StructureException if the state is too short.
+    inline const byte* view(std::size_t count);
+
+    /// Get the number of bytes not yet read.
+    /// \returns The number of bytes left.
+    inline std::size_t getRemaining() const;
+
+  private:
+    /// The state.
+    const byte* data;
+    /// Number of bytes in the state.
+    std::size_t size;
+    /// Number of bytes read.
+    std::size_t offset;
+};
+
+template<class T>
+void StateWriter::write(const T& value) {
+  static_assert(std::is_trivially_copyable<T>::value,
+      "Only trivially copyable fields can be saved as they are.");
+  write(&value, sizeof(T));
+}
+
+void StateWriter::write(const void* data, std::size_t size) {
+  const byte* bytes = static_cast<const byte*>(data);
+  buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+std::size_t StateWriter::getSize() const {
+  return buffer.size();
+}
+
+template<class T>
+void StateReader::read(T& value) {
+  static_assert(std::is_trivially_copyable<T>::value,
+      "Only trivially copyable fields can be loaded as they are.");
+  read(&value, sizeof(T));
+}
+
+template<class T>
+T StateReader::read() {
+  T value;
+  read(value);
+  return value;
+}
+
+void StateReader::read(void* destination, std::size_t count) {
+  std::memcpy(destination, view(count), count);
+}
+
+const byte* StateReader::view(std::size_t count) {
+  if(count > size - offset) {
+    throw Exception::StructureException("Saved state of " + std::to_string(size)
+        + " bytes ends before byte " + std::to_string(offset + count) + ".");
+  }
+  const byte* bytes = data + offset;
+  offset += count;
+  return bytes;
+}
+
+std::size_t StateReader::getRemaining() const {
+  return size - offset;
+}
+
+} // namespace Structure
+
+#endif // STATE_BUFFER_H //:~
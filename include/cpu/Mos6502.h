@@ -17,6 +17,7 @@
 #include <string>
 
 #include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
 #include "cpu/AbstractCpu.h"
 #include "cpu/Mos6502Mmu.h"
 #include "cpu/Mos6502Disassembler.h"
@@ -27,19 +28,24 @@
 
 namespace Cpu {
 
-/// \class Mos6502
+/// \class Mos6502Core
 /// \brief This class is an abstract base that provides common functionality and
 /// structure for emulation the Mos6502. Inheritors of this class can use the
 /// public and protected interface of this class to provide a more concrete
 /// method of emulation.
-class Mos6502 : public AbstractCpu {
+/// \tparam MapperType Type of the memory map. Instantiating with a concrete
+/// mapper, rather than Memory::Mapper, resolves every memory access at compile
+/// time.
+template<class MapperType>
+class Mos6502Core : public AbstractCpu {
   public:
     /// Default constructor. Bootstrap a Mos6502 CPU object.
-    Mos6502(Memory::Mapper<byte>& memMap) :
+    Mos6502Core(MapperType& memMap) :
         stack(reg.sp, memMap),
         dis(),
         mmu(reg.x, reg.y, memMap) {
       this->cycleCount = 0;
+      this->reg.ir = 0;
       this->reg.pc.val = 0;
       this->reg.ac = 0;
       this->reg.x = 0;
@@ -56,6 +62,27 @@ class Mos6502 : public AbstractCpu {
     void trace() override;
     void shutdown() override;
 
+    /// Service a non-maskable interrupt. The program counter and status
+    /// register are pushed and execution continues at the NMI vector. Should
+    /// only be called between instructions, when the cycle count is zero.
+    void nmi();
+
+    /// Service a maskable interrupt request, unless interrupts are disabled.
+    /// Should only be called between instructions, when the cycle count is
+    /// zero.
+    /// \returns true if the interrupt was taken.
+    bool irq();
+
+    /// Write the registers, and the cycles left of the current instruction,
+    /// to a saved state.
+    /// \param writer The state being written.
+    inline void saveState(Structure::StateWriter& writer) const;
+
+    /// Read the registers, and the cycles left of the current instruction,
+    /// from a saved state.
+    /// \param reader The state being read.
+    inline void loadState(Structure::StateReader& reader);
+
     // Cpu state inspection methods
     /// Get the remaining number of cycles to execute for the current instruction.
     /// \returns The current cycle count.
@@ -303,9 +330,14 @@ class Mos6502 : public AbstractCpu {
     
     /// Get the internal memory management object for the Mos6502 object.
     /// \returns The internal Mos6502Mmu object.
-    inline const Mos6502Mmu& getMmu() const;
+    inline const Mos6502MmuCore<MapperType>& getMmu() const;
 
   private:
+    /// Push the program counter and status register, disable interrupts and
+    /// jump through the given vector, as the hardware does for NMI and IRQ.
+    /// \param vector Address of the interrupt vector.
+    inline void interrupt(const Vaddr vector);
+
     // Mos6502 private static consts
     /// Low byte location of memory containing non-maskable interrupt vector
     static constexpr const Vaddr& NMI_VECTOR = { 0xFFFA };
@@ -376,12 +408,12 @@ class Mos6502 : public AbstractCpu {
 
         Stack(
             byte& stackPointerRegister,
-            const Memory::Mapper<byte>& memMap) 
+            const MapperType& memMap) 
             : stackPointer(stackPointerRegister) {
           auto bankPtr = memMap.mapToHardware(BASE_ADDRESS);
           // Mos6502 stack is top-down, so we must offset top from base.
           base = Memory::Reference<byte>(bankPtr,
-              BASE_ADDRESS.val - bankPtr->getBaseAddress().val);
+              bankPtr->getIndex(BASE_ADDRESS));
         }
 
         ~Stack() {}
@@ -398,71 +430,197 @@ class Mos6502 : public AbstractCpu {
     Mos6502Disassembler dis;
 
     /// The memory management unit for the Mos6502.
-    const Mos6502Mmu mmu;
+    const Mos6502MmuCore<MapperType> mmu;
 
 };
 
+template<class MapperType>
+void Mos6502Core<MapperType>::saveState(Structure::StateWriter& writer) const {
+  // Registers are written one at a time, so that the padding and bit-field
+  // layout of the register structure stay out of the state.
+  writer.write(cycleCount);
+  writer.write(reg.ir);
+  writer.write(reg.pc.val);
+  writer.write(reg.ac);
+  writer.write(reg.x);
+  writer.write(reg.y);
+  writer.write(reg.sr);
+  writer.write(reg.sp);
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::loadState(Structure::StateReader& reader) {
+  reader.read(cycleCount);
+  reader.read(reg.ir);
+  reader.read(reg.pc.val);
+  reader.read(reg.ac);
+  reader.read(reg.x);
+  reader.read(reg.y);
+  reader.read(reg.sr);
+  reader.read(reg.sp);
+}
+
 // Inlinable Cpu state inspection methods.
-byte Mos6502::getCycleCount() const {
+template<class MapperType>
+byte Mos6502Core<MapperType>::getCycleCount() const {
   return cycleCount;
 }
 
-void Mos6502::incrementCycles(const byte value) {
+template<class MapperType>
+void Mos6502Core<MapperType>::incrementCycles(const byte value) {
   this->cycleCount += value;
 }
 
-void Mos6502::decrementCycles() {
+template<class MapperType>
+void Mos6502Core<MapperType>::decrementCycles() {
   this->cycleCount--;
 }
 
-byte Mos6502::getRegIR() const {
+template<class MapperType>
+byte Mos6502Core<MapperType>::getRegIR() const {
   return reg.ir;
 }
 
-void Mos6502::setRegIR(const byte value) {
+template<class MapperType>
+void Mos6502Core<MapperType>::setRegIR(const byte value) {
   this->reg.ir = value;
 }
 
-addr Mos6502::getRegPC() const {
+template<class MapperType>
+addr Mos6502Core<MapperType>::getRegPC() const {
   return reg.pc.val;
 }
 
-void Mos6502::incrementRegPC(const addr value) {
+template<class MapperType>
+void Mos6502Core<MapperType>::incrementRegPC(const addr value) {
   this->reg.pc.val += value;
 }
 
-byte Mos6502::getRegAC() const {
+template<class MapperType>
+byte Mos6502Core<MapperType>::getRegAC() const {
   return reg.ac;
 }
 
-void Mos6502::setRegAC(const byte value) {
+template<class MapperType>
+void Mos6502Core<MapperType>::setRegAC(const byte value) {
   this->reg.ac = value;
 }
 
-byte Mos6502::getRegX() const {
+template<class MapperType>
+byte Mos6502Core<MapperType>::getRegX() const {
   return reg.x;
 }
 
-byte Mos6502::getRegY() const {
+template<class MapperType>
+byte Mos6502Core<MapperType>::getRegY() const {
   return reg.y;
 }
 
-byte Mos6502::getRegSR() const {
+template<class MapperType>
+byte Mos6502Core<MapperType>::getRegSR() const {
   return reg.sr;
 }
 
-byte Mos6502::getRegSP() const {
+template<class MapperType>
+byte Mos6502Core<MapperType>::getRegSP() const {
   return reg.sp;
 }
 
-Mos6502Disassembler& Mos6502::getDis() {
+template<class MapperType>
+Mos6502Disassembler& Mos6502Core<MapperType>::getDis() {
   return dis;
 }
 
-const Mos6502Mmu& Mos6502::getMmu() const {
+template<class MapperType>
+const Mos6502MmuCore<MapperType>& Mos6502Core<MapperType>::getMmu() const {
   return mmu;
 }
 
+// CpuBase class methods
+template<class MapperType>
+void Mos6502Core<MapperType>::init() {
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::run() {
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::step() {
+  if(getCycleCount() == 0) {
+    fetchOpcode();
+    decodeOpcode();
+    executeOpcode();
+  }
+  decrementCycles();
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::reset() {
+  // load RESET vector from memory, with interrupts masked until the program
+  // is ready for them
+  reg.srf.i = 1;
+  reg.pc = getMmu().loadVector(RESET_VECTOR);
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::nmi() {
+  interrupt(NMI_VECTOR);
+}
+
+template<class MapperType>
+bool Mos6502Core<MapperType>::irq() {
+  if(reg.srf.i) {
+    return false;
+  }
+  interrupt(IRQ_VECTOR);
+  return true;
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::interrupt(const Vaddr vector) {
+  // Hardware interrupts push the status register with the break flag clear,
+  // which is how an RTI'd handler tells them apart from BRK.
+  stack.push(reg.pc.hh);
+  stack.push(reg.pc.ll);
+  stack.push(reg.sr & ~SR_B);
+  reg.srf.i = 1;
+  reg.pc = getMmu().loadVector(vector);
+  // Taking an interrupt takes as long as a BRK.
+  incrementCycles(7);
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::trace() {
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::shutdown() {
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::fetchOpcode() {
+  // call the implementation of fetchOpcode
+  fetchOpcodeImpl();
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::decodeOpcode() {
+  // call the implementation of decodeOpcode
+  decodeOpcodeImpl();
+}
+
+template<class MapperType>
+void Mos6502Core<MapperType>::executeOpcode() {
+  // call the implementation of executeOpcode
+  executeOpcodeImpl();
+}
+
+/// The Mos6502, resolving memory accesses through any mapper.
+using Mos6502 = Mos6502Core<Memory::Mapper<byte>>;
+
+extern template class Mos6502Core<Memory::Mapper<byte>>;
+
 #include "cpu/Mos6502_Ops.h"
 
 } // namespace Cpu
@@ -21,21 +21,25 @@
 
 namespace Cpu {
 
-/// \class Mos6502Mmu
+/// \class Mos6502MmuCore
 /// \brief This class represents the memory management unit for the Mos6502.
 /// This class is responsible for taking virtual addresses and converting
 /// them into references to real hardware.
-class Mos6502Mmu {
+/// \tparam MapperType Type of the memory map. Instantiating with a concrete
+/// mapper, rather than Memory::Mapper, resolves and inlines every call to
+/// mapToHardware at compile time.
+template<class MapperType>
+class Mos6502MmuCore {
   public:
     // Constructors / Destructors
-    /// Constructor for the Mos6502Mmu. This constructor requires references to both
+    /// Constructor for the Mos6502MmuCore. This constructor requires references to both
     /// index registers of the Mos6502 and a Memory::Mapper as these are needed to
     /// provide sensible memory management for the Mos6502.
     /// \param regX A reference to a Mos6502 X-index register.
     /// \param regY A reference to a Mos6502 Y-index register.
     /// \param memMap Hardware memory map to use internally.
-    Mos6502Mmu(const byte& regX, const byte& regY, const Memory::Mapper<byte>& memMap);
-    ~Mos6502Mmu() {};
+    Mos6502MmuCore(const byte& regX, const byte& regY, const MapperType& memMap);
+    ~Mos6502MmuCore() {};
 
     /// Retrieves the two byte vector whose low is pointed to by the input.
     /// \param vaddr Address of low byte of vector in memory
@@ -103,7 +107,7 @@ class Mos6502Mmu {
     const byte& indexRegY;
 
     /// Reference to the memory mapper to use.
-    const Memory::Mapper<byte>& memoryMap;
+    const MapperType& memoryMap;
 
     // Private implementation functions
     inline Memory::Reference<byte> absoluteImpl(Vaddr vaddr) const;
@@ -112,6 +116,119 @@ class Mos6502Mmu {
 
 };
 
+/// The Mos6502 memory management unit, resolving addresses through any mapper.
+using Mos6502Mmu = Mos6502MmuCore<Memory::Mapper<byte>>;
+
+// Constructor
+template<class MapperType>
+Mos6502MmuCore<MapperType>::Mos6502MmuCore(
+    const byte& regX, 
+    const byte& regY, 
+    const MapperType& memMap) :
+  indexRegX(regX),
+  indexRegY(regY),
+  memoryMap(memMap) {}
+
+//===---------------------------------------------------------------------===//
+// Private inlined implementation functions
+//===---------------------------------------------------------------------===//
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::absoluteImpl(Vaddr vaddr) const {
+  // Map this virtual address to its corresponding hardware bank.
+  Memory::Bank<byte>* dataBank = memoryMap.mapToHardware(vaddr);
+  // Compute the index into this dataBank relative to its base address
+  std::size_t index = dataBank->getIndex(vaddr);
+  return Memory::Reference<byte>(dataBank, index);
+}
+
+template<class MapperType>
+Vaddr Mos6502MmuCore<MapperType>::indirectImpl(Vaddr vaddr) const {
+  // Compute the absolute address to use
+  Memory::Bank<byte>* dataBank = memoryMap.mapToHardware(vaddr);
+  std::size_t index = dataBank->getIndex(vaddr);
+  // Now grab the real address
+  Vaddr effectiveAddress;
+  effectiveAddress.ll = dataBank->read(index);
+  effectiveAddress.hh = dataBank->read(index + 1);
+  return effectiveAddress;
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::zeropageImpl(Vaddr vaddr) const {
+  // find the zeropage memory bank. since we are on the zeropage, we do not
+  // need to compute a new index. vaddr's low byte is sufficient
+  Memory::Bank<byte>* dataBank = memoryMap.mapToHardware(vaddr);
+  return Memory::Reference<byte>(dataBank, vaddr.ll);
+}
+
+//===---------------------------------------------------------------------===//
+// Mos6502Mmu member functions
+//===---------------------------------------------------------------------===//
+template<class MapperType>
+Vaddr Mos6502MmuCore<MapperType>::loadVector(Vaddr vaddr) const {
+  return indirectImpl(vaddr);
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::absolute(Vaddr vaddr) const {
+  return absoluteImpl(vaddr);
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::absoluteXIndexed(Vaddr vaddr) const {
+  // Add with carry the index X to the virtual address
+  vaddr.val += indexRegX;
+  return absoluteImpl(vaddr);
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::absoluteYIndexed(Vaddr vaddr) const {
+  // Add with carry the index Y to the virtual address
+  vaddr.val += indexRegY;
+  return absoluteImpl(vaddr);
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::indirect(Vaddr vaddr) const {
+  return absoluteImpl(indirectImpl(vaddr));
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::xIndexedIndirect(Vaddr vaddr) const {
+  // Increment the low byte of our address without carry; ensure high byte is zero.
+  vaddr.ll += indexRegX;
+  vaddr.hh = 0;
+  // do indirect addressing.
+  return absoluteImpl(indirectImpl(vaddr));
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::indirectYIndexed(Vaddr vaddr) const {
+  // Compute the effective address, increment by Y and read from that address.
+  Vaddr effectiveAddress = indirectImpl(vaddr);
+  effectiveAddress.val += indexRegY;
+  return absoluteImpl(effectiveAddress);
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::zeropage(Vaddr vaddr) const {
+  return zeropageImpl(vaddr);
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::zeropageXIndexed(Vaddr vaddr) const {
+  vaddr.ll += indexRegX;
+  return zeropageImpl(vaddr);
+}
+
+template<class MapperType>
+Memory::Reference<byte> Mos6502MmuCore<MapperType>::zeropageYIndexed(Vaddr vaddr) const {
+  vaddr.ll += indexRegY;
+  return zeropageImpl(vaddr);
+}
+
+extern template class Mos6502MmuCore<Memory::Mapper<byte>>;
+
 } // namespace Cpu
 
 #endif // MOS6502_MMU_H //
@@ -1,4 +1,4 @@
-//===-- source/cpu/Mos6502_Inst.h - Mos6502 Cpu Class Impl ------*- C++ -*-===//
+//===-- include/cpu/Mos6502_Inst.h - Mos6502 Cpu Class Impl -----*- C++ -*-===//
 //
 //                           The OpenNES Project
 //
@@ -45,7 +45,8 @@ static inline uint16 computeBranch(uint16 pc, byte m);
 // ----------------------------------------------------------------------------
 
 // Load Accumulator with Memory
-inline void Cpu::Mos6502::LDA(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::LDA(const byte opd) {
   // Copy memory to accumulator
   reg.ac = opd;
   // set appropriate status register flags
@@ -55,7 +56,8 @@ inline void Cpu::Mos6502::LDA(const byte opd) {
 }
 
 // Load Index X with Memory
-inline void Cpu::Mos6502::LDX(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::LDX(const byte opd) {
   // Copy memory to X register
   reg.x = opd;
   // set appropriate status register flags
@@ -65,7 +67,8 @@ inline void Cpu::Mos6502::LDX(const byte opd) {
 }
 
 // Load Index Y with Memory
-inline void Cpu::Mos6502::LDY(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::LDY(const byte opd) {
   // Copy memory to Y register
   reg.y = opd;
   // set appropriate status register flags
@@ -75,19 +78,22 @@ inline void Cpu::Mos6502::LDY(const byte opd) {
 }
 
 // Store Accumulator in Memory
-inline byte Cpu::Mos6502::STA() {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::STA() {
   // return accumulator value to be stored
   return reg.ac;
 }
 
 // Store Index X in Memory
-inline byte Cpu::Mos6502::STX() {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::STX() {
   // return X register value to be stored
   return reg.x;
 }
 
 // Store Index Y in Memory
-inline byte Cpu::Mos6502::STY() {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::STY() {
   // return Y register value to be stored
   return reg.y;
 }
@@ -98,7 +104,8 @@ inline byte Cpu::Mos6502::STY() {
 // ----------------------------------------------------------------------------
 
 // Add Memory to Accumulator with Carry
-inline void Cpu::Mos6502::ADC(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::ADC(const byte opd) {
   // To add 2 bytes with carry, we will first widen to native width, perform
   // the add with carry, and mask out the relevant bits.
   // ADD the memory to Accumulator + carry if set
@@ -124,7 +131,8 @@ inline void Cpu::Mos6502::ADC(const byte opd) {
 
 // Subtract Memory from Accumulator with Borrow
 // Notice that SBC(x) == ADC(~x) since a - x - !c == a + ~x + 1 - !c == a + ~x + c
-inline void Cpu::Mos6502::SBC(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::SBC(const byte opd) {
   ADC(~opd);
   return;
 }
@@ -135,7 +143,8 @@ inline void Cpu::Mos6502::SBC(const byte opd) {
 // ----------------------------------------------------------------------------
 
 // Increment Memory by One
-inline byte Cpu::Mos6502::INC(byte opd) {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::INC(byte opd) {
   opd = opd + 1;
   // set appropriate status register flags
   reg.srf.z = checkZero(opd);
@@ -144,7 +153,8 @@ inline byte Cpu::Mos6502::INC(byte opd) {
 }
 
 // Increment Index X by One
-inline void Cpu::Mos6502::INX() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::INX() {
   reg.x = reg.x + 1;
   // set appropriate status register flags
   reg.srf.z = checkZero(reg.x);
@@ -153,7 +163,8 @@ inline void Cpu::Mos6502::INX() {
 }
 
 // Increment Memory by One
-inline void Cpu::Mos6502::INY() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::INY() {
   reg.y = reg.y + 1;
   // set appropriate status register flags
   reg.srf.z = checkZero(reg.y);
@@ -162,7 +173,8 @@ inline void Cpu::Mos6502::INY() {
 }
 
 // Decrement Memory by One
-inline byte Cpu::Mos6502::DEC(byte opd) {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::DEC(byte opd) {
   opd = opd - 1;
   // set appropriate status register flags
   reg.srf.z = checkZero(opd);
@@ -171,7 +183,8 @@ inline byte Cpu::Mos6502::DEC(byte opd) {
 }
 
 // Decrement Index X by One
-inline void Cpu::Mos6502::DEX() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::DEX() {
   reg.x = reg.x - 1;
   // set appropriate status register flags
   reg.srf.z = checkZero(reg.x);
@@ -180,7 +193,8 @@ inline void Cpu::Mos6502::DEX() {
 }
 
 // Decrement Memory by One
-inline void Cpu::Mos6502::DEY() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::DEY() {
   reg.y = reg.y - 1;
   // set appropriate status register flags
   reg.srf.z = checkZero(reg.y);
@@ -194,7 +208,8 @@ inline void Cpu::Mos6502::DEY() {
 // ----------------------------------------------------------------------------
 
 // AND Memory with Accumulator
-inline void Cpu::Mos6502::AND(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::AND(const byte opd) {
   // AND the memory M with the Accumulator
   reg.ac = reg.ac & opd;
   // Set the remaining status register flags
@@ -204,7 +219,8 @@ inline void Cpu::Mos6502::AND(const byte opd) {
 }
 
 // EOR Exclusive-OR Memory with Accumulator
-inline void Cpu::Mos6502::EOR(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::EOR(const byte opd) {
   // XOR the memory M with the Accumulator
   reg.ac = reg.ac ^ opd;
   // Set the remaining status register flags
@@ -214,7 +230,8 @@ inline void Cpu::Mos6502::EOR(const byte opd) {
 }
 
 // OR Memory with Accumulator
-inline void Cpu::Mos6502::ORA(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::ORA(const byte opd) {
   // OR the memory M with the Accumulator
   reg.ac = reg.ac | opd;
   // Set the remaining status register flags
@@ -229,7 +246,8 @@ inline void Cpu::Mos6502::ORA(const byte opd) {
 // ----------------------------------------------------------------------------
 
 // Jump to New Location
-inline void Cpu::Mos6502::JMP(const Vaddr vaddr) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::JMP(const Vaddr vaddr) {
   // vaddr.ll is the low byte of the new PC and vaddr.hh is the high byte of new PC
   // (PC+1 = vaddr.ll) -> PCL
   // (PC+2 = vaddr.hh -> PCH
@@ -238,7 +256,8 @@ inline void Cpu::Mos6502::JMP(const Vaddr vaddr) {
 }
 
 // Branch on Carry Clear
-inline void Cpu::Mos6502::BCC(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BCC(const byte opd) {
   if(reg.srf.c == 0) {
     // Condition true, branch to PC + offset
     reg.pc.val = computeBranch(reg.pc.val, opd);
@@ -247,7 +266,8 @@ inline void Cpu::Mos6502::BCC(const byte opd) {
 }
 
 // Branch of Carry Set
-inline void Cpu::Mos6502::BCS(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BCS(const byte opd) {
   if(reg.srf.c == 1) {
     // Condition true, branch to PC + offset
     reg.pc.val = computeBranch(reg.pc.val, opd);
@@ -256,7 +276,8 @@ inline void Cpu::Mos6502::BCS(const byte opd) {
 }
 
 // Branch on Result Zero
-inline void Cpu::Mos6502::BEQ(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BEQ(const byte opd) {
   if(reg.srf.z == 1) {
     // Condition true, branch to PC + offset
     reg.pc.val = computeBranch(reg.pc.val,opd);
@@ -265,7 +286,8 @@ inline void Cpu::Mos6502::BEQ(const byte opd) {
 }
 
 // Branch on Result Minus
-inline void Cpu::Mos6502::BMI(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BMI(const byte opd) {
   if(reg.srf.n == 1) {
     // Condition true, branch to PC + offset
     reg.pc.val = computeBranch(reg.pc.val,opd);
@@ -274,7 +296,8 @@ inline void Cpu::Mos6502::BMI(const byte opd) {
 }
 
 // Branch on Result not Zero
-inline void Cpu::Mos6502::BNE(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BNE(const byte opd) {
   if(reg.srf.z == 0) {
     // Condition true, branch to PC + offset
     reg.pc.val = computeBranch(reg.pc.val,opd);
@@ -283,7 +306,8 @@ inline void Cpu::Mos6502::BNE(const byte opd) {
 }
 
 // Branch on Result Plus
-inline void Cpu::Mos6502::BPL(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BPL(const byte opd) {
   if(reg.srf.n == 0) {
     // Condition true, branch to PC + offset
     reg.pc.val = computeBranch(reg.pc.val,opd);
@@ -292,7 +316,8 @@ inline void Cpu::Mos6502::BPL(const byte opd) {
 }
 
 // Branch on Overflow Clear
-inline void Cpu::Mos6502::BVC(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BVC(const byte opd) {
   if(reg.srf.v == 0) {
     // Condition true, branch to PC + offset
     reg.pc.val = computeBranch(reg.pc.val,opd);
@@ -301,7 +326,8 @@ inline void Cpu::Mos6502::BVC(const byte opd) {
 }
 
 // Branch on Overflow Set
-inline void Cpu::Mos6502::BVS(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BVS(const byte opd) {
   if(reg.srf.v == 1) {
     // Condition true, branch to PC + offset
     reg.pc.val = computeBranch(reg.pc.val,opd);
@@ -310,7 +336,8 @@ inline void Cpu::Mos6502::BVS(const byte opd) {
 }
 
 // Compare Memory with Accumulator
-inline void Cpu::Mos6502::CMP(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::CMP(const byte opd) {
   // set appropriate bit flags
   reg.srf.n = checkNthBit(reg.ac - opd, BitPosition::BIT_7);
   reg.srf.z = reg.ac == opd; 
@@ -319,7 +346,8 @@ inline void Cpu::Mos6502::CMP(const byte opd) {
 }
 
 // Compare Memory and Index X
-inline void Cpu::Mos6502::CPX(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::CPX(const byte opd) {
   // set appropriate bit flags
   reg.srf.n = checkNthBit(reg.x - opd, BitPosition::BIT_7);
   reg.srf.z = reg.x == opd; 
@@ -328,7 +356,8 @@ inline void Cpu::Mos6502::CPX(const byte opd) {
 }
 
 // Compare Memory and Index Y
-inline void Cpu::Mos6502::CPY(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::CPY(const byte opd) {
   // set appropriate bit flags
   reg.srf.n = checkNthBit(reg.y - opd, BitPosition::BIT_7);
   reg.srf.z = reg.y == opd; 
@@ -337,7 +366,8 @@ inline void Cpu::Mos6502::CPY(const byte opd) {
 }
 
 // Test Bits in Memory with Accumulator
-inline void Cpu::Mos6502::BIT(const byte opd) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BIT(const byte opd) {
   // zero flag is set to result of A AND M
   reg.srf.z = checkZero(reg.ac & opd);
   // M7 -> N, M6 -> V
@@ -352,7 +382,8 @@ inline void Cpu::Mos6502::BIT(const byte opd) {
 // ----------------------------------------------------------------------------
 
 // Shift Left One Bit (Memory or Accumulator)
-inline byte Cpu::Mos6502::ASL(byte opd) {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::ASL(byte opd) {
   // Set the carry bit.
   reg.srf.c = checkNthBit(opd, BitPosition::BIT_7);
   // Shift memory (or accumulator) left 1
@@ -364,7 +395,8 @@ inline byte Cpu::Mos6502::ASL(byte opd) {
 }
 
 // Shift One Bit Right (Memory or Accumulator)
-inline byte Cpu::Mos6502::LSR(byte opd) {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::LSR(byte opd) {
   // Set the carry bit
   reg.srf.c = checkNthBit(opd, BitPosition::BIT_0);
   // Shift memory (or accumulator) left 1
@@ -375,7 +407,8 @@ inline byte Cpu::Mos6502::LSR(byte opd) {
 }
 
 // Rotate One Bit Left (Memory or Accumulator)
-inline byte Cpu::Mos6502::ROL(byte opd) {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::ROL(byte opd) {
   // Store old carry
   byte old_c = reg.srf.c;
   // Set the carry bit
@@ -389,7 +422,8 @@ inline byte Cpu::Mos6502::ROL(byte opd) {
 }
 
 // Rotate One Bit Right (Memory or Accumulator)
-inline byte Cpu::Mos6502::ROR(byte opd) {
+template<class MapperType>
+inline byte Cpu::Mos6502Core<MapperType>::ROR(byte opd) {
   // Store old carry
   byte old_c = reg.srf.c;
   // Set the carry bit
@@ -408,7 +442,8 @@ inline byte Cpu::Mos6502::ROR(byte opd) {
 // ----------------------------------------------------------------------------
 
 // Transfer Accumulator to Index X
-inline void Cpu::Mos6502::TAX() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::TAX() {
   // Copy accumulator to X register
   reg.x = reg.ac;
   // set appropriate status register flags
@@ -418,7 +453,8 @@ inline void Cpu::Mos6502::TAX() {
 }
 
 // Transfer Accumulator to Index Y
-inline void Cpu::Mos6502::TAY() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::TAY() {
   // Copy accumulator to Y register
   reg.y = reg.ac;
   // set appropriate status register flags
@@ -428,7 +464,8 @@ inline void Cpu::Mos6502::TAY() {
 }
 
 // Transfer Index X to Accumulator
-inline void Cpu::Mos6502::TXA() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::TXA() {
   // Copy X register to accumulator
   reg.ac = reg.x;
   // set appropriate status register flags
@@ -438,7 +475,8 @@ inline void Cpu::Mos6502::TXA() {
 }
 
 // Transfer Index Y to Accumulator
-inline void Cpu::Mos6502::TYA() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::TYA() {
   // Copy Y register to accumulator
   reg.ac = reg.y;
   // set appropriate status register flags
@@ -453,7 +491,8 @@ inline void Cpu::Mos6502::TYA() {
 // ----------------------------------------------------------------------------
 
 // Transfer Stack Pointer to Index X
-inline void Cpu::Mos6502::TSX() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::TSX() {
   // Copy Stack Pointer to X register
   reg.x = reg.sp;
   // set appropriate status register flags
@@ -463,7 +502,8 @@ inline void Cpu::Mos6502::TSX() {
 }
 
 // Transfer Index X to Stack Pointer
-inline void Cpu::Mos6502::TXS() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::TXS() {
   // Copy X register to stack pointer
   reg.sp = reg.x;
   // set appropriate status register flags
@@ -473,19 +513,22 @@ inline void Cpu::Mos6502::TXS() {
 }
 
 // Push Accumulator on the Stack
-inline void Cpu::Mos6502::PHA() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::PHA() {
   stack.push(reg.ac);
   return;
 }
 
 // Push Processor Status on the Stack
-inline void Cpu::Mos6502::PHP() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::PHP() {
   stack.push(reg.sr);
   return;
 }
 
 // Pull Accumulator from Stack
-inline void Cpu::Mos6502::PLA() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::PLA() {
   reg.ac = stack.pull();
   // set appropriate status register flags
   reg.srf.z = checkZero(reg.ac);
@@ -494,7 +537,8 @@ inline void Cpu::Mos6502::PLA() {
 }
 
 // Pull Processor Status from Stack
-inline void Cpu::Mos6502::PLP() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::PLP() {
   reg.sr = stack.pull();
   return;
 }
@@ -505,7 +549,8 @@ inline void Cpu::Mos6502::PLP() {
 // ----------------------------------------------------------------------------
 
 // Jump to New Location Saving Return Address
-inline void Cpu::Mos6502::JSR(const Vaddr vaddr) {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::JSR(const Vaddr vaddr) {
   // Push the value PC+2 onto the stack then assigned the new PC bytes from
   // vaddr.ll and vaddr.hh.
   // vaddr.ll -> PCL
@@ -520,7 +565,8 @@ inline void Cpu::Mos6502::JSR(const Vaddr vaddr) {
   return;
 }
 
-inline void Cpu::Mos6502::RTI() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::RTI() {
   // pull status register from stack, followed by program counter
   // BRK implementation pushes PCH then PCL then SR so must pull in reverse order
   reg.sr = stack.pull();
@@ -530,7 +576,8 @@ inline void Cpu::Mos6502::RTI() {
 }
 
 // Return from Subroutine
-inline void Cpu::Mos6502::RTS() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::RTS() {
   // pull program counter from the stack and increment to land on new instruction
   // JSR implementation pushes PCH then PCL so must pull PCL then PCH
   reg.pc.ll = stack.pull();
@@ -545,43 +592,50 @@ inline void Cpu::Mos6502::RTS() {
 // ----------------------------------------------------------------------------
 
 // Clear Carry Flag
-inline void Cpu::Mos6502::CLC() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::CLC() {
   reg.srf.c = 0;
   return;
 }
 
 // Clear Decimal Mode
-inline void Cpu::Mos6502::CLD() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::CLD() {
   reg.srf.d = 0;
   return;
 }
 
 // Clear Interrupt Disable Bit
-inline void Cpu::Mos6502::CLI() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::CLI() {
   reg.srf.i = 0;
   return;
 }
 
 // Clear Overflow Flag
-inline void Cpu::Mos6502::CLV() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::CLV() {
   reg.srf.v = 0;
   return;
 }
 
 // Set Carry Flag
-inline void Cpu::Mos6502::SEC() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::SEC() {
   reg.srf.c = 1;
   return;
 }
 
 // Set Decimal Flag
-inline void Cpu::Mos6502::SED() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::SED() {
   reg.srf.d = 1;
   return;
 }
 
 // Set Interrupt Disable Status
-inline void Cpu::Mos6502::SEI() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::SEI() {
   reg.srf.i = 1;
   return;
 }
@@ -592,12 +646,14 @@ inline void Cpu::Mos6502::SEI() {
 // ----------------------------------------------------------------------------
 
 // No Operation
-inline void Cpu::Mos6502::NOP() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::NOP() {
   return;
 }
 
 // Force Break
-inline void Cpu::Mos6502::BRK() {
+template<class MapperType>
+inline void Cpu::Mos6502Core<MapperType>::BRK() {
   // interrupt, push PC+2, push SR
   // increment pc by 1, because BRK needs to skip 1 byte.
   reg.pc.val = reg.pc.val + 1;
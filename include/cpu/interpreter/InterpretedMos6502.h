@@ -26,13 +26,15 @@
 
 namespace Cpu {
 
-/// \class InterpretedMos6502
+/// \class InterpretedMos6502Core
 /// \brief This class is an implementation of an interpreted Mos6502 emulator.
-class InterpretedMos6502 : public Mos6502 {
+/// \tparam MapperType Type of the memory map, see Mos6502Core.
+template<class MapperType>
+class InterpretedMos6502Core : public Mos6502Core<MapperType> {
   public:
     /// Default constructor. Bootstrap an IntrepretedMos6502 CPU object.
-    InterpretedMos6502(Memory::Mapper<byte>&);
-    ~InterpretedMos6502();
+    InterpretedMos6502Core(MapperType&);
+    ~InterpretedMos6502Core();
 
   protected:
     void fetchOpcodeImpl() override;
@@ -575,6 +577,11 @@ class InterpretedMos6502 : public Mos6502 {
     std::unordered_map<byte, std::function<void(const Mos6502Instruction&)>> instructionMap;
 };
 
+/// The interpreted Mos6502, resolving memory accesses through any mapper.
+using InterpretedMos6502 = InterpretedMos6502Core<Memory::Mapper<byte>>;
+
+extern template class InterpretedMos6502Core<Memory::Mapper<byte>>;
+
 } // namespace Cpu
 
 #endif // INTERPRETED_MOS6502_H //
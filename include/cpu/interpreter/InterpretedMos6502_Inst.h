@@ -0,0 +1,1173 @@
+//===-- include/cpu/interpreter/InterpretedMos6502_Inst.h -------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implemntation of the InterpretedMos6502Core class, an
+/// interpreted implementation of a Mos6502 emulator. Include it only where the
+/// interpreter is instantiated for a memory map type.
+///
+//===----------------------------------------------------------------------===//
+#ifndef INTERPRETED_MOS6502_INST_H
+#define INTERPRETED_MOS6502_INST_H
+
+#include <functional>
+#include <unordered_map>
+
+#include "common/CommonTypes.h"
+#include "cpu/Mos6502_Inst.h"
+#include "cpu/Mos6502_Ops.h"
+#include "cpu/interpreter/InterpretedMos6502.h"
+#include "memory/Reference.h"
+
+namespace Cpu {
+
+//===----------------------------------------------------------------------===//
+// For all instruction emulation functions, we use the instruction information to
+// build the virtual address (if needed), feed that into the MMU to get an
+// appropriate memory refrence, and read an write to that memory as needed.
+// 
+// For immediate and relative addressing, we read the immediate value from the 
+// lo byte of the input instruction.
+//===----------------------------------------------------------------------===//
+
+/// Helper function for computing the virtual address referenced by a
+/// Mos6502Instruction.
+/// \param inst The instruction whose operands build the address.
+/// \returns The virtual address.
+static inline Vaddr computeAddress(const Mos6502Instruction& inst) {
+  Vaddr vaddr;
+  vaddr.ll = inst.operand.lo;
+  vaddr.hh = inst.operand.hi;
+  return vaddr;
+}
+
+/// Helper function for computing the virtual address referenced by a
+/// Memory::Reference.
+/// \param ref The reference which points to the address.
+/// \returns The virtual address.
+static inline Vaddr computeAddress(const Memory::Reference<byte>& ref) {
+  Vaddr vaddr;
+  vaddr.ll = ref.read();
+  vaddr.hh = ref.read(1);
+  return vaddr;
+}
+
+template<class MapperType>
+InterpretedMos6502Core<MapperType>::InterpretedMos6502Core(MapperType& memMap) :
+    Mos6502Core<MapperType>(memMap) {
+  initializeInstructionMap();    
+}
+
+template<class MapperType>
+InterpretedMos6502Core<MapperType>::~InterpretedMos6502Core() {}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::fetchOpcodeImpl() {
+  // fetch the opcode at the current program counter
+  Vaddr vaddr;
+  vaddr.val = this->getRegPC();
+  Memory::Reference<byte> ref = this->getMmu().absolute(vaddr);
+  this->setRegIR(ref.read());
+  this->getDis().setReadPosition(ref);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::decodeOpcodeImpl() {
+  // decode instruction in the instruction register
+  currentInstruction = this->getDis().disassembleInstruction(this->getRegIR());
+  // Increment the program counter by the number of operands + 1 for
+  // the opcode. It is important that we increment the program counter
+  // after we decode the instruction, as some instruction behaviour, like
+  // jumps and branchs depend on this behaviour.
+  this->incrementRegPC(static_cast<addr>(currentInstruction.type) + 1);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::executeOpcodeImpl() {
+  instructionMap[currentInstruction.opcode](currentInstruction);
+  this->incrementCycles(currentInstruction.cycles);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::initializeInstructionMap() {
+  using std::placeholders::_1;
+  // Here we will build the instruction map
+  // ADC
+  instructionMap[Op::ADC_IMMED] = std::bind(&InterpretedMos6502Core::adcImmediate, this, _1);
+  instructionMap[Op::ADC_ZPG] = std::bind(&InterpretedMos6502Core::adcZeropage, this, _1);
+  instructionMap[Op::ADC_ZPG_X] = std::bind(&InterpretedMos6502Core::adcZeropageX, this, _1);
+  instructionMap[Op::ADC_ABS] = std::bind(&InterpretedMos6502Core::adcAbsolute, this, _1);
+  instructionMap[Op::ADC_ABS_X] = std::bind(&InterpretedMos6502Core::adcAbsoluteX, this, _1); 
+  instructionMap[Op::ADC_ABS_Y] = std::bind(&InterpretedMos6502Core::adcAbsoluteY, this, _1); 
+  instructionMap[Op::ADC_X_IND] = std::bind(&InterpretedMos6502Core::adcXIndirect, this, _1); 
+  instructionMap[Op::ADC_IND_Y] = std::bind(&InterpretedMos6502Core::adcIndirectY, this, _1); 
+  // AND
+  instructionMap[Op::AND_IMMED] = std::bind(&InterpretedMos6502Core::andImmediate, this, _1); 
+  instructionMap[Op::AND_ZPG] = std::bind(&InterpretedMos6502Core::andZeropage, this, _1); 
+  instructionMap[Op::AND_ZPG_X] = std::bind(&InterpretedMos6502Core::andZeropageX, this, _1); 
+  instructionMap[Op::AND_ABS] = std::bind(&InterpretedMos6502Core::andAbsolute, this, _1); 
+  instructionMap[Op::AND_ABS_X] = std::bind(&InterpretedMos6502Core::andAbsoluteX, this, _1); 
+  instructionMap[Op::AND_ABS_Y] = std::bind(&InterpretedMos6502Core::andAbsoluteY, this, _1); 
+  instructionMap[Op::AND_X_IND] = std::bind(&InterpretedMos6502Core::andXIndirect, this, _1); 
+  instructionMap[Op::AND_IND_Y] = std::bind(&InterpretedMos6502Core::andIndirectY, this, _1); 
+  // ASL
+  instructionMap[Op::ASL_ACC] = std::bind(&InterpretedMos6502Core::aslAccumulator, this, _1);
+  instructionMap[Op::ASL_ZPG] = std::bind(&InterpretedMos6502Core::aslZeropage, this, _1);
+  instructionMap[Op::ASL_ZPG_X] = std::bind(&InterpretedMos6502Core::aslZeropageX, this, _1);
+  instructionMap[Op::ASL_ABS] = std::bind(&InterpretedMos6502Core::aslAbsolute, this, _1);
+  instructionMap[Op::ASL_ABS_X] = std::bind(&InterpretedMos6502Core::aslAbsoluteX, this, _1);
+  // Branch
+  instructionMap[Op::BCC_REL] = std::bind(&InterpretedMos6502Core::bccRelative, this, _1);
+  instructionMap[Op::BCS_REL] = std::bind(&InterpretedMos6502Core::bcsRelative, this, _1);
+  instructionMap[Op::BEQ_REL] = std::bind(&InterpretedMos6502Core::beqRelative, this, _1);
+  instructionMap[Op::BMI_REL] = std::bind(&InterpretedMos6502Core::bmiRelative, this, _1);
+  instructionMap[Op::BNE_REL] = std::bind(&InterpretedMos6502Core::bneRelative, this, _1);
+  instructionMap[Op::BPL_REL] = std::bind(&InterpretedMos6502Core::bplRelative, this, _1);
+  instructionMap[Op::BVC_REL] = std::bind(&InterpretedMos6502Core::bvcRelative, this, _1);
+  instructionMap[Op::BVS_REL] = std::bind(&InterpretedMos6502Core::bvsRelative, this, _1);
+  // BIT
+  instructionMap[Op::BIT_ZPG] = std::bind(&InterpretedMos6502Core::bitZeropage, this, _1);
+  instructionMap[Op::BIT_ABS] = std::bind(&InterpretedMos6502Core::bitAbsolute, this, _1);
+  // BRK
+  instructionMap[Op::BRK_IMPL] = std::bind(&InterpretedMos6502Core::brkImplied, this, _1);
+  // Clears
+  instructionMap[Op::CLC_IMPL] = std::bind(&InterpretedMos6502Core::clcImplied, this, _1);
+  instructionMap[Op::CLD_IMPL] = std::bind(&InterpretedMos6502Core::cldImplied, this, _1);
+  instructionMap[Op::CLI_IMPL] = std::bind(&InterpretedMos6502Core::cliImplied, this, _1);
+  instructionMap[Op::CLV_IMPL] = std::bind(&InterpretedMos6502Core::clvImplied, this, _1);
+  // CMP
+  instructionMap[Op::CMP_IMMED] = std::bind(&InterpretedMos6502Core::cmpImmediate, this, _1);
+  instructionMap[Op::CMP_ZPG] = std::bind(&InterpretedMos6502Core::cmpZeropage, this, _1);
+  instructionMap[Op::CMP_ZPG_X] = std::bind(&InterpretedMos6502Core::cmpZeropageX, this, _1);
+  instructionMap[Op::CMP_ABS] = std::bind(&InterpretedMos6502Core::cmpAbsolute, this, _1);
+  instructionMap[Op::CMP_ABS_X] = std::bind(&InterpretedMos6502Core::cmpAbsoluteX, this, _1);
+  instructionMap[Op::CMP_ABS_Y] = std::bind(&InterpretedMos6502Core::cmpAbsoluteY, this, _1);
+  instructionMap[Op::CMP_X_IND] = std::bind(&InterpretedMos6502Core::cmpXIndirect, this, _1);
+  instructionMap[Op::CMP_IND_Y] = std::bind(&InterpretedMos6502Core::cmpIndirectY, this, _1);
+  // CPX
+  instructionMap[Op::CPX_IMMED] = std::bind(&InterpretedMos6502Core::cpxImmediate, this, _1);
+  instructionMap[Op::CPX_ZPG] = std::bind(&InterpretedMos6502Core::cpxZeropage, this, _1);
+  instructionMap[Op::CPX_ABS] = std::bind(&InterpretedMos6502Core::cpxAbsolute, this, _1);
+  // CPY
+  instructionMap[Op::CPY_IMMED] = std::bind(&InterpretedMos6502Core::cpyImmediate, this, _1);
+  instructionMap[Op::CPY_ZPG] = std::bind(&InterpretedMos6502Core::cpyZeropage, this, _1);
+  instructionMap[Op::CPY_ABS] = std::bind(&InterpretedMos6502Core::cpyAbsolute, this, _1);
+  // DEC
+  instructionMap[Op::DEC_ZPG] = std::bind(&InterpretedMos6502Core::decZeropage, this, _1);
+  instructionMap[Op::DEC_ZPG_X] = std::bind(&InterpretedMos6502Core::decZeropageX, this, _1);
+  instructionMap[Op::DEC_ABS] = std::bind(&InterpretedMos6502Core::decAbsolute, this, _1);
+  instructionMap[Op::DEC_ABS_X] = std::bind(&InterpretedMos6502Core::decAbsoluteX, this, _1);
+  // DEX
+  instructionMap[Op::DEX_IMPL] = std::bind(&InterpretedMos6502Core::dexImplied, this, _1);
+  // DEY
+  instructionMap[Op::DEY_IMPL] = std::bind(&InterpretedMos6502Core::deyImplied, this, _1);
+  // EOR
+  instructionMap[Op::EOR_IMMED] = std::bind(&InterpretedMos6502Core::eorImmediate, this, _1);
+  instructionMap[Op::EOR_ZPG] = std::bind(&InterpretedMos6502Core::eorZeropage, this, _1);
+  instructionMap[Op::EOR_ZPG_X] = std::bind(&InterpretedMos6502Core::eorZeropageX, this, _1);
+  instructionMap[Op::EOR_ABS] = std::bind(&InterpretedMos6502Core::eorAbsolute, this, _1);
+  instructionMap[Op::EOR_ABS_X] = std::bind(&InterpretedMos6502Core::eorAbsoluteX, this, _1); 
+  instructionMap[Op::EOR_ABS_Y] = std::bind(&InterpretedMos6502Core::eorAbsoluteY, this, _1); 
+  instructionMap[Op::EOR_X_IND] = std::bind(&InterpretedMos6502Core::eorXIndirect, this, _1); 
+  instructionMap[Op::EOR_IND_Y] = std::bind(&InterpretedMos6502Core::eorIndirectY, this, _1); 
+  // INC
+  instructionMap[Op::INC_ZPG] = std::bind(&InterpretedMos6502Core::incZeropage, this, _1);
+  instructionMap[Op::INC_ZPG_X] = std::bind(&InterpretedMos6502Core::incZeropageX, this, _1);
+  instructionMap[Op::INC_ABS] = std::bind(&InterpretedMos6502Core::incAbsolute, this, _1);
+  instructionMap[Op::INC_ABS_X] = std::bind(&InterpretedMos6502Core::incAbsoluteX, this, _1);
+  // INX
+  instructionMap[Op::INX_IMPL] = std::bind(&InterpretedMos6502Core::inxImplied, this, _1);
+  // INY
+  instructionMap[Op::INY_IMPL] = std::bind(&InterpretedMos6502Core::inyImplied, this, _1);
+  // JMP
+  instructionMap[Op::JMP_ABS] = std::bind(&InterpretedMos6502Core::jmpAbsolute, this, _1);
+  instructionMap[Op::JMP_IND] = std::bind(&InterpretedMos6502Core::jmpIndirect, this, _1);
+  // JSR
+  instructionMap[Op::JSR_ABS] = std::bind(&InterpretedMos6502Core::jsrAbsolute, this, _1);
+  // LDA
+  instructionMap[Op::LDA_IMMED] = std::bind(&InterpretedMos6502Core::ldaImmediate, this, _1);
+  instructionMap[Op::LDA_ZPG] = std::bind(&InterpretedMos6502Core::ldaZeropage, this, _1);
+  instructionMap[Op::LDA_ZPG_X] = std::bind(&InterpretedMos6502Core::ldaZeropageX, this, _1);
+  instructionMap[Op::LDA_ABS] = std::bind(&InterpretedMos6502Core::ldaAbsolute, this, _1);
+  instructionMap[Op::LDA_ABS_X] = std::bind(&InterpretedMos6502Core::ldaAbsoluteX, this, _1);
+  instructionMap[Op::LDA_ABS_Y] = std::bind(&InterpretedMos6502Core::ldaAbsoluteY, this, _1);
+  instructionMap[Op::LDA_X_IND] = std::bind(&InterpretedMos6502Core::ldaXIndirect, this, _1);
+  instructionMap[Op::LDA_IND_Y] = std::bind(&InterpretedMos6502Core::ldaIndirectY, this, _1);
+  // LDX
+  instructionMap[Op::LDX_IMMED] = std::bind(&InterpretedMos6502Core::ldxImmediate, this, _1);
+  instructionMap[Op::LDX_ZPG] = std::bind(&InterpretedMos6502Core::ldxZeropage, this, _1);
+  instructionMap[Op::LDX_ZPG_Y] = std::bind(&InterpretedMos6502Core::ldxZeropageY, this, _1);
+  instructionMap[Op::LDX_ABS] = std::bind(&InterpretedMos6502Core::ldxAbsolute, this, _1);
+  instructionMap[Op::LDX_ABS_Y] = std::bind(&InterpretedMos6502Core::ldxAbsoluteY, this, _1);
+  // LDY
+  instructionMap[Op::LDY_IMMED] = std::bind(&InterpretedMos6502Core::ldyImmediate, this, _1);
+  instructionMap[Op::LDY_ZPG] = std::bind(&InterpretedMos6502Core::ldyZeropage, this, _1);
+  instructionMap[Op::LDY_ZPG_X] = std::bind(&InterpretedMos6502Core::ldyZeropageX, this, _1);
+  instructionMap[Op::LDY_ABS] = std::bind(&InterpretedMos6502Core::ldyAbsolute, this, _1);
+  instructionMap[Op::LDY_ABS_X] = std::bind(&InterpretedMos6502Core::ldyAbsoluteX, this, _1);
+  // LSR
+  instructionMap[Op::LSR_ACC] = std::bind(&InterpretedMos6502Core::lsrAccumulator, this, _1);
+  instructionMap[Op::LSR_ZPG] = std::bind(&InterpretedMos6502Core::lsrZeropage, this, _1);
+  instructionMap[Op::LSR_ZPG_X] = std::bind(&InterpretedMos6502Core::lsrZeropageX, this, _1);
+  instructionMap[Op::LSR_ABS] = std::bind(&InterpretedMos6502Core::lsrAbsolute, this, _1);
+  instructionMap[Op::LSR_ABS_X] = std::bind(&InterpretedMos6502Core::lsrAbsoluteX, this, _1);
+  // NOP
+  instructionMap[Op::NOP_IMPL] = std::bind(&InterpretedMos6502Core::nopImplied, this, _1);
+  // ORA
+  instructionMap[Op::ORA_IMMED] = std::bind(&InterpretedMos6502Core::oraImmediate, this, _1);
+  instructionMap[Op::ORA_ZPG] = std::bind(&InterpretedMos6502Core::oraZeropage, this, _1);
+  instructionMap[Op::ORA_ZPG_X] = std::bind(&InterpretedMos6502Core::oraZeropageX, this, _1);
+  instructionMap[Op::ORA_ABS] = std::bind(&InterpretedMos6502Core::oraAbsolute, this, _1);
+  instructionMap[Op::ORA_ABS_X] = std::bind(&InterpretedMos6502Core::oraAbsoluteX, this, _1); 
+  instructionMap[Op::ORA_ABS_Y] = std::bind(&InterpretedMos6502Core::oraAbsoluteY, this, _1); 
+  instructionMap[Op::ORA_X_IND] = std::bind(&InterpretedMos6502Core::oraXIndirect, this, _1); 
+  instructionMap[Op::ORA_IND_Y] = std::bind(&InterpretedMos6502Core::oraIndirectY, this, _1); 
+  // Stack Operations
+  instructionMap[Op::PHA_IMPL] = std::bind(&InterpretedMos6502Core::phaImplied, this, _1);
+  instructionMap[Op::PHP_IMPL] = std::bind(&InterpretedMos6502Core::phpImplied, this, _1);
+  instructionMap[Op::PLA_IMPL] = std::bind(&InterpretedMos6502Core::plaImplied, this, _1);
+  instructionMap[Op::PLP_IMPL] = std::bind(&InterpretedMos6502Core::plpImplied, this, _1);
+  // ROL
+  instructionMap[Op::ROL_ACC] = std::bind(&InterpretedMos6502Core::rolAccumulator, this, _1);
+  instructionMap[Op::ROL_ZPG] = std::bind(&InterpretedMos6502Core::rolZeropage, this, _1);
+  instructionMap[Op::ROL_ZPG_X] = std::bind(&InterpretedMos6502Core::rolZeropageX, this, _1);
+  instructionMap[Op::ROL_ABS] = std::bind(&InterpretedMos6502Core::rolAbsolute, this, _1);
+  instructionMap[Op::ROL_ABS_X] = std::bind(&InterpretedMos6502Core::rolAbsoluteX, this, _1);
+  // ROR
+  instructionMap[Op::ROR_ACC] = std::bind(&InterpretedMos6502Core::rorAccumulator, this, _1);
+  instructionMap[Op::ROR_ZPG] = std::bind(&InterpretedMos6502Core::rorZeropage, this, _1);
+  instructionMap[Op::ROR_ZPG_X] = std::bind(&InterpretedMos6502Core::rorZeropageX, this, _1);
+  instructionMap[Op::ROR_ABS] = std::bind(&InterpretedMos6502Core::rorAbsolute, this, _1);
+  instructionMap[Op::ROR_ABS_X] = std::bind(&InterpretedMos6502Core::rorAbsoluteX, this, _1);
+  // Returns
+  instructionMap[Op::RTI_IMPL] = std::bind(&InterpretedMos6502Core::rtiImplied, this, _1);
+  instructionMap[Op::RTS_IMPL] = std::bind(&InterpretedMos6502Core::rtsImplied, this, _1);
+  // SBC
+  instructionMap[Op::SBC_IMMED] = std::bind(&InterpretedMos6502Core::sbcImmediate, this, _1);
+  instructionMap[Op::SBC_ZPG] = std::bind(&InterpretedMos6502Core::sbcZeropage, this, _1);
+  instructionMap[Op::SBC_ZPG_X] = std::bind(&InterpretedMos6502Core::sbcZeropageX, this, _1);
+  instructionMap[Op::SBC_ABS] = std::bind(&InterpretedMos6502Core::sbcAbsolute, this, _1);
+  instructionMap[Op::SBC_ABS_X] = std::bind(&InterpretedMos6502Core::sbcAbsoluteX, this, _1); 
+  instructionMap[Op::SBC_ABS_Y] = std::bind(&InterpretedMos6502Core::sbcAbsoluteY, this, _1); 
+  instructionMap[Op::SBC_X_IND] = std::bind(&InterpretedMos6502Core::sbcXIndirect, this, _1); 
+  instructionMap[Op::SBC_IND_Y] = std::bind(&InterpretedMos6502Core::sbcIndirectY, this, _1); 
+  // Sets
+  instructionMap[Op::SEC_IMPL] = std::bind(&InterpretedMos6502Core::secImplied, this, _1); 
+  instructionMap[Op::SED_IMPL] = std::bind(&InterpretedMos6502Core::sedImplied, this, _1); 
+  instructionMap[Op::SEI_IMPL] = std::bind(&InterpretedMos6502Core::seiImplied, this, _1); 
+  // STA
+  instructionMap[Op::STA_ZPG] = std::bind(&InterpretedMos6502Core::staZeropage, this, _1);
+  instructionMap[Op::STA_ZPG_X] = std::bind(&InterpretedMos6502Core::staZeropageX, this, _1);
+  instructionMap[Op::STA_ABS] = std::bind(&InterpretedMos6502Core::staAbsolute, this, _1);
+  instructionMap[Op::STA_ABS_X] = std::bind(&InterpretedMos6502Core::staAbsoluteX, this, _1); 
+  instructionMap[Op::STA_ABS_Y] = std::bind(&InterpretedMos6502Core::staAbsoluteY, this, _1); 
+  instructionMap[Op::STA_X_IND] = std::bind(&InterpretedMos6502Core::staXIndirect, this, _1); 
+  instructionMap[Op::STA_IND_Y] = std::bind(&InterpretedMos6502Core::staIndirectY, this, _1); 
+  // STX
+  instructionMap[Op::STX_ZPG] = std::bind(&InterpretedMos6502Core::stxZeropage, this, _1);
+  instructionMap[Op::STX_ZPG_Y] = std::bind(&InterpretedMos6502Core::stxZeropageY, this, _1);
+  instructionMap[Op::STX_ABS] = std::bind(&InterpretedMos6502Core::stxAbsolute, this, _1);
+  // STY
+  instructionMap[Op::STY_ZPG] = std::bind(&InterpretedMos6502Core::styZeropage, this, _1);
+  instructionMap[Op::STY_ZPG_X] = std::bind(&InterpretedMos6502Core::styZeropageX, this, _1);
+  instructionMap[Op::STY_ABS] = std::bind(&InterpretedMos6502Core::styAbsolute, this, _1);
+  // Transfers
+  instructionMap[Op::TAX_IMPL] = std::bind(&InterpretedMos6502Core::taxImplied, this, _1);
+  instructionMap[Op::TAY_IMPL] = std::bind(&InterpretedMos6502Core::tayImplied, this, _1);
+  instructionMap[Op::TSX_IMPL] = std::bind(&InterpretedMos6502Core::tsxImplied, this, _1);
+  instructionMap[Op::TXA_IMPL] = std::bind(&InterpretedMos6502Core::txaImplied, this, _1);
+  instructionMap[Op::TXS_IMPL] = std::bind(&InterpretedMos6502Core::txsImplied, this, _1);
+  instructionMap[Op::TYA_IMPL] = std::bind(&InterpretedMos6502Core::tyaImplied, this, _1);
+  
+}
+
+// Add with carry
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::adcImmediate(const Mos6502Instruction& inst) {
+  this->ADC(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::adcZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->ADC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::adcZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  this->ADC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::adcAbsolute(const Mos6502Instruction& inst) { 
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->ADC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::adcAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  this->ADC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::adcAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  this->ADC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::adcXIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->ADC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::adcIndirectY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().indirectYIndexed(computeAddress(inst));
+  this->ADC(ref.read());
+}
+
+// AND with memory
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::andImmediate(const Mos6502Instruction& inst) {
+  this->AND(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::andZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->AND(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::andZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  this->AND(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::andAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->AND(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::andAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  this->AND(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::andAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  this->AND(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::andXIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->AND(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::andIndirectY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->AND(ref.read());
+}
+
+// Arithmetic shift left
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::aslAccumulator(const Mos6502Instruction& inst) { 
+  this->setRegAC(this->ASL(this->getRegAC()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::aslZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->ASL(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::aslZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  ref.write(this->ASL(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::aslAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->ASL(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::aslAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  ref.write(this->ASL(ref.read()));
+}
+
+// Branching
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bccRelative(const Mos6502Instruction& inst) {
+  this->BCC(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bcsRelative(const Mos6502Instruction& inst) {
+  this->BCS(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::beqRelative(const Mos6502Instruction& inst) {
+  this->BEQ(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bmiRelative(const Mos6502Instruction& inst) {
+  this->BMI(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bneRelative(const Mos6502Instruction& inst) {
+  this->BNE(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bplRelative(const Mos6502Instruction& inst) {
+  this->BPL(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bvcRelative(const Mos6502Instruction& inst) {
+  this->BVC(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bvsRelative(const Mos6502Instruction& inst) {
+  this->BVS(inst.operand.lo);
+}
+
+// Test bits
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bitZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->BIT(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::bitAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->BIT(ref.read());
+}
+
+// Force break
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::brkImplied(const Mos6502Instruction& inst) {
+  this->BRK();
+}
+
+// Clear flags
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::clcImplied(const Mos6502Instruction& inst) {
+  this->CLC();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cldImplied(const Mos6502Instruction& inst) {
+  this->CLD();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cliImplied(const Mos6502Instruction& inst) {
+  this->CLI();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::clvImplied(const Mos6502Instruction& inst) {
+  this->CLV();
+}
+
+// Compare with memory
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cmpImmediate(const Mos6502Instruction& inst) {
+  this->CMP(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cmpZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->CMP(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cmpZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  this->CMP(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cmpAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->CMP(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cmpAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  this->CMP(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cmpAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  this->CMP(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cmpXIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->CMP(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cmpIndirectY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().indirectYIndexed(computeAddress(inst));
+  this->CMP(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cpxImmediate(const Mos6502Instruction& inst) {
+  this->CPX(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cpxZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->CPX(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cpxAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->CPX(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cpyImmediate(const Mos6502Instruction& inst) {
+  this->CPY(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cpyZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->CPY(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::cpyAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->CPY(ref.read());
+}
+
+// Decrement memory
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::decZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->DEC(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::decZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  ref.write(this->DEC(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::decAbsolute(const Mos6502Instruction& inst) { 
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->DEC(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::decAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  ref.write(this->DEC(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::dexImplied(const Mos6502Instruction& inst) {
+  this->DEX();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::deyImplied(const Mos6502Instruction& inst) {
+  this->DEY();
+}
+
+// Exclusive OR with memory
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::eorImmediate(const Mos6502Instruction& inst) {
+  this->EOR(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::eorZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->EOR(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::eorZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  this->EOR(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::eorAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->EOR(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::eorAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  this->EOR(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::eorAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  this->EOR(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::eorXIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->EOR(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::eorIndirectY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().indirectYIndexed(computeAddress(inst));
+  this->EOR(ref.read());
+}
+
+// Increment memory
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::incZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->INC(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::incZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  ref.write(this->INC(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::incAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->INC(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::incAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  ref.write(this->INC(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::inxImplied(const Mos6502Instruction& inst) {
+  this->INX();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::inyImplied(const Mos6502Instruction& inst) {
+  this->INY();
+}
+
+// Jumps
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::jmpAbsolute(const Mos6502Instruction& inst) {
+  this->JMP(computeAddress(inst));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::jmpIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->JMP(computeAddress(ref));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::jsrAbsolute(const Mos6502Instruction& inst) {
+  this->JMP(computeAddress(inst));
+}
+
+// Loads
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldaImmediate(const Mos6502Instruction& inst) {
+  this->LDA(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldaZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->LDA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldaZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  this->LDA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldaAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->LDA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldaAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  this->LDA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldaAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  this->LDA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldaXIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->LDA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldaIndirectY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().indirectYIndexed(computeAddress(inst));
+  this->LDA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldxImmediate(const Mos6502Instruction& inst) {
+  this->LDX(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldxZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->LDX(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldxZeropageY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageYIndexed(computeAddress(inst));
+  this->LDX(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldxAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->LDX(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldxAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  this->LDX(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldyImmediate(const Mos6502Instruction& inst) {
+  this->LDY(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldyZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->LDY(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldyZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  this->LDY(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldyAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->LDY(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::ldyAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  this->LDY(ref.read());
+}
+
+// Logical shift right
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::lsrAccumulator(const Mos6502Instruction& inst) {
+  this->setRegAC(this->LSR(this->getRegAC()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::lsrZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->LSR(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::lsrZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  ref.write(this->LSR(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::lsrAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->LSR(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::lsrAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  ref.write(this->LSR(ref.read()));
+}
+
+/// No operation
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::nopImplied(const Mos6502Instruction& inst) {
+  this->NOP();
+}
+
+//  OR with memory
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::oraImmediate(const Mos6502Instruction& inst) {
+  this->ORA(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::oraZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->ORA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::oraZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  this->ORA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::oraAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->ORA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::oraAbsoluteX(const Mos6502Instruction& inst) { 
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  this->ORA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::oraAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  this->ORA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::oraXIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->ORA(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::oraIndirectY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->ORA(ref.read());
+}
+
+// Stack operations
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::phaImplied(const Mos6502Instruction& inst) {
+  this->PHA();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::phpImplied(const Mos6502Instruction& inst) {
+  this->PHP();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::plaImplied(const Mos6502Instruction& inst) {
+  this->PLA();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::plpImplied(const Mos6502Instruction& inst) {
+  this->PLP();
+}
+
+// Rotate left
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rolAccumulator(const Mos6502Instruction& inst) {
+  this->setRegAC(this->ROL(this->getRegAC()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rolZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->ROL(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rolZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  ref.write(this->ROL(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rolAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->ROL(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rolAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  ref.write(this->ROL(ref.read()));
+}
+
+// Rotate right
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rorAccumulator(const Mos6502Instruction& inst) {
+  this->setRegAC(this->ROR(this->getRegAC()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rorZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->ROR(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rorZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  ref.write(this->ROR(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rorAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->ROR(ref.read()));
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rorAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  ref.write(this->ROR(ref.read()));
+}
+
+// Returns
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rtiImplied(const Mos6502Instruction& inst) {
+  this->RTI();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::rtsImplied(const Mos6502Instruction& inst) {
+  this->RTS();
+}
+
+// Subtract with borrow
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sbcImmediate(const Mos6502Instruction& inst) {
+  this->SBC(inst.operand.lo);
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sbcZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  this->SBC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sbcZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  this->SBC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sbcAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  this->SBC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sbcAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  this->SBC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sbcAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  this->SBC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sbcXIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  this->SBC(ref.read());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sbcIndirectY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().indirectYIndexed(computeAddress(inst));
+  this->SBC(ref.read());
+}
+
+// Set flags
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::secImplied(const Mos6502Instruction& inst) {
+  this->SEC();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::sedImplied(const Mos6502Instruction& inst) {
+  this->SED();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::seiImplied(const Mos6502Instruction& inst) {
+  this->SEI();
+}
+
+// Store accumulator
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::staZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->STA());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::staZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  ref.write(this->STA());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::staAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->STA());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::staAbsoluteX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteXIndexed(computeAddress(inst));
+  ref.write(this->STA());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::staAbsoluteY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absoluteYIndexed(computeAddress(inst));
+  ref.write(this->STA());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::staXIndirect(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().xIndexedIndirect(computeAddress(inst));
+  ref.write(this->STA());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::staIndirectY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().indirectYIndexed(computeAddress(inst));
+  ref.write(this->STA());
+}
+
+// Store X-index register
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::stxZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->STX());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::stxZeropageY(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageYIndexed(computeAddress(inst));
+  ref.write(this->STX());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::stxAbsolute(const Mos6502Instruction& inst) { 
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->STX());
+}
+
+// Store Y-index register
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::styZeropage(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropage(computeAddress(inst));
+  ref.write(this->STY());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::styZeropageX(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().zeropageXIndexed(computeAddress(inst));
+  ref.write(this->STY());
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::styAbsolute(const Mos6502Instruction& inst) {
+  Memory::Reference<byte> ref = this->getMmu().absolute(computeAddress(inst));
+  ref.write(this->STY());
+}
+
+// Transfers
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::taxImplied(const Mos6502Instruction& inst) {
+  this->TAX();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::tayImplied(const Mos6502Instruction& inst) {
+  this->TAY();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::tsxImplied(const Mos6502Instruction& inst) {
+  this->TSX();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::txaImplied(const Mos6502Instruction& inst) {
+  this->TXA();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::txsImplied(const Mos6502Instruction& inst) {
+  this->TXS();
+}
+
+template<class MapperType>
+void InterpretedMos6502Core<MapperType>::tyaImplied(const Mos6502Instruction& inst) {
+  this->TYA();
+}
+
+} // namespace Cpu
+
+#endif // INTERPRETED_MOS6502_INST_H //
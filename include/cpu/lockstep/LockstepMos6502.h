@@ -0,0 +1,324 @@
+//===-- include/cpu/lockstep/LockstepMos6502.h - Lockstep Batch -*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the LockstepMos6502Core class, an experimental back end
+/// running a batch of Mos6502s in lockstep, one SIMD lane per Cpu.
+///
+//===----------------------------------------------------------------------===//
+#ifndef LOCKSTEP_MOS6502_H
+#define LOCKSTEP_MOS6502_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "cpu/Mos6502Mmu.h"
+#include "memory/Mapper.h"
+#include "memory/Reference.h"
+
+namespace Cpu {
+
+namespace Lockstep {
+
+#if defined(__AVX2__)
+/// Number of lanes of a register processed at once, one AVX2 register.
+static constexpr const std::size_t CHUNK = 32;
+#else
+/// Number of lanes of a register processed at once by the portable fallback.
+static constexpr const std::size_t CHUNK = 1;
+#endif
+
+} // namespace Lockstep
+
+/// \class LockstepMos6502Core
+/// \brief This class runs a batch of Mos6502s in lockstep, for batches of
+/// machines running the same program on different data.
+///
+/// The registers of every Cpu are held as arrays, one lane per Cpu, so that
+/// an instruction updates the registers of a whole group of Cpus with a few
+/// SIMD operations. Each step issues one instruction to the group of lanes
+/// at the same program counter about to run the same opcode; the other lanes
+/// are masked out, and wait. Memory is per lane, so operands are gathered
+/// and results scattered a lane at a time through each lane's memory map.
+///
+/// Diverged lanes reconverge by always issuing to the lowest program
+/// counter, so lanes that skip ahead wait for the others to catch up at the
+/// next join. The lane that has run the fewest cycles is run out of turn
+/// once it trails by more than MAX_SKEW cycles, so that lanes spinning at a
+/// low address cannot starve the rest.
+/// \tparam MapperType Type of the memory maps, see Mos6502Core.
+/// \tparam Lanes Number of Cpus in the batch, 8, 16 or 32.
+template<class MapperType, std::size_t Lanes>
+class LockstepMos6502Core {
+  static_assert(Lanes == 8 || Lanes == 16 || Lanes == 32,
+      "A lockstep batch has 8, 16 or 32 lanes.");
+
+  public:
+    /// Number of lanes.
+    static constexpr const std::size_t LANES = Lanes;
+    /// Number of cycles the slowest lane may trail the lane furthest ahead
+    /// before it is run out of turn.
+    static constexpr const std::uint64_t MAX_SKEW = 256;
+
+    /// Build a batch of Cpus, with registers as a Mos6502 has after
+    /// construction.
+    /// \param memMaps The memory map of each lane.
+    explicit LockstepMos6502Core(const std::array<MapperType*, Lanes>& memMaps);
+
+    /// LockstepMos6502Cores cannot be copied, as the memory management units
+    /// point into the registers.
+    LockstepMos6502Core(const LockstepMos6502Core&) = delete;
+    /// LockstepMos6502Cores cannot be copy assigned.
+    LockstepMos6502Core& operator=(const LockstepMos6502Core&) = delete;
+
+    /// Reset every lane, loading its program counter from the reset vector.
+    void reset();
+
+    /// Issue one instruction to the group of lanes the scheduler picks.
+    /// \throws Exception::InvalidOpcodeException if the group's opcode is
+    /// undefined.
+    void step();
+
+    /// Run every lane for at least the given number of cycles. Lanes that
+    /// have run long enough drop out of the batch until all are done.
+    /// \param cycles Number of cycles.
+    /// \throws Exception::InvalidOpcodeException if a group's opcode is
+    /// undefined.
+    void run(std::uint64_t cycles);
+
+    /// Get the program counter of a lane.
+    /// \param lane The lane.
+    /// \returns The program counter.
+    inline addr getRegPC(std::size_t lane) const;
+
+    /// Get the accumulator of a lane.
+    /// \param lane The lane.
+    /// \returns The accumulator.
+    inline byte getRegAC(std::size_t lane) const;
+
+    /// Get the X-index register of a lane.
+    /// \param lane The lane.
+    /// \returns The X-index register.
+    inline byte getRegX(std::size_t lane) const;
+
+    /// Get the Y-index register of a lane.
+    /// \param lane The lane.
+    /// \returns The Y-index register.
+    inline byte getRegY(std::size_t lane) const;
+
+    /// Get the status register of a lane.
+    /// \param lane The lane.
+    /// \returns The status register.
+    inline byte getRegSR(std::size_t lane) const;
+
+    /// Get the stack pointer of a lane.
+    /// \param lane The lane.
+    /// \returns The stack pointer.
+    inline byte getRegSP(std::size_t lane) const;
+
+    /// Get the number of cycles a lane has run.
+    /// \param lane The lane.
+    /// \returns The number of cycles.
+    inline std::uint64_t getCycles(std::size_t lane) const;
+
+    /// Get the number of instructions issued to groups of lanes.
+    /// \returns The number of issues.
+    inline std::uint64_t getIssueCount() const;
+
+    /// Get the number of instructions run, summed over every lane.
+    /// \returns The number of lane instructions.
+    inline std::uint64_t getLaneInstructionCount() const;
+
+    /// Get the fraction of lanes that ran each issued instruction, which
+    /// falls as the lanes diverge. 1 means every lane ran every instruction.
+    /// \returns The lane utilization, or 0 if nothing has been issued.
+    inline double getUtilization() const;
+
+  private:
+    /// Operations of the Mos6502, in the order of OPERATION_NAMES.
+    enum class Operation : byte {
+      ADC, AND, ASL, BCC, BCS, BEQ, BIT, BMI, BNE, BPL, BRK, BVC, BVS, CLC,
+      CLD, CLI, CLV, CMP, CPX, CPY, DEC, DEX, DEY, EOR, INC, INX, INY, JMP,
+      JSR, LDA, LDX, LDY, LSR, NOP, ORA, PHA, PHP, PLA, PLP, ROL, ROR, RTI,
+      RTS, SBC, SEC, SED, SEI, STA, STX, STY, TAX, TAY, TSX, TXA, TXS, TYA
+    };
+
+    /// Addressing modes of the Mos6502.
+    enum class Mode : byte {
+      IMPLIED, ACCUMULATOR, IMMEDIATE, RELATIVE, ZEROPAGE, ZEROPAGE_X,
+      ZEROPAGE_Y, ABSOLUTE, ABSOLUTE_X, ABSOLUTE_Y, INDIRECT, X_INDIRECT,
+      INDIRECT_Y
+    };
+
+    /// How an instruction accesses the memory its addressing mode selects.
+    enum class Access : byte {
+      /// The addressing mode only supplies an address, or nothing.
+      NONE,
+      /// The operand is read.
+      READ,
+      /// The result is written.
+      WRITE,
+      /// The operand is read, and the result written back.
+      MODIFY
+    };
+
+    /// An opcode, decoded once by the disassembler.
+    struct Decoded {
+      /// Set if the opcode is defined.
+      bool valid;
+      /// The operation.
+      Operation operation;
+      /// The addressing mode.
+      Mode mode;
+      /// How the operand is accessed.
+      Access access;
+      /// Length of the instruction in bytes.
+      byte length;
+      /// Cycles the instruction takes.
+      byte cycles;
+    };
+
+    /// Number of lanes of storage for each register, rounded up to whole
+    /// chunks. Lanes past the batch are never active.
+    static constexpr const std::size_t STORAGE =
+        Lanes < Lockstep::CHUNK ? Lockstep::CHUNK : Lanes;
+
+    /// Decode every opcode with the disassembler.
+    void buildDecodeTable();
+
+    /// Pick the lane whose instruction is issued next.
+    /// \returns The lane, or Lanes if every lane has run long enough.
+    std::size_t selectLeader() const;
+
+    /// Issue one instruction to the group of lanes the scheduler picks.
+    /// \returns false if every lane has run long enough.
+    bool issue();
+
+    /// Run an instruction on the active lanes.
+    /// \param inst The decoded instruction.
+    void execute(const Decoded& inst);
+
+    /// Run an instruction that changes control flow or the stack on one
+    /// lane.
+    /// \param lane The lane.
+    /// \param inst The decoded instruction.
+    void executeLane(std::size_t lane, const Decoded& inst);
+
+    /// Update the registers of the active lanes, a chunk at a time.
+    /// \param kernel Updates a chunk of every register, and the operand.
+    template<class Kernel>
+    void apply(Kernel kernel);
+
+    /// Push a byte on the stack of a lane.
+    /// \param lane The lane.
+    /// \param data The byte.
+    inline void push(std::size_t lane, byte data);
+
+    /// Pull a byte from the stack of a lane.
+    /// \param lane The lane.
+    /// \returns The byte.
+    inline byte pull(std::size_t lane);
+
+    /// Accumulator of each lane.
+    std::array<byte, STORAGE> ac;
+    /// X-index register of each lane.
+    std::array<byte, STORAGE> x;
+    /// Y-index register of each lane.
+    std::array<byte, STORAGE> y;
+    /// Stack pointer of each lane.
+    std::array<byte, STORAGE> sp;
+    /// Status register of each lane.
+    std::array<byte, STORAGE> sr;
+    /// Operand read, or result to write, of each lane.
+    std::array<byte, STORAGE> operand;
+    /// 0xFF for each lane running the current instruction, 0 otherwise.
+    std::array<byte, STORAGE> active;
+    /// Program counter of each lane.
+    std::array<Vaddr, Lanes> pc;
+    /// The operand bytes of the current instruction of each lane.
+    std::array<Vaddr, Lanes> operandAddress;
+    /// The memory the current instruction of each lane accesses.
+    std::array<Memory::Reference<byte>, Lanes> refs;
+    /// Number of cycles each lane has run.
+    std::array<std::uint64_t, Lanes> cycles;
+    /// Number of cycles each lane runs to before dropping out.
+    std::array<std::uint64_t, Lanes> deadline;
+    /// The memory management unit of each lane.
+    std::vector<Mos6502MmuCore<MapperType>> mmus;
+    /// Every opcode, decoded.
+    std::array<Decoded, 0x100> decodeTable;
+    /// Number of instructions issued.
+    std::uint64_t issueCount;
+    /// Number of instructions run, summed over every lane.
+    std::uint64_t laneInstructionCount;
+};
+
+template<class MapperType, std::size_t Lanes>
+addr LockstepMos6502Core<MapperType, Lanes>::getRegPC(std::size_t lane) const {
+  return pc[lane].val;
+}
+
+template<class MapperType, std::size_t Lanes>
+byte LockstepMos6502Core<MapperType, Lanes>::getRegAC(std::size_t lane) const {
+  return ac[lane];
+}
+
+template<class MapperType, std::size_t Lanes>
+byte LockstepMos6502Core<MapperType, Lanes>::getRegX(std::size_t lane) const {
+  return x[lane];
+}
+
+template<class MapperType, std::size_t Lanes>
+byte LockstepMos6502Core<MapperType, Lanes>::getRegY(std::size_t lane) const {
+  return y[lane];
+}
+
+template<class MapperType, std::size_t Lanes>
+byte LockstepMos6502Core<MapperType, Lanes>::getRegSR(std::size_t lane) const {
+  return sr[lane];
+}
+
+template<class MapperType, std::size_t Lanes>
+byte LockstepMos6502Core<MapperType, Lanes>::getRegSP(std::size_t lane) const {
+  return sp[lane];
+}
+
+template<class MapperType, std::size_t Lanes>
+std::uint64_t LockstepMos6502Core<MapperType, Lanes>::getCycles(std::size_t lane) const {
+  return cycles[lane];
+}
+
+template<class MapperType, std::size_t Lanes>
+std::uint64_t LockstepMos6502Core<MapperType, Lanes>::getIssueCount() const {
+  return issueCount;
+}
+
+template<class MapperType, std::size_t Lanes>
+std::uint64_t LockstepMos6502Core<MapperType, Lanes>::getLaneInstructionCount() const {
+  return laneInstructionCount;
+}
+
+template<class MapperType, std::size_t Lanes>
+double LockstepMos6502Core<MapperType, Lanes>::getUtilization() const {
+  return issueCount > 0
+      ? static_cast<double>(laneInstructionCount) / (issueCount * Lanes) : 0.0;
+}
+
+/// A lockstep batch of Mos6502s, resolving memory accesses through any mapper.
+template<std::size_t Lanes>
+using LockstepMos6502 = LockstepMos6502Core<Memory::Mapper<byte>, Lanes>;
+
+extern template class LockstepMos6502Core<Memory::Mapper<byte>, 8>;
+extern template class LockstepMos6502Core<Memory::Mapper<byte>, 16>;
+extern template class LockstepMos6502Core<Memory::Mapper<byte>, 32>;
+
+} // namespace Cpu
+
+#endif // LOCKSTEP_MOS6502_H //
@@ -0,0 +1,773 @@
+//===-- include/cpu/lockstep/LockstepMos6502_Inst.h -------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the LockstepMos6502Core class.
+/// Include it only where the lockstep batch is instantiated for a memory map
+/// type and lane count.
+///
+/// Each operation updates the registers exactly as its counterpart in
+/// Mos6502_Inst.h does, flag for flag, but for a chunk of lanes at a time.
+///
+//===----------------------------------------------------------------------===//
+#ifndef LOCKSTEP_MOS6502_INST_H
+#define LOCKSTEP_MOS6502_INST_H
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "common/CommonTypes.h"
+#include "cpu/CpuException.h"
+#include "cpu/Mos6502.h"
+#include "cpu/Mos6502_Inst.h"
+#include "cpu/Mos6502Disassembler.h"
+#include "cpu/lockstep/LockstepMos6502.h"
+#include "memory/Ram.h"
+
+namespace Cpu {
+
+namespace Lockstep {
+
+/// Address of the reset vector.
+static const Vaddr RESET_VECTOR = {0xFFFC};
+/// Address of the maskable interrupt vector, used by BRK.
+static const Vaddr IRQ_VECTOR = {0xFFFE};
+/// Address of the bottom of the stack page.
+static const addr STACK_BASE = 0x0100;
+
+/// Name of each operation, as the disassembler names it, in the order of
+/// LockstepMos6502Core::Operation.
+static const char* const OPERATION_NAMES[] = {
+  "ADC", "AND", "ASL", "BCC", "BCS", "BEQ", "BIT", "BMI", "BNE", "BPL", "BRK",
+  "BVC", "BVS", "CLC", "CLD", "CLI", "CLV", "CMP", "CPX", "CPY", "DEC", "DEX",
+  "DEY", "EOR", "INC", "INX", "INY", "JMP", "JSR", "LDA", "LDX", "LDY", "LSR",
+  "NOP", "ORA", "PHA", "PHP", "PLA", "PLP", "ROL", "ROR", "RTI", "RTS", "SBC",
+  "SEC", "SED", "SEI", "STA", "STX", "STY", "TAX", "TAY", "TSX", "TXA", "TXS",
+  "TYA"
+};
+
+/// Name of each addressing mode, as the disassembler names it, in the order
+/// of LockstepMos6502Core::Mode.
+static const char* const MODE_NAMES[] = {
+  "impl", "A", "#", "rel", "zpg", "zpg,X", "zpg,Y", "abs", "abs,X", "abs,Y",
+  "ind", "X,ind", "ind,Y"
+};
+
+#if defined(__AVX2__)
+/// A chunk of lanes of one register.
+using Chunk = __m256i;
+
+/// Load a chunk of lanes.
+static inline Chunk load(const byte* lanes) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+}
+
+/// Store a chunk of lanes.
+static inline void store(byte* lanes, Chunk value) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), value);
+}
+
+/// Broadcast a byte to every lane.
+static inline Chunk splat(byte value) {
+  return _mm256_set1_epi8(static_cast<char>(value));
+}
+
+/// Bitwise AND.
+static inline Chunk bitAnd(Chunk a, Chunk b) {
+  return _mm256_and_si256(a, b);
+}
+
+/// Bitwise AND of the complement of a with b.
+static inline Chunk bitAndNot(Chunk a, Chunk b) {
+  return _mm256_andnot_si256(a, b);
+}
+
+/// Bitwise OR.
+static inline Chunk bitOr(Chunk a, Chunk b) {
+  return _mm256_or_si256(a, b);
+}
+
+/// Bitwise exclusive OR.
+static inline Chunk bitXor(Chunk a, Chunk b) {
+  return _mm256_xor_si256(a, b);
+}
+
+/// Add, wrapping.
+static inline Chunk add(Chunk a, Chunk b) {
+  return _mm256_add_epi8(a, b);
+}
+
+/// Subtract, wrapping.
+static inline Chunk sub(Chunk a, Chunk b) {
+  return _mm256_sub_epi8(a, b);
+}
+
+/// 0xFF where a equals b, 0 elsewhere.
+static inline Chunk equal(Chunk a, Chunk b) {
+  return _mm256_cmpeq_epi8(a, b);
+}
+
+/// 0xFF where a is at least b, unsigned, 0 elsewhere.
+static inline Chunk atLeast(Chunk a, Chunk b) {
+  return _mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a);
+}
+
+/// 0xFF where bit 7 is set, 0 elsewhere.
+static inline Chunk negative(Chunk a) {
+  return _mm256_cmpgt_epi8(_mm256_setzero_si256(), a);
+}
+
+/// Shift right one bit. AVX2 only shifts words, so mask off the bit shifted
+/// in from the next byte.
+static inline Chunk shiftRight(Chunk a) {
+  return _mm256_and_si256(_mm256_srli_epi16(a, 1), splat(0x7F));
+}
+
+/// Take a where the mask is set, and b elsewhere.
+static inline Chunk select(Chunk mask, Chunk a, Chunk b) {
+  return _mm256_blendv_epi8(b, a, mask);
+}
+#else
+/// A chunk of lanes of one register.
+using Chunk = byte;
+
+/// Load a chunk of lanes.
+static inline Chunk load(const byte* lanes) {
+  return *lanes;
+}
+
+/// Store a chunk of lanes.
+static inline void store(byte* lanes, Chunk value) {
+  *lanes = value;
+}
+
+/// Broadcast a byte to every lane.
+static inline Chunk splat(byte value) {
+  return value;
+}
+
+/// Bitwise AND.
+static inline Chunk bitAnd(Chunk a, Chunk b) {
+  return a & b;
+}
+
+/// Bitwise AND of the complement of a with b.
+static inline Chunk bitAndNot(Chunk a, Chunk b) {
+  return static_cast<byte>(~a & b);
+}
+
+/// Bitwise OR.
+static inline Chunk bitOr(Chunk a, Chunk b) {
+  return a | b;
+}
+
+/// Bitwise exclusive OR.
+static inline Chunk bitXor(Chunk a, Chunk b) {
+  return a ^ b;
+}
+
+/// Add, wrapping.
+static inline Chunk add(Chunk a, Chunk b) {
+  return static_cast<byte>(a + b);
+}
+
+/// Subtract, wrapping.
+static inline Chunk sub(Chunk a, Chunk b) {
+  return static_cast<byte>(a - b);
+}
+
+/// 0xFF where a equals b, 0 elsewhere.
+static inline Chunk equal(Chunk a, Chunk b) {
+  return a == b ? 0xFF : 0x00;
+}
+
+/// 0xFF where a is at least b, unsigned, 0 elsewhere.
+static inline Chunk atLeast(Chunk a, Chunk b) {
+  return a >= b ? 0xFF : 0x00;
+}
+
+/// 0xFF where bit 7 is set, 0 elsewhere.
+static inline Chunk negative(Chunk a) {
+  return (a & 0x80) ? 0xFF : 0x00;
+}
+
+/// Shift right one bit.
+static inline Chunk shiftRight(Chunk a) {
+  return a >> 1;
+}
+
+/// Take a where the mask is set, and b elsewhere.
+static inline Chunk select(Chunk mask, Chunk a, Chunk b) {
+  return static_cast<byte>((mask & a) | (~mask & b));
+}
+#endif
+
+/// A chunk of every register of the batch, and of the operand.
+struct Registers {
+  /// Accumulator.
+  Chunk ac;
+  /// X-index register.
+  Chunk x;
+  /// Y-index register.
+  Chunk y;
+  /// Stack pointer.
+  Chunk sp;
+  /// Status register.
+  Chunk sr;
+  /// Operand read, or result to write.
+  Chunk opd;
+};
+
+/// Replace some flags of a status register.
+/// \param sr The status register.
+/// \param flags Mask of the flags to replace.
+/// \param values The new flags, which must lie within the mask.
+static inline Chunk setFlags(Chunk sr, byte flags, Chunk values) {
+  return bitOr(bitAndNot(splat(flags), sr), values);
+}
+
+/// Set the negative and zero flags from a result, as most operations do.
+static inline Chunk setNZ(Chunk sr, Chunk result) {
+  return setFlags(sr, Mos6502::SR_N | Mos6502::SR_Z,
+      bitOr(bitAnd(result, splat(Mos6502::SR_N)),
+      bitAnd(equal(result, splat(0)), splat(Mos6502::SR_Z))));
+}
+
+/// Add with carry into the accumulator, as ADC.
+static inline void addWithCarry(Registers& r, Chunk opd) {
+  Chunk sum = add(add(r.ac, opd), bitAnd(r.sr, splat(Mos6502::SR_C)));
+  // Bit 7 carries out where both addends have it set, or one does and the
+  // sum does not.
+  Chunk carry = negative(bitOr(bitAnd(r.ac, opd), bitAndNot(sum, bitOr(r.ac, opd))));
+  // A signed overflow is when the addends share a sign the sum lacks.
+  Chunk overflow = negative(bitAndNot(bitXor(r.ac, opd), bitXor(r.ac, sum)));
+  r.sr = setFlags(r.sr, Mos6502::SR_C | Mos6502::SR_V,
+      bitOr(bitAnd(carry, splat(Mos6502::SR_C)), bitAnd(overflow, splat(Mos6502::SR_V))));
+  r.sr = setNZ(r.sr, sum);
+  r.ac = sum;
+}
+
+/// Compare a register with the operand, as CMP, CPX and CPY.
+static inline Chunk compare(Chunk sr, Chunk reg, Chunk opd) {
+  return setFlags(sr, Mos6502::SR_N | Mos6502::SR_Z | Mos6502::SR_C,
+      bitOr(bitAnd(sub(reg, opd), splat(Mos6502::SR_N)),
+      bitOr(bitAnd(equal(reg, opd), splat(Mos6502::SR_Z)),
+      bitAnd(atLeast(reg, opd), splat(Mos6502::SR_C)))));
+}
+
+} // namespace Lockstep
+
+template<class MapperType, std::size_t Lanes>
+constexpr const std::size_t LockstepMos6502Core<MapperType, Lanes>::LANES;
+
+template<class MapperType, std::size_t Lanes>
+constexpr const std::uint64_t LockstepMos6502Core<MapperType, Lanes>::MAX_SKEW;
+
+template<class MapperType, std::size_t Lanes>
+LockstepMos6502Core<MapperType, Lanes>::LockstepMos6502Core(
+    const std::array<MapperType*, Lanes>& memMaps) :
+  issueCount(0),
+  laneInstructionCount(0) {
+  // Registers start as a Mos6502's do, with the stack pointer full.
+  ac.fill(0);
+  x.fill(0);
+  y.fill(0);
+  sp.fill(0xFF);
+  sr.fill(0);
+  operand.fill(0);
+  active.fill(0);
+  cycles.fill(0);
+  deadline.fill(0);
+  mmus.reserve(Lanes);
+  for(std::size_t lane = 0; lane < Lanes; lane++) {
+    pc[lane].val = 0;
+    mmus.emplace_back(x[lane], y[lane], *memMaps[lane]);
+  }
+  buildDecodeTable();
+}
+
+template<class MapperType, std::size_t Lanes>
+void LockstepMos6502Core<MapperType, Lanes>::buildDecodeTable() {
+  // The disassembler reads the operands following an opcode, so give it
+  // somewhere to read them from.
+  Memory::Ram<byte> scratch(3);
+  Mos6502Disassembler dis;
+  for(std::size_t opcode = 0; opcode < decodeTable.size(); opcode++) {
+    Decoded& decoded = decodeTable[opcode];
+    decoded.valid = false;
+    Mos6502Instruction inst;
+    try {
+      dis.setReadPosition(Memory::Reference<byte>(&scratch, 0));
+      inst = dis.disassembleInstruction(static_cast<byte>(opcode));
+    } catch(Exception::InvalidOpcodeException&) {
+      continue;
+    }
+    auto name = std::find_if(std::begin(Lockstep::OPERATION_NAMES),
+        std::end(Lockstep::OPERATION_NAMES),
+        [&inst](const char* name) { return inst.name == name; });
+    auto mode = std::find_if(std::begin(Lockstep::MODE_NAMES),
+        std::end(Lockstep::MODE_NAMES),
+        [&inst](const char* name) { return inst.addr == name; });
+    decoded.valid = true;
+    decoded.operation = static_cast<Operation>(name - std::begin(Lockstep::OPERATION_NAMES));
+    decoded.mode = static_cast<Mode>(mode - std::begin(Lockstep::MODE_NAMES));
+    decoded.length = static_cast<byte>(inst.type) + 1;
+    decoded.cycles = inst.cycles;
+    switch(decoded.operation) {
+      case Operation::ADC: case Operation::AND: case Operation::BIT:
+      case Operation::CMP: case Operation::CPX: case Operation::CPY:
+      case Operation::EOR: case Operation::LDA: case Operation::LDX:
+      case Operation::LDY: case Operation::ORA: case Operation::SBC:
+        decoded.access = decoded.mode == Mode::IMMEDIATE ? Access::NONE : Access::READ;
+        break;
+      case Operation::STA: case Operation::STX: case Operation::STY:
+        decoded.access = Access::WRITE;
+        break;
+      case Operation::ASL: case Operation::LSR: case Operation::ROL:
+      case Operation::ROR: case Operation::INC: case Operation::DEC:
+        decoded.access = decoded.mode == Mode::ACCUMULATOR ? Access::NONE : Access::MODIFY;
+        break;
+      default:
+        decoded.access = Access::NONE;
+        break;
+    }
+  }
+}
+
+template<class MapperType, std::size_t Lanes>
+void LockstepMos6502Core<MapperType, Lanes>::reset() {
+  for(std::size_t lane = 0; lane < Lanes; lane++) {
+    sr[lane] |= Mos6502::SR_I;
+    pc[lane] = mmus[lane].loadVector(Lockstep::RESET_VECTOR);
+  }
+}
+
+template<class MapperType, std::size_t Lanes>
+void LockstepMos6502Core<MapperType, Lanes>::step() {
+  deadline.fill(std::numeric_limits<std::uint64_t>::max());
+  issue();
+}
+
+template<class MapperType, std::size_t Lanes>
+void LockstepMos6502Core<MapperType, Lanes>::run(std::uint64_t cycles) {
+  for(std::size_t lane = 0; lane < Lanes; lane++) {
+    deadline[lane] = this->cycles[lane] + cycles;
+  }
+  while(issue()) {}
+}
+
+template<class MapperType, std::size_t Lanes>
+std::size_t LockstepMos6502Core<MapperType, Lanes>::selectLeader() const {
+  std::size_t leader = Lanes;
+  std::size_t slowest = Lanes;
+  std::uint64_t fastest = 0;
+  for(std::size_t lane = 0; lane < Lanes; lane++) {
+    if(cycles[lane] >= deadline[lane]) {
+      continue;
+    }
+    if(leader == Lanes || pc[lane].val < pc[leader].val) {
+      leader = lane;
+    }
+    if(slowest == Lanes || cycles[lane] < cycles[slowest]) {
+      slowest = lane;
+    }
+    fastest = std::max(fastest, cycles[lane]);
+  }
+  if(slowest != Lanes && fastest - cycles[slowest] > MAX_SKEW) {
+    return slowest;
+  }
+  return leader;
+}
+
+template<class MapperType, std::size_t Lanes>
+bool LockstepMos6502Core<MapperType, Lanes>::issue() {
+  std::size_t leader = selectLeader();
+  if(leader == Lanes) {
+    return false;
+  }
+  addr groupPc = pc[leader].val;
+  byte opcode = mmus[leader].absolute(pc[leader]).read();
+  const Decoded& inst = decodeTable[opcode];
+  if(!inst.valid) {
+    throw Exception::InvalidOpcodeException(opcode);
+  }
+  // Gather the group, fetching each lane's operands from its own memory, as
+  // lanes running the same code may still hold different bytes there.
+  std::size_t groupSize = 0;
+  for(std::size_t lane = 0; lane < Lanes; lane++) {
+    active[lane] = 0x00;
+    if(cycles[lane] >= deadline[lane] || pc[lane].val != groupPc) {
+      continue;
+    }
+    Memory::Reference<byte> ref = mmus[lane].absolute(pc[lane]);
+    if(ref.read() != opcode) {
+      continue;
+    }
+    active[lane] = 0xFF;
+    groupSize++;
+    operandAddress[lane].ll = inst.length > 1 ? ref.read(1) : 0;
+    operandAddress[lane].hh = inst.length > 2 ? ref.read(2) : 0;
+    // As in the interpreter, the program counter moves past the instruction
+    // before it runs, which branches and jumps rely on.
+    pc[lane].val += inst.length;
+    cycles[lane] += inst.cycles;
+  }
+  issueCount++;
+  laneInstructionCount += groupSize;
+  execute(inst);
+  return true;
+}
+
+template<class MapperType, std::size_t Lanes>
+template<class Kernel>
+void LockstepMos6502Core<MapperType, Lanes>::apply(Kernel kernel) {
+  using namespace Lockstep;
+  for(std::size_t lane = 0; lane < STORAGE; lane += CHUNK) {
+    Chunk mask = load(&active[lane]);
+    Registers before = {load(&ac[lane]), load(&x[lane]), load(&y[lane]),
+        load(&sp[lane]), load(&sr[lane]), load(&operand[lane])};
+    Registers after = before;
+    kernel(after);
+    store(&ac[lane], select(mask, after.ac, before.ac));
+    store(&x[lane], select(mask, after.x, before.x));
+    store(&y[lane], select(mask, after.y, before.y));
+    store(&sp[lane], select(mask, after.sp, before.sp));
+    store(&sr[lane], select(mask, after.sr, before.sr));
+    store(&operand[lane], select(mask, after.opd, before.opd));
+  }
+}
+
+template<class MapperType, std::size_t Lanes>
+void LockstepMos6502Core<MapperType, Lanes>::execute(const Decoded& inst) {
+  using namespace Lockstep;
+  // Resolve the operand of each lane. The index registers differ between
+  // lanes, so each lane may address different memory.
+  for(std::size_t lane = 0; lane < Lanes; lane++) {
+    if(!active[lane]) {
+      continue;
+    }
+    const Mos6502MmuCore<MapperType>& mmu = mmus[lane];
+    Vaddr vaddr = operandAddress[lane];
+    if(inst.mode == Mode::IMMEDIATE) {
+      operand[lane] = vaddr.ll;
+      continue;
+    }
+    if(inst.access == Access::NONE) {
+      continue;
+    }
+    switch(inst.mode) {
+      case Mode::ZEROPAGE:   refs[lane] = mmu.zeropage(vaddr); break;
+      case Mode::ZEROPAGE_X: refs[lane] = mmu.zeropageXIndexed(vaddr); break;
+      case Mode::ZEROPAGE_Y: refs[lane] = mmu.zeropageYIndexed(vaddr); break;
+      case Mode::ABSOLUTE:   refs[lane] = mmu.absolute(vaddr); break;
+      case Mode::ABSOLUTE_X: refs[lane] = mmu.absoluteXIndexed(vaddr); break;
+      case Mode::ABSOLUTE_Y: refs[lane] = mmu.absoluteYIndexed(vaddr); break;
+      case Mode::X_INDIRECT: refs[lane] = mmu.xIndexedIndirect(vaddr); break;
+      case Mode::INDIRECT_Y: refs[lane] = mmu.indirectYIndexed(vaddr); break;
+      default: break;
+    }
+    if(inst.access != Access::WRITE) {
+      operand[lane] = refs[lane].read();
+    }
+  }
+
+  const bool accumulator = inst.mode == Mode::ACCUMULATOR;
+  switch(inst.operation) {
+    // Loads and stores
+    case Operation::LDA:
+      apply([](Registers& r) { r.ac = r.opd; r.sr = setNZ(r.sr, r.ac); });
+      break;
+    case Operation::LDX:
+      apply([](Registers& r) { r.x = r.opd; r.sr = setNZ(r.sr, r.x); });
+      break;
+    case Operation::LDY:
+      apply([](Registers& r) { r.y = r.opd; r.sr = setNZ(r.sr, r.y); });
+      break;
+    case Operation::STA:
+      apply([](Registers& r) { r.opd = r.ac; });
+      break;
+    case Operation::STX:
+      apply([](Registers& r) { r.opd = r.x; });
+      break;
+    case Operation::STY:
+      apply([](Registers& r) { r.opd = r.y; });
+      break;
+
+    // Arithmetic, logic and comparisons
+    case Operation::ADC:
+      apply([](Registers& r) { addWithCarry(r, r.opd); });
+      break;
+    case Operation::SBC:
+      apply([](Registers& r) { addWithCarry(r, bitXor(r.opd, splat(0xFF))); });
+      break;
+    case Operation::AND:
+      apply([](Registers& r) { r.ac = bitAnd(r.ac, r.opd); r.sr = setNZ(r.sr, r.ac); });
+      break;
+    case Operation::EOR:
+      apply([](Registers& r) { r.ac = bitXor(r.ac, r.opd); r.sr = setNZ(r.sr, r.ac); });
+      break;
+    case Operation::ORA:
+      apply([](Registers& r) { r.ac = bitOr(r.ac, r.opd); r.sr = setNZ(r.sr, r.ac); });
+      break;
+    case Operation::CMP:
+      apply([](Registers& r) { r.sr = compare(r.sr, r.ac, r.opd); });
+      break;
+    case Operation::CPX:
+      apply([](Registers& r) { r.sr = compare(r.sr, r.x, r.opd); });
+      break;
+    case Operation::CPY:
+      apply([](Registers& r) { r.sr = compare(r.sr, r.y, r.opd); });
+      break;
+    case Operation::BIT:
+      apply([](Registers& r) {
+        r.sr = setFlags(r.sr, Mos6502::SR_N | Mos6502::SR_V | Mos6502::SR_Z,
+            bitOr(bitAnd(r.opd, splat(Mos6502::SR_N | Mos6502::SR_V)),
+            bitAnd(equal(bitAnd(r.ac, r.opd), splat(0)), splat(Mos6502::SR_Z))));
+      });
+      break;
+
+    // Increments and decrements
+    case Operation::INC:
+      apply([](Registers& r) { r.opd = add(r.opd, splat(1)); r.sr = setNZ(r.sr, r.opd); });
+      break;
+    case Operation::DEC:
+      apply([](Registers& r) { r.opd = sub(r.opd, splat(1)); r.sr = setNZ(r.sr, r.opd); });
+      break;
+    case Operation::INX:
+      apply([](Registers& r) { r.x = add(r.x, splat(1)); r.sr = setNZ(r.sr, r.x); });
+      break;
+    case Operation::INY:
+      apply([](Registers& r) { r.y = add(r.y, splat(1)); r.sr = setNZ(r.sr, r.y); });
+      break;
+    case Operation::DEX:
+      apply([](Registers& r) { r.x = sub(r.x, splat(1)); r.sr = setNZ(r.sr, r.x); });
+      break;
+    case Operation::DEY:
+      apply([](Registers& r) { r.y = sub(r.y, splat(1)); r.sr = setNZ(r.sr, r.y); });
+      break;
+
+    // Shifts and rotates, of the accumulator or memory
+    case Operation::ASL:
+      apply([accumulator](Registers& r) {
+        Chunk& value = accumulator ? r.ac : r.opd;
+        r.sr = setFlags(r.sr, Mos6502::SR_C, bitAnd(negative(value), splat(Mos6502::SR_C)));
+        value = add(value, value);
+        r.sr = setNZ(r.sr, value);
+      });
+      break;
+    case Operation::LSR:
+      // As in Mos6502_Inst.h, LSR leaves the negative flag alone.
+      apply([accumulator](Registers& r) {
+        Chunk& value = accumulator ? r.ac : r.opd;
+        r.sr = setFlags(r.sr, Mos6502::SR_C, bitAnd(value, splat(Mos6502::SR_C)));
+        value = shiftRight(value);
+        r.sr = setFlags(r.sr, Mos6502::SR_Z,
+            bitAnd(equal(value, splat(0)), splat(Mos6502::SR_Z)));
+      });
+      break;
+    case Operation::ROL:
+      apply([accumulator](Registers& r) {
+        Chunk& value = accumulator ? r.ac : r.opd;
+        Chunk carry = bitAnd(r.sr, splat(Mos6502::SR_C));
+        r.sr = setFlags(r.sr, Mos6502::SR_C, bitAnd(negative(value), splat(Mos6502::SR_C)));
+        value = bitOr(add(value, value), carry);
+        r.sr = setNZ(r.sr, value);
+      });
+      break;
+    case Operation::ROR:
+      apply([accumulator](Registers& r) {
+        Chunk& value = accumulator ? r.ac : r.opd;
+        // The old carry, as a mask, rotates into bit 7.
+        Chunk carry = bitAnd(sub(splat(0), bitAnd(r.sr, splat(Mos6502::SR_C))), splat(0x80));
+        r.sr = setFlags(r.sr, Mos6502::SR_C, bitAnd(value, splat(Mos6502::SR_C)));
+        value = bitOr(shiftRight(value), carry);
+        r.sr = setNZ(r.sr, value);
+      });
+      break;
+
+    // Transfers. As in Mos6502_Inst.h, TXS sets the flags too.
+    case Operation::TAX:
+      apply([](Registers& r) { r.x = r.ac; r.sr = setNZ(r.sr, r.x); });
+      break;
+    case Operation::TAY:
+      apply([](Registers& r) { r.y = r.ac; r.sr = setNZ(r.sr, r.y); });
+      break;
+    case Operation::TXA:
+      apply([](Registers& r) { r.ac = r.x; r.sr = setNZ(r.sr, r.ac); });
+      break;
+    case Operation::TYA:
+      apply([](Registers& r) { r.ac = r.y; r.sr = setNZ(r.sr, r.ac); });
+      break;
+    case Operation::TSX:
+      apply([](Registers& r) { r.x = r.sp; r.sr = setNZ(r.sr, r.x); });
+      break;
+    case Operation::TXS:
+      apply([](Registers& r) { r.sp = r.x; r.sr = setNZ(r.sr, r.sp); });
+      break;
+
+    // Flags
+    case Operation::CLC:
+      apply([](Registers& r) { r.sr = bitAndNot(splat(Mos6502::SR_C), r.sr); });
+      break;
+    case Operation::CLD:
+      apply([](Registers& r) { r.sr = bitAndNot(splat(Mos6502::SR_D), r.sr); });
+      break;
+    case Operation::CLI:
+      apply([](Registers& r) { r.sr = bitAndNot(splat(Mos6502::SR_I), r.sr); });
+      break;
+    case Operation::CLV:
+      apply([](Registers& r) { r.sr = bitAndNot(splat(Mos6502::SR_V), r.sr); });
+      break;
+    case Operation::SEC:
+      apply([](Registers& r) { r.sr = bitOr(r.sr, splat(Mos6502::SR_C)); });
+      break;
+    case Operation::SED:
+      apply([](Registers& r) { r.sr = bitOr(r.sr, splat(Mos6502::SR_D)); });
+      break;
+    case Operation::SEI:
+      apply([](Registers& r) { r.sr = bitOr(r.sr, splat(Mos6502::SR_I)); });
+      break;
+
+    case Operation::NOP:
+      break;
+
+    // Branches, jumps and the stack take a lane at a time.
+    default:
+      for(std::size_t lane = 0; lane < Lanes; lane++) {
+        if(active[lane]) {
+          executeLane(lane, inst);
+        }
+      }
+      break;
+  }
+
+  // Scatter the results.
+  if(inst.access == Access::WRITE || inst.access == Access::MODIFY) {
+    for(std::size_t lane = 0; lane < Lanes; lane++) {
+      if(active[lane]) {
+        refs[lane].write(operand[lane]);
+      }
+    }
+  }
+}
+
+template<class MapperType, std::size_t Lanes>
+void LockstepMos6502Core<MapperType, Lanes>::executeLane(std::size_t lane,
+    const Decoded& inst) {
+  Vaddr& lanePc = pc[lane];
+  const Vaddr target = operandAddress[lane];
+  const byte flags = sr[lane];
+  switch(inst.operation) {
+    case Operation::BCC:
+      if(!(flags & Mos6502::SR_C)) {
+        lanePc.val = computeBranch(lanePc.val, target.ll);
+      }
+      break;
+    case Operation::BCS:
+      if(flags & Mos6502::SR_C) {
+        lanePc.val = computeBranch(lanePc.val, target.ll);
+      }
+      break;
+    case Operation::BEQ:
+      if(flags & Mos6502::SR_Z) {
+        lanePc.val = computeBranch(lanePc.val, target.ll);
+      }
+      break;
+    case Operation::BMI:
+      if(flags & Mos6502::SR_N) {
+        lanePc.val = computeBranch(lanePc.val, target.ll);
+      }
+      break;
+    case Operation::BNE:
+      if(!(flags & Mos6502::SR_Z)) {
+        lanePc.val = computeBranch(lanePc.val, target.ll);
+      }
+      break;
+    case Operation::BPL:
+      if(!(flags & Mos6502::SR_N)) {
+        lanePc.val = computeBranch(lanePc.val, target.ll);
+      }
+      break;
+    case Operation::BVC:
+      if(!(flags & Mos6502::SR_V)) {
+        lanePc.val = computeBranch(lanePc.val, target.ll);
+      }
+      break;
+    case Operation::BVS:
+      if(flags & Mos6502::SR_V) {
+        lanePc.val = computeBranch(lanePc.val, target.ll);
+      }
+      break;
+    case Operation::JMP:
+      lanePc = inst.mode == Mode::INDIRECT ? mmus[lane].loadVector(target) : target;
+      break;
+    case Operation::JSR:
+      lanePc.val = lanePc.val - 1;
+      push(lane, lanePc.hh);
+      push(lane, lanePc.ll);
+      lanePc = target;
+      break;
+    case Operation::RTS:
+      lanePc.ll = pull(lane);
+      lanePc.hh = pull(lane);
+      lanePc.val = lanePc.val + 1;
+      break;
+    case Operation::RTI:
+      sr[lane] = pull(lane);
+      lanePc.ll = pull(lane);
+      lanePc.hh = pull(lane);
+      break;
+    case Operation::BRK:
+      lanePc.val = lanePc.val + 1;
+      push(lane, lanePc.hh);
+      push(lane, lanePc.ll);
+      push(lane, flags);
+      sr[lane] = flags | Mos6502::SR_I | Mos6502::SR_B;
+      lanePc = mmus[lane].loadVector(Lockstep::IRQ_VECTOR);
+      break;
+    case Operation::PHA:
+      push(lane, ac[lane]);
+      break;
+    case Operation::PHP:
+      push(lane, flags);
+      break;
+    case Operation::PLA:
+      ac[lane] = pull(lane);
+      sr[lane] = (flags & ~(Mos6502::SR_N | Mos6502::SR_Z))
+          | (checkNthBit(ac[lane], BitPosition::BIT_7) << 7)
+          | (checkZero(ac[lane]) << 1);
+      break;
+    case Operation::PLP:
+      sr[lane] = pull(lane);
+      break;
+    default:
+      break;
+  }
+}
+
+template<class MapperType, std::size_t Lanes>
+void LockstepMos6502Core<MapperType, Lanes>::push(std::size_t lane, byte data) {
+  Vaddr vaddr;
+  vaddr.val = Lockstep::STACK_BASE | sp[lane]--;
+  mmus[lane].absolute(vaddr).write(data);
+}
+
+template<class MapperType, std::size_t Lanes>
+byte LockstepMos6502Core<MapperType, Lanes>::pull(std::size_t lane) {
+  Vaddr vaddr;
+  vaddr.val = Lockstep::STACK_BASE | ++sp[lane];
+  return mmus[lane].absolute(vaddr).read();
+}
+
+} // namespace Cpu
+
+#endif // LOCKSTEP_MOS6502_INST_H //
@@ -0,0 +1,162 @@
+//===-- include/memory/Arena.h - Memory Arena Class -------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the Memory::Arena class, a single aligned allocation that
+/// many memory banks can be carved out of.
+///
+//===----------------------------------------------------------------------===//
+#ifndef MEMORY_ARENA_H
+#define MEMORY_ARENA_H
+
+#include <algorithm>
+#include <memory>
+
+#include "common/CommonTypes.h"
+#include "memory/MemoryException.h"
+
+namespace Memory {
+
+/// \class Arena
+/// \brief This class owns one contiguous, aligned block of words. Memory banks
+/// are allocated out of the arena back to back and are addressed by their
+/// offset from the start of the arena, so that related banks share cache lines
+/// and pages instead of being scattered across the heap.
+/// \tparam Wordsize Size of a memory word for the memory object.
+template<class Wordsize>
+class Arena {
+  public:
+    /// The default alignment of the arena storage, one cache line.
+    static constexpr const std::size_t DEFAULT_ALIGNMENT = 64;
+
+    /// Create an empty arena with no storage.
+    inline Arena();
+
+    /// Create an arena with room for the given number of words.
+    /// \param capacity The number of words in the arena.
+    /// \param alignment Alignment in bytes of the start of the arena.
+    inline explicit Arena(std::size_t capacity,
+        std::size_t alignment = DEFAULT_ALIGNMENT);
+
+    /// Arenas cannot be copied.
+    Arena(const Arena&) = delete;
+    /// Arenas cannot be copy assigned.
+    Arena& operator=(const Arena&) = delete;
+
+    /// Move an arena. Pointers into the moved arena remain valid.
+    inline Arena(Arena&& otherArena);
+    /// Move assign an arena. Pointers into the moved arena remain valid.
+    inline Arena& operator=(Arena&& otherArena);
+
+    ~Arena() {}
+
+    /// Reserve the given number of words at the end of the arena.
+    /// \param size The number of words to reserve.
+    /// \returns The offset of the reserved words from the start of the arena.
+    /// \throws Exception::MemoryException if the arena is exhausted.
+    inline std::size_t allocate(std::size_t size);
+
+    /// Get a pointer to the word at the given offset into the arena.
+    /// \param offset Offset from the start of the arena.
+    /// \returns Pointer to the word at the offset.
+    inline Wordsize* at(std::size_t offset) const;
+
+    /// Get the total number of words in the arena.
+    /// \returns The capacity of the arena.
+    inline std::size_t getCapacity() const;
+
+    /// Get the number of words allocated out of the arena so far.
+    /// \returns The number of allocated words.
+    inline std::size_t getAllocated() const;
+
+  private:
+    /// The raw, unaligned storage backing the arena.
+    std::unique_ptr<byte[]> buffer;
+    /// The aligned start of the arena within buffer.
+    Wordsize* data;
+    /// The total number of words in the arena.
+    std::size_t capacity;
+    /// The number of words allocated so far.
+    std::size_t allocated;
+};
+
+template<class Wordsize>
+Arena<Wordsize>::Arena() :
+  data(nullptr),
+  capacity(0),
+  allocated(0) {}
+
+template<class Wordsize>
+Arena<Wordsize>::Arena(std::size_t capacity, std::size_t alignment) :
+  capacity(capacity),
+  allocated(0) {
+  // Over allocate by the alignment so that we can align the start of the
+  // arena ourselves, then zero the whole arena.
+  std::size_t bytes = capacity * sizeof(Wordsize);
+  std::size_t space = bytes + alignment;
+  buffer = std::unique_ptr<byte[]>(new byte[space]);
+  void* start = buffer.get();
+  data = static_cast<Wordsize*>(std::align(alignment, bytes, start, space));
+  std::fill(data, data + capacity, Wordsize());
+}
+
+template<class Wordsize>
+Arena<Wordsize>::Arena(Arena&& otherArena) :
+  buffer(std::move(otherArena.buffer)),
+  data(otherArena.data),
+  capacity(otherArena.capacity),
+  allocated(otherArena.allocated) {
+  otherArena.data = nullptr;
+  otherArena.capacity = 0;
+  otherArena.allocated = 0;
+}
+
+template<class Wordsize>
+Arena<Wordsize>& Arena<Wordsize>::operator=(Arena&& otherArena) {
+  if(this != &otherArena) {
+    buffer = std::move(otherArena.buffer);
+    data = otherArena.data;
+    capacity = otherArena.capacity;
+    allocated = otherArena.allocated;
+    otherArena.data = nullptr;
+    otherArena.capacity = 0;
+    otherArena.allocated = 0;
+  }
+  return *this;
+}
+
+template<class Wordsize>
+std::size_t Arena<Wordsize>::allocate(std::size_t size) {
+  // Bump allocate from the end of the arena.
+  if(size > capacity - allocated) {
+    throw Exception::MemoryException("Arena of " + std::to_string(capacity)
+        + " words cannot allocate " + std::to_string(size) + " more words.");
+  }
+  std::size_t offset = allocated;
+  allocated += size;
+  return offset;
+}
+
+template<class Wordsize>
+Wordsize* Arena<Wordsize>::at(std::size_t offset) const {
+  return data + offset;
+}
+
+template<class Wordsize>
+std::size_t Arena<Wordsize>::getCapacity() const {
+  return capacity;
+}
+
+template<class Wordsize>
+std::size_t Arena<Wordsize>::getAllocated() const {
+  return allocated;
+}
+
+} // namespace Memory
+
+#endif // MEMORY_ARENA_H //
@@ -14,10 +14,13 @@
 #ifndef MEMORY_BANK_H
 #define MEMORY_BANK_H
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 #include "common/CommonTypes.h"
 #include "memory/AbstractMemory.h"
+#include "memory/MemoryException.h"
 
 namespace Memory {
 
@@ -34,12 +37,32 @@ class Bank : public AbstractMemory<Wordsize> {
     /// \param size The number of words in the memory bank.
     /// \param vaddr The base address of the memory bank.
     inline Bank(std::size_t size, Vaddr vaddr = {0x0});
+
+    /// Create a memory bank viewing the given number of words of external
+    /// storage, such as a Memory::Arena, at the given base address. The bank
+    /// does not own the storage, which must outlive the bank.
+    /// \param storage Pointer to the first word of the bank.
+    /// \param size The number of words in the memory bank.
+    /// \param vaddr The base address of the memory bank.
+    inline Bank(Wordsize* storage, std::size_t size, Vaddr vaddr = {0x0});
+
+    /// Copy a memory bank. Owned storage is copied, viewed storage is shared.
+    inline Bank(const Bank<Wordsize>& otherBank);
+    /// Move a memory bank.
+    inline Bank(Bank<Wordsize>&& otherBank);
+    /// Copy assign a memory bank. Owned storage is copied, viewed storage is
+    /// shared.
+    inline Bank<Wordsize>& operator=(const Bank<Wordsize>& otherBank);
+    /// Move assign a memory bank.
+    inline Bank<Wordsize>& operator=(Bank<Wordsize>&& otherBank);
+
     virtual ~Bank() {};
 
-    /// Read word from \p index into the memory bank.
+    /// Read word from \p index into the memory bank. Banks backed by devices
+    /// rather than storage may override this.
     /// \param index Index into the dataBank array.
     /// \returns Word at the given index.
-    inline const Wordsize read(std::size_t index) const final;
+    inline const Wordsize read(std::size_t index) const override;
 
     /// Get the size of this memory bank.
     /// \returns The size of this memory bank.
@@ -47,8 +70,13 @@ class Bank : public AbstractMemory<Wordsize> {
 
     /// Resize the Memory::Bank object.
     /// \param size The new size of the memory bank.
+    /// \throws Exception::MemoryException if the bank views external storage.
     inline void resize(std::size_t size);
 
+    /// Check if this bank views external storage rather than owning it.
+    /// \returns True if the storage is external.
+    inline bool isView() const;
+
     /// Get the base address of this memory bank.
     /// \returns The base address of this memory bank.
     inline Vaddr getBaseAddress() const;
@@ -56,41 +84,136 @@ class Bank : public AbstractMemory<Wordsize> {
     /// Set the base address of this memory bank.
     /// \param vaddr The base address to give this memory bank.
     inline void setBaseAddress(const Vaddr vaddr);
+
+    /// Get the index into this memory bank of a virtual address mapped to it.
+    /// Banks whose size is a power of 2 are mirrored through any larger window
+    /// they are mapped into.
+    /// \param vaddr The virtual address to convert.
+    /// \returns The index of the address in this memory bank.
+    inline std::size_t getIndex(const Vaddr vaddr) const;
+
+    /// Get read only access to the storage of the memory bank, for copying
+    /// runs of words without a read call for each.
+    /// \returns A pointer to the first word of the bank.
+    inline const Wordsize* getStorage() const;
   
   protected:
-    /// Get a reference to the internal dataBank.
-    /// \returns A reference to the internal dataBank
-    inline std::vector<Wordsize>& getDataBank();
+    /// Get a pointer to the first word of the memory bank.
+    /// \returns A pointer to the bank storage.
+    inline Wordsize* getData();
+
+    /// Replace the owned storage of this bank with the given words.
+    /// \param words The new contents of the memory bank.
+    inline void assign(std::vector<Wordsize>&& words);
+
+    /// Point this view at the storage of another bank, starting at the given
+    /// word. The view may run past the end of \p source into storage the
+    /// caller knows to be contiguous with it, such as banks allocated back to
+    /// back out of one Memory::Arena.
+    /// \param source The bank whose storage to view.
+    /// \param offset Offset of the first viewed word from the start of source.
+    /// \throws Exception::MemoryException if this bank owns its storage.
+    inline void setView(const Bank<Wordsize>& source, std::size_t offset);
 
   private:
-    /// The array of data comprising the memory bank
+    /// The array of data owned by the memory bank. Empty for views.
     std::vector<Wordsize> dataBank;
 
+    /// Pointer to the first word of the bank, owned or viewed.
+    Wordsize* data;
+
+    /// The number of words in the memory bank.
+    std::size_t size;
+
+    /// True if the bank views external storage.
+    bool view;
+
     /// The base virtual address of this memory bank
     Vaddr baseAddress;
 };
 
 template<class Wordsize>
-Bank<Wordsize>::Bank(std::size_t size, Vaddr vaddr) {
-  // Initialize the memory bank
-  this->dataBank.resize(size);
+Bank<Wordsize>::Bank(std::size_t size, Vaddr vaddr) :
+  dataBank(size),
+  data(dataBank.data()),
+  size(size),
+  view(false) {
+  this->baseAddress.val = vaddr.val;
+}
+
+template<class Wordsize>
+Bank<Wordsize>::Bank(Wordsize* storage, std::size_t size, Vaddr vaddr) :
+  data(storage),
+  size(size),
+  view(true) {
   this->baseAddress.val = vaddr.val;
 }
 
+template<class Wordsize>
+Bank<Wordsize>::Bank(const Bank<Wordsize>& otherBank) :
+  dataBank(otherBank.dataBank),
+  data(otherBank.view ? otherBank.data : dataBank.data()),
+  size(otherBank.size),
+  view(otherBank.view),
+  baseAddress(otherBank.baseAddress) {}
+
+template<class Wordsize>
+Bank<Wordsize>::Bank(Bank<Wordsize>&& otherBank) :
+  dataBank(std::move(otherBank.dataBank)),
+  data(otherBank.view ? otherBank.data : dataBank.data()),
+  size(otherBank.size),
+  view(otherBank.view),
+  baseAddress(otherBank.baseAddress) {}
+
+template<class Wordsize>
+Bank<Wordsize>& Bank<Wordsize>::operator=(const Bank<Wordsize>& otherBank) {
+  if(this != &otherBank) {
+    dataBank = otherBank.dataBank;
+    data = otherBank.view ? otherBank.data : dataBank.data();
+    size = otherBank.size;
+    view = otherBank.view;
+    baseAddress = otherBank.baseAddress;
+  }
+  return *this;
+}
+
+template<class Wordsize>
+Bank<Wordsize>& Bank<Wordsize>::operator=(Bank<Wordsize>&& otherBank) {
+  if(this != &otherBank) {
+    dataBank = std::move(otherBank.dataBank);
+    data = otherBank.view ? otherBank.data : dataBank.data();
+    size = otherBank.size;
+    view = otherBank.view;
+    baseAddress = otherBank.baseAddress;
+  }
+  return *this;
+}
+
 template<class Wordsize>
 const Wordsize Bank<Wordsize>::read(std::size_t index) const {
   // read the data from the given index
-  return dataBank[index];
+  return data[index];
 }
 
 template<class Wordsize>
 std::size_t Bank<Wordsize>::getSize() const {
-  return dataBank.size();
+  return size;
 }
 
 template<class Wordsize>
 void Bank<Wordsize>::resize(std::size_t size) {
+  // Views do not own their storage, so they cannot grow it.
+  if(view) {
+    throw Exception::MemoryException("Cannot resize a bank viewing external storage.");
+  }
   dataBank.resize(size);
+  this->data = dataBank.data();
+  this->size = size;
+}
+
+template<class Wordsize>
+bool Bank<Wordsize>::isView() const {
+  return view;
 }
 
 template<class Wordsize>
@@ -104,8 +227,45 @@ void Bank<Wordsize>::setBaseAddress(const Vaddr vaddr) {
 }
 
 template<class Wordsize>
-std::vector<Wordsize>& Bank<Wordsize>::getDataBank() {
-  return dataBank;
+std::size_t Bank<Wordsize>::getIndex(const Vaddr vaddr) const {
+  std::size_t offset = vaddr.val - baseAddress.val;
+  // Wrap the offset into the bank if the bank can be mirrored.
+  return (size & (size - 1)) == 0 ? offset & (size - 1) : offset;
+}
+
+template<class Wordsize>
+const Wordsize* Bank<Wordsize>::getStorage() const {
+  return data;
+}
+
+template<class Wordsize>
+Wordsize* Bank<Wordsize>::getData() {
+  return data;
+}
+
+template<class Wordsize>
+void Bank<Wordsize>::assign(std::vector<Wordsize>&& words) {
+  if(view) {
+    // Copy into the viewed storage, which must be large enough.
+    if(words.size() > size) {
+      throw Exception::MemoryException("Cannot assign " + std::to_string(words.size())
+          + " words to a bank viewing " + std::to_string(size) + " words.");
+    }
+    std::copy(words.begin(), words.end(), data);
+  } else {
+    dataBank = std::move(words);
+    data = dataBank.data();
+    size = dataBank.size();
+  }
+}
+
+template<class Wordsize>
+void Bank<Wordsize>::setView(const Bank<Wordsize>& source, std::size_t offset) {
+  // Only views may be pointed at other storage.
+  if(!view) {
+    throw Exception::MemoryException("Cannot view external storage from a bank owning its storage.");
+  }
+  data = source.data + offset;
 }
 
 } // namespace Memory
@@ -0,0 +1,118 @@
+//===-- include/memory/IoPort.h - Memory Mapped I/O Port --------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the Memory::IoPort class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef MEMORY_IO_PORT_H
+#define MEMORY_IO_PORT_H
+
+#include <functional>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "memory/MemoryException.h"
+#include "memory/Bank.h"
+
+namespace Memory {
+
+/// \class IoPort
+/// \brief This class represents a bank of memory mapped device registers.
+/// Reads and writes of each register are dispatched through a table of
+/// handlers indexed by register. Registers without a handler behave as a
+/// latch, reading back the last word written to them.
+/// \tparam Wordsize Size of a memory word for the memory object.
+template<class Wordsize>
+class IoPort : public Bank<Wordsize> {
+  public:
+    /// Handler for reads of a register, given the register index.
+    using ReadHandler = std::function<Wordsize(std::size_t)>;
+    /// Handler for writes to a register, given the register index and data.
+    using WriteHandler = std::function<void(std::size_t, Wordsize)>;
+
+    /// Create an IoPort with the given number of registers, at the given
+    /// base address.
+    /// \param size The number of registers in the port.
+    /// \param vaddr The base address of the port.
+    IoPort(std::size_t size, Vaddr vaddr = {0x0});
+
+    /// Nothing is needed to destroy an IoPort.
+    virtual ~IoPort() {};
+
+    /// Read a register, dispatching to its read handler if it has one.
+    /// \param index Index of the register to read.
+    /// \returns Word read from the register.
+    const Wordsize read(std::size_t index) const override;
+
+    /// Write a register, dispatching to its write handler if it has one.
+    /// \param index Index of the register to write.
+    /// \param data Word to write to the register.
+    void write(std::size_t index, Wordsize data) override;
+
+    /// Set the handler called when the given register is read.
+    /// \param index Index of the register.
+    /// \param handler Handler to call, or an empty handler to latch.
+    /// \throws Exception::MemoryException if the register does not exist.
+    void setReadHandler(std::size_t index, ReadHandler handler);
+
+    /// Set the handler called when the given register is written.
+    /// \param index Index of the register.
+    /// \param handler Handler to call, or an empty handler to latch.
+    /// \throws Exception::MemoryException if the register does not exist.
+    void setWriteHandler(std::size_t index, WriteHandler handler);
+
+  private:
+    /// Read handlers, indexed by register.
+    std::vector<ReadHandler> readHandlers;
+    /// Write handlers, indexed by register.
+    std::vector<WriteHandler> writeHandlers;
+};
+
+template<class Wordsize>
+IoPort<Wordsize>::IoPort(std::size_t size, Vaddr vaddr) :
+  Bank<Wordsize>(size, vaddr),
+  readHandlers(size),
+  writeHandlers(size) {}
+
+template<class Wordsize>
+const Wordsize IoPort<Wordsize>::read(std::size_t index) const {
+  const ReadHandler& handler = readHandlers[index];
+  return handler ? handler(index) : Bank<Wordsize>::read(index);
+}
+
+template<class Wordsize>
+void IoPort<Wordsize>::write(std::size_t index, Wordsize data) {
+  // Always latch the data, so that registers without a read handler read
+  // back what was last written.
+  this->getData()[index] = data;
+  const WriteHandler& handler = writeHandlers[index];
+  if(handler) {
+    handler(index, data);
+  }
+}
+
+template<class Wordsize>
+void IoPort<Wordsize>::setReadHandler(std::size_t index, ReadHandler handler) {
+  if(index >= readHandlers.size()) {
+    throw Exception::MemoryException("IoPort has no register " + std::to_string(index));
+  }
+  readHandlers[index] = std::move(handler);
+}
+
+template<class Wordsize>
+void IoPort<Wordsize>::setWriteHandler(std::size_t index, WriteHandler handler) {
+  if(index >= writeHandlers.size()) {
+    throw Exception::MemoryException("IoPort has no register " + std::to_string(index));
+  }
+  writeHandlers[index] = std::move(handler);
+}
+
+} // namespace Memory
+
+#endif // MEMORY_IO_PORT_H //:~
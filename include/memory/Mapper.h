@@ -34,9 +34,11 @@ class Mapper {
     virtual const std::string getName() const = 0;
 
     /// This function maps a virtual address to its associated hardware unit.
+    /// The hardware is owned by whoever owns the mapper, and the returned
+    /// pointer is valid for as long as the mapper is.
     /// \param address Address to find the hardware for.
-    /// \returns A shared pointer to the hardware resource.
-    virtual std::shared_ptr<Bank<Wordsize>> mapToHardware(Vaddr vaddr) const = 0;
+    /// \returns A pointer to the hardware resource.
+    virtual Bank<Wordsize>* mapToHardware(Vaddr vaddr) const = 0;
 
 };
 
@@ -13,6 +13,10 @@
 #ifndef MEMORY_RAM_H
 #define MEMORY_RAM_H
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 #include "common/CommonTypes.h"
 #include "memory/MemoryException.h"
 #include "memory/Bank.h"
@@ -21,16 +25,35 @@ namespace Memory {
 
 /// \class Ram
 /// \brief This class act as a random access memory for an architecture with the
-/// given wordsize.
+/// given wordsize. The Ram keeps one dirty bit for each page of PAGE_SIZE
+/// words, set by every write, so that snapshots taken every frame can copy
+/// only the pages written since the last one.
 /// \tparam Wordsize Size of a memory word for the memory object.
 template<class Wordsize> 
 class Ram : public Bank<Wordsize> {
   public:
+    /// Number of index bits spanned by one dirty page.
+    static constexpr const std::size_t PAGE_BITS = 8;
+    /// Number of words in one dirty page.
+    static constexpr const std::size_t PAGE_SIZE = 1 << PAGE_BITS;
+
     /// Create a Ram of with the given number of words, at the given
     /// base address.
     /// \param size The number of words in the memory bank.
     /// \param vaddr The base address of the memory bank.
-    Ram(std::size_t size = 0, Vaddr vaddr = {0x0}) : Bank<Wordsize>(size, vaddr) {};
+    Ram(std::size_t size = 0, Vaddr vaddr = {0x0}) : Bank<Wordsize>(size, vaddr) {
+      resizeDirtyPages();
+    };
+
+    /// Create a Ram viewing the given number of words of external storage, at
+    /// the given base address.
+    /// \param storage Pointer to the first word of the Ram.
+    /// \param size The number of words in the memory bank.
+    /// \param vaddr The base address of the memory bank.
+    Ram(Wordsize* storage, std::size_t size, Vaddr vaddr = {0x0}) :
+      Bank<Wordsize>(storage, size, vaddr) {
+      resizeDirtyPages();
+    };
 
     // Destructor
     virtual ~Ram() {};
@@ -39,12 +62,132 @@ class Ram : public Bank<Wordsize> {
     /// \param index Memory location to write to
     /// \param data Data to write at the given location
     inline void write(std::size_t index, Wordsize data) override;
+
+    /// Overwrite the whole Ram, as restoring a saved state does. Every page
+    /// is marked dirty.
+    /// \param words getSize() words to copy in.
+    inline void load(const Wordsize* words);
+
+    /// Resize the Ram, marking every page dirty.
+    /// \param size The new number of words.
+    /// \throws Exception::MemoryException if the Ram views external storage.
+    inline void resize(std::size_t size);
+
+    /// Mark the page holding a word as dirty, for writes made straight to
+    /// the storage of the Ram, such as through a Window.
+    /// \param index Index of the word written.
+    inline void markDirty(std::size_t index);
+
+    /// Mark every page as dirty.
+    inline void markAllDirty();
+
+    /// Get the number of pages in the Ram, the last of which may be partial.
+    /// \returns The number of pages.
+    inline std::size_t getPageCount() const;
+
+    /// Check if a page has been written since dirty pages were last cleared.
+    /// \param page Page number, the index of its first word over PAGE_SIZE.
+    /// \returns True if the page is dirty.
+    inline bool isPageDirty(std::size_t page) const;
+
+    /// Append the numbers of the dirty pages, in ascending order, to a list,
+    /// and mark every page clean.
+    /// \param pages Receives the page numbers.
+    /// \returns The number of dirty pages.
+    inline std::size_t collectDirtyPages(std::vector<std::size_t>& pages);
+
+    /// Mark every page clean.
+    inline void clearDirtyPages();
+
+  private:
+    /// Number of dirty bits in each word of the bitmap.
+    static constexpr const std::size_t BITMAP_WORD_BITS = 64;
+
+    /// Size the dirty bitmap to the Ram, with every page dirty.
+    inline void resizeDirtyPages();
+
+    /// One dirty bit for each page.
+    std::vector<std::uint64_t> dirtyPages;
 };
 
+template<class Wordsize>
+constexpr const std::size_t Ram<Wordsize>::PAGE_BITS;
+
+template<class Wordsize>
+constexpr const std::size_t Ram<Wordsize>::PAGE_SIZE;
+
+template<class Wordsize>
+constexpr const std::size_t Ram<Wordsize>::BITMAP_WORD_BITS;
+
 template<class Wordsize>
 void Ram<Wordsize>::write(std::size_t index, Wordsize data) {
   // write the data at the given index
-  this->getDataBank()[index] = data;
+  this->getData()[index] = data;
+  markDirty(index);
+}
+
+template<class Wordsize>
+void Ram<Wordsize>::load(const Wordsize* words) {
+  std::copy(words, words + this->getSize(), this->getData());
+  markAllDirty();
+}
+
+template<class Wordsize>
+void Ram<Wordsize>::resize(std::size_t size) {
+  Bank<Wordsize>::resize(size);
+  resizeDirtyPages();
+}
+
+template<class Wordsize>
+void Ram<Wordsize>::markDirty(std::size_t index) {
+  // A single OR, which leaves pages already dirty as they are.
+  std::size_t page = index >> PAGE_BITS;
+  dirtyPages[page / BITMAP_WORD_BITS] |= std::uint64_t(1) << (page % BITMAP_WORD_BITS);
+}
+
+template<class Wordsize>
+void Ram<Wordsize>::markAllDirty() {
+  std::fill(dirtyPages.begin(), dirtyPages.end(), ~std::uint64_t(0));
+}
+
+template<class Wordsize>
+std::size_t Ram<Wordsize>::getPageCount() const {
+  return (this->getSize() + PAGE_SIZE - 1) >> PAGE_BITS;
+}
+
+template<class Wordsize>
+bool Ram<Wordsize>::isPageDirty(std::size_t page) const {
+  return (dirtyPages[page / BITMAP_WORD_BITS] >> (page % BITMAP_WORD_BITS)) & 1;
+}
+
+template<class Wordsize>
+std::size_t Ram<Wordsize>::collectDirtyPages(std::vector<std::size_t>& pages) {
+  std::size_t count = 0;
+  std::size_t pageCount = getPageCount();
+  for(std::size_t word = 0; word < dirtyPages.size(); word++) {
+    std::uint64_t bits = dirtyPages[word];
+    dirtyPages[word] = 0;
+    // Most words are clean, and are skipped whole.
+    for(std::size_t bit = 0; bits != 0; bit++, bits >>= 1) {
+      std::size_t page = word * BITMAP_WORD_BITS + bit;
+      if((bits & 1) && page < pageCount) {
+        pages.push_back(page);
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+template<class Wordsize>
+void Ram<Wordsize>::clearDirtyPages() {
+  std::fill(dirtyPages.begin(), dirtyPages.end(), 0);
+}
+
+template<class Wordsize>
+void Ram<Wordsize>::resizeDirtyPages() {
+  dirtyPages.assign((getPageCount() + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS,
+      ~std::uint64_t(0));
 }
 
 } // namespace Memory
@@ -21,16 +21,22 @@ namespace Memory {
 /// \class Reference
 /// \brief This creates references to the underlying words in objects of
 /// the type Memory::Bank. These references should be use to access data in
-/// other subsystems.
+/// other subsystems. References do not own the referenced bank.
 template<class Wordsize>
 class Reference {
   public:
     // Constructors and Destructor
     inline Reference();
-    inline Reference(std::shared_ptr<Bank<Wordsize>> dataBank, std::size_t index);
+    inline Reference(Bank<Wordsize>* dataBank, std::size_t index);
+    inline Reference(const std::shared_ptr<Bank<Wordsize>>& dataBank, std::size_t index);
     inline Reference(const Reference<Wordsize>& reference);
     virtual ~Reference() {};
 
+    /// Point at the same location as another reference.
+    /// \param reference The reference to copy.
+    /// \return Reference to this for chaining.
+    inline Reference& operator=(const Reference<Wordsize>& reference);
+
     /// Write to referenced location.
     /// \param data Data to write that the given location.
     inline void write(Wordsize data);
@@ -62,7 +68,7 @@ class Reference {
     std::size_t index;
 
     /// The memory bank pointed to by the reference.
-    std::shared_ptr<Bank<Wordsize>> dataBank;
+    Bank<Wordsize>* dataBank;
 };
 
 // default constructor
@@ -75,12 +81,18 @@ Reference<Wordsize>::Reference() {
 // normal constructor
 template <class Wordsize>
 Reference<Wordsize>::Reference(
-    std::shared_ptr<Memory::Bank<Wordsize>> dataBank,
+    Memory::Bank<Wordsize>* dataBank,
     std::size_t index) {
   this->dataBank = dataBank;
   this->index = index;
 }
 
+// shared bank constructor, the caller keeps ownership of the bank
+template <class Wordsize>
+Reference<Wordsize>::Reference(
+    const std::shared_ptr<Memory::Bank<Wordsize>>& dataBank,
+    std::size_t index) : Reference(dataBank.get(), index) {}
+
 // copy constructor
 template <class Wordsize>
 Reference<Wordsize>::Reference(const Reference<Wordsize>& reference) {
@@ -88,6 +100,14 @@ Reference<Wordsize>::Reference(const Reference<Wordsize>& reference) {
   this->index = reference.index;
 }
 
+// copy assignment
+template <class Wordsize>
+Reference<Wordsize>& Reference<Wordsize>::operator=(const Reference<Wordsize>& reference) {
+  this->dataBank = reference.dataBank;
+  this->index = reference.index;
+  return *this;
+}
+
 template<class Wordsize>
 void Reference<Wordsize>::write(Wordsize data) {
   // write data to dataBank at index
@@ -32,6 +32,14 @@ class Rom : public Bank<Wordsize> {
     /// \param vaddr The base address of the memory bank.
     Rom(std::size_t size = 0, Vaddr vaddr = {0x0}) : Bank<Wordsize>(size, vaddr) {};
 
+    /// Create a Rom viewing the given number of words of external storage, at
+    /// the given base address. The Rom still has to be loaded.
+    /// \param storage Pointer to the first word of the Rom.
+    /// \param size The number of words in the memory bank.
+    /// \param vaddr The base address of the memory bank.
+    Rom(Wordsize* storage, std::size_t size, Vaddr vaddr = {0x0}) :
+      Bank<Wordsize>(storage, size, vaddr) {};
+
     /// Destroy a Rom
     virtual ~Rom() {};
 
@@ -41,7 +49,8 @@ class Rom : public Bank<Wordsize> {
     /// \throws ReadOnlyMemoryException This is guaranteed.
     inline void write(std::size_t index, Wordsize data) override;
 
-    /// Load data into this Rom object. This can only be done once.
+    /// Load data into this Rom object. This can only be done once. Roms viewing
+    /// external storage copy the data into that storage.
     /// \tparam InputIterator Type of input iterator to use.
     /// \param start Data import start position.
     /// \param end Data import end position.
@@ -68,8 +77,8 @@ void Rom<Wordsize>::load(InputIterator start, InputIterator end) {
   if(isLoaded) {
     throw Exception::ReadOnlyMemoryException("Loaded ROM is trying to be overwritten");
   }
-  // replace the internal dataBank with a new one containing the loaded data.
-  this->getDataBank() = std::vector<byte>(start, end);
+  // replace the contents of the bank with the loaded data.
+  this->assign(std::vector<Wordsize>(start, end));
   isLoaded = true;
 }
 
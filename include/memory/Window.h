@@ -0,0 +1,140 @@
+//===-- include/memory/Window.h - Bank Switched Window ----------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the Memory::Window class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef MEMORY_WINDOW_H
+#define MEMORY_WINDOW_H
+
+#include <functional>
+
+#include "common/CommonTypes.h"
+#include "memory/MemoryException.h"
+#include "memory/Bank.h"
+#include "memory/Ram.h"
+
+namespace Memory {
+
+/// \class Window
+/// \brief This class represents a fixed region of an address space through
+/// which banks of a larger memory are switched. The window stays at its base
+/// address while the storage behind it changes, so switching banks is a single
+/// pointer update and anything mapping addresses to the window never needs to
+/// be told about the switch.
+/// \tparam Wordsize Size of a memory word for the memory object.
+template<class Wordsize>
+class Window : public Bank<Wordsize> {
+  public:
+    /// Handler for writes to a read only window, given the address written
+    /// and the data.
+    using WriteHandler = std::function<void(Vaddr, Wordsize)>;
+
+    /// Create an unmapped Window of the given size at the given base address.
+    /// \param size The number of words in the window.
+    /// \param vaddr The base address of the window.
+    Window(std::size_t size, Vaddr vaddr = {0x0}) :
+      Bank<Wordsize>(nullptr, size, vaddr),
+      writable(false),
+      dirtyRam(nullptr),
+      dirtyOffset(0) {};
+
+    /// Destroy a Window.
+    virtual ~Window() {};
+
+    /// Switch the storage behind this window.
+    /// \param source The bank holding the storage to map.
+    /// \param offset Offset of the first mapped word from the start of source.
+    /// \param writable True if writes go to the storage.
+    inline void map(const Bank<Wordsize>& source, std::size_t offset, bool writable);
+
+    /// Switch a Ram behind this window, marking the pages of the Ram written
+    /// through the window dirty.
+    /// \param source The Ram holding the storage to map.
+    /// \param offset Offset of the first mapped word from the start of source.
+    /// \param writable True if writes go to the storage.
+    inline void map(Ram<Wordsize>& source, std::size_t offset, bool writable);
+
+    /// Write to the storage behind the window if it is writable, otherwise
+    /// pass the write to the write handler.
+    /// \param index Index into the window.
+    /// \param data Word to write.
+    /// \throws Exception::ReadOnlyMemoryException if the window is read only
+    /// and has no write handler.
+    inline void write(std::size_t index, Wordsize data) override;
+
+    /// Set the handler called on writes to the window while it is read only.
+    /// \param handler Handler to call.
+    inline void setWriteHandler(WriteHandler handler);
+
+    /// Check if writes to this window go to its storage.
+    /// \returns True if the window is writable.
+    inline bool isWritable() const;
+
+  private:
+    /// True if writes go to the storage behind the window.
+    bool writable;
+
+    /// Handler for writes while the window is read only.
+    WriteHandler writeHandler;
+
+    /// The Ram whose pages are marked dirty by writes, or nullptr.
+    Ram<Wordsize>* dirtyRam;
+
+    /// Offset of the window into dirtyRam.
+    std::size_t dirtyOffset;
+};
+
+template<class Wordsize>
+void Window<Wordsize>::map(const Bank<Wordsize>& source, std::size_t offset, bool writable) {
+  this->setView(source, offset);
+  this->writable = writable;
+  dirtyRam = nullptr;
+}
+
+template<class Wordsize>
+void Window<Wordsize>::map(Ram<Wordsize>& source, std::size_t offset, bool writable) {
+  map(static_cast<const Bank<Wordsize>&>(source), offset, writable);
+  // Windows running past the end of the Ram, into storage contiguous with
+  // it, are not tracked.
+  if(offset + this->getSize() <= source.getSize()) {
+    dirtyRam = &source;
+    dirtyOffset = offset;
+  }
+}
+
+template<class Wordsize>
+void Window<Wordsize>::write(std::size_t index, Wordsize data) {
+  if(writable) {
+    this->getData()[index] = data;
+    if(dirtyRam != nullptr) {
+      dirtyRam->markDirty(dirtyOffset + index);
+    }
+  } else if(writeHandler) {
+    Vaddr vaddr;
+    vaddr.val = static_cast<addr>(this->getBaseAddress().val + index);
+    writeHandler(vaddr, data);
+  } else {
+    throw Exception::ReadOnlyMemoryException();
+  }
+}
+
+template<class Wordsize>
+void Window<Wordsize>::setWriteHandler(WriteHandler handler) {
+  writeHandler = std::move(handler);
+}
+
+template<class Wordsize>
+bool Window<Wordsize>::isWritable() const {
+  return writable;
+}
+
+} // namespace Memory
+
+#endif // MEMORY_WINDOW_H //:~
@@ -0,0 +1,433 @@
+//===-- include/nes/Apu.h - Nes Audio Processing Unit -----------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Apu class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_APU_H
+#define NES_APU_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
+#include "nes/CpuBus.h"
+
+namespace Nes {
+
+/// \class Apu
+/// \brief This class represents the audio half of the Ricoh 2A03: two pulse
+/// channels, a triangle, a noise channel and the delta modulation channel
+/// (DMC). Like the Ppu, the Apu is told how many Cpu cycles have elapsed and
+/// only catches up when a register is accessed or an IRQ may be due.
+///
+/// No sample is generated per Cpu cycle. Catching up steps from one channel
+/// timer clock to the next, and each time the mixed output changes the
+/// change is recorded at its exact time as a band-limited step, spread over
+/// a few output samples by a windowed sinc kernel. Ending a frame integrates
+/// the recorded steps into the frame's samples in one pass. The nonlinear
+/// mixer of the Nes is two lookup tables, one for the pulses and one for the
+/// other channels.
+class Apu {
+  public:
+    /// Cpu clock rate of an NTSC Nes, in Hz.
+    static constexpr const double CPU_CLOCK_RATE = 1789773.0;
+    /// Number of fractional sample positions a step is placed at.
+    static constexpr const std::size_t BLEP_PHASES = 32;
+    /// Number of samples a step is spread over.
+    static constexpr const std::size_t BLEP_TAPS = 16;
+
+    /// Build an Apu producing samples at the given rate.
+    /// \param sampleRate Output sample rate, in Hz.
+    explicit Apu(double sampleRate = 48000.0);
+
+    /// Apus cannot be copied.
+    Apu(const Apu&) = delete;
+    /// Apus cannot be copy assigned.
+    Apu& operator=(const Apu&) = delete;
+
+    /// Destroy an Apu.
+    ~Apu() {}
+
+    /// Attach the Apu registers to their addresses on the Cpu bus, which the
+    /// DMC also fetches its samples from.
+    /// \param bus The Cpu bus.
+    void connect(CpuBus& bus);
+
+    /// Let the given number of Cpu cycles elapse. No work is done until the
+    /// Apu is caught up.
+    /// \param cycles Number of Cpu cycles.
+    inline void advance(std::size_t cycles);
+
+    /// Check whether enough cycles have elapsed that an IRQ may be due, and
+    /// the Apu should be caught up.
+    /// \returns true if catchUp should be called.
+    inline bool isCatchUpDue() const;
+
+    /// Run the Apu through every cycle that has elapsed.
+    void catchUp();
+
+    /// Read an Apu register, catching up first.
+    /// \param index Register index, the address less $4000.
+    /// \returns The value read.
+    byte readRegister(std::size_t index);
+
+    /// Write an Apu register, catching up first.
+    /// \param index Register index, the address less $4000.
+    /// \param data The value written.
+    void writeRegister(std::size_t index, byte data);
+
+    /// Check if the frame counter or the DMC is asserting the Cpu IRQ line,
+    /// as of the last catch up.
+    /// \returns true if an IRQ is pending.
+    inline bool isIrqAsserted() const;
+
+    /// Catch up, and synthesize the samples of every cycle since the last
+    /// call. Steps not taken within a frame and a quarter are dropped, all
+    /// but the last frame of them, so an Apu whose audio is never taken does
+    /// not grow.
+    /// \param samples Receives the samples, appended as 16 bit signed PCM.
+    /// \returns The number of samples appended.
+    std::size_t endFrame(std::vector<std::int16_t>& samples);
+
+    /// Get the output sample rate.
+    /// \returns The sample rate, in Hz.
+    inline double getSampleRate() const;
+
+    /// Switch headless mode on or off. In headless mode the channels, the
+    /// frame counter and the IRQs run as usual, but changes to the mix are
+    /// not recorded, so the samples of the frame are silent.
+    /// \param headless true to stop producing audio.
+    inline void setHeadless(bool headless);
+
+    /// Check whether the Apu is in headless mode.
+    /// \returns true if no audio is being produced.
+    inline bool isHeadless() const;
+
+    /// Catch up, and write the channels, the frame counter and the audio of
+    /// the frame so far to a saved state. A headless Apu saves no audio.
+    /// \param writer The state being written.
+    void saveState(Structure::StateWriter& writer);
+
+    /// Read the channels, the frame counter and the audio of the frame so
+    /// far from a saved state.
+    /// \param reader The state being read.
+    void loadState(Structure::StateReader& reader);
+
+  private:
+    /// Time of a clock that will never come, for stopped timers.
+    static constexpr const std::size_t NEVER = std::numeric_limits<std::size_t>::max();
+
+    /// The volume envelope shared by the pulse and noise channels.
+    struct Envelope {
+      /// Restart the envelope at its next clock.
+      bool start;
+      /// Loop the decay, which also halts the length counter.
+      bool loop;
+      /// Output the volume directly instead of the decay.
+      bool constant;
+      /// Volume, or the decay period.
+      byte volume;
+      /// Divider counting down the decay period.
+      byte divider;
+      /// Decay level.
+      byte decay;
+    };
+
+    /// A pulse channel.
+    struct Pulse {
+      /// Volume envelope.
+      Envelope envelope;
+      /// Duty cycle, 0 to 3.
+      byte duty;
+      /// Step of the 8 step duty sequence.
+      byte sequence;
+      /// Timer period, in units of 2 Cpu cycles, less one.
+      addr period;
+      /// Length counter.
+      byte length;
+      /// Whether the channel is enabled through $4015.
+      bool enabled;
+      /// Whether the sweep unit adjusts the period.
+      bool sweepEnabled;
+      /// Sweep towards higher pitches.
+      bool sweepNegate;
+      /// Reload the sweep divider at its next clock.
+      bool sweepReload;
+      /// Sweep divider period.
+      byte sweepPeriod;
+      /// Sweep shift count.
+      byte sweepShift;
+      /// Divider counting down the sweep period.
+      byte sweepDivider;
+      /// Pulse 1 negates its sweep in ones' complement.
+      bool onesComplement;
+      /// Cycle of the next timer clock.
+      std::size_t nextClock;
+    };
+
+    /// The triangle channel.
+    struct Triangle {
+      /// Timer period, in Cpu cycles, less one.
+      addr period;
+      /// Step of the 32 step sequence.
+      byte sequence;
+      /// Length counter.
+      byte length;
+      /// Whether the channel is enabled through $4015.
+      bool enabled;
+      /// Halts the length counter and keeps reloading the linear counter.
+      bool control;
+      /// Value the linear counter is reloaded with.
+      byte linearReload;
+      /// Linear counter.
+      byte linearCounter;
+      /// Reload the linear counter at its next clock.
+      bool linearReloadFlag;
+      /// Cycle of the next timer clock.
+      std::size_t nextClock;
+    };
+
+    /// The noise channel.
+    struct Noise {
+      /// Volume envelope.
+      Envelope envelope;
+      /// Short, 93 step, mode.
+      bool mode;
+      /// Timer period, in Cpu cycles.
+      addr period;
+      /// The 15 bit linear feedback shift register.
+      std::uint16_t shift;
+      /// Length counter.
+      byte length;
+      /// Whether the channel is enabled through $4015.
+      bool enabled;
+      /// Cycle of the next timer clock.
+      std::size_t nextClock;
+    };
+
+    /// The delta modulation channel.
+    struct Dmc {
+      /// Raise an IRQ when a sample ends.
+      bool irqEnabled;
+      /// Restart samples when they end.
+      bool loop;
+      /// Timer period, in Cpu cycles.
+      addr period;
+      /// 7 bit output level.
+      byte level;
+      /// Start address of the sample.
+      addr sampleAddress;
+      /// Length of the sample in bytes.
+      std::size_t sampleLength;
+      /// Address of the next sample byte.
+      addr currentAddress;
+      /// Sample bytes left to fetch.
+      std::size_t bytesRemaining;
+      /// The sample byte fetched ahead of the output unit.
+      byte buffer;
+      /// Whether the buffer holds a byte.
+      bool bufferFull;
+      /// Bits of the sample byte being output.
+      byte shift;
+      /// Bits of the shift register left to output.
+      byte bitsRemaining;
+      /// Set while the output unit has no sample byte.
+      bool silence;
+      /// Cycle of the next timer clock.
+      std::size_t nextClock;
+    };
+
+    /// Clock a pulse channel timer.
+    void clockPulse(Pulse& pulse);
+    /// Clock the triangle timer.
+    void clockTriangle();
+    /// Clock the noise timer.
+    void clockNoise();
+    /// Clock the DMC timer.
+    void clockDmc();
+    /// Fetch the next DMC sample byte if the buffer is empty.
+    void fetchDmcSample();
+    /// Clock the frame counter sequence.
+    void clockFrameCounter();
+    /// Clock the envelopes and the triangle linear counter.
+    void clockQuarterFrame();
+    /// Clock the length counters and sweeps.
+    void clockHalfFrame();
+    /// Restart the timers of channels stopped while silent that can sound
+    /// again.
+    void startTimers();
+
+    /// Get the sweep target period of a pulse channel.
+    static inline int getSweepTarget(const Pulse& pulse);
+    /// Check whether a pulse channel is muted by its period or sweep.
+    static inline bool isMuted(const Pulse& pulse);
+    /// Get the output of a pulse channel, 0 to 15.
+    static inline byte getOutput(const Pulse& pulse);
+    /// Get the output of the noise channel, 0 to 15.
+    inline byte getNoiseOutput() const;
+    /// Check whether the triangle sequencer runs.
+    inline bool isTriangleRunning() const;
+    /// Clock an envelope.
+    static inline void clockEnvelope(Envelope& envelope);
+    /// Write the volume register of an envelope.
+    static inline void writeEnvelope(Envelope& envelope, byte data);
+
+    /// Write the fields of an envelope to a saved state.
+    static void saveChannel(Structure::StateWriter& writer, const Envelope& envelope);
+    /// Write the fields of a pulse channel to a saved state.
+    static void saveChannel(Structure::StateWriter& writer, const Pulse& pulse);
+    /// Write the fields of the triangle channel to a saved state.
+    static void saveChannel(Structure::StateWriter& writer, const Triangle& triangle);
+    /// Write the fields of the noise channel to a saved state.
+    static void saveChannel(Structure::StateWriter& writer, const Noise& noise);
+    /// Write the fields of the DMC to a saved state.
+    static void saveChannel(Structure::StateWriter& writer, const Dmc& dmc);
+    /// Read the fields of an envelope from a saved state.
+    static void loadChannel(Structure::StateReader& reader, Envelope& envelope);
+    /// Read the fields of a pulse channel from a saved state.
+    static void loadChannel(Structure::StateReader& reader, Pulse& pulse);
+    /// Read the fields of the triangle channel from a saved state.
+    static void loadChannel(Structure::StateReader& reader, Triangle& triangle);
+    /// Read the fields of the noise channel from a saved state.
+    static void loadChannel(Structure::StateReader& reader, Noise& noise);
+    /// Read the fields of the DMC from a saved state.
+    static void loadChannel(Structure::StateReader& reader, Dmc& dmc);
+
+    /// Mix the channel outputs.
+    /// \returns The mixer output.
+    inline float getMix() const;
+
+    /// Mix the channel outputs, and record a step if the mix changed.
+    /// \param time The cycle the outputs changed on.
+    void mix(std::size_t time);
+
+    /// Record a step in the output.
+    /// \param time The cycle of the step.
+    /// \param delta The change in output.
+    void addStep(std::size_t time, float delta);
+
+    /// Get the index in the step buffer of the sample a cycle falls in.
+    /// \param time The cycle.
+    /// \returns The sample index.
+    inline std::size_t getSampleIndex(std::size_t time) const;
+
+    /// Integrate the steps of the cycles before a given one into samples,
+    /// and count cycles from that one on.
+    /// \param end The first cycle not integrated.
+    /// \param samples Receives the samples, or nullptr to drop them.
+    void drain(std::size_t end, std::int16_t* samples);
+
+    /// Drop the samples of all but the last frame of cycles.
+    /// \returns The number of cycles dropped, which times are now counted
+    /// less.
+    std::size_t dropUndrained();
+
+    /// Compute the cycles until the next event that can raise an IRQ.
+    std::size_t getCyclesUntilIrq() const;
+
+    /// The Cpu bus DMC samples are fetched from, or nullptr.
+    CpuBus* bus;
+    /// Output sample rate.
+    double sampleRate;
+    /// Output samples per Cpu cycle, in 32.32 fixed point.
+    std::uint64_t timeScale;
+    /// Position of cycle 0 in the step buffer, in 32.32 fixed point samples.
+    std::uint64_t sampleOffset;
+
+    /// Cycle reached, counted from the last endFrame.
+    std::size_t cycle;
+    /// Cycles elapsed that have not been caught up.
+    std::size_t pendingCycles;
+    /// Cycles from the current cycle to the next event that can raise an IRQ.
+    std::size_t cyclesUntilIrq;
+
+    /// The pulse channels.
+    Pulse pulses[2];
+    /// The triangle channel.
+    Triangle triangle;
+    /// The noise channel.
+    Noise noise;
+    /// The delta modulation channel.
+    Dmc dmc;
+
+    /// Five step sequence selected.
+    bool fiveStepMode;
+    /// Frame IRQ inhibited.
+    bool irqInhibit;
+    /// Frame IRQ raised.
+    bool frameIrq;
+    /// DMC IRQ raised.
+    bool dmcIrq;
+    /// Step of the frame counter sequence.
+    std::size_t frameStep;
+    /// Cycle the frame counter sequence started.
+    std::size_t frameStart;
+    /// Cycle of the next frame counter step.
+    std::size_t nextFrameClock;
+
+    /// Output of the pulse mixer, by the sum of the pulse outputs.
+    std::array<float, 31> pulseMix;
+    /// Output of the triangle, noise and DMC mixer, by 3 * triangle + 2 *
+    /// noise + DMC.
+    std::array<float, 203> tndMix;
+    /// Mixer output as of the last step.
+    float output;
+    /// True while no steps are being recorded.
+    bool headless;
+
+    /// Band-limited impulses, each the derivative of a step at one fraction
+    /// of a sample, summing to 1.
+    float blepKernels[BLEP_PHASES][BLEP_TAPS];
+    /// Steps of the current frame, to be integrated into samples.
+    std::vector<float> steps;
+    /// Running sum of the steps integrated so far.
+    double integrator;
+    /// Integrator value at the previous sample, for the high pass filter.
+    double lastIntegrator;
+    /// High pass filtered output at the previous sample.
+    double filtered;
+    /// Coefficient of the high pass filter.
+    double highPass;
+};
+
+void Apu::advance(std::size_t cycles) {
+  pendingCycles += cycles;
+}
+
+bool Apu::isCatchUpDue() const {
+  return pendingCycles >= cyclesUntilIrq;
+}
+
+bool Apu::isIrqAsserted() const {
+  return frameIrq || dmcIrq;
+}
+
+double Apu::getSampleRate() const {
+  return sampleRate;
+}
+
+std::size_t Apu::getSampleIndex(std::size_t time) const {
+  return static_cast<std::size_t>((sampleOffset + time * timeScale) >> 32);
+}
+
+void Apu::setHeadless(bool headless) {
+  this->headless = headless;
+}
+
+bool Apu::isHeadless() const {
+  return headless;
+}
+
+} // namespace Nes
+
+#endif // NES_APU_H //
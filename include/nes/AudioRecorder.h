@@ -0,0 +1,150 @@
+//===-- include/nes/AudioRecorder.h - Audio File Recorder -------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::AudioRecorder class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_AUDIO_RECORDER_H
+#define NES_AUDIO_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "common/CommonTypes.h"
+#include "memory/Arena.h"
+#include "nes/AudioRing.h"
+
+namespace Nes {
+
+/// \class AudioRecorder
+/// \brief This class records mono 16 bit audio to a file without holding up
+/// the emulation. The emulation thread writes samples into an AudioRing, and
+/// a writer thread of the recorder streams them to disk in large chunks
+/// copied out of the ring into an aligned buffer. If the disk falls behind
+/// by more than the ring holds, samples are dropped and counted as overrun
+/// by the ring, rather than the emulation waiting.
+class AudioRecorder {
+  public:
+    /// The file formats a recording can be written in.
+    enum class Format {
+      /// A RIFF WAVE file, with a header giving the rate and length.
+      WAV,
+      /// Bare little endian samples.
+      RAW
+    };
+
+    /// Number of samples the writer thread writes at once.
+    static constexpr const std::size_t CHUNK_SAMPLES = 8192;
+    /// Default number of samples the ring holds, a few seconds at 48kHz.
+    static constexpr const std::size_t DEFAULT_RING_CAPACITY = 1 << 17;
+    /// Most samples a WAV file holds, as its header gives sizes in 32 bits and
+    /// counts 36 bytes of itself in the RIFF size.
+    /// A WAV recording stops here, a little over 12 hours in at 48kHz.
+    static constexpr const std::uint64_t MAX_WAV_SAMPLES = (0xFFFFFFFFu - 36) / 2;
+
+    /// Create the file and start the writer thread.
+    /// \param path Path of the file to write.
+    /// \param format Format of the file.
+    /// \param sampleRate Sample rate, in Hz, recorded in a WAV header.
+    /// \param ringCapacity Number of samples the ring holds.
+    /// \throws Exception::RuntimeException if the file cannot be created.
+    AudioRecorder(const std::string& path, Format format, std::uint32_t sampleRate,
+        std::size_t ringCapacity = DEFAULT_RING_CAPACITY);
+
+    /// AudioRecorders cannot be copied.
+    AudioRecorder(const AudioRecorder&) = delete;
+    /// AudioRecorders cannot be copy assigned.
+    AudioRecorder& operator=(const AudioRecorder&) = delete;
+
+    /// Close the recording.
+    ~AudioRecorder();
+
+    /// Queue samples to be written. Only one thread may write samples.
+    /// \param samples The samples.
+    /// \param count Number of samples.
+    /// \returns The number of samples queued, less than count if the ring
+    /// was full.
+    inline std::size_t write(const std::int16_t* samples, std::size_t count);
+
+    /// Stop the writer thread once it has written every queued sample, and
+    /// finish the file. Does nothing if the recording is already closed.
+    /// \throws Exception::RuntimeException if a write to the file failed,
+    /// for example on a full disk, or a WAV recording outgrew its header.
+    /// The file then holds only the samples written before that.
+    void close();
+
+    /// Check whether a write to the file has failed, or a WAV recording has
+    /// reached MAX_WAV_SAMPLES, after which no more samples are written.
+    /// \returns true if the recording is cut short.
+    inline bool hasFailed() const;
+
+    /// Get the ring samples are queued in, for its fill level and overrun
+    /// and underrun counts.
+    /// \returns The ring.
+    inline const AudioRing& getRing() const;
+
+    /// Get the number of samples written to the file so far.
+    /// \returns The number of samples written.
+    inline std::uint64_t getWrittenCount() const;
+
+  private:
+    /// Body of the writer thread.
+    void run();
+
+    /// Write a chunk of samples to the file.
+    /// \param count Number of samples at the start of chunk.
+    void writeChunk(std::size_t count);
+
+    /// Write or rewrite the WAV header, for the samples written so far.
+    void writeWavHeader();
+
+    /// The file being written.
+    std::ofstream file;
+    /// Format of the file.
+    Format format;
+    /// Sample rate recorded in the header.
+    std::uint32_t sampleRate;
+    /// Samples queued for the writer thread.
+    AudioRing ring;
+    /// Page aligned buffer the writer thread reads chunks into.
+    Memory::Arena<std::int16_t> chunk;
+    /// Number of samples written to the file.
+    std::atomic<std::uint64_t> writtenCount;
+    /// Set when a write to the file fails.
+    std::atomic<bool> failed;
+    /// Set when a WAV recording reaches MAX_WAV_SAMPLES.
+    std::atomic<bool> full;
+    /// Set when the writer thread should finish up.
+    std::atomic<bool> stopping;
+    /// The writer thread.
+    std::thread writer;
+};
+
+std::size_t AudioRecorder::write(const std::int16_t* samples, std::size_t count) {
+  return ring.write(samples, count);
+}
+
+const AudioRing& AudioRecorder::getRing() const {
+  return ring;
+}
+
+bool AudioRecorder::hasFailed() const {
+  return failed.load(std::memory_order_relaxed) || full.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AudioRecorder::getWrittenCount() const {
+  return writtenCount.load(std::memory_order_relaxed);
+}
+
+} // namespace Nes
+
+#endif // NES_AUDIO_RECORDER_H //:~
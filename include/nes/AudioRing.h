@@ -0,0 +1,126 @@
+//===-- include/nes/AudioRing.h - Lock-Free Audio Ring Buffer ---*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::AudioRing class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_AUDIO_RING_H
+#define NES_AUDIO_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "common/CommonTypes.h"
+
+namespace Nes {
+
+/// \class AudioRing
+/// \brief This class passes 16 bit samples from one producer thread to one
+/// consumer thread without locks. The producer only ever advances the head,
+/// and the consumer only ever advances the tail, so each side publishes its
+/// progress with a single release store. Each side also keeps its own copy
+/// of the other side's index, and only reloads it when the copy says the
+/// ring is full or empty, to keep the shared cache lines quiet.
+///
+/// Neither side waits. Samples written while the ring is full are dropped,
+/// and counted as overrun, and samples asked for while it is empty are
+/// counted as underrun.
+class AudioRing {
+  public:
+    /// Build a ring holding at least the given number of samples.
+    /// \param capacity Minimum capacity, rounded up to a power of two.
+    explicit AudioRing(std::size_t capacity);
+
+    /// AudioRings cannot be copied.
+    AudioRing(const AudioRing&) = delete;
+    /// AudioRings cannot be copy assigned.
+    AudioRing& operator=(const AudioRing&) = delete;
+
+    /// Destroy an AudioRing.
+    ~AudioRing() {}
+
+    /// Write samples to the ring. Only the producer thread may call this.
+    /// \param samples The samples to write.
+    /// \param count Number of samples.
+    /// \returns The number of samples written, less than count if the ring
+    /// filled up.
+    std::size_t write(const std::int16_t* samples, std::size_t count);
+
+    /// Read samples from the ring. Only the consumer thread may call this.
+    /// \param samples Receives the samples.
+    /// \param count Number of samples wanted.
+    /// \returns The number of samples read, less than count if the ring ran
+    /// dry.
+    std::size_t read(std::int16_t* samples, std::size_t count);
+
+    /// Get the number of samples the ring holds.
+    /// \returns The number of samples written but not yet read.
+    inline std::size_t getFillCount() const;
+
+    /// Get how full the ring is.
+    /// \returns The fill level, from 0 to 1.
+    inline double getFillLevel() const;
+
+    /// Get the number of samples the ring can hold.
+    /// \returns The capacity.
+    inline std::size_t getCapacity() const;
+
+    /// Get the number of samples dropped because the ring was full.
+    /// \returns The number of overrun samples.
+    inline std::uint64_t getOverrunCount() const;
+
+    /// Get the number of samples asked for while the ring was empty.
+    /// \returns The number of underrun samples.
+    inline std::uint64_t getUnderrunCount() const;
+
+  private:
+    /// The samples.
+    std::vector<std::int16_t> buffer;
+    /// Capacity less one, to wrap indices with.
+    std::size_t mask;
+    /// Number of samples ever written.
+    alignas(64) std::atomic<std::size_t> head;
+    /// The producer's copy of the tail.
+    std::size_t producerTail;
+    /// Number of samples dropped.
+    std::atomic<std::uint64_t> overrunCount;
+    /// Number of samples ever read.
+    alignas(64) std::atomic<std::size_t> tail;
+    /// The consumer's copy of the head.
+    std::size_t consumerHead;
+    /// Number of samples missed.
+    std::atomic<std::uint64_t> underrunCount;
+};
+
+std::size_t AudioRing::getFillCount() const {
+  // Load the tail first, so that the head is never behind it.
+  std::size_t tailIndex = tail.load(std::memory_order_acquire);
+  return head.load(std::memory_order_acquire) - tailIndex;
+}
+
+double AudioRing::getFillLevel() const {
+  return static_cast<double>(getFillCount()) / buffer.size();
+}
+
+std::size_t AudioRing::getCapacity() const {
+  return buffer.size();
+}
+
+std::uint64_t AudioRing::getOverrunCount() const {
+  return overrunCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AudioRing::getUnderrunCount() const {
+  return underrunCount.load(std::memory_order_relaxed);
+}
+
+} // namespace Nes
+
+#endif // NES_AUDIO_RING_H //:~
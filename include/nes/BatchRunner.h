@@ -0,0 +1,201 @@
+//===-- include/nes/BatchRunner.h - Batch of Consoles -----------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::BatchRunner class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_BATCH_RUNNER_H
+#define NES_BATCH_RUNNER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "nes/Console.h"
+
+namespace Nes {
+
+/// \class BatchRunner
+/// \brief This class owns a batch of independent Consoles, and runs a frame
+/// of every one of them at once on a pool of threads.
+///
+/// Each thread has a home block of Consoles, which it builds, so that their
+/// memory is first touched, and so placed, on the NUMA node of the core the
+/// thread is pinned to. Each frame a thread runs its home block from the
+/// front, and once it runs out, steals the back half of the Consoles left in
+/// another thread's block. A block is a range of indices packed into one
+/// atomic word, so taking a Console, or stealing, is a single compare and
+/// swap, and no lock is taken until the thread is out of work.
+class BatchRunner {
+  public:
+    /// Builds the Console at an index of the batch. Called on the thread the
+    /// Console is homed on, so it must be safe to call from several threads.
+    using Factory = std::function<std::unique_ptr<Console>(std::size_t index)>;
+
+    /// Build a batch of Consoles and the threads to run them.
+    /// \param consoleCount Number of Consoles.
+    /// \param factory Builds each Console.
+    /// \param threadCount Number of threads, or 0 for one for each core.
+    /// \throws Any exception thrown by the factory.
+    BatchRunner(std::size_t consoleCount, const Factory& factory, std::size_t threadCount = 0);
+
+    /// BatchRunners cannot be copied.
+    BatchRunner(const BatchRunner&) = delete;
+    /// BatchRunners cannot be copy assigned.
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    /// Stop the threads.
+    ~BatchRunner();
+
+    /// Run a frame of every Console, returning once they are all done. Only
+    /// the frame is run: nothing draws or takes audio, so factories usually
+    /// build their Consoles with a headless Ppu and Apu, or the caller takes
+    /// each Console's samples with Apu::endFrame between frames.
+    /// \throws The first exception thrown running a Console. The other
+    /// Consoles still run their frames.
+    void runFrame();
+
+    /// Run a task on every Console at once, spread over the threads as
+    /// frames are, returning once it is done for all of them.
+    /// \param task The task, given the index of a Console. It must be safe to
+    /// call from several threads.
+    /// \throws The first exception thrown by the task. It still runs for the
+    /// other Consoles.
+    void forEach(const std::function<void(std::size_t)>& task);
+
+    /// Get a Console of the batch. Consoles must not be used while a frame
+    /// is running.
+    /// \param index Index of the Console.
+    /// \returns Reference to the Console.
+    inline Console& getConsole(std::size_t index);
+
+    /// Get the number of Consoles in the batch.
+    /// \returns The number of Consoles.
+    inline std::size_t getConsoleCount() const;
+
+    /// Get the number of threads running the batch.
+    /// \returns The number of threads.
+    inline std::size_t getThreadCount() const;
+
+    /// Get the number of Console frames run per second, over every call to
+    /// runFrame so far.
+    /// \returns The aggregate frame rate.
+    inline double getFramesPerSecond() const;
+
+    /// Get the number of times a thread has stolen Consoles from another.
+    /// \returns The number of steals.
+    inline std::uint64_t getStealCount() const;
+
+  private:
+    /// A block of Console indices, packed as the first index in the low 32
+    /// bits and the end in the high 32 bits. Blocks are padded to a cache
+    /// line apart, so threads taking from their own blocks do not contend.
+    struct Block {
+      /// The packed indices.
+      std::atomic<std::uint64_t> range;
+      /// Padding to the next block.
+      byte padding[64 - sizeof(std::atomic<std::uint64_t>)];
+    };
+
+    /// Stop the threads.
+    void stop();
+
+    /// Body of a thread.
+    /// \param index Index of the thread.
+    void work(std::size_t index);
+
+    /// Run a task on every thread, for every Console, and wait for it.
+    /// \param task The task, given the index of a Console.
+    void dispatch(const std::function<void(std::size_t)>& task);
+
+    /// Run the current task on a thread's block, and then on stolen
+    /// Consoles, until there are none left.
+    /// \param index Index of the thread.
+    void runTask(std::size_t index);
+
+    /// Take the first Console of a block.
+    /// \param block The block.
+    /// \param console Receives the index of the Console.
+    /// \returns True if the block had a Console left.
+    static bool take(Block& block, std::size_t& console);
+
+    /// Steal the back half of the Consoles left in another block.
+    /// \param victim The block to steal from.
+    /// \param thief The empty block of the thread stealing.
+    /// \returns True if any Consoles were stolen.
+    static bool steal(Block& victim, Block& thief);
+
+    /// Pack a range of indices.
+    static inline std::uint64_t pack(std::uint64_t first, std::uint64_t end);
+
+    /// The Consoles.
+    std::vector<std::unique_ptr<Console>> consoles;
+    /// The block of Consoles of each thread.
+    std::unique_ptr<Block[]> blocks;
+    /// The threads.
+    std::vector<std::thread> threads;
+    /// Number of steals.
+    std::atomic<std::uint64_t> stealCount;
+    /// Number of frames run on all Consoles.
+    std::uint64_t frameCount;
+    /// Total time spent running frames, in seconds.
+    double frameTime;
+
+    /// Guards everything below.
+    std::mutex mutex;
+    /// Signalled when a task is started, or the threads are stopped.
+    std::condition_variable taskStarted;
+    /// Signalled when the last thread finishes a task.
+    std::condition_variable taskDone;
+    /// The current task.
+    const std::function<void(std::size_t)>* task;
+    /// Number of tasks started.
+    std::uint64_t taskNumber;
+    /// Number of threads still running the current task.
+    std::size_t pendingThreads;
+    /// First exception thrown by the current task.
+    std::exception_ptr error;
+    /// Set when the threads should stop.
+    bool stopping;
+};
+
+Console& BatchRunner::getConsole(std::size_t index) {
+  return *consoles[index];
+}
+
+std::size_t BatchRunner::getConsoleCount() const {
+  return consoles.size();
+}
+
+std::size_t BatchRunner::getThreadCount() const {
+  return threads.size();
+}
+
+double BatchRunner::getFramesPerSecond() const {
+  return frameTime > 0.0 ? frameCount * consoles.size() / frameTime : 0.0;
+}
+
+std::uint64_t BatchRunner::getStealCount() const {
+  return stealCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t BatchRunner::pack(std::uint64_t first, std::uint64_t end) {
+  return first | end << 32;
+}
+
+} // namespace Nes
+
+#endif // NES_BATCH_RUNNER_H //:~
@@ -13,12 +13,15 @@
 #ifndef NES_CARTRIDGE_H
 #define NES_CARTRIDGE_H
 
+#include <memory>
 #include <vector>
 
 #include "common/CommonTypes.h"
+#include "memory/Arena.h"
 #include "memory/Mapper.h"
 #include "memory/Ram.h"
 #include "memory/Rom.h"
+#include "nes/CartridgeMapper.h"
 
 
 namespace Nes {
@@ -56,7 +59,11 @@ struct CartridgeOptions {
 
 /// \class Cartridge
 /// \brief This class represents an Nes cartridge. It contains all cartridge
-/// specific information related to the game being emulated.
+/// specific information related to the game being emulated. The PRG RAM and
+/// CHR RAM banks of the cartridge view one contiguous memory arena of its
+/// own. The PRG ROM and CHR ROM banks view images interned in the RomStore,
+/// shared by every cartridge of the same game. Banks of the same kind are laid
+/// out back to back so that bank switched windows may span them.
 class Cartridge {
   /// CartridgeBuilder is a friend of the Cartridge. Cartridges can only be
   /// built by the cartridge builder.
@@ -73,9 +80,33 @@ class Cartridge {
     /// \returns Reference to this Cartridge.
     Cartridge& operator=(Cartridge&& otherCartridge);
 
+    /// Build a copy of this cartridge, sharing its ROM. The copy has RAM and
+    /// a mapper of its own, as at power on; copy them over by loading a
+    /// saved state.
+    /// \returns The copy.
+    std::unique_ptr<Cartridge> clone() const;
+
     /// Get the memory mapper for this cartridge.
     /// \returns Reference to the contained memory mapper.
-    inline const Memory::Mapper<byte>& getMapper() const;
+    inline const CartridgeMapper& getMapper() const;
+
+    /// Get the memory mapper for this cartridge.
+    /// \returns Reference to the contained memory mapper.
+    inline CartridgeMapper& getMapper();
+
+    /// Get a hash of the PRG ROM and CHR ROM, which saved states refer to
+    /// the ROM by.
+    /// \returns The 64 bit FNV-1a hash of PRG ROM followed by CHR ROM.
+    inline std::uint64_t getRomHash() const;
+
+    /// Write PRG RAM and the mapper state to a saved state. CHR RAM belongs
+    /// to the Ppu's state, and ROM is only referred to by its hash.
+    /// \param writer The state being written.
+    void saveState(Structure::StateWriter& writer) const;
+
+    /// Read PRG RAM and the mapper state from a saved state.
+    /// \param reader The state being read.
+    void loadState(Structure::StateReader& reader);
 
   private:
     /// Number of bytes in a 512 byte object
@@ -89,26 +120,62 @@ class Cartridge {
     /// by the CartridgeBuilder.
     explicit Cartridge(CartridgeOptions options, const std::vector<byte>& romFile);
 
+    /// Build a copy of a cartridge for clone.
+    /// \param source The cartridge to copy.
+    /// \param trainerData The trainer of the cartridge, if it has one.
+    Cartridge(const Cartridge& source, const byte* trainerData);
+
+    /// Build the banks and mapper of the cartridge, once its options and ROM
+    /// images are set.
+    /// \param trainerData The 512 byte trainer, if the cartridge has one.
+    void build(const byte* trainerData);
+
+    /// The options the cartridge was built with.
+    CartridgeOptions options;
+
     /// The memory mapper for this cartridge.
-    std::unique_ptr<Memory::Mapper<byte>> mapperPtr;  
+    std::unique_ptr<CartridgeMapper> mapperPtr;  
+
+    /// The storage for the RAM banks and trainer of this cartridge, laid out
+    /// back to back.
+    Memory::Arena<byte> arena;
+
+    /// The shared image the PRG ROM banks view.
+    std::shared_ptr<const Memory::Arena<byte>> prgImage;
+
+    /// The shared image the CHR ROM banks view. Null without CHR ROM.
+    std::shared_ptr<const Memory::Arena<byte>> chrImage;
 
     /// The array of PRG RAMs for this cartridge.
-    std::vector<std::shared_ptr<Memory::Ram<byte>>> prgRams;
+    std::vector<Memory::Ram<byte>> prgRams;
 
     /// The array of PRG ROMs for this cartridge.
-    std::vector<std::shared_ptr<Memory::Rom<byte>>> prgRoms;
+    std::vector<Memory::Rom<byte>> prgRoms;
 
     /// The array of CHR ROMs for this cartdige.
-    std::vector<std::shared_ptr<Memory::Rom<byte>>> chrRoms;
+    std::vector<Memory::Rom<byte>> chrRoms;
 
-    /// 512 byte trainer.
-    std::shared_ptr<Memory::Rom<byte>> trainer;
+    /// The 8kB CHR RAM of cartridges without CHR ROM. Empty otherwise.
+    std::vector<Memory::Ram<byte>> chrRams;
+
+    /// 512 byte trainer. Empty if the cartridge has no trainer.
+    Memory::Rom<byte> trainer;
+    /// Hash of PRG ROM and CHR ROM.
+    std::uint64_t romHash;
 };
 
-const Memory::Mapper<byte>& Cartridge::getMapper() const {
+const CartridgeMapper& Cartridge::getMapper() const {
   return *mapperPtr;
 }
 
+CartridgeMapper& Cartridge::getMapper() {
+  return *mapperPtr;
+}
+
+std::uint64_t Cartridge::getRomHash() const {
+  return romHash;
+}
+
 } // namespace Nes
 
 #endif // NES_CARTRIDGE_H //
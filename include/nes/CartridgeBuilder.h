@@ -49,9 +49,9 @@ class CartridgeBuilder : public Pattern::Builder<Cartridge>{
 
   private:
     /// The number of bytes in the iNES file header.
-    static constexpr const std::size_t& INES_HEADER_SIZE = 16;
+    static constexpr const std::size_t INES_HEADER_SIZE = 16;
     /// The array of bytes designating the .nes format: NES^Z
-    static constexpr const std::array<byte, 4>& NES_TOKEN 
+    static constexpr const std::array<byte, 4> NES_TOKEN
       = { {0x4E, 0x45, 0x53, 0x1A} };
     
     /// Read the iNES file header of the input file and convert these
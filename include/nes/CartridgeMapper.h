@@ -13,106 +13,390 @@
 #ifndef NES_CARTRIDGE_MAPPER_H
 #define NES_CARTRIDGE_MAPPER_H
 
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
 #include "memory/Mapper.h"
 #include "memory/Ram.h"
 #include "memory/Rom.h"
+#include "memory/Window.h"
 
 namespace Nes {
 // Forward Declarations
 class CartridgeMapperBuilder;
 
+/// \brief Nametable mirroring arrangements selectable by a cartridge.
+enum class Mirroring {
+  /// $2000 and $2400 share a nametable, as do $2800 and $2C00.
+  HORIZONTAL,
+  /// $2000 and $2800 share a nametable, as do $2400 and $2C00.
+  VERTICAL,
+  /// Every nametable is the lower nametable.
+  SINGLE_SCREEN_LOWER,
+  /// Every nametable is the upper nametable.
+  SINGLE_SCREEN_UPPER,
+  /// The cartridge provides four distinct nametables.
+  FOUR_SCREEN
+};
+
 /// \class CartridgeMapper
 /// \brief This class represents a memory mapper from an Nes Cartridge. This
 /// base class contains the common elements between the more specific 
+/// mappers. PRG ROM space ($8000-$FFFF) and CHR space ($0000-$1FFF on the PPU)
+/// are each divided into equally sized bank switched windows. The page tables
+/// map addresses to windows and are fixed once the windows are configured, so
+/// switching a bank only repoints the window and costs the same regardless of
+/// the size of the cartridge.
 class CartridgeMapper : public Memory::Mapper<byte> {
   /// CartridgeMapperBuilder is a friend of the CartridgeMapper. CartridgeMappers
   /// can only be built by the CartridgeMapperBuilder.
   friend CartridgeMapperBuilder;
 
   public:
+    /// CartridgeMappers cannot be copied, as their windows call back into them.
+    CartridgeMapper(const CartridgeMapper&) = delete;
+    /// CartridgeMappers cannot be copy assigned.
+    CartridgeMapper& operator=(const CartridgeMapper&) = delete;
+
     /// Destroy a CartridgeMapper
-    ~CartridgeMapper() {}
+    virtual ~CartridgeMapper() {}
+
+    /// Number of address bits spanned by one page of the page tables.
+    static constexpr const std::size_t PAGE_BITS = 10;
+
+    /// Number of pages in the Cpu address space.
+    static constexpr const std::size_t NUM_PAGES = 0x10000 >> PAGE_BITS;
+
+    /// Number of pages in the PPU pattern table space.
+    static constexpr const std::size_t NUM_CHR_PAGES = 0x2000 >> PAGE_BITS;
+
+    /// Map an address from the Cpu to a piece of hardware in the Cartridge.
+    /// \param vaddr Virtual address from the Cpu.
+    /// \returns Pointer to the hardware on the Cartridge, or nullptr if
+    /// nothing on the Cartridge is mapped to the address.
+    inline Memory::Bank<byte>* mapToHardware(Vaddr vaddr) const final;
+
+    /// Map a pattern table address from the PPU to CHR memory.
+    /// \param vaddr Virtual address from the PPU, $0000-$1FFF.
+    /// \returns Pointer to the CHR window holding the address.
+    inline Memory::Bank<byte>* mapChrToHardware(Vaddr vaddr) const;
+
+    /// Get the page table of the Cpu address space. Entries do not change
+    /// once the mapper is built, so they may be watched by address.
+    /// \returns The page table, indexed by address >> PAGE_BITS.
+    inline const std::array<Memory::Bank<byte>*, NUM_PAGES>& getPageTable() const;
+
+    /// Get the current nametable mirroring.
+    /// \returns The nametable mirroring.
+    inline Mirroring getMirroring() const;
+
+    /// Check whether the CHR windows are backed by CHR RAM. Writes to CHR ROM
+    /// are ignored by the hardware.
+    /// \returns true if CHR memory can be written.
+    inline bool isChrWritable() const;
+
+    /// Get the offset into CHR memory of the byte a Ppu pattern table address
+    /// is mapped to. Offsets do not change when a bank is mapped elsewhere, so
+    /// they can key caches of CHR data.
+    /// \param address Ppu pattern table address, $0000-$1FFF.
+    /// \returns Offset from the start of CHR memory.
+    inline std::size_t getChrOffset(addr address) const;
+
+    /// Get the CHR memory, the start of every CHR ROM or CHR RAM bank laid
+    /// out back to back.
+    /// \returns Bank at the start of CHR memory.
+    inline const Memory::Bank<byte>& getChrMemory() const;
+
+    /// Get the CHR memory, the start of every CHR ROM or CHR RAM bank laid
+    /// out back to back.
+    /// \returns Bank at the start of CHR memory.
+    inline Memory::Bank<byte>& getChrMemory();
+
+    /// Get a count of the changes to CHR banking and mirroring, so that
+    /// copies of them can tell when they are stale.
+    /// \returns The number of CHR bank switches and mirroring changes.
+    inline std::size_t getChrGeneration() const;
+
+    /// Get the size of CHR memory.
+    /// \returns Number of bytes of CHR ROM or CHR RAM.
+    inline std::size_t getChrSize() const;
+
+    /// Clock the scanline counter of mappers that have one. The PPU calls this
+    /// once per rendered scanline.
+    virtual void clockScanline() {}
+
+    /// Check if the mapper is asserting the Cpu IRQ line.
+    /// \returns True if an IRQ is pending.
+    virtual bool isIrqAsserted() const {
+      return false;
+    }
+
+    /// Write the bank mapped into each window, the mirroring and the mapper
+    /// registers to a saved state.
+    /// \param writer The state being written.
+    void saveState(Structure::StateWriter& writer) const;
+
+    /// Read the bank mapped into each window, the mirroring and the mapper
+    /// registers from a saved state, and map the banks.
+    /// \param reader The state being read.
+    void loadState(Structure::StateReader& reader);
 
   protected:
-    /// Build a CartridgeMapper.
+    /// Build a CartridgeMapper. The first PRG RAM, if any, is mapped at $6000.
     /// \param prgRams The array of PRG RAMs from the containing cartridge.
     /// \param prgRoms The array of PRG ROMs from the containing cartridge.
     /// \param chrRoms The array of CHR ROMs from the containing cartridge.
+    /// \param chrRams The array of CHR RAMs from the containing cartridge.
+    /// \param mirroring The nametable mirroring wired on the cartridge.
     CartridgeMapper(
-        std::vector<std::shared_ptr<Memory::Ram<byte>>>& prgRams,
-        std::vector<std::shared_ptr<Memory::Rom<byte>>>& prgRoms,
-        std::vector<std::shared_ptr<Memory::Rom<byte>>>& chrRoms
+        std::vector<Memory::Ram<byte>>& prgRams,
+        std::vector<Memory::Rom<byte>>& prgRoms,
+        std::vector<Memory::Rom<byte>>& chrRoms,
+        std::vector<Memory::Ram<byte>>& chrRams,
+        Mirroring mirroring
         );
 
-    /// Get the currently loaded PRG RAM.
-    /// \returns The loaded PRG RAM.
-    std::weak_ptr<Memory::Ram<byte>> getPrgRam() const;
-
-    /// Set the currently loaded PRG RAM.
-    /// \param index Index into the RAM array.
-    void setPrgRam(std::size_t index);
-    
-    /// Get the currently loaded lower PRG ROM.
-    /// \returns The loaded lower PRG ROM.
-    std::weak_ptr<Memory::Rom<byte>> getLowerPrgRom() const;
-
-    /// Set the currently loaded lower PRG ROM.
-    /// \param index Index into the ROM array.
-    void setLowerPrgRom(std::size_t index);
-    
-    /// Get the currently loaded upper PRG ROM.
-    /// \returns The loaded upper PRG ROM.
-    std::weak_ptr<Memory::Rom<byte>> getUpperPrgRom() const;
-
-    /// Set the currently loaded upper PRG ROM.
-    /// \param index Index into the ROM array.
-    void setUpperPrgRom(std::size_t index);
-    
+    /// Divide PRG ROM space into windows of the given size. Every window
+    /// starts out mapped to bank 0. This may only be called once.
+    /// \param windowSize Window size in bytes, a power of 2 from 1kB to 32kB.
+    /// \throws Exception::MemoryException if the window size is invalid.
+    void configurePrgRom(std::size_t windowSize);
+
+    /// Divide CHR space into windows of the given size, backed by CHR ROM, or
+    /// by CHR RAM if the cartridge has no CHR ROM. Every window starts out
+    /// mapped to bank 0. This may only be called once.
+    /// \param windowSize Window size in bytes, a power of 2 from 1kB to 8kB.
+    /// \throws Exception::MemoryException if the window size is invalid.
+    void configureChr(std::size_t windowSize);
+
+    /// Switch a PRG ROM bank into a window.
+    /// \param window Index of the window, counting up from $8000.
+    /// \param bank Index of the bank in units of the window size. Banks past
+    /// the end of PRG ROM wrap around.
+    inline void mapPrgRom(std::size_t window, std::size_t bank);
+
+    /// Switch a CHR bank into a window.
+    /// \param window Index of the window, counting up from $0000.
+    /// \param bank Index of the bank in units of the window size. Banks past
+    /// the end of CHR memory wrap around.
+    inline void mapChr(std::size_t window, std::size_t bank);
+
+    /// Get the number of PRG ROM banks the size of a PRG ROM window.
+    /// \returns The number of PRG ROM banks.
+    inline std::size_t getPrgRomBankCount() const;
+
+    /// Get the number of CHR banks the size of a CHR window.
+    /// \returns The number of CHR banks.
+    inline std::size_t getChrBankCount() const;
+
+    /// Set the nametable mirroring.
+    /// \param mirroring The new nametable mirroring.
+    inline void setMirroring(Mirroring mirroring);
+
+    /// Handle a Cpu write to PRG ROM space. Mappers with registers override
+    /// this, the default treats the write as a write to ROM.
+    /// \param vaddr Address written, $8000-$FFFF.
+    /// \param data Data written.
+    /// \throws Exception::ReadOnlyMemoryException unless overridden.
+    virtual void writeRegister(Vaddr vaddr, byte data);
+
+    /// Write the registers of the mapper to a saved state. Mappers with
+    /// registers beyond their bank numbers override this.
+    /// \param writer The state being written.
+    virtual void saveRegisters(Structure::StateWriter& writer) const {}
+
+    /// Read the registers of the mapper from a saved state. The banks and
+    /// mirroring have already been restored.
+    /// \param reader The state being read.
+    virtual void loadRegisters(Structure::StateReader& reader) {}
+
     /// Get the internal reference to the PRG RAM array.
     /// \returns The internal reference to the PRG RAM array.
-    std::vector<std::shared_ptr<Memory::Ram<byte>>>& getPrgRams();
+    std::vector<Memory::Ram<byte>>& getPrgRams();
 
     /// Get the internal reference to the PRG ROM array.
     /// \returns The internal reference to the PRG ROM array.
-    std::vector<std::shared_ptr<Memory::Rom<byte>>>& getPrgRoms();
+    std::vector<Memory::Rom<byte>>& getPrgRoms();
 
     /// Get the internal reference to the CHR ROM array.
     /// \returns The internal reference to the CHR ROM array.
-    std::vector<std::shared_ptr<Memory::Rom<byte>>>& getChrRoms();
+    std::vector<Memory::Rom<byte>>& getChrRoms();
+
+    /// Get the internal reference to the CHR RAM array.
+    /// \returns The internal reference to the CHR RAM array.
+    std::vector<Memory::Ram<byte>>& getChrRams();
 
   private:
     /// The base address reserved for PRG RAM.
-    static constexpr const Vaddr& PRG_RAM_ADDR = {0x6000};
+    static constexpr const addr PRG_RAM_ADDR = 0x6000;
 
-    /// The base address reserved for Lower PRG ROM.
-    static constexpr const Vaddr& LOWER_PRG_ROM_ADDR = {0x8000};
+    /// Size of the window reserved for PRG RAM.
+    static constexpr const std::size_t PRG_RAM_SIZE = 0x2000;
 
-    /// The base address reserved for Upper PRG ROM.
-    static constexpr const Vaddr& UPPER_PRG_ROM_ADDR = {0xC000};
+    /// The base address of PRG ROM space.
+    static constexpr const addr PRG_ROM_ADDR = 0x8000;
 
-    /// The PRG RAM currently at base address 0x6000.
-    std::weak_ptr<Memory::Ram<byte>> prgRam;
+    /// Size of PRG ROM space.
+    static constexpr const std::size_t PRG_ROM_SPACE = 0x8000;
 
-    /// The PRG ROM currently as base address 0x8000.
-    std::weak_ptr<Memory::Rom<byte>> lowerPrgRom;
+    /// Size of CHR space.
+    static constexpr const std::size_t CHR_SPACE = 0x2000;
 
-    /// The CHR ROM currently as base address 0xC000.
-    std::weak_ptr<Memory::Rom<byte>> upperPrgRom;
+    /// Smallest supported window size.
+    static constexpr const std::size_t MIN_WINDOW_SIZE = 0x400;
+
+    /// Build equally sized windows over a space and point the pages of the
+    /// space at them.
+    /// \param windows The windows to build.
+    /// \param pages The first page of the space.
+    /// \param baseAddress The base address of the space.
+    /// \param spaceSize The size of the space.
+    /// \param windowSize The size of each window.
+    /// \param regionSize The size of the memory switched through the windows.
+    /// \throws Exception::MemoryException if the window size is invalid.
+    static void buildWindows(
+        std::vector<Memory::Window<byte>>& windows,
+        Memory::Bank<byte>** pages,
+        addr baseAddress,
+        std::size_t spaceSize,
+        std::size_t windowSize,
+        std::size_t regionSize);
+
+    /// The window mapped into each page of the Cpu address space.
+    std::array<Memory::Bank<byte>*, NUM_PAGES> pageTable;
+
+    /// The window mapped into each page of CHR space.
+    std::array<Memory::Bank<byte>*, NUM_CHR_PAGES> chrPageTable;
+
+    /// Offset into CHR memory of each page of the Ppu pattern tables.
+    std::array<std::size_t, NUM_CHR_PAGES> chrPageOffsets;
+
+    /// The PRG RAM window at $6000.
+    Memory::Window<byte> prgRamWindow;
+
+    /// The PRG ROM windows, from $8000 up.
+    std::vector<Memory::Window<byte>> prgRomWindows;
+
+    /// The CHR windows, from $0000 up.
+    std::vector<Memory::Window<byte>> chrWindows;
+
+    /// The bank mapped into each PRG ROM window.
+    std::vector<std::size_t> prgBanks;
+    /// The bank mapped into each CHR window.
+    std::vector<std::size_t> chrBanks;
+    /// The size of each PRG ROM window.
+    std::size_t prgRomWindowSize;
+
+    /// The number of PRG ROM banks the size of a window.
+    std::size_t prgRomBankCount;
+
+    /// The size of each CHR window.
+    std::size_t chrWindowSize;
+
+    /// The number of CHR banks the size of a window.
+    std::size_t chrBankCount;
+
+    /// The bank CHR windows switch through, the first CHR ROM or CHR RAM.
+    Memory::Bank<byte>* chrSource;
+
+    /// True if CHR windows are backed by RAM.
+    bool chrWritable;
+
+    /// The current nametable mirroring.
+    Mirroring mirroring;
+
+    /// Count of CHR bank switches and mirroring changes.
+    std::size_t chrGeneration;
 
     /// A reference to the PRG RAMs for this mappers Cartridge.
-    std::vector<std::shared_ptr<Memory::Ram<byte>>>& prgRams;
+    std::vector<Memory::Ram<byte>>& prgRams;
 
     /// A reference to the PRG ROMs for this mappers Cartridge.
-    std::vector<std::shared_ptr<Memory::Rom<byte>>>& prgRoms;
+    std::vector<Memory::Rom<byte>>& prgRoms;
 
     /// A reference to the CHR ROMs for this mappers Cartridge.
-    std::vector<std::shared_ptr<Memory::Rom<byte>>>& chrRoms;
+    std::vector<Memory::Rom<byte>>& chrRoms;
+
+    /// A reference to the CHR RAMs for this mappers Cartridge.
+    std::vector<Memory::Ram<byte>>& chrRams;
 
 };
 
+Memory::Bank<byte>* CartridgeMapper::mapToHardware(Vaddr vaddr) const {
+  return pageTable[vaddr.val >> PAGE_BITS];
+}
+
+Memory::Bank<byte>* CartridgeMapper::mapChrToHardware(Vaddr vaddr) const {
+  return chrPageTable[(vaddr.val >> PAGE_BITS) & (NUM_CHR_PAGES - 1)];
+}
+
+const std::array<Memory::Bank<byte>*, CartridgeMapper::NUM_PAGES>& CartridgeMapper::getPageTable() const {
+  return pageTable;
+}
+
+Mirroring CartridgeMapper::getMirroring() const {
+  return mirroring;
+}
+
+bool CartridgeMapper::isChrWritable() const {
+  return chrWritable;
+}
+
+std::size_t CartridgeMapper::getChrOffset(addr address) const {
+  return chrPageOffsets[(address >> PAGE_BITS) & (NUM_CHR_PAGES - 1)]
+      + (address & ((1 << PAGE_BITS) - 1));
+}
+
+const Memory::Bank<byte>& CartridgeMapper::getChrMemory() const {
+  return *chrSource;
+}
+
+Memory::Bank<byte>& CartridgeMapper::getChrMemory() {
+  return *chrSource;
+}
+
+std::size_t CartridgeMapper::getChrGeneration() const {
+  return chrGeneration;
+}
+
+std::size_t CartridgeMapper::getChrSize() const {
+  return chrBankCount * chrWindowSize;
+}
+
+void CartridgeMapper::mapPrgRom(std::size_t window, std::size_t bank) {
+  // The PRG ROM banks are contiguous in the cartridge arena, so the window
+  // can be pointed straight at its offset from the first bank.
+  prgBanks[window] = bank % prgRomBankCount;
+  prgRomWindows[window].map(prgRoms.front(), prgBanks[window] * prgRomWindowSize, false);
+}
+
+void CartridgeMapper::mapChr(std::size_t window, std::size_t bank) {
+  chrBanks[window] = bank % chrBankCount;
+  std::size_t offset = chrBanks[window] * chrWindowSize;
+  chrWindows[window].map(*chrSource, offset, chrWritable);
+  std::size_t pagesPerWindow = chrWindowSize >> PAGE_BITS;
+  for(std::size_t page = 0; page < pagesPerWindow; page++) {
+    chrPageOffsets[window * pagesPerWindow + page] = offset + (page << PAGE_BITS);
+  }
+  chrGeneration++;
+}
+
+std::size_t CartridgeMapper::getPrgRomBankCount() const {
+  return prgRomBankCount;
+}
+
+std::size_t CartridgeMapper::getChrBankCount() const {
+  return chrBankCount;
+}
+
+void CartridgeMapper::setMirroring(Mirroring mirroring) {
+  this->mirroring = mirroring;
+  chrGeneration++;
+}
+
 } // namespace Nes
 
 #endif // NES_CARTRIDGE_MAPPER_H //
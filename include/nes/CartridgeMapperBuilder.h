@@ -31,7 +31,13 @@ namespace Nes {
 class CartridgeMapperBuilder : public Pattern::Builder<CartridgeMapper>{
   public:
     /// Construct an empty CartridgeMapperBuilder.
-    CartridgeMapperBuilder() {}
+    CartridgeMapperBuilder() :
+      iNesIndex(0),
+      prgRamsPtr(nullptr),
+      prgRomsPtr(nullptr),
+      chrRomsPtr(nullptr),
+      chrRamsPtr(nullptr),
+      mirroring(Mirroring::HORIZONTAL) {}
 
     /// Destroy a CartridgeMapperBuilder.
     ~CartridgeMapperBuilder() {}
@@ -49,19 +55,30 @@ class CartridgeMapperBuilder : public Pattern::Builder<CartridgeMapper>{
     /// \param Reference to the vector of Ram to use.
     /// \returns This builder for chaining.
     CartridgeMapperBuilder& setPrgRams(
-        std::vector<std::shared_ptr<Memory::Ram<byte>>>* prgRamsPtr);
+        std::vector<Memory::Ram<byte>>* prgRamsPtr);
 
     /// Set the vector of PRG ROMS to build the mapper with.
     /// \param Reference to the vector of Rom to use.
     /// \returns This builder for chaining.
     CartridgeMapperBuilder& setPrgRoms(
-        std::vector<std::shared_ptr<Memory::Rom<byte>>>* prgRomsPtr);
+        std::vector<Memory::Rom<byte>>* prgRomsPtr);
 
     /// Set the vector of CHR ROMS to build the mapper with.
     /// \param Reference to the vector of Rom to use.
     /// \returns This builder for chaining.
     CartridgeMapperBuilder& setChrRoms(
-        std::vector<std::shared_ptr<Memory::Rom<byte>>>* chrRomsPtr);
+        std::vector<Memory::Rom<byte>>* chrRomsPtr);
+
+    /// Set the vector of CHR RAMS to build the mapper with.
+    /// \param Reference to the vector of Ram to use.
+    /// \returns This builder for chaining.
+    CartridgeMapperBuilder& setChrRams(
+        std::vector<Memory::Ram<byte>>* chrRamsPtr);
+
+    /// Set the nametable mirroring wired on the cartridge.
+    /// \param mirroring The nametable mirroring.
+    /// \returns This builder for chaining.
+    CartridgeMapperBuilder& setMirroring(Mirroring mirroring);
 
   private:
     /// Temporary storage for a constructed cartridge pointer.
@@ -71,13 +88,19 @@ class CartridgeMapperBuilder : public Pattern::Builder<CartridgeMapper>{
     std::size_t iNesIndex;
 
     /// A reference to the PRG RAMs for this mappers Cartridge.
-    std::vector<std::shared_ptr<Memory::Ram<byte>>>* prgRamsPtr;
+    std::vector<Memory::Ram<byte>>* prgRamsPtr;
 
     /// A reference to the PRG ROMs for this mappers Cartridge.
-    std::vector<std::shared_ptr<Memory::Rom<byte>>>* prgRomsPtr;
+    std::vector<Memory::Rom<byte>>* prgRomsPtr;
 
     /// A reference to the CHR ROMs for this mappers Cartridge.
-    std::vector<std::shared_ptr<Memory::Rom<byte>>>* chrRomsPtr;
+    std::vector<Memory::Rom<byte>>* chrRomsPtr;
+
+    /// A reference to the CHR RAMs for this mappers Cartridge.
+    std::vector<Memory::Ram<byte>>* chrRamsPtr;
+
+    /// The nametable mirroring wired on the cartridge.
+    Mirroring mirroring;
 
 };
 
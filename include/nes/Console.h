@@ -0,0 +1,183 @@
+//===-- include/nes/Console.h - Nes Console ---------------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Console class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_CONSOLE_H
+#define NES_CONSOLE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
+#include "nes/Apu.h"
+#include "nes/Cartridge.h"
+#include "nes/Controllers.h"
+#include "nes/Cpu2A03.h"
+#include "nes/CpuBus.h"
+#include "nes/Ppu.h"
+
+namespace Nes {
+
+/// \class Console
+/// \brief This class represents a whole Nes with a cartridge inserted. It owns
+/// the hardware and schedules it: the Cpu is stepped cycle by cycle, and the
+/// Ppu and Apu are only told how much time has passed. They are caught up
+/// when the Cpu touches their registers, or when they have an event due that
+/// the Cpu must see, such as an NMI or IRQ.
+class Console {
+  public:
+    /// Number of cycles the Cpu is halted for by OAM DMA, plus one if it
+    /// halts on an odd cycle.
+    static constexpr const std::size_t OAM_DMA_CYCLES = 513;
+    /// Version of the saved state layout, bumped whenever a field is added,
+    /// removed or moved.
+    static constexpr const std::uint32_t STATE_VERSION = 4;
+
+    /// Build a Console with the given cartridge inserted, and reset it.
+    /// \param cartridge The cartridge to insert.
+    explicit Console(std::unique_ptr<Cartridge> cartridge);
+
+    /// Consoles cannot be copied.
+    Console(const Console&) = delete;
+    /// Consoles cannot be copy assigned.
+    Console& operator=(const Console&) = delete;
+
+    /// Destroy a Console.
+    ~Console() {}
+
+    /// Reset the Console.
+    void reset();
+
+    /// Run one Cpu cycle, servicing any interrupt due before the next
+    /// instruction.
+    void step();
+
+    /// Run until the Ppu completes a frame.
+    void runFrame();
+
+    /// Save the whole machine into a flat binary state. The cartridge ROM is
+    /// not saved, only its hash, so a state only loads with the same ROM.
+    /// \param state Receives the state. It keeps its capacity, so saving
+    /// into the same buffer again does not allocate.
+    void saveState(std::vector<byte>& state);
+
+    /// Load the whole machine from a state saved by saveState. A state that is
+    /// rejected leaves the machine as it was.
+    /// \param state The state.
+    /// \throws Exception::InvalidFormatException if the state is not a saved
+    /// state of this version, or was saved with a different ROM.
+    /// \throws Exception::StructureException if the state is truncated.
+    void loadState(const std::vector<byte>& state);
+
+    /// Build a copy of the whole machine, which runs on exactly as this one
+    /// would. The copy shares this Console's ROM images and copies the rest
+    /// through a saved state. It has no framebuffer, but is headless if this
+    /// Console is, and holds the same buttons.
+    /// \returns The copy.
+    std::unique_ptr<Console> clone();
+
+    /// Get the inserted cartridge.
+    /// \returns Reference to the cartridge.
+    inline Cartridge& getCartridge();
+
+    /// Get the Cpu bus.
+    /// \returns Reference to the Cpu bus.
+    inline CpuBus& getBus();
+
+    /// Get the Ppu.
+    /// \returns Reference to the Ppu.
+    inline Ppu& getPpu();
+
+    /// Get the Apu.
+    /// \returns Reference to the Apu.
+    inline Apu& getApu();
+
+    /// Get the Cpu.
+    /// \returns Reference to the Cpu.
+    inline Cpu2A03& getCpu();
+
+    /// Get the controller ports.
+    /// \returns Reference to the controller ports.
+    inline Controllers& getControllers();
+
+  private:
+    /// Copy a page into OAM for a write to $4014, and halt the Cpu once the
+    /// writing instruction is done.
+    /// \param page The high byte of the addresses to copy from.
+    void writeOamDma(byte page);
+
+    /// Read the start of a saved state, checking it was saved by this version
+    /// for this ROM.
+    /// \param reader Reader at the start of the state.
+    /// \throws Exception::InvalidFormatException if the state does not match.
+    /// \throws Exception::StructureException if the state is truncated.
+    void readStateHeader(Structure::StateReader& reader);
+
+    /// Load the machine from the rest of a saved state, after its header.
+    /// \param reader Reader just past the header.
+    /// \throws Exception::InvalidFormatException if bytes are left over.
+    /// \throws Exception::StructureException if the state is truncated.
+    void readStateBody(Structure::StateReader& reader);
+
+    /// The inserted cartridge.
+    std::unique_ptr<Cartridge> cartridge;
+    /// The Cpu bus.
+    CpuBus bus;
+    /// The Ppu.
+    Ppu ppu;
+    /// The Apu.
+    Apu apu;
+    /// The Cpu.
+    Cpu2A03 cpu;
+    /// The controller ports.
+    Controllers controllers;
+    /// Number of Cpu cycles run.
+    std::uint64_t cycle;
+    /// Set when an OAM DMA has been started, and the Cpu is yet to halt.
+    bool dmaPending;
+    /// Number of cycles the Cpu is still halted for.
+    std::size_t stallCycles;
+    /// Scratch state for clone, kept to save without allocating.
+    std::vector<byte> cloneState;
+    /// The machine as it was before the state being loaded, put back if
+    /// that state is rejected partway through.
+    std::vector<byte> rollbackState;
+};
+
+Cartridge& Console::getCartridge() {
+  return *cartridge;
+}
+
+CpuBus& Console::getBus() {
+  return bus;
+}
+
+Ppu& Console::getPpu() {
+  return ppu;
+}
+
+Apu& Console::getApu() {
+  return apu;
+}
+
+Cpu2A03& Console::getCpu() {
+  return cpu;
+}
+
+Controllers& Console::getControllers() {
+  return controllers;
+}
+
+} // namespace Nes
+
+#endif // NES_CONSOLE_H //
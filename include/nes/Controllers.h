@@ -0,0 +1,103 @@
+//===-- include/nes/Controllers.h - Nes Controller Ports --------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Controllers class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_CONTROLLERS_H
+#define NES_CONTROLLERS_H
+
+#include <array>
+
+#include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
+#include "nes/CpuBus.h"
+
+namespace Nes {
+
+/// \class Controllers
+/// \brief This class represents the two controller ports, each with a
+/// standard controller plugged in. Writing bit 0 of $4016 strobes both
+/// controllers, latching their buttons into shift registers, which $4016 and
+/// $4017 then read out a button at a time, in the order of the Button bits.
+class Controllers {
+  public:
+    /// Bits of the button state of a controller.
+    enum Button : byte {
+      A = 0x01,
+      B = 0x02,
+      SELECT = 0x04,
+      START = 0x08,
+      UP = 0x10,
+      DOWN = 0x20,
+      LEFT = 0x40,
+      RIGHT = 0x80
+    };
+
+    /// Number of controller ports.
+    static constexpr const std::size_t PORTS = 2;
+
+    /// Build the ports with no buttons held.
+    Controllers();
+
+    /// Controllers cannot be copied, as the bus handlers point at them.
+    Controllers(const Controllers&) = delete;
+    /// Controllers cannot be copy assigned.
+    Controllers& operator=(const Controllers&) = delete;
+
+    /// Attach the controller registers to their addresses on the Cpu bus.
+    /// \param bus The Cpu bus.
+    void connect(CpuBus& bus);
+
+    /// Set the buttons held on a controller.
+    /// \param port The port of the controller, 0 or 1.
+    /// \param buttons The Button bits held.
+    inline void setButtons(std::size_t port, byte buttons);
+
+    /// Get the buttons held on a controller.
+    /// \param port The port of the controller, 0 or 1.
+    /// \returns The Button bits held.
+    inline byte getButtons(std::size_t port) const;
+
+    /// Write the strobe and shift registers to a saved state. The buttons
+    /// held are input, not state, and are not saved.
+    /// \param writer The state being written.
+    void saveState(Structure::StateWriter& writer);
+
+    /// Read the strobe and shift registers from a saved state.
+    /// \param reader The state being read.
+    void loadState(Structure::StateReader& reader);
+
+  private:
+    /// Read the next button of a controller.
+    /// \param port The port of the controller.
+    /// \returns The button in bit 0, over the open bus bits.
+    byte readPort(std::size_t port);
+
+    /// The buttons held on each controller.
+    std::array<byte, PORTS> buttons;
+    /// The buttons left to read from each controller, next in bit 0.
+    std::array<byte, PORTS> shifters;
+    /// Number of buttons read from each controller since the last strobe.
+    std::array<byte, PORTS> readCounts;
+    /// Set while the strobe bit is held, reloading the shift registers.
+    bool strobe;
+};
+
+void Controllers::setButtons(std::size_t port, byte buttons) {
+  this->buttons[port] = buttons;
+}
+
+byte Controllers::getButtons(std::size_t port) const {
+  return buttons[port];
+}
+
+} // namespace Nes
+
+#endif // NES_CONTROLLERS_H //:~
@@ -0,0 +1,34 @@
+//===-- include/nes/Cpu2A03.h - Nes Cpu -------------------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//  
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Cpu2A03 type, the Mos6502 core of the Nes.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_CPU_2A03_H
+#define NES_CPU_2A03_H
+
+#include "cpu/interpreter/InterpretedMos6502.h"
+#include "nes/CpuBus.h"
+
+namespace Nes {
+
+/// The Ricoh 2A03 Cpu of the Nes, an interpreted Mos6502 instantiated on the
+/// CpuBus. Every memory access resolves through the CpuBus page table at
+/// compile time instead of through the virtual Memory::Mapper interface. The
+/// bus flattens every cartridge mapper into that page table, so one
+/// instantiation serves all of them.
+using Cpu2A03 = Cpu::InterpretedMos6502Core<CpuBus>;
+
+} // namespace Nes
+
+extern template class Cpu::Mos6502MmuCore<Nes::CpuBus>;
+extern template class Cpu::Mos6502Core<Nes::CpuBus>;
+extern template class Cpu::InterpretedMos6502Core<Nes::CpuBus>;
+
+#endif // NES_CPU_2A03_H //
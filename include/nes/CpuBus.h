@@ -0,0 +1,156 @@
+//===-- include/nes/CpuBus.h - Nes Cpu Address Bus --------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//  
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::CpuBus class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_CPU_BUS_H
+#define NES_CPU_BUS_H
+
+#include <array>
+
+#include "common/CommonTypes.h"
+#include "memory/Bank.h"
+#include "memory/IoPort.h"
+#include "memory/Mapper.h"
+#include "memory/Ram.h"
+#include "nes/Cartridge.h"
+#include "nes/CartridgeMapper.h"
+
+namespace Nes {
+
+/// \class CpuBus
+/// \brief This class represents the Nes Cpu address bus, mapping the whole
+/// $0000-$FFFF address space to hardware. The bus owns the 2kB internal RAM
+/// and the PPU and APU/IO register ports, and delegates cartridge space to the
+/// CartridgeMapper. Every 256 byte page of the address space is resolved
+/// through one precomputed page table.
+class CpuBus : public Memory::Mapper<byte> {
+  public:
+    /// Build a CpuBus with the given cartridge inserted.
+    /// \param cartridge The cartridge to map into cartridge space.
+    explicit CpuBus(const Cartridge& cartridge);
+
+    /// CpuBuses cannot be copied, as the page table points into the bus.
+    CpuBus(const CpuBus&) = delete;
+    /// CpuBuses cannot be copy assigned.
+    CpuBus& operator=(const CpuBus&) = delete;
+
+    /// Destroy a CpuBus.
+    ~CpuBus() {}
+
+    /// Get the name of this Mapper.
+    /// \returns CpuBus
+    const std::string getName() const override {
+      return "CpuBus";
+    }
+
+    /// Map an address from the Cpu to a piece of hardware on the bus.
+    /// Unmapped addresses map to an open bus latch.
+    /// \param vaddr Virtual address from the Cpu.
+    /// \returns Pointer to the hardware on the bus.
+    inline Memory::Bank<byte>* mapToHardware(Vaddr vaddr) const final;
+
+    /// Set the handler called when the I/O register at the given address is
+    /// read.
+    /// \param vaddr Address of a PPU ($2000-$3FFF) or APU/IO ($4000-$401F)
+    /// register.
+    /// \param handler Handler to call.
+    /// \throws Exception::MemoryException if the address is not an I/O register.
+    void setReadHandler(Vaddr vaddr, Memory::IoPort<byte>::ReadHandler handler);
+
+    /// Set the handler called when the I/O register at the given address is
+    /// written.
+    /// \param vaddr Address of a PPU ($2000-$3FFF) or APU/IO ($4000-$401F)
+    /// register.
+    /// \param handler Handler to call.
+    /// \throws Exception::MemoryException if the address is not an I/O register.
+    void setWriteHandler(Vaddr vaddr, Memory::IoPort<byte>::WriteHandler handler);
+
+    /// Get the storage behind a whole page of the address space, so that it
+    /// can be copied in one go.
+    /// \param page The high byte of the addresses in the page.
+    /// \returns The 256 bytes of the page, or nullptr if the page holds I/O
+    /// registers or open bus, which must be read a byte at a time.
+    const byte* getPageData(byte page) const;
+
+    /// Get the internal RAM.
+    /// \returns Reference to the 2kB internal RAM.
+    inline Memory::Ram<byte>& getRam();
+
+    /// Number of address bits spanned by one page of the page table.
+    static constexpr const std::size_t PAGE_BITS = 8;
+
+    /// Number of pages in the Cpu address space.
+    static constexpr const std::size_t NUM_PAGES = 0x10000 >> PAGE_BITS;
+
+  private:
+    /// Size of the internal RAM, mirrored through $0000-$1FFF.
+    static constexpr const std::size_t RAM_SIZE = 0x800;
+    /// Number of PPU registers, mirrored through $2000-$3FFF.
+    static constexpr const std::size_t PPU_PORT_SIZE = 0x8;
+    /// Number of APU/IO registers at $4000-$401F.
+    static constexpr const std::size_t APU_PORT_SIZE = 0x20;
+
+    /// Base address of the PPU registers.
+    static constexpr const addr PPU_PORT_ADDR = 0x2000;
+    /// Base address of the APU/IO registers.
+    static constexpr const addr APU_PORT_ADDR = 0x4000;
+    /// End of the APU/IO registers.
+    static constexpr const addr APU_PORT_END = 0x4020;
+    /// Base address of cartridge space.
+    static constexpr const addr CARTRIDGE_ADDR = 0x4100;
+
+    /// Get the I/O port holding the register at the given address.
+    /// \param vaddr Address of the register.
+    /// \returns The port holding the register.
+    /// \throws Exception::MemoryException if the address is not an I/O register.
+    Memory::IoPort<byte>& getPort(Vaddr vaddr);
+
+    /// The 2kB internal RAM.
+    Memory::Ram<byte> ram;
+    /// The PPU registers.
+    Memory::IoPort<byte> ppuPort;
+    /// The APU and controller registers.
+    Memory::IoPort<byte> apuPort;
+    /// Latch for reads of unmapped addresses, approximating open bus.
+    mutable Memory::IoPort<byte> openBus;
+
+    /// Slot holding the internal RAM. Pages owned by the bus are resolved
+    /// through slots just like cartridge pages.
+    Memory::Bank<byte>* ramSlot;
+    /// Slot holding the PPU port.
+    Memory::Bank<byte>* ppuSlot;
+    /// Slot holding the APU/IO port.
+    Memory::Bank<byte>* apuSlot;
+    /// The cartridge slot behind the rest of the APU/IO page, $4020-$40FF.
+    Memory::Bank<byte>* const* expansionSlot;
+
+    /// The slot holding the bank mapped into each page. Cartridge pages point
+    /// at the CartridgeMapper page table, so bank switches need no update here.
+    std::array<Memory::Bank<byte>* const*, NUM_PAGES> pageTable;
+};
+
+Memory::Bank<byte>* CpuBus::mapToHardware(Vaddr vaddr) const {
+  Memory::Bank<byte>* bank = *pageTable[vaddr.hh];
+  // The APU/IO page holds registers only up to $401F; the rest of it is
+  // cartridge space.
+  if(static_cast<addr>(vaddr.val - APU_PORT_END) < CARTRIDGE_ADDR - APU_PORT_END) {
+    bank = *expansionSlot;
+  }
+  return bank != nullptr ? bank : &openBus;
+}
+
+Memory::Ram<byte>& CpuBus::getRam() {
+  return ram;
+}
+
+} // namespace Nes
+
+#endif // NES_CPU_BUS_H //
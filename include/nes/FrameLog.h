@@ -0,0 +1,111 @@
+//===-- include/nes/FrameLog.h - Log of a Ppu Frame -------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the Nes::FrameLog structure.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_FRAME_LOG_H
+#define NES_FRAME_LOG_H
+
+#include <array>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "memory/Bank.h"
+#include "nes/CartridgeMapper.h"
+
+namespace Nes {
+
+/// \struct FrameLog
+/// \brief Everything needed to render a frame away from the Ppu that ran it:
+/// the Ppu state as the frame starts, then every register access and change
+/// of CHR banking up to the end of the visible scanlines, each stamped with
+/// the dot it happened on. Replaying the log through another Ppu renders the
+/// frame exactly as the original would have.
+struct FrameLog {
+  /// The kinds of logged event.
+  enum class EventType : byte {
+    /// A register read, which may have side effects.
+    READ,
+    /// A register write.
+    WRITE,
+    /// A change of CHR banking or mirroring, the next entry of chrMappings.
+    CHR_MAPPING
+  };
+
+  /// A logged event.
+  struct Event {
+    /// Dot of the frame the event happened on, scanline * 341 + dot.
+    std::size_t time;
+    /// The kind of event.
+    EventType type;
+    /// Register index, for register accesses.
+    byte index;
+    /// Data written, for register writes.
+    byte data;
+  };
+
+  /// How the pattern tables and nametables are mapped.
+  struct ChrMapping {
+    /// Offset into CHR memory of each 1kB page of the pattern tables.
+    std::array<std::size_t, CartridgeMapper::NUM_CHR_PAGES> offsets;
+    /// Nametable mirroring.
+    Mirroring mirroring;
+  };
+
+  /// PPUCTRL at the start of the frame.
+  byte ctrl;
+  /// PPUMASK at the start of the frame.
+  byte mask;
+  /// PPUSTATUS flags at the start of the frame.
+  byte status;
+  /// OAMADDR at the start of the frame.
+  byte oamAddr;
+  /// The $2007 read buffer at the start of the frame.
+  byte readBuffer;
+  /// The I/O latch at the start of the frame.
+  byte ioLatch;
+  /// The current VRAM address at the start of the frame.
+  addr v;
+  /// The temporary VRAM address at the start of the frame.
+  addr t;
+  /// The fine horizontal scroll at the start of the frame.
+  byte fineX;
+  /// The write toggle at the start of the frame.
+  bool writeToggle;
+  /// Whether the frame is odd.
+  bool oddFrame;
+  /// CHR mapping at the start of the frame.
+  ChrMapping chrMapping;
+  /// Nametables at the start of the frame.
+  std::array<byte, 0x1000> nametables;
+  /// Palette RAM at the start of the frame.
+  std::array<byte, 0x20> palette;
+  /// OAM at the start of the frame.
+  std::array<byte, 0x100> oam;
+
+  /// CHR memory of the cartridge.
+  Memory::Bank<byte>* chrMemory;
+  /// Size of CHR memory.
+  std::size_t chrSize;
+  /// Whether CHR memory is CHR RAM.
+  bool chrWritable;
+  /// Copy of CHR RAM at the start of the frame. Empty for CHR ROM, which
+  /// cannot change.
+  std::vector<byte> chrRam;
+
+  /// Events of the frame, in order.
+  std::vector<Event> events;
+  /// CHR mappings switched to by CHR_MAPPING events, in order.
+  std::vector<ChrMapping> chrMappings;
+};
+
+} // namespace Nes
+
+#endif // NES_FRAME_LOG_H //
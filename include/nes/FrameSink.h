@@ -0,0 +1,144 @@
+//===-- include/nes/FrameSink.h - Triple Buffered Frame Handoff -*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::FrameSink class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_FRAME_SINK_H
+#define NES_FRAME_SINK_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "common/CommonTypes.h"
+
+namespace Nes {
+
+/// \class FrameSink
+/// \brief This class hands finished frames from the emulation thread to one
+/// consumer thread, such as a display or an encoder, through a triple buffer.
+/// The producer draws into the back buffer and publishes it by swapping it
+/// with the middle buffer in a single atomic exchange, and the consumer takes
+/// the middle buffer the same way. Neither side ever waits for the other or
+/// copies a frame: a slow consumer just misses frames, which are counted as
+/// dropped, and a fast one sees the same frame again, counted as duplicated.
+class FrameSink {
+  public:
+    /// The clock frames are timestamped with.
+    using Clock = std::chrono::steady_clock;
+
+    /// Number of buckets of the latency histogram.
+    static constexpr const std::size_t NUM_LATENCY_BUCKETS = 24;
+
+    /// A frame and what is known about it.
+    struct Frame {
+      /// The pixels of the frame.
+      std::vector<byte> pixels;
+      /// Number of the frame, counting publishes from 1.
+      std::uint64_t number;
+      /// When the frame was published.
+      Clock::time_point published;
+    };
+
+    /// Build a sink of frames of the given size.
+    /// \param frameSize Number of bytes in a frame.
+    explicit FrameSink(std::size_t frameSize);
+
+    /// FrameSinks cannot be copied.
+    FrameSink(const FrameSink&) = delete;
+    /// FrameSinks cannot be copy assigned.
+    FrameSink& operator=(const FrameSink&) = delete;
+
+    /// Destroy a FrameSink.
+    ~FrameSink() {}
+
+    /// Get the buffer the producer draws the next frame into. It changes on
+    /// every publish.
+    /// \returns The pixels of the back buffer.
+    inline byte* getBackBuffer();
+
+    /// Publish the back buffer as the latest frame, and take a new back
+    /// buffer. Only the producer thread may call this.
+    void publish();
+
+    /// Take the latest published frame. The frame stays valid, and is not
+    /// written, until the next call. Only the consumer thread may call this.
+    /// \returns The latest frame, or nullptr if none has been published.
+    const Frame* acquire();
+
+    /// Get the number of frames published.
+    /// \returns The number of frames published.
+    inline std::uint64_t getPublishedCount() const;
+
+    /// Get the number of frames replaced by a newer one before the consumer
+    /// took them.
+    /// \returns The number of dropped frames.
+    inline std::uint64_t getDroppedCount() const;
+
+    /// Get the number of times the consumer took a frame it already had.
+    /// \returns The number of duplicated frames.
+    inline std::uint64_t getDuplicatedCount() const;
+
+    /// Get the histogram of times from publishing a frame to the consumer
+    /// taking it. Bucket n counts latencies of 2^(n-1) to 2^n - 1
+    /// microseconds, bucket 0 those under a microsecond, and the last bucket
+    /// everything longer.
+    /// \returns The count of frames in each bucket.
+    std::array<std::uint64_t, NUM_LATENCY_BUCKETS> getLatencyHistogram() const;
+
+  private:
+    /// Bit of the middle buffer state set while it holds a frame the
+    /// consumer has not taken.
+    static constexpr const byte FRESH = 0x04;
+    /// Bits of the middle buffer state holding the buffer index.
+    static constexpr const byte INDEX = 0x03;
+
+    /// The three buffers.
+    std::array<Frame, 3> frames;
+    /// Index of the buffer the producer draws into.
+    byte back;
+    /// Index of the buffer the consumer holds.
+    byte front;
+    /// Whether the consumer holds a frame at all.
+    bool holdingFrame;
+    /// Index of the middle buffer, and FRESH. Kept off the cache lines of
+    /// the other members, which each belong to one side.
+    alignas(64) std::atomic<byte> middle;
+    /// Number of frames published.
+    alignas(64) std::atomic<std::uint64_t> publishedCount;
+    /// Number of frames dropped.
+    std::atomic<std::uint64_t> droppedCount;
+    /// Number of frames duplicated.
+    alignas(64) std::atomic<std::uint64_t> duplicatedCount;
+    /// Latency histogram.
+    std::array<std::atomic<std::uint64_t>, NUM_LATENCY_BUCKETS> latencies;
+};
+
+byte* FrameSink::getBackBuffer() {
+  return frames[back].pixels.data();
+}
+
+std::uint64_t FrameSink::getPublishedCount() const {
+  return publishedCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t FrameSink::getDroppedCount() const {
+  return droppedCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t FrameSink::getDuplicatedCount() const {
+  return duplicatedCount.load(std::memory_order_relaxed);
+}
+
+} // namespace Nes
+
+#endif // NES_FRAME_SINK_H //
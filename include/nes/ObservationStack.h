@@ -0,0 +1,180 @@
+//===-- include/nes/ObservationStack.h - Stacked Observations ---*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::ObservationStack class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_OBSERVATION_STACK_H
+#define NES_OBSERVATION_STACK_H
+
+#include <cstdint>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "memory/Arena.h"
+#include "nes/VideoConverter.h"
+
+namespace Nes {
+
+/// \class ObservationStack
+/// \brief This class turns frames of Ppu palette indices into the small
+/// observations agents are trained on: each frame is grayscaled, cropped,
+/// downsampled, and kept in a ring of the last few, so that only the stack
+/// ever leaves the emulator.
+///
+/// Downsampling averages the area of the frame under each output pixel, as
+/// a box filter with fractional edges. The filter is separable, so a frame
+/// is grayscaled with the VideoConverter lookup, each output row is a
+/// weighted sum of a few gray rows in 16 bit fixed point, done a vector at a
+/// time, and each output pixel a dot product of a few columns of that row
+/// with its weights, done with pmaddwd where AVX2 is available.
+/// The weights of every row and column are worked out once, when the stack
+/// is built.
+class ObservationStack {
+  public:
+    /// Width of an observation in the usual training setups.
+    static constexpr const std::size_t DEFAULT_SIZE = 84;
+    /// Number of observations stacked in the usual training setups.
+    static constexpr const std::size_t DEFAULT_DEPTH = 4;
+    /// Number of rows cropped from the top and bottom of a frame, which an
+    /// NTSC television hides in overscan.
+    static constexpr const std::size_t DEFAULT_CROP = 8;
+
+    /// Build a stack of blank observations.
+    /// \param width Width of an observation.
+    /// \param height Height of an observation.
+    /// \param depth Number of observations in the stack.
+    /// \param cropTop Number of rows dropped from the top of a frame.
+    /// \param cropBottom Number of rows dropped from the bottom of a frame.
+    /// \throws Exception::StructureException if a size is 0, or the crop
+    /// leaves no rows.
+    ObservationStack(std::size_t width = DEFAULT_SIZE, std::size_t height = DEFAULT_SIZE,
+        std::size_t depth = DEFAULT_DEPTH, std::size_t cropTop = DEFAULT_CROP,
+        std::size_t cropBottom = DEFAULT_CROP);
+
+    /// ObservationStacks cannot be copied.
+    ObservationStack(const ObservationStack&) = delete;
+    /// ObservationStacks cannot be copy assigned.
+    ObservationStack& operator=(const ObservationStack&) = delete;
+
+    /// Fill the whole stack with the observation of a frame, as at the start
+    /// of an episode.
+    /// \param frame Ppu::WIDTH * Ppu::HEIGHT palette indices.
+    /// \param emphasis Colour emphasis bits the frame was drawn with.
+    void reset(const byte* frame, byte emphasis);
+
+    /// Push the observation of a frame, dropping the oldest.
+    /// \param frame Ppu::WIDTH * Ppu::HEIGHT palette indices.
+    /// \param emphasis Colour emphasis bits the frame was drawn with.
+    void push(const byte* frame, byte emphasis);
+
+    /// Get an observation of the stack.
+    /// \param age 0 for the newest observation, up to getDepth() - 1.
+    /// \returns width * height gray levels, row by row.
+    inline const byte* getObservation(std::size_t age) const;
+
+    /// Copy the whole stack, oldest observation first.
+    /// \param destination getStackSize() bytes receiving the stack.
+    void copyStack(byte* destination) const;
+
+    /// Get the width of an observation.
+    /// \returns The width.
+    inline std::size_t getWidth() const;
+
+    /// Get the height of an observation.
+    /// \returns The height.
+    inline std::size_t getHeight() const;
+
+    /// Get the number of observations in the stack.
+    /// \returns The depth.
+    inline std::size_t getDepth() const;
+
+    /// Get the number of bytes in the whole stack.
+    /// \returns depth * height * width.
+    inline std::size_t getStackSize() const;
+
+  private:
+    /// A box filter from one size to another, as the weights of the input
+    /// lines averaged into each output line. Every output line has the same
+    /// number of taps, some of weight 0, so the sums run in fixed loops.
+    struct Filter {
+      /// Number of taps of each output line.
+      std::size_t taps;
+      /// First input line of each output line.
+      std::vector<std::size_t> first;
+      /// Weights of the taps of each output line, one line after another, in
+      /// fixed point, summing to one for each line.
+      std::vector<std::uint16_t> weights;
+    };
+
+    /// Work out the weights of a box filter from one size to another.
+    /// \param inputs Number of input lines.
+    /// \param outputs Number of output lines.
+    /// \param one The weight of a whole line, in fixed point.
+    /// \param minTaps Number of taps to pad each output line to, if it needs
+    /// no more.
+    /// \returns The filter.
+    static Filter buildFilter(std::size_t inputs, std::size_t outputs, int one,
+        std::size_t minTaps);
+
+    /// Downsample a frame into an observation.
+    /// \param frame The palette indices.
+    /// \param emphasis Colour emphasis bits.
+    /// \param observation width * height bytes receiving the observation.
+    void downsample(const byte* frame, byte emphasis, byte* observation);
+
+    /// Width of an observation.
+    std::size_t width;
+    /// Height of an observation.
+    std::size_t height;
+    /// Number of observations in the stack.
+    std::size_t depth;
+    /// Number of rows dropped from the top of a frame.
+    std::size_t cropTop;
+    /// Number of rows of a frame kept.
+    std::size_t rows;
+    /// Converts palette indices to gray.
+    VideoConverter converter;
+    /// Filter from the kept rows to the output rows.
+    Filter rowFilter;
+    /// Filter from the frame columns to the output columns.
+    Filter columnFilter;
+    /// The kept rows of the frame being downsampled, in gray.
+    Memory::Arena<byte> gray;
+    /// Weighted sum of gray rows making the output row being downsampled.
+    Memory::Arena<std::uint16_t> rowSum;
+    /// The observations, one after another, as a ring.
+    Memory::Arena<byte> ring;
+    /// Index in the ring of the newest observation.
+    std::size_t newest;
+};
+
+const byte* ObservationStack::getObservation(std::size_t age) const {
+  return ring.at(((newest + depth - age % depth) % depth) * width * height);
+}
+
+std::size_t ObservationStack::getWidth() const {
+  return width;
+}
+
+std::size_t ObservationStack::getHeight() const {
+  return height;
+}
+
+std::size_t ObservationStack::getDepth() const {
+  return depth;
+}
+
+std::size_t ObservationStack::getStackSize() const {
+  return depth * width * height;
+}
+
+} // namespace Nes
+
+#endif // NES_OBSERVATION_STACK_H //:~
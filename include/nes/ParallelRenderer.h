@@ -0,0 +1,111 @@
+//===-- include/nes/ParallelRenderer.h - Multithreaded Renderer -*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::ParallelRenderer class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_PARALLEL_RENDERER_H
+#define NES_PARALLEL_RENDERER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "memory/Bank.h"
+#include "memory/Ram.h"
+#include "nes/FrameLog.h"
+#include "nes/Ppu.h"
+
+namespace Nes {
+
+/// \class ParallelRenderer
+/// \brief This class renders logged frames on a pool of threads, each
+/// replaying the frame log on a Ppu of its own and drawing one band of
+/// scanlines. Every band replays the same register accesses at the same dots
+/// as the Ppu that logged the frame, so the frame is identical to one drawn
+/// by that Ppu. Rendering runs alongside the emulation of the next frame,
+/// which logs to a second FrameLog.
+class ParallelRenderer {
+  public:
+    /// Start a renderer with the given number of threads.
+    /// \param threadCount Number of threads, and bands of scanlines.
+    explicit ParallelRenderer(std::size_t threadCount);
+
+    /// ParallelRenderers cannot be copied.
+    ParallelRenderer(const ParallelRenderer&) = delete;
+    /// ParallelRenderers cannot be copy assigned.
+    ParallelRenderer& operator=(const ParallelRenderer&) = delete;
+
+    /// Wait for any frame being rendered, and stop the threads.
+    ~ParallelRenderer();
+
+    /// Start rendering a logged frame, once any frame being rendered is done.
+    /// The log and framebuffer must not change until the frame is done.
+    /// \param frameLog Log of the frame.
+    /// \param framebuffer Ppu::WIDTH * Ppu::HEIGHT bytes receiving palette
+    /// indices.
+    void render(const FrameLog& frameLog, byte* framebuffer);
+
+    /// Wait until the frame being rendered is done.
+    void wait();
+
+    /// Get the number of threads rendering.
+    /// \returns The number of threads.
+    std::size_t getThreadCount() const;
+
+  private:
+    /// A rendering thread and the Ppu it replays frames on.
+    struct Worker {
+      /// The thread.
+      std::thread thread;
+      /// The Ppu, built for the CHR memory of the last frame rendered.
+      std::unique_ptr<Ppu> ppu;
+      /// The CHR memory the Ppu was built for.
+      const Memory::Bank<byte>* chrSource;
+      /// Copy of CHR RAM for the Ppu to read, as the cartridge's CHR RAM
+      /// changes while frames are rendered.
+      Memory::Ram<byte> chrRam;
+    };
+
+    /// Body of a rendering thread.
+    /// \param index Index of the thread's worker.
+    void work(std::size_t index);
+
+    /// Render the band of scanlines of a worker.
+    /// \param worker The worker.
+    /// \param index Index of the worker.
+    void renderBand(Worker& worker, std::size_t index);
+
+    /// The rendering threads.
+    std::vector<std::unique_ptr<Worker>> workers;
+    /// Guards everything below.
+    std::mutex mutex;
+    /// Signalled when a frame is started, or the threads are stopped.
+    std::condition_variable frameStarted;
+    /// Signalled when the last band of a frame is done.
+    std::condition_variable frameDone;
+    /// Log of the frame being rendered.
+    const FrameLog* frameLog;
+    /// Framebuffer of the frame being rendered.
+    byte* framebuffer;
+    /// Number of frames started.
+    std::uint64_t frameNumber;
+    /// Number of bands of the current frame still rendering.
+    std::size_t pendingBands;
+    /// Set when the threads should stop.
+    bool stopping;
+};
+
+} // namespace Nes
+
+#endif // NES_PARALLEL_RENDERER_H //
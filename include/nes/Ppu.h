@@ -0,0 +1,475 @@
+//===-- include/nes/Ppu.h - Nes Picture Processing Unit ---------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Ppu class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_PPU_H
+#define NES_PPU_H
+
+#include <array>
+#include <cstdint>
+
+#include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
+#include "memory/Bank.h"
+#include "nes/CartridgeMapper.h"
+#include "nes/CpuBus.h"
+#include "nes/FrameLog.h"
+#include "nes/TileCache.h"
+
+namespace Nes {
+
+/// \class Ppu
+/// \brief This class represents the Ricoh 2C02 picture processing unit of the
+/// Nes. Rather than ticking once per dot, the Ppu is told how many dots have
+/// elapsed and only catches up when something can observe it: when the Cpu
+/// touches one of its registers, or when an event the Cpu must see (vblank,
+/// a mapper scanline clock, the end of a frame) is due. Catching up renders
+/// whole runs of pixels at once, so a frame without mid-scanline register
+/// writes is rendered one scanline at a time.
+///
+/// Pattern data is read from a TileCache rather than decoded from its
+/// bitplanes pixel by pixel.
+///
+/// Rendered pixels are written to a caller provided framebuffer as palette
+/// indices, one byte per pixel, WIDTH pixels per row. In headless mode no
+/// pixels are produced, and only what the Cpu can observe is computed: vblank
+/// and NMI timing, sprite overflow, and the sprite 0 hit, for which only the
+/// background under sprite 0 is fetched.
+///
+/// Instead of drawing, the Ppu can log each frame to a FrameLog, for other
+/// Ppus detached from the cartridge to replay a band of scanlines each. The
+/// Ppu keeps its own copy of the CHR banking and mirroring, so that the log
+/// records exactly when they change as far as rendering is concerned.
+class Ppu {
+  public:
+    /// Width of a frame in pixels.
+    static constexpr const std::size_t WIDTH = 256;
+    /// Height of a frame in pixels.
+    static constexpr const std::size_t HEIGHT = 240;
+    /// Number of dots in a scanline.
+    static constexpr const std::size_t DOTS_PER_SCANLINE = 341;
+    /// Number of scanlines in a frame, including vblank.
+    static constexpr const std::size_t SCANLINES_PER_FRAME = 262;
+    /// Number of dots in a frame, ignoring the dot skipped on odd frames.
+    static constexpr const std::size_t DOTS_PER_FRAME =
+        DOTS_PER_SCANLINE * SCANLINES_PER_FRAME;
+    /// Number of Ppu dots per Cpu cycle.
+    static constexpr const std::size_t DOTS_PER_CPU_CYCLE = 3;
+    /// The scanline on which vblank starts.
+    static constexpr const std::size_t VBLANK_SCANLINE = 241;
+    /// The pre-render scanline, the last scanline of a frame.
+    static constexpr const std::size_t PRE_RENDER_SCANLINE = 261;
+
+    /// PPUSTATUS flag set when more than eight sprites share a scanline.
+    static constexpr const byte STATUS_SPRITE_OVERFLOW = 0x20;
+    /// PPUSTATUS flag set when sprite 0 overlaps the background.
+    static constexpr const byte STATUS_SPRITE_ZERO_HIT = 0x40;
+    /// PPUSTATUS flag set during vblank.
+    static constexpr const byte STATUS_VBLANK = 0x80;
+
+    /// Build a Ppu reading pattern data and mirroring from the given mapper.
+    /// \param mapper The cartridge mapper of the inserted cartridge.
+    explicit Ppu(CartridgeMapper& mapper);
+
+    /// Build a Ppu detached from any cartridge, to replay frame logs. CHR
+    /// banking and mirroring come from the logs.
+    /// \param chrMemory The CHR memory to read pattern data from. CHR RAM is
+    /// overwritten with the contents logged at the start of each frame.
+    /// \param chrSize Number of bytes of CHR memory.
+    /// \param chrWritable true if the CHR memory is CHR RAM.
+    Ppu(Memory::Bank<byte>& chrMemory, std::size_t chrSize, bool chrWritable);
+
+    /// Ppus cannot be copied.
+    Ppu(const Ppu&) = delete;
+    /// Ppus cannot be copy assigned.
+    Ppu& operator=(const Ppu&) = delete;
+
+    /// Destroy a Ppu.
+    ~Ppu() {}
+
+    /// Attach the Ppu registers to their addresses on the Cpu bus.
+    /// \param bus The Cpu bus.
+    void connect(CpuBus& bus);
+
+    /// Set the framebuffer to render into.
+    /// \param framebuffer WIDTH * HEIGHT bytes receiving palette indices, or
+    /// nullptr to discard pixels.
+    void setFramebuffer(byte* framebuffer);
+
+    /// Switch headless mode on or off. Switching between frames, during
+    /// vblank, changes only whether the next frame is drawn.
+    /// \param headless true to stop producing pixels.
+    void setHeadless(bool headless);
+
+    /// Check whether the Ppu is in headless mode.
+    /// \returns true if no pixels are being produced.
+    inline bool isHeadless() const;
+
+    /// Set the log to record frames to. Logging starts with the next frame,
+    /// and while logging the Ppu draws nothing itself, as in headless mode.
+    /// Switching logs during vblank hands over the log of the frame just
+    /// completed.
+    /// \param frameLog The log to record to, or nullptr to draw again.
+    void setFrameLog(FrameLog* frameLog);
+
+    /// Render a band of scanlines of a logged frame, replaying the frame from
+    /// its start. Scanlines above the band are run without drawing, so each
+    /// band can be rendered by a different Ppu.
+    /// \param frameLog The log of the frame.
+    /// \param firstLine The first scanline of the band.
+    /// \param lastLine One past the last scanline of the band.
+    /// \param output Framebuffer receiving the scanlines of the band.
+    void replay(const FrameLog& frameLog, std::size_t firstLine,
+        std::size_t lastLine, byte* output);
+
+    /// Let the given number of dots elapse. No work is done until the Ppu is
+    /// caught up.
+    /// \param dots Number of dots.
+    inline void advance(std::size_t dots);
+
+    /// Check whether enough dots have elapsed that an event visible to the Cpu
+    /// is due, and the Ppu should be caught up.
+    /// \returns true if catchUp should be called.
+    inline bool isCatchUpDue() const;
+
+    /// Run the Ppu through every dot that has elapsed.
+    void catchUp();
+
+    /// Read a Ppu register, catching up first.
+    /// \param index Register index, 0 to 7.
+    /// \returns The value read.
+    byte readRegister(std::size_t index);
+
+    /// Write a Ppu register, catching up first.
+    /// \param index Register index, 0 to 7.
+    /// \param data The value written.
+    void writeRegister(std::size_t index, byte data);
+
+    /// Copy a page into OAM, starting at OAMADDR, as OAM DMA does with 256
+    /// writes to OAMDATA. Catches up first.
+    /// \param page The 256 bytes to copy.
+    void writeOamDma(const byte* page);
+
+    /// Get the contents of OAM.
+    /// \returns The 256 bytes of OAM.
+    inline const std::array<byte, 0x100>& getOam() const;
+
+    /// Catch up, and write the registers, memories and position in the frame
+    /// to a saved state, along with CHR RAM if the cartridge has it.
+    /// \param writer The state being written.
+    void saveState(Structure::StateWriter& writer);
+
+    /// Read the registers, memories and position in the frame from a saved
+    /// state, after the cartridge state. Tiles of CHR RAM that change are
+    /// decoded again when next drawn.
+    /// \param reader The state being read.
+    void loadState(Structure::StateReader& reader);
+
+    /// Check for an NMI raised since the last poll, and acknowledge it.
+    /// \returns true if the Cpu should take an NMI.
+    inline bool pollNmi();
+
+    /// Get the number of frames completed. A frame is complete once vblank
+    /// starts.
+    /// \returns The frame count.
+    inline std::uint64_t getFrameCount() const;
+
+    /// Get the current scanline, as of the last catch up.
+    /// \returns The scanline, 0 to 261.
+    inline std::size_t getScanline() const;
+
+    /// Get the current dot within the scanline, as of the last catch up.
+    /// \returns The dot, 0 to 340.
+    inline std::size_t getDot() const;
+
+    /// Get the colour emphasis bits of PPUMASK.
+    /// \returns Red, green and blue emphasis in bits 0 to 2.
+    inline byte getEmphasis() const;
+
+  private:
+    /// PPUCTRL and PPUMASK bits used by the renderer.
+    enum : byte {
+      CTRL_INCREMENT_32 = 0x04,
+      CTRL_SPRITE_TABLE = 0x08,
+      CTRL_BACKGROUND_TABLE = 0x10,
+      CTRL_SPRITE_16 = 0x20,
+      CTRL_NMI = 0x80,
+      MASK_GRAYSCALE = 0x01,
+      MASK_BACKGROUND_LEFT = 0x02,
+      MASK_SPRITES_LEFT = 0x04,
+      MASK_BACKGROUND = 0x08,
+      MASK_SPRITES = 0x10
+    };
+
+    /// Bits of a sprite line pixel. The low four bits are the sprite palette
+    /// entry, zero for transparent.
+    enum : byte {
+      SPRITE_BEHIND = 0x10,
+      SPRITE_ZERO = 0x20
+    };
+
+    /// Run the dots [from, to) of the current scanline.
+    void runScanline(std::size_t from, std::size_t to);
+
+    /// Render the pixels [x0, x1) of the current scanline.
+    void renderPixels(std::size_t x0, std::size_t x1);
+
+    /// Fill backgroundPixels [x0, x1) with background palette entries.
+    void fetchBackground(std::size_t x0, std::size_t x1);
+
+    /// Set the sprite zero hit flag if sprite 0 overlaps the background
+    /// within the pixels [x0, x1).
+    void checkSpriteZero(std::size_t x0, std::size_t x1);
+
+    /// Evaluate OAM and fill spritePixels for the given scanline.
+    /// \param line The scanline the sprites are displayed on.
+    void evaluateSprites(std::size_t line);
+
+    /// Latch the horizontal scroll of the current scanline from v.
+    /// \param x The pixel the scroll takes effect from.
+    void latchScrollX(std::size_t x);
+
+    /// Increment the vertical scroll in v, as at dot 256.
+    void incrementY();
+
+    /// Check whether pixels are being output.
+    inline bool isDrawing() const;
+
+    /// Copy the CHR banking and mirroring from the mapper, logging the
+    /// change if a frame is being logged.
+    void syncChrMapping();
+
+    /// Record the state of the Ppu at the start of a frame to the frame log,
+    /// and clear its events.
+    void logFrameStart();
+
+    /// Record an event at the current dot to the frame log, if a visible
+    /// scanline is being logged.
+    inline void logEvent(FrameLog::EventType type, std::size_t index, byte data);
+
+    /// Load the state of the Ppu at the start of a logged frame.
+    void restore(const FrameLog& frameLog);
+
+    /// Run a replayed frame up to a dot, drawing only the band of scanlines
+    /// from firstLine on.
+    void replayUntil(std::size_t time, std::size_t firstLine, byte* output);
+
+    /// Get the dot of the frame at the current position.
+    inline std::size_t getFrameTime() const;
+
+    /// Get the length of the current scanline, one dot short on the pre-render
+    /// scanline of odd frames when rendering.
+    std::size_t getScanlineLength() const;
+
+    /// Get the number of dots from the current position to the next event
+    /// the Cpu can observe.
+    std::size_t getDotsUntilEvent() const;
+
+    /// Check whether background or sprite rendering is enabled.
+    inline bool isRendering() const;
+
+    /// Check whether the current dot is within the visible pixels of a
+    /// rendered scanline.
+    inline bool isMidScanline() const;
+
+    /// Read from the Ppu address space.
+    byte readVram(addr address) const;
+
+    /// Write to the Ppu address space.
+    void writeVram(addr address, byte data);
+
+    /// Get the offset into CHR memory of a pattern table address.
+    inline std::size_t getChrOffset(addr address) const;
+
+    /// Read a byte of pattern data.
+    inline byte readChr(addr address) const;
+
+    /// Get the index into the nametables of a nametable address, applying
+    /// the cartridge mirroring.
+    inline std::size_t getNametableIndex(addr address) const;
+
+    /// Get the index into the palette of a palette address.
+    static inline std::size_t getPaletteIndex(addr address);
+
+    /// The inserted cartridge's mapper, or nullptr if detached.
+    CartridgeMapper* mapper;
+    /// CHR memory, every CHR bank back to back.
+    Memory::Bank<byte>& chrMemory;
+    /// Size of CHR memory.
+    std::size_t chrSize;
+    /// Whether CHR memory is CHR RAM.
+    bool chrWritable;
+    /// CHR banking and mirroring, as of the last catch up.
+    FrameLog::ChrMapping chrMapping;
+    /// The mapper's CHR generation chrMapping was copied at.
+    std::size_t chrGeneration;
+    /// CHR memory decoded to one byte per pixel.
+    TileCache tileCache;
+    /// Framebuffer to render into, or nullptr.
+    byte* framebuffer;
+    /// Whether pixel output is skipped.
+    bool headless;
+    /// Log frames are recorded to, or nullptr.
+    FrameLog* frameLog;
+
+    /// PPUCTRL.
+    byte ctrl;
+    /// PPUMASK.
+    byte mask;
+    /// PPUSTATUS flags.
+    byte status;
+    /// OAMADDR.
+    byte oamAddr;
+    /// The $2007 read buffer.
+    byte readBuffer;
+    /// The last value written to any register, read back from write only
+    /// registers.
+    byte ioLatch;
+    /// The current VRAM address.
+    addr v;
+    /// The temporary VRAM address.
+    addr t;
+    /// The fine horizontal scroll.
+    byte fineX;
+    /// The shared $2005/$2006 write toggle.
+    bool writeToggle;
+    /// Set when an NMI is raised, until polled.
+    bool nmiPending;
+
+    /// The current scanline.
+    std::size_t scanline;
+    /// The current dot within the scanline.
+    std::size_t dot;
+    /// The number of completed frames.
+    std::uint64_t frameCount;
+    /// Whether the current frame is odd, and skips a dot when rendering.
+    bool oddFrame;
+    /// Dots elapsed that have not been caught up.
+    std::size_t pendingDots;
+    /// Dots from the current position to the next Cpu visible event.
+    std::size_t dotsUntilEvent;
+    /// Horizontal position in the 512 pixel wide pair of nametables of pixel
+    /// 0 of the current scanline.
+    int scrollX;
+
+    /// Background palette entries of the current scanline.
+    std::array<byte, WIDTH> backgroundPixels;
+    /// Sprite pixels of the current scanline.
+    std::array<byte, WIDTH> spritePixels;
+    /// Whether sprite 0 is on the current scanline.
+    bool spriteZeroOnScanline;
+    /// Left edge of sprite 0 on the current scanline.
+    std::size_t spriteZeroX;
+
+    /// Four 1kB nametables. Only two are used unless the cartridge provides
+    /// four screen VRAM.
+    std::array<byte, 0x1000> nametables;
+    /// Palette RAM.
+    std::array<byte, 0x20> palette;
+    /// Object attribute memory.
+    std::array<byte, 0x100> oam;
+};
+
+void Ppu::advance(std::size_t dots) {
+  pendingDots += dots;
+}
+
+bool Ppu::isCatchUpDue() const {
+  return pendingDots >= dotsUntilEvent;
+}
+
+bool Ppu::isHeadless() const {
+  return headless;
+}
+
+bool Ppu::pollNmi() {
+  bool nmi = nmiPending;
+  nmiPending = false;
+  return nmi;
+}
+
+std::uint64_t Ppu::getFrameCount() const {
+  return frameCount;
+}
+
+std::size_t Ppu::getScanline() const {
+  return scanline;
+}
+
+std::size_t Ppu::getDot() const {
+  return dot;
+}
+
+byte Ppu::getEmphasis() const {
+  return mask >> 5;
+}
+
+const std::array<byte, 0x100>& Ppu::getOam() const {
+  return oam;
+}
+
+bool Ppu::isDrawing() const {
+  return !headless && frameLog == nullptr;
+}
+
+void Ppu::logEvent(FrameLog::EventType type, std::size_t index, byte data) {
+  if(frameLog != nullptr && scanline < HEIGHT) {
+    frameLog->events.push_back({getFrameTime(), type, static_cast<byte>(index), data});
+  }
+}
+
+std::size_t Ppu::getFrameTime() const {
+  return scanline * DOTS_PER_SCANLINE + dot;
+}
+
+bool Ppu::isRendering() const {
+  return (mask & (MASK_BACKGROUND | MASK_SPRITES)) != 0;
+}
+
+bool Ppu::isMidScanline() const {
+  return scanline < HEIGHT && dot >= 1 && dot <= WIDTH && isRendering();
+}
+
+std::size_t Ppu::getChrOffset(addr address) const {
+  return chrMapping.offsets[(address >> CartridgeMapper::PAGE_BITS)
+      & (CartridgeMapper::NUM_CHR_PAGES - 1)]
+      + (address & ((1 << CartridgeMapper::PAGE_BITS) - 1));
+}
+
+byte Ppu::readChr(addr address) const {
+  return chrMemory.read(getChrOffset(address));
+}
+
+std::size_t Ppu::getNametableIndex(addr address) const {
+  // Physical nametable backing each of the four logical nametables, for each
+  // Mirroring.
+  static const byte NAMETABLE_MAP[][4] = {
+    {0, 0, 1, 1}, // HORIZONTAL
+    {0, 1, 0, 1}, // VERTICAL
+    {0, 0, 0, 0}, // SINGLE_SCREEN_LOWER
+    {1, 1, 1, 1}, // SINGLE_SCREEN_UPPER
+    {0, 1, 2, 3}  // FOUR_SCREEN
+  };
+  std::size_t table = (address >> 10) & 0x3;
+  std::size_t physical =
+      NAMETABLE_MAP[static_cast<std::size_t>(chrMapping.mirroring)][table];
+  return (physical << 10) | (address & 0x3FF);
+}
+
+std::size_t Ppu::getPaletteIndex(addr address) {
+  // The backdrop entries of the sprite palettes mirror the background ones.
+  std::size_t index = address & 0x1F;
+  return (index & 0x13) == 0x10 ? index & 0x0F : index;
+}
+
+} // namespace Nes
+
+#endif // NES_PPU_H //
@@ -0,0 +1,131 @@
+//===-- include/nes/Resampler.h - Polyphase Audio Resampler -----*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Resampler class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_RESAMPLER_H
+#define NES_RESAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "nes/Apu.h"
+
+namespace Nes {
+
+/// \class Resampler
+/// \brief This class converts a stream of samples from one rate to another,
+/// typically mixer output at the Cpu clock rate down to 44.1 or 48kHz.
+///
+/// Each output sample is the dot product of the input around its position
+/// with one phase of a windowed sinc low pass filter. The filter is tabulated
+/// at a fixed number of fractional positions, so no kernel is computed while
+/// resampling, and the dot products are vectorized. The position of the next
+/// output sample and the input it still needs are kept between calls, so a
+/// stream can be fed a frame at a time without seams.
+///
+/// The ratio can be nudged by a small number of parts per million, either
+/// directly or from the fill level of the buffer the output feeds, to keep
+/// that buffer centred without audible pitch changes.
+class Resampler {
+  public:
+    /// Number of fractional input positions the filter is tabulated at.
+    static constexpr const std::size_t PHASES = 32;
+    /// Number of zero crossings of the filter on each side of its centre.
+    static constexpr const std::size_t ZERO_CROSSINGS = 8;
+    /// Largest adjustment of the rate, in parts per million.
+    static constexpr const double MAX_RATE_ADJUSTMENT = 2000.0;
+
+    /// Build a resampler between two rates.
+    /// \param inputRate Input sample rate, in Hz.
+    /// \param outputRate Output sample rate, in Hz.
+    Resampler(double inputRate = Apu::CPU_CLOCK_RATE, double outputRate = 48000.0);
+
+    /// Destroy a Resampler.
+    ~Resampler() {}
+
+    /// Resample the next part of the input stream.
+    /// \param input The input samples.
+    /// \param count Number of input samples.
+    /// \param output Receives the output samples, appended.
+    /// \returns The number of samples appended.
+    std::size_t process(const float* input, std::size_t count, std::vector<float>& output);
+
+    /// Forget the stream, as if no input had been processed.
+    void reset();
+
+    /// Nudge the rate, so that more or fewer output samples are produced.
+    /// \param ppm Adjustment in parts per million, clamped to
+    /// MAX_RATE_ADJUSTMENT. Positive adjustments produce fewer samples.
+    void setRateAdjustment(double ppm);
+
+    /// Nudge the rate to keep the buffer the output feeds half full. A fuller
+    /// buffer produces fewer samples, and an emptier one more.
+    /// \param fill Fill level of the buffer, from 0 to 1.
+    void setBufferFill(double fill);
+
+    /// Get the current rate adjustment.
+    /// \returns The adjustment in parts per million.
+    inline double getRateAdjustment() const;
+
+    /// Get the number of input samples each output sample is filtered from.
+    /// \returns The filter length.
+    inline std::size_t getTapCount() const;
+
+    /// Get the input sample rate.
+    /// \returns The input rate, in Hz.
+    inline double getInputRate() const;
+
+    /// Get the output sample rate.
+    /// \returns The output rate, in Hz.
+    inline double getOutputRate() const;
+
+  private:
+    /// Input sample rate, in Hz.
+    double inputRate;
+    /// Output sample rate, in Hz.
+    double outputRate;
+    /// Filter length, a multiple of the vector width.
+    std::size_t taps;
+    /// Filter phases, PHASES runs of taps coefficients.
+    std::vector<float> kernels;
+    /// Input not yet consumed, starting at the first tap of the next output.
+    std::vector<float> history;
+    /// Position of the next output within history, in 32.32 fixed point.
+    std::uint64_t position;
+    /// Input samples per output sample, in 32.32 fixed point.
+    std::uint64_t step;
+    /// Current rate adjustment, in parts per million.
+    double adjustment;
+
+    /// Compute the step from the rates and the adjustment.
+    void updateStep();
+};
+
+double Resampler::getRateAdjustment() const {
+  return adjustment;
+}
+
+std::size_t Resampler::getTapCount() const {
+  return taps;
+}
+
+double Resampler::getInputRate() const {
+  return inputRate;
+}
+
+double Resampler::getOutputRate() const {
+  return outputRate;
+}
+
+} // namespace Nes
+
+#endif // NES_RESAMPLER_H //:~
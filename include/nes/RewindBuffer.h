@@ -0,0 +1,222 @@
+//===-- include/nes/RewindBuffer.h - Rewind Buffer --------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::RewindBuffer class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_REWIND_BUFFER_H
+#define NES_REWIND_BUFFER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "common/CommonTypes.h"
+
+namespace Nes {
+
+/// \class RewindBuffer
+/// \brief This class keeps the saved states of the most recent frames, for
+/// rewinding, in a fixed amount of memory. Every keyframe interval a state is
+/// stored whole, as a keyframe, and the states in between are stored as the
+/// run length encoded XOR of the state with its keyframe. Most of a state is
+/// the same from frame to frame, so the XOR is mostly zeros and encodes to a
+/// few hundred bytes. Any frame is restored from its keyframe and at most one
+/// delta.
+///
+/// Records are packed into one byte ring, preallocated along with the index
+/// of records, so that once the ring has filled, pushing a frame evicts the
+/// oldest frames rather than allocating. A keyframe is evicted together with
+/// the deltas against it.
+class RewindBuffer {
+  public:
+    /// Build a RewindBuffer.
+    /// \param maxFrames Number of frames held at most, for example 60 times
+    /// the number of seconds to rewind through.
+    /// \param budget Number of bytes of records held at most.
+    /// \param keyframeInterval Number of frames from one keyframe to the
+    /// next.
+    RewindBuffer(std::size_t maxFrames, std::size_t budget, std::size_t keyframeInterval);
+
+    /// RewindBuffers cannot be copied.
+    RewindBuffer(const RewindBuffer&) = delete;
+    /// RewindBuffers cannot be copy assigned.
+    RewindBuffer& operator=(const RewindBuffer&) = delete;
+
+    /// Destroy a RewindBuffer.
+    ~RewindBuffer() {}
+
+    /// Store the state of the next frame, evicting the oldest frames if the
+    /// buffer is full.
+    /// \param state The saved state.
+    /// \returns The number of the frame, counting from 0.
+    /// \throws Exception::StructureException if the state does not fit in the
+    /// budget.
+    std::uint64_t push(const std::vector<byte>& state);
+
+    /// Restore the state of a frame.
+    /// \param frame Number of the frame.
+    /// \param state Receives the saved state.
+    /// \throws Exception::KeyErrorException if the frame is not held.
+    void load(std::uint64_t frame, std::vector<byte>& state) const;
+
+    /// Drop every frame after the given one, so that frames pushed from
+    /// there on follow it, as when play resumes after rewinding.
+    /// \param frame Number of the last frame to keep.
+    /// \throws Exception::KeyErrorException if the frame is not held.
+    void discardAfter(std::uint64_t frame);
+
+    /// Drop every frame.
+    void clear();
+
+    /// Check if the state of a frame is held.
+    /// \param frame Number of the frame.
+    /// \returns True if the frame can be loaded.
+    inline bool hasFrame(std::uint64_t frame) const;
+
+    /// Get the number of frames held.
+    /// \returns The number of frames.
+    inline std::size_t getFrameCount() const;
+
+    /// Get the number of the oldest frame held.
+    /// \returns The frame number, undefined if no frame is held.
+    inline std::uint64_t getOldestFrame() const;
+
+    /// Get the number of the newest frame held.
+    /// \returns The frame number, undefined if no frame is held.
+    inline std::uint64_t getNewestFrame() const;
+
+    /// Get the number of bytes the held frames are stored in.
+    /// \returns The number of bytes of records.
+    inline std::size_t getStoredBytes() const;
+
+    /// Get how well the held frames are compressed.
+    /// \returns The size of the held states over the size of their records.
+    inline double getCompressionRatio() const;
+
+    /// Get the mean time taken to push a frame, encoding and storing it.
+    /// \returns The mean time, in microseconds.
+    inline double getMeanPushTime() const;
+
+  private:
+    /// Where a frame is stored in the ring.
+    struct Record {
+      /// Offset of the record in the ring.
+      std::size_t offset;
+      /// Number of bytes in the record.
+      std::size_t size;
+      /// Number of bytes in the state.
+      std::size_t stateSize;
+      /// True if the record is the whole state, false if it is a delta
+      /// against the last keyframe before it.
+      bool keyframe;
+    };
+
+    /// Get the record of a held frame.
+    /// \param frame Number of the frame.
+    /// \returns The record.
+    inline const Record& getRecord(std::uint64_t frame) const;
+
+    /// Find room for a record in the ring, evicting the oldest frames until
+    /// it fits.
+    /// \param size Number of bytes in the record.
+    /// \returns The offset of the room.
+    std::size_t allocate(std::size_t size);
+
+    /// Evict the oldest frame, and the deltas against it if it is a keyframe.
+    void evictOldest();
+
+    /// Make a frame the reference that later deltas are taken against.
+    /// \param frame Number of a held frame.
+    void setReference(std::uint64_t frame);
+
+    /// Encode the XOR of a state with the reference.
+    /// \param state The state.
+    /// \param size Number of bytes in the state.
+    /// \param delta Receives the delta, and must have room for
+    /// getMaxDeltaSize(size) bytes.
+    /// \returns The number of bytes in the delta.
+    std::size_t encodeDelta(const byte* state, std::size_t size, byte* delta) const;
+
+    /// Apply a delta to a copy of its keyframe.
+    /// \param delta The delta.
+    /// \param size Number of bytes in the delta.
+    /// \param state The keyframe, padded with zeros to the size of the state,
+    /// which receives the state.
+    static void decodeDelta(const byte* delta, std::size_t size, byte* state);
+
+    /// Get the most bytes the delta of a state can be encoded in.
+    /// \param size Number of bytes in the state.
+    /// \returns The number of bytes.
+    static std::size_t getMaxDeltaSize(std::size_t size);
+
+    /// The records.
+    std::vector<byte> ring;
+    /// Offset in the ring to store the next record at.
+    std::size_t writeOffset;
+    /// The index of records, one for each frame held, in frame order.
+    std::vector<Record> records;
+    /// Index of the record of the oldest frame.
+    std::size_t firstRecord;
+    /// Number of frames held.
+    std::size_t frameCount;
+    /// Number of the oldest frame held.
+    std::uint64_t oldestFrame;
+    /// Number of frames from one keyframe to the next.
+    std::size_t keyframeInterval;
+    /// Number of frames pushed since the last keyframe.
+    std::size_t sinceKeyframe;
+    /// Copy of the last keyframe, which deltas are taken against.
+    std::vector<byte> reference;
+    /// Scratch buffer deltas are encoded into.
+    std::vector<byte> scratch;
+    /// Total size of the held states.
+    std::size_t stateBytes;
+    /// Total size of the records of the held states.
+    std::size_t storedBytes;
+    /// Number of frames ever pushed.
+    std::uint64_t pushCount;
+    /// Total time spent pushing frames, in microseconds.
+    double pushTime;
+};
+
+bool RewindBuffer::hasFrame(std::uint64_t frame) const {
+  return frame >= oldestFrame && frame - oldestFrame < frameCount;
+}
+
+std::size_t RewindBuffer::getFrameCount() const {
+  return frameCount;
+}
+
+std::uint64_t RewindBuffer::getOldestFrame() const {
+  return oldestFrame;
+}
+
+std::uint64_t RewindBuffer::getNewestFrame() const {
+  return oldestFrame + frameCount - 1;
+}
+
+std::size_t RewindBuffer::getStoredBytes() const {
+  return storedBytes;
+}
+
+double RewindBuffer::getCompressionRatio() const {
+  return storedBytes > 0 ? static_cast<double>(stateBytes) / storedBytes : 1.0;
+}
+
+double RewindBuffer::getMeanPushTime() const {
+  return pushCount > 0 ? pushTime / pushCount : 0.0;
+}
+
+const RewindBuffer::Record& RewindBuffer::getRecord(std::uint64_t frame) const {
+  return records[(firstRecord + (frame - oldestFrame)) % records.size()];
+}
+
+} // namespace Nes
+
+#endif // NES_REWIND_BUFFER_H //:~
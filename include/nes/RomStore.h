@@ -0,0 +1,103 @@
+//===-- include/nes/RomStore.h - Shared ROM Store ---------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::RomStore class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_ROM_STORE_H
+#define NES_ROM_STORE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "common/CommonTypes.h"
+#include "memory/Arena.h"
+
+namespace Nes {
+
+/// \class RomStore
+/// \brief This class interns ROM images, so that every Cartridge built from
+/// the same game views one copy of its PRG ROM and CHR ROM. Images are keyed
+/// by a hash of their contents, and compared in full on a hash match, so two
+/// games never share an image by accident. An image lives as long as some
+/// Cartridge holds it, and is dropped from the store after that. The tiles
+/// of a CHR ROM image are kept decoded next to it for as long as some
+/// TileCache holds them, so instances of the same game decode them once.
+class RomStore {
+  public:
+    /// Starting value of an FNV-1a hash.
+    static constexpr const std::uint64_t HASH_SEED = 0xCBF29CE484222325ull;
+
+    /// Get the store shared by the whole process.
+    /// \returns Reference to the store.
+    static RomStore& getInstance();
+
+    /// RomStores cannot be copied.
+    RomStore(const RomStore&) = delete;
+    /// RomStores cannot be copy assigned.
+    RomStore& operator=(const RomStore&) = delete;
+
+    /// Get the image holding the given bytes, copying them into a new image
+    /// if no other Cartridge holds one.
+    /// \param data The bytes.
+    /// \param size Number of bytes.
+    /// \returns The image, which must never be written.
+    std::shared_ptr<const Memory::Arena<byte>> intern(const byte* data, std::size_t size);
+
+    /// Get the tiles of an image decoded to one byte per pixel, decoding them
+    /// if no TileCache holds them.
+    /// \param data Start of an image from intern.
+    /// \param size Number of bytes in the image.
+    /// \returns The tiles, which must never be written, or null if the bytes
+    /// are not an image in the store.
+    std::shared_ptr<const Memory::Arena<byte>> getTiles(const byte* data, std::size_t size);
+
+    /// Get the number of images held by some Cartridge.
+    /// \returns The number of live images.
+    std::size_t getImageCount();
+
+    /// Get the size of the images held by some Cartridge.
+    /// \returns The number of bytes in live images.
+    std::size_t getImageBytes();
+
+    /// Continue a 64 bit FNV-1a hash over some bytes.
+    /// \param data The bytes.
+    /// \param size Number of bytes.
+    /// \param hash The hash of the bytes before these.
+    /// \returns The hash.
+    static std::uint64_t hash(const byte* data, std::size_t size,
+        std::uint64_t hash = HASH_SEED);
+
+  private:
+    /// \struct Entry
+    /// \brief An image, and its tiles once decoded.
+    struct Entry {
+      /// The image.
+      std::weak_ptr<const Memory::Arena<byte>> image;
+      /// The decoded tiles of the image.
+      std::weak_ptr<const Memory::Arena<byte>> tiles;
+    };
+
+    /// Build an empty store.
+    RomStore() {}
+
+    /// Drop the images no Cartridge holds any more. The mutex must be held.
+    void prune();
+
+    /// Guards images.
+    std::mutex mutex;
+    /// The images, by hash. Several images may share a hash.
+    std::unordered_multimap<std::uint64_t, Entry> images;
+};
+
+} // namespace Nes
+
+#endif // NES_ROM_STORE_H //:~
@@ -0,0 +1,106 @@
+//===-- include/nes/RunAhead.h - Run-Ahead Frame Scheduler ------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::RunAhead class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_RUN_AHEAD_H
+#define NES_RUN_AHEAD_H
+
+#include <cstdint>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "nes/Console.h"
+
+namespace Nes {
+
+/// \class RunAhead
+/// \brief This class hides the frames of lag a game has between reading its
+/// input and showing the result. Each host frame it runs the real frame, saves
+/// the state, runs the given number of frames further ahead with the same
+/// input and shows the last of them, then loads the saved state, so that the
+/// picture is always that many frames ahead of the game.
+///
+/// The real frame and all but the last speculative frame are run headless,
+/// as their pictures are never shown. The speculative frames are silent, so
+/// the audio of the host frame is that of the real frame, read from the Apu
+/// with endFrame as usual.
+class RunAhead {
+  public:
+    /// Run a Console ahead.
+    /// \param console The Console.
+    /// \param frames Number of frames to run ahead.
+    RunAhead(Console& console, std::size_t frames);
+
+    /// RunAheads cannot be copied.
+    RunAhead(const RunAhead&) = delete;
+    /// RunAheads cannot be copy assigned.
+    RunAhead& operator=(const RunAhead&) = delete;
+
+    /// Destroy a RunAhead.
+    ~RunAhead() {}
+
+    /// Run one host frame: the real frame, and the frames ahead of it. The
+    /// Console is left at the end of the real frame, with the picture of the
+    /// last frame ahead in its framebuffer. With no frames ahead this is just
+    /// a frame of the Console.
+    void runFrame();
+
+    /// Set the number of frames to run ahead.
+    /// \param frames Number of frames.
+    inline void setFrames(std::size_t frames);
+
+    /// Get the number of frames run ahead.
+    /// \returns The number of frames.
+    inline std::size_t getFrames() const;
+
+    /// Get the mean time taken to run a real frame.
+    /// \returns The mean time, in microseconds.
+    inline double getMeanFrameTime() const;
+
+    /// Get the mean time added to a host frame by running ahead: saving the
+    /// state, the frames ahead, and loading the state.
+    /// \returns The mean time, in microseconds.
+    inline double getMeanRunAheadTime() const;
+
+  private:
+    /// The Console.
+    Console& console;
+    /// Number of frames to run ahead.
+    std::size_t frames;
+    /// The state at the end of the real frame.
+    std::vector<byte> state;
+    /// Number of host frames run.
+    std::uint64_t frameCount;
+    /// Total time spent on real frames, in microseconds.
+    double frameTime;
+    /// Total time spent running ahead, in microseconds.
+    double runAheadTime;
+};
+
+void RunAhead::setFrames(std::size_t frames) {
+  this->frames = frames;
+}
+
+std::size_t RunAhead::getFrames() const {
+  return frames;
+}
+
+double RunAhead::getMeanFrameTime() const {
+  return frameCount > 0 ? frameTime / frameCount : 0.0;
+}
+
+double RunAhead::getMeanRunAheadTime() const {
+  return frameCount > 0 ? runAheadTime / frameCount : 0.0;
+}
+
+} // namespace Nes
+
+#endif // NES_RUN_AHEAD_H //:~
@@ -0,0 +1,135 @@
+//===-- include/nes/TileCache.h - Decoded CHR Tile Cache --------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::TileCache class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_TILE_CACHE_H
+#define NES_TILE_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "memory/Arena.h"
+#include "memory/Bank.h"
+
+namespace Nes {
+
+/// \class TileCache
+/// \brief This class holds CHR memory decoded from 2 bit planar tiles into one
+/// byte per pixel. Tiles are addressed by their offset into CHR memory, which
+/// is the same whatever window a bank is mapped into, so bank switching costs
+/// nothing. CHR ROM interned in the RomStore is decoded once per game, and
+/// every cache of it reads the same tiles. Other CHR memory is decoded
+/// privately: an 8kB bank is allocated and decoded in one go the first time
+/// any of its tiles is used. CHR RAM writes must be reported, and mark just
+/// the written tile for decoding again.
+class TileCache {
+  public:
+    /// Size of a bank of CHR memory decoded at once.
+    static constexpr const std::size_t BANK_SIZE = 0x2000;
+    /// Size of a planar tile.
+    static constexpr const std::size_t TILE_SIZE = 16;
+    /// Number of tiles in a bank.
+    static constexpr const std::size_t TILES_PER_BANK = BANK_SIZE / TILE_SIZE;
+    /// Number of pixels in a decoded tile.
+    static constexpr const std::size_t PIXELS_PER_TILE = 64;
+
+    /// Build an empty cache of the given CHR memory.
+    /// \param chrMemory Bank at the start of CHR memory.
+    /// \param chrSize Number of bytes of CHR memory.
+    /// \param chrWritable true if the CHR memory is CHR RAM. CHR ROM is read
+    /// from the tiles the RomStore keeps for it, if it is an interned image.
+    TileCache(const Memory::Bank<byte>& chrMemory, std::size_t chrSize, bool chrWritable);
+
+    /// TileCaches cannot be copied.
+    TileCache(const TileCache&) = delete;
+    /// TileCaches cannot be copy assigned.
+    TileCache& operator=(const TileCache&) = delete;
+
+    /// Destroy a TileCache.
+    ~TileCache() {}
+
+    /// Get the decoded row of a tile.
+    /// \param offset Offset into CHR memory of the row's low bitplane byte.
+    /// \returns Pointer to the 8 pixels of the row, left to right, each 0 to 3.
+    inline const byte* getRow(std::size_t offset);
+
+    /// Mark the tile holding a byte of CHR memory as changed. Only CHR RAM
+    /// can change.
+    /// \param offset Offset into CHR memory of the written byte.
+    inline void invalidate(std::size_t offset);
+
+    /// Check whether a bank has been decoded.
+    /// \param bank Index of the 8kB bank.
+    /// \returns true if the bank has been decoded.
+    bool isBankDecoded(std::size_t bank) const;
+
+    /// Check whether the tiles are shared with every other cache of the same
+    /// CHR ROM.
+    /// \returns true if the tiles are shared.
+    bool isShared() const;
+
+    /// Decode planar tiles into one byte per pixel.
+    /// \param chr The planar tiles.
+    /// \param size Number of bytes of tiles.
+    /// \param pixels Receives PIXELS_PER_TILE for every tile.
+    static void decode(const byte* chr, std::size_t size, byte* pixels);
+
+  private:
+    /// Decode the tile, or allocate and decode its whole bank if the bank was
+    /// never decoded.
+    /// \param tile Index of the tile in CHR memory.
+    void refresh(std::size_t tile);
+
+    /// Decode one tile into its private bank.
+    /// \param tile Index of the tile in CHR memory.
+    void decodeTile(std::size_t tile);
+
+    /// Check whether a tile needs decoding.
+    inline bool isDirty(std::size_t tile) const;
+
+    /// The planar CHR memory.
+    const Memory::Bank<byte>& chrMemory;
+    /// Size of CHR memory.
+    std::size_t chrSize;
+    /// Decoded CHR ROM shared through the RomStore, or null.
+    std::shared_ptr<const Memory::Arena<byte>> sharedTiles;
+    /// Privately decoded pixels of each bank, empty until the bank is used.
+    std::vector<Memory::Arena<byte>> privateBanks;
+    /// Decoded pixels of each bank, PIXELS_PER_TILE for every tile, or null
+    /// until the bank is decoded.
+    std::vector<const byte*> banks;
+    /// One bit per tile, set while a tile needs decoding.
+    std::vector<std::uint64_t> dirtyTiles;
+};
+
+const byte* TileCache::getRow(std::size_t offset) {
+  std::size_t tile = offset / TILE_SIZE;
+  if(isDirty(tile)) {
+    refresh(tile);
+  }
+  return banks[tile / TILES_PER_BANK] + (tile % TILES_PER_BANK) * PIXELS_PER_TILE
+      + (offset & 0x7) * 8;
+}
+
+void TileCache::invalidate(std::size_t offset) {
+  std::size_t tile = offset / TILE_SIZE;
+  dirtyTiles[tile / 64] |= std::uint64_t(1) << (tile % 64);
+}
+
+bool TileCache::isDirty(std::size_t tile) const {
+  return (dirtyTiles[tile / 64] >> (tile % 64)) & 0x1;
+}
+
+} // namespace Nes
+
+#endif // NES_TILE_CACHE_H //
@@ -0,0 +1,126 @@
+//===-- include/nes/VideoConverter.h - Video Output Conversion --*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::VideoConverter class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_VIDEO_CONVERTER_H
+#define NES_VIDEO_CONVERTER_H
+
+#include <array>
+#include <cstdint>
+
+#include "common/CommonTypes.h"
+
+namespace Nes {
+
+/// \class VideoConverter
+/// \brief This class converts frames of Ppu palette indices into the pixel
+/// formats of video outputs: RGBA8888, planar YUV 4:2:0, and grayscale. Every output
+/// value depends only on the palette index and the colour emphasis, so
+/// conversion is a lookup in a 64 entry table per output channel, which fits
+/// in four SSE registers and is done 16 or 32 pixels at a time with byte
+/// shuffles instead of gathers. Frames are scaled up by nearest neighbour
+/// while they are still one byte per pixel, before conversion.
+class VideoConverter {
+  public:
+    /// Number of entries in the Nes palette.
+    static constexpr const std::size_t PALETTE_SIZE = 64;
+    /// Number of combinations of the colour emphasis bits.
+    static constexpr const std::size_t NUM_EMPHASES = 8;
+
+    /// Build a converter for the palette of the 2C02.
+    VideoConverter();
+
+    /// Build a converter for the given palette.
+    /// \param palette The colour of each palette index, as 0xRRGGBB.
+    explicit VideoConverter(const std::array<std::uint32_t, PALETTE_SIZE>& palette);
+
+    /// Get the colour of a palette index.
+    /// \param index Palette index, 0 to 63.
+    /// \param emphasis Colour emphasis bits, as returned by Ppu::getEmphasis.
+    /// \returns The colour, as 0xRRGGBB.
+    std::uint32_t getRgb(byte index, byte emphasis) const;
+
+    /// Get the YUV of a palette index, in BT.601 studio swing.
+    /// \param index Palette index, 0 to 63.
+    /// \param emphasis Colour emphasis bits.
+    /// \returns The Y, U and V components.
+    std::array<byte, 3> getYuv(byte index, byte emphasis) const;
+
+    /// Convert palette indices to RGBA8888, R in the lowest address.
+    /// \param indices The palette indices.
+    /// \param count Number of pixels.
+    /// \param emphasis Colour emphasis bits.
+    /// \param rgba 4 * count bytes receiving the pixels.
+    void toRgba(const byte* indices, std::size_t count, byte emphasis, byte* rgba) const;
+
+    /// Convert a frame of palette indices to planar YUV 4:2:0. Each chroma
+    /// sample is the average of a 2x2 block of pixels, averaging the rows
+    /// then the columns, rounding up each time.
+    /// \param indices The palette indices, width * height.
+    /// \param width Width of the frame, a multiple of 2.
+    /// \param height Height of the frame, a multiple of 2.
+    /// \param emphasis Colour emphasis bits.
+    /// \param yPlane width * height bytes receiving luma.
+    /// \param uPlane width * height / 4 bytes receiving blue difference chroma.
+    /// \param vPlane width * height / 4 bytes receiving red difference chroma.
+    void toYuv420(const byte* indices, std::size_t width, std::size_t height,
+        byte emphasis, byte* yPlane, byte* uPlane, byte* vPlane) const;
+
+    /// Get the gray level of a palette index, its BT.601 luma in full swing.
+    /// \param index Palette index, 0 to 63.
+    /// \param emphasis Colour emphasis bits.
+    /// \returns The gray level.
+    byte getGray(byte index, byte emphasis) const;
+
+    /// Convert palette indices to gray levels, as getGray does.
+    /// \param indices The palette indices.
+    /// \param count Number of pixels.
+    /// \param emphasis Colour emphasis bits.
+    /// \param gray count bytes receiving the gray levels.
+    void toGray(const byte* indices, std::size_t count, byte emphasis, byte* gray) const;
+
+    /// Scale a frame of one byte pixels up by nearest neighbour.
+    /// \param source The frame, width * height bytes.
+    /// \param width Width of the frame.
+    /// \param height Height of the frame.
+    /// \param factor Scale factor, at least 1.
+    /// \param destination width * height * factor * factor bytes receiving
+    /// the scaled frame.
+    static void scale(const byte* source, std::size_t width, std::size_t height,
+        std::size_t factor, byte* destination);
+
+  private:
+    /// Output channels with a lookup table.
+    enum Channel {
+      RED,
+      GREEN,
+      BLUE,
+      LUMA,
+      BLUE_CHROMA,
+      RED_CHROMA,
+      GRAY,
+      NUM_CHANNELS
+    };
+
+    /// Get the lookup table of a channel.
+    inline const byte* getTable(byte emphasis, Channel channel) const;
+
+    /// Lookup tables, indexed by emphasis, channel and palette index.
+    alignas(16) byte tables[NUM_EMPHASES][NUM_CHANNELS][PALETTE_SIZE];
+};
+
+const byte* VideoConverter::getTable(byte emphasis, Channel channel) const {
+  return tables[emphasis & (NUM_EMPHASES - 1)][channel];
+}
+
+} // namespace Nes
+
+#endif // NES_VIDEO_CONVERTER_H //
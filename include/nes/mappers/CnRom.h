@@ -0,0 +1,80 @@
+//===-- include/nes/mappers/CnRom.h - CnRom Mapper --------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//  
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Mappers::CnRom class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_CNROM_MAPPER_H
+#define NES_CNROM_MAPPER_H
+
+#include <memory>
+
+#include "common/CommonTypes.h"
+#include "memory/Mapper.h"
+#include "memory/Bank.h"
+#include "nes/CartridgeMapper.h"
+
+namespace Nes {
+namespace Mappers {
+
+/// \class CnRom
+/// \brief This class represents the memory mapper from Nintendo CNROM
+/// cartridges. PRG ROM is mapped as on NROM, and any write to PRG ROM space
+/// switches the 8kB CHR ROM bank.
+class CnRom : public CartridgeMapper {
+  /// CartridgeMapperBuilder is a friend of the CnRom. CnRom mappers
+  /// can only be built by the CartridgeMapperBuilder.
+  friend CartridgeMapperBuilder;
+
+  public:
+    /// The index of this memory mapper, specified by the iNES format. 
+    static constexpr const std::size_t iNesIndex = 0x03;
+
+    /// Destroy a CnRom
+    ~CnRom() {}
+
+    /// Get the name of this Mapper.
+    /// \returns CnRom
+    const std::string getName() const override {
+      return "CnRom";
+    }
+
+  protected:
+    /// Handle a write to one of the CnRom registers.
+    /// \param vaddr Address written, $8000-$FFFF.
+    /// \param data Data written.
+    void writeRegister(Vaddr vaddr, byte data) override;
+
+  private:
+    /// Size of each PRG ROM window.
+    static constexpr const std::size_t PRG_WINDOW_SIZE = 0x4000;
+
+    /// Size of the CHR window.
+    static constexpr const std::size_t CHR_WINDOW_SIZE = 0x2000;
+
+    /// Construct a CnRom.
+    /// \param prgRams The array of PRG RAMs from the containing cartridge.
+    /// \param prgRoms The array of PRG ROMs from the containing cartridge.
+    /// \param chrRoms The array of CHR ROMs from the containing cartridge.
+    /// \param chrRams The array of CHR RAMs from the containing cartridge.
+    /// \param mirroring The nametable mirroring wired on the cartridge.
+    CnRom(
+        std::vector<Memory::Ram<byte>>& prgRams,
+        std::vector<Memory::Rom<byte>>& prgRoms,
+        std::vector<Memory::Rom<byte>>& chrRoms,
+        std::vector<Memory::Ram<byte>>& chrRams,
+        Mirroring mirroring
+        );
+
+};
+
+} // namespace Mappers
+} // namespace Nes
+
+#endif // NES_CNROM_MAPPER_H //
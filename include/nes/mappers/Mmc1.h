@@ -0,0 +1,116 @@
+//===-- include/nes/mappers/Mmc1.h - MMC1 Mapper ----------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//  
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Mappers::Mmc1 class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_MMC1_MAPPER_H
+#define NES_MMC1_MAPPER_H
+
+#include <memory>
+
+#include "common/CommonTypes.h"
+#include "memory/Mapper.h"
+#include "memory/Bank.h"
+#include "nes/CartridgeMapper.h"
+
+namespace Nes {
+namespace Mappers {
+
+/// \class Mmc1
+/// \brief This class represents the memory mapper from Nintendo SxROM
+/// cartridges, built around the MMC1. Registers are loaded serially, one bit
+/// per write, through a 5 bit shift register. PRG ROM is switched as one 32kB
+/// bank or two 16kB banks with either one fixed, and CHR as one 8kB bank or
+/// two 4kB banks.
+class Mmc1 : public CartridgeMapper {
+  /// CartridgeMapperBuilder is a friend of the Mmc1. Mmc1 mappers
+  /// can only be built by the CartridgeMapperBuilder.
+  friend CartridgeMapperBuilder;
+
+  public:
+    /// The index of this memory mapper, specified by the iNES format. 
+    static constexpr const std::size_t iNesIndex = 0x01;
+
+    /// Destroy an Mmc1
+    ~Mmc1() {}
+
+    /// Get the name of this Mapper.
+    /// \returns Mmc1
+    const std::string getName() const override {
+      return "Mmc1";
+    }
+
+  protected:
+    /// Handle a write to one of the Mmc1 registers.
+    /// \param vaddr Address written, $8000-$FFFF.
+    /// \param data Data written.
+    void writeRegister(Vaddr vaddr, byte data) override;
+
+    /// Write the Mmc1 registers to a saved state.
+    /// \param writer The state being written.
+    void saveRegisters(Structure::StateWriter& writer) const override;
+
+    /// Read the Mmc1 registers from a saved state.
+    /// \param reader The state being read.
+    void loadRegisters(Structure::StateReader& reader) override;
+
+  private:
+    /// Size of each PRG ROM window. 32kB banks span both windows.
+    static constexpr const std::size_t PRG_WINDOW_SIZE = 0x4000;
+
+    /// Size of each CHR window. 8kB banks span both windows.
+    static constexpr const std::size_t CHR_WINDOW_SIZE = 0x1000;
+
+    /// Value of the shift register when empty. The marker bit reaches bit 0
+    /// when the fifth bit is shifted in.
+    static constexpr const byte SHIFT_RESET = 0x10;
+
+    /// Control register value at power on and after a reset, fixing the last
+    /// PRG ROM bank at $C000.
+    static constexpr const byte CONTROL_RESET = 0x0C;
+
+    /// Construct an Mmc1.
+    /// \param prgRams The array of PRG RAMs from the containing cartridge.
+    /// \param prgRoms The array of PRG ROMs from the containing cartridge.
+    /// \param chrRoms The array of CHR ROMs from the containing cartridge.
+    /// \param chrRams The array of CHR RAMs from the containing cartridge.
+    /// \param mirroring The nametable mirroring wired on the cartridge.
+    Mmc1(
+        std::vector<Memory::Ram<byte>>& prgRams,
+        std::vector<Memory::Rom<byte>>& prgRoms,
+        std::vector<Memory::Rom<byte>>& chrRoms,
+        std::vector<Memory::Ram<byte>>& chrRams,
+        Mirroring mirroring
+        );
+
+    /// Map the banks selected by the registers into the windows.
+    void updateBanks();
+
+    /// The serial shift register.
+    byte shift;
+
+    /// The control register, mirroring and bank modes.
+    byte control;
+
+    /// The CHR bank register for $0000.
+    byte chrBank0;
+
+    /// The CHR bank register for $1000.
+    byte chrBank1;
+
+    /// The PRG bank register.
+    byte prgBank;
+
+};
+
+} // namespace Mappers
+} // namespace Nes
+
+#endif // NES_MMC1_MAPPER_H //
@@ -0,0 +1,126 @@
+//===-- include/nes/mappers/Mmc3.h - MMC3 Mapper ----------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//  
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Mappers::Mmc3 class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_MMC3_MAPPER_H
+#define NES_MMC3_MAPPER_H
+
+#include <array>
+#include <memory>
+
+#include "common/CommonTypes.h"
+#include "memory/Mapper.h"
+#include "memory/Bank.h"
+#include "nes/CartridgeMapper.h"
+
+namespace Nes {
+namespace Mappers {
+
+/// \class Mmc3
+/// \brief This class represents the memory mapper from Nintendo TxROM
+/// cartridges, built around the MMC3. PRG ROM is switched in four 8kB banks
+/// and CHR in two 2kB and four 1kB banks, both through eight bank registers.
+/// The MMC3 also counts scanlines to raise an IRQ.
+class Mmc3 : public CartridgeMapper {
+  /// CartridgeMapperBuilder is a friend of the Mmc3. Mmc3 mappers
+  /// can only be built by the CartridgeMapperBuilder.
+  friend CartridgeMapperBuilder;
+
+  public:
+    /// The index of this memory mapper, specified by the iNES format. 
+    static constexpr const std::size_t iNesIndex = 0x04;
+
+    /// Destroy an Mmc3
+    ~Mmc3() {}
+
+    /// Get the name of this Mapper.
+    /// \returns Mmc3
+    const std::string getName() const override {
+      return "Mmc3";
+    }
+
+    /// Clock the scanline counter, asserting an IRQ when it reaches zero.
+    void clockScanline() override;
+
+    /// Check if the scanline counter is asserting the Cpu IRQ line.
+    /// \returns True if an IRQ is pending.
+    bool isIrqAsserted() const override {
+      return irqAsserted;
+    }
+
+  protected:
+    /// Handle a write to one of the Mmc3 registers.
+    /// \param vaddr Address written, $8000-$FFFF.
+    /// \param data Data written.
+    void writeRegister(Vaddr vaddr, byte data) override;
+
+    /// Write the Mmc3 registers to a saved state.
+    /// \param writer The state being written.
+    void saveRegisters(Structure::StateWriter& writer) const override;
+
+    /// Read the Mmc3 registers from a saved state.
+    /// \param reader The state being read.
+    void loadRegisters(Structure::StateReader& reader) override;
+
+  private:
+    /// Size of each PRG ROM window.
+    static constexpr const std::size_t PRG_WINDOW_SIZE = 0x2000;
+
+    /// Size of each CHR window. 2kB banks span two windows.
+    static constexpr const std::size_t CHR_WINDOW_SIZE = 0x400;
+
+    /// Number of bank registers.
+    static constexpr const std::size_t NUM_BANK_REGISTERS = 8;
+
+    /// Construct an Mmc3.
+    /// \param prgRams The array of PRG RAMs from the containing cartridge.
+    /// \param prgRoms The array of PRG ROMs from the containing cartridge.
+    /// \param chrRoms The array of CHR ROMs from the containing cartridge.
+    /// \param chrRams The array of CHR RAMs from the containing cartridge.
+    /// \param mirroring The nametable mirroring wired on the cartridge.
+    Mmc3(
+        std::vector<Memory::Ram<byte>>& prgRams,
+        std::vector<Memory::Rom<byte>>& prgRoms,
+        std::vector<Memory::Rom<byte>>& chrRoms,
+        std::vector<Memory::Ram<byte>>& chrRams,
+        Mirroring mirroring
+        );
+
+    /// Map the banks selected by the registers into the windows.
+    void updateBanks();
+
+    /// The bank select register, target register and bank modes.
+    byte bankSelect;
+
+    /// The bank registers R0-R7.
+    std::array<byte, NUM_BANK_REGISTERS> bankRegisters;
+
+    /// The value reloaded into the scanline counter.
+    byte irqLatch;
+
+    /// The scanline counter.
+    byte irqCounter;
+
+    /// True if the counter is reloaded on the next scanline.
+    bool irqReload;
+
+    /// True if the counter reaching zero raises an IRQ.
+    bool irqEnabled;
+
+    /// True while an IRQ is pending.
+    bool irqAsserted;
+
+};
+
+} // namespace Mappers
+} // namespace Nes
+
+#endif // NES_MMC3_MAPPER_H //
@@ -25,7 +25,8 @@ namespace Mappers {
 
 /// \class NRom
 /// \brief This class represents the memory mapper from Nintendo NROM
-/// Cartridges. 
+/// Cartridges. NROM-256 maps two 16kB PRG ROMs, NROM-128 maps its single
+/// 16kB PRG ROM into both PRG ROM windows.
 class NRom : public CartridgeMapper {
   /// CartridgeMapperBuilder is a friend of the NRom. NRom mappers
   /// can only be built by the CartridgeMapperBuilder.
@@ -33,7 +34,7 @@ class NRom : public CartridgeMapper {
 
   public:
     /// The index of this memory mapper, specified by the iNES format. 
-    static constexpr const size_t& iNesIndex = 0x00;
+    static constexpr const size_t iNesIndex = 0x00;
 
     /// Destroy an NRom
     ~NRom() {}
@@ -44,20 +45,25 @@ class NRom : public CartridgeMapper {
       return "NRom";
     }
 
-    /// Map an address from the Cpu to a piece of hardware in the Cartridge.
-    /// \param vaddr Virtual address from the Cpu.
-    /// \returns shared_ptr to the hardware on the Cartridge.
-    std::shared_ptr<Memory::Bank<byte>> mapToHardware(Vaddr vaddr) const override;
-
   private:
+    /// Size of each PRG ROM window.
+    static constexpr const std::size_t PRG_WINDOW_SIZE = 0x4000;
+
+    /// Size of the CHR window.
+    static constexpr const std::size_t CHR_WINDOW_SIZE = 0x2000;
+
     /// Construct an NRom.
     /// \param prgRams The array of PRG RAMs from the containing cartridge.
     /// \param prgRoms The array of PRG ROMs from the containing cartridge.
     /// \param chrRoms The array of CHR ROMs from the containing cartridge.
+    /// \param chrRams The array of CHR RAMs from the containing cartridge.
+    /// \param mirroring The nametable mirroring wired on the cartridge.
     NRom(
-        std::vector<std::shared_ptr<Memory::Ram<byte>>>& prgRams,
-        std::vector<std::shared_ptr<Memory::Rom<byte>>>& prgRoms,
-        std::vector<std::shared_ptr<Memory::Rom<byte>>>& chrRoms
+        std::vector<Memory::Ram<byte>>& prgRams,
+        std::vector<Memory::Rom<byte>>& prgRoms,
+        std::vector<Memory::Rom<byte>>& chrRoms,
+        std::vector<Memory::Ram<byte>>& chrRams,
+        Mirroring mirroring
         );
 
 };
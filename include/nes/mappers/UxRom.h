@@ -0,0 +1,81 @@
+//===-- include/nes/mappers/UxRom.h - UxRom Mapper --------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//  
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the Nes::Mappers::UxRom class.
+///
+//===----------------------------------------------------------------------===//
+#ifndef NES_UXROM_MAPPER_H
+#define NES_UXROM_MAPPER_H
+
+#include <memory>
+
+#include "common/CommonTypes.h"
+#include "memory/Mapper.h"
+#include "memory/Bank.h"
+#include "nes/CartridgeMapper.h"
+
+namespace Nes {
+namespace Mappers {
+
+/// \class UxRom
+/// \brief This class represents the memory mapper from Nintendo UNROM and
+/// UOROM cartridges. Any write to PRG ROM space switches the 16kB PRG ROM bank
+/// at $8000, while the last bank is fixed at $C000. CHR is a single 8kB bank,
+/// usually RAM.
+class UxRom : public CartridgeMapper {
+  /// CartridgeMapperBuilder is a friend of the UxRom. UxRom mappers
+  /// can only be built by the CartridgeMapperBuilder.
+  friend CartridgeMapperBuilder;
+
+  public:
+    /// The index of this memory mapper, specified by the iNES format. 
+    static constexpr const std::size_t iNesIndex = 0x02;
+
+    /// Destroy a UxRom
+    ~UxRom() {}
+
+    /// Get the name of this Mapper.
+    /// \returns UxRom
+    const std::string getName() const override {
+      return "UxRom";
+    }
+
+  protected:
+    /// Handle a write to one of the UxRom registers.
+    /// \param vaddr Address written, $8000-$FFFF.
+    /// \param data Data written.
+    void writeRegister(Vaddr vaddr, byte data) override;
+
+  private:
+    /// Size of each PRG ROM window.
+    static constexpr const std::size_t PRG_WINDOW_SIZE = 0x4000;
+
+    /// Size of the CHR window.
+    static constexpr const std::size_t CHR_WINDOW_SIZE = 0x2000;
+
+    /// Construct a UxRom.
+    /// \param prgRams The array of PRG RAMs from the containing cartridge.
+    /// \param prgRoms The array of PRG ROMs from the containing cartridge.
+    /// \param chrRoms The array of CHR ROMs from the containing cartridge.
+    /// \param chrRams The array of CHR RAMs from the containing cartridge.
+    /// \param mirroring The nametable mirroring wired on the cartridge.
+    UxRom(
+        std::vector<Memory::Ram<byte>>& prgRams,
+        std::vector<Memory::Rom<byte>>& prgRoms,
+        std::vector<Memory::Rom<byte>>& chrRoms,
+        std::vector<Memory::Ram<byte>>& chrRams,
+        Mirroring mirroring
+        );
+
+};
+
+} // namespace Mappers
+} // namespace Nes
+
+#endif // NES_UXROM_MAPPER_H //
@@ -0,0 +1,135 @@
+//===-- include/opennes/OpenNesBatch.h - Batched C Interface ----*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares the C interface of the opennes shared library, which
+/// steps a batch of Consoles running the same ROM, one frame per step, and
+/// writes their observations and RAM into arrays owned by the caller. No
+/// audio is made. Steps and resets never allocate, and no exception leaves
+/// the library.
+///
+/// Observations are frames of WIDTH * HEIGHT palette indices, one byte per
+/// pixel, or, once stacking is switched on, stacks of small gray frames
+/// preprocessed inside the library. RAM snapshots are the 2kB internal RAM.
+/// The buffers of a batch are contiguous, the entry of instance i starting
+/// at i times the size of one entry, and must be aligned to
+/// OPENNES_BUFFER_ALIGNMENT bytes.
+///
+//===----------------------------------------------------------------------===//
+#ifndef OPENNES_BATCH_H
+#define OPENNES_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Width of a frame in pixels.
+#define OPENNES_FRAME_WIDTH 256
+/// Height of a frame in pixels.
+#define OPENNES_FRAME_HEIGHT 240
+/// Number of bytes in a frame.
+#define OPENNES_FRAME_SIZE (OPENNES_FRAME_WIDTH * OPENNES_FRAME_HEIGHT)
+/// Number of bytes in a RAM snapshot.
+#define OPENNES_RAM_SIZE 2048
+/// Alignment required of the frame and RAM buffers, in bytes.
+#define OPENNES_BUFFER_ALIGNMENT 64
+
+/// Status returned by the calls of the library.
+typedef enum OpenNesStatus {
+  /// The call succeeded.
+  OPENNES_OK = 0,
+  /// An argument was null, misaligned or out of range.
+  OPENNES_ERROR_ARGUMENT = 1,
+  /// The ROM could not be read.
+  OPENNES_ERROR_ROM = 2,
+  /// An instance failed while running, for example on an undefined opcode.
+  OPENNES_ERROR_EMULATION = 3
+} OpenNesStatus;
+
+/// A batch of Consoles, run on a pool of threads.
+typedef struct OpenNesBatch OpenNesBatch;
+
+/// Build a batch of Consoles running a ROM, in their power on state.
+/// \param romPath Path to an iNES file.
+/// \param count Number of instances.
+/// \param threadCount Number of threads, or 0 for one for each core.
+/// \returns The batch, or null on failure, see opennes_last_error.
+OpenNesBatch* opennes_batch_create(const char* romPath, size_t count, size_t threadCount);
+
+/// Destroy a batch, stopping its threads.
+/// \param batch The batch, or null.
+void opennes_batch_destroy(OpenNesBatch* batch);
+
+/// Get the number of instances in a batch.
+/// \param batch The batch, or null.
+/// \returns The number of instances, or 0 for a null batch.
+size_t opennes_batch_size(const OpenNesBatch* batch);
+
+/// Switch a batch from frames to stacked observations, as agents are usually
+/// trained on. Each frame is grayscaled, cropped of the 8 rows of overscan
+/// at the top and bottom, downsampled by area averaging, and pushed onto a
+/// stack of the last few kept for each instance. Observations are then the
+/// whole stack of an instance, oldest first, depth * height * width bytes,
+/// padded to a multiple of OPENNES_BUFFER_ALIGNMENT bytes so that every
+/// instance's stack is aligned. The padding is left as it is. Frames stepped
+/// without an observation buffer are not stacked, as when skipping frames.
+/// \param batch The batch.
+/// \param width Width of an observation, usually 84.
+/// \param height Height of an observation, usually 84.
+/// \param depth Number of observations stacked, usually 4.
+/// \returns OPENNES_OK, or the failure, see opennes_last_error.
+OpenNesStatus opennes_batch_set_stacking(OpenNesBatch* batch, size_t width,
+    size_t height, size_t depth);
+
+/// Get the size of the observation of one instance, OPENNES_FRAME_SIZE, or
+/// the padded size of a stack once stacking is switched on.
+/// \param batch The batch, or null.
+/// \returns The number of bytes from one instance's observation to the
+/// next, a multiple of OPENNES_BUFFER_ALIGNMENT, or 0 for a null batch.
+size_t opennes_batch_observation_size(const OpenNesBatch* batch);
+
+/// Return every instance to its power on state, and run a first frame with
+/// no buttons held.
+/// \param batch The batch.
+/// \param observations count * opennes_batch_observation_size bytes
+/// receiving the observation of each instance, or null to skip drawing. A
+/// stack is filled with the observation of this frame, which is drawn for
+/// the stack even when there is no buffer to receive it.
+/// \param ram count * OPENNES_RAM_SIZE bytes receiving the RAM of each
+/// instance, or null.
+/// \returns OPENNES_OK, or the failure, see opennes_last_error.
+OpenNesStatus opennes_batch_reset(OpenNesBatch* batch, uint8_t* observations, uint8_t* ram);
+
+/// Run a frame of every instance, each holding its own buttons on
+/// controller 1.
+/// \param batch The batch.
+/// \param actions count bytes, the buttons held on each instance, bit 0 to 7
+/// being A, B, Select, Start, Up, Down, Left and Right.
+/// \param observations count * opennes_batch_observation_size bytes
+/// receiving the observation of each instance, or null to skip drawing,
+/// which runs faster.
+/// \param ram count * OPENNES_RAM_SIZE bytes receiving the RAM of each
+/// instance, or null.
+/// \returns OPENNES_OK, or the failure, see opennes_last_error. On an
+/// emulation failure the other instances still run their frames.
+OpenNesStatus opennes_batch_step(OpenNesBatch* batch, const uint8_t* actions,
+    uint8_t* observations, uint8_t* ram);
+
+/// Get a description of the last failure on the calling thread.
+/// \returns The description, valid until the next call on this thread, or
+/// an empty string.
+const char* opennes_last_error(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // OPENNES_BATCH_H //:~
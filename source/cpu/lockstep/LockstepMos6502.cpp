@@ -0,0 +1,19 @@
+//===-- source/cpu/lockstep/LockstepMos6502.cpp - Lockstep Batch *- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the LockstepMos6502Core class, a
+/// batch of Mos6502s run in lockstep.
+///
+//===----------------------------------------------------------------------===//
+#include "cpu/lockstep/LockstepMos6502_Inst.h"
+
+// Lockstep batches of Cpus resolving memory accesses through any mapper.
+template class Cpu::LockstepMos6502Core<Memory::Mapper<byte>, 8>;
+template class Cpu::LockstepMos6502Core<Memory::Mapper<byte>, 16>;
+template class Cpu::LockstepMos6502Core<Memory::Mapper<byte>, 32>;
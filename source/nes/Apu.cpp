@@ -0,0 +1,850 @@
+//===-- source/nes/Apu.cpp - Nes Audio Processing Unit ----------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the Apu class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "common/CommonTypes.h"
+#include "nes/Apu.h"
+
+using namespace Nes;
+
+constexpr const double Apu::CPU_CLOCK_RATE;
+constexpr const std::size_t Apu::BLEP_PHASES;
+constexpr const std::size_t Apu::BLEP_TAPS;
+constexpr const std::size_t Apu::NEVER;
+
+/// Length counter loads, indexed by the top five bits of the length register.
+static const byte LENGTH_TABLE[32] = {
+  10, 254, 20, 2, 40, 4, 80, 6, 160, 8, 60, 10, 14, 12, 26, 14,
+  12, 16, 24, 18, 48, 20, 96, 22, 192, 24, 72, 26, 16, 28, 32, 30
+};
+/// Pulse duty cycle sequences, one bit per step.
+static const byte DUTY_TABLE[4] = {0x40, 0x60, 0x78, 0x9F};
+/// Triangle output at each step of its sequence.
+static const byte TRIANGLE_TABLE[32] = {
+  15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
+/// Noise timer periods in Cpu cycles.
+static const addr NOISE_PERIODS[16] = {
+  4, 8, 16, 32, 64, 96, 128, 160, 202, 254, 380, 508, 762, 1016, 2034, 4068
+};
+/// DMC timer periods in Cpu cycles.
+static const addr DMC_PERIODS[16] = {
+  428, 380, 340, 320, 286, 254, 226, 214, 190, 160, 142, 128, 106, 84, 72, 54
+};
+/// Cycles from the start of the frame counter sequence to each of its steps,
+/// for the four and five step sequences. The last step ends the sequence.
+static const std::size_t FRAME_STEPS[2][4] = {
+  {3729, 7457, 11186, 14915},
+  {3729, 7457, 11186, 18641}
+};
+/// Cutoff of the band-limited steps, as a fraction of the output Nyquist
+/// frequency.
+static const double BLEP_CUTOFF = 0.9;
+/// Corner frequency of the high pass filter of the Nes audio output, in Hz.
+static const double HIGH_PASS_FREQUENCY = 90.0;
+/// The ratio of a circle's circumference to its diameter.
+static const double PI = 3.14159265358979323846;
+/// Mask of the fractional part of a 32.32 fixed point sample position.
+static const std::uint64_t FRACTION_MASK = 0xFFFFFFFFull;
+/// Cpu cycles in an NTSC frame, rounded up.
+static const std::size_t CYCLES_PER_FRAME = 29781;
+/// Cycles the steps may run on for without endFrame before all but the last
+/// frame of them are dropped, leaving room for a frame running long.
+static const std::size_t MAX_UNDRAINED_CYCLES = CYCLES_PER_FRAME + CYCLES_PER_FRAME / 4;
+
+Apu::Apu(double sampleRate) :
+  bus(nullptr),
+  sampleRate(sampleRate),
+  timeScale(static_cast<std::uint64_t>(std::llround(sampleRate / CPU_CLOCK_RATE * 4294967296.0))),
+  sampleOffset(0),
+  cycle(0),
+  pendingCycles(0),
+  pulses(),
+  triangle(),
+  noise(),
+  dmc(),
+  fiveStepMode(false),
+  irqInhibit(false),
+  frameIrq(false),
+  dmcIrq(false),
+  frameStep(0),
+  frameStart(0),
+  nextFrameClock(FRAME_STEPS[0][0]),
+  output(0.0f),
+  headless(false),
+  integrator(0.0),
+  lastIntegrator(0.0),
+  filtered(0.0),
+  highPass(1.0 - 2.0 * PI * HIGH_PASS_FREQUENCY / sampleRate) {
+  pulses[0].onesComplement = true;
+  for(Pulse& pulse : pulses) {
+    pulse.nextClock = NEVER;
+  }
+  triangle.nextClock = NEVER;
+  noise.shift = 1;
+  noise.period = NOISE_PERIODS[0];
+  noise.nextClock = NEVER;
+  dmc.period = DMC_PERIODS[0];
+  dmc.sampleAddress = 0xC000;
+  dmc.currentAddress = 0xC000;
+  dmc.sampleLength = 1;
+  dmc.bitsRemaining = 8;
+  dmc.silence = true;
+  dmc.nextClock = DMC_PERIODS[0];
+
+  // The mixer of the Nes, approximated as in the formulas of its schematic.
+  pulseMix[0] = 0.0f;
+  for(std::size_t sum = 1; sum < pulseMix.size(); sum++) {
+    pulseMix[sum] = static_cast<float>(95.52 / (8128.0 / sum + 100.0));
+  }
+  tndMix[0] = 0.0f;
+  for(std::size_t sum = 1; sum < tndMix.size(); sum++) {
+    tndMix[sum] = static_cast<float>(163.67 / (24329.0 / sum + 100.0));
+  }
+
+  // Each kernel is a Blackman windowed sinc, centred between taps 7 and 8
+  // at its fraction of a sample, and scaled to sum to 1 so that the
+  // integrated step settles at exactly its height.
+  for(std::size_t phase = 0; phase < BLEP_PHASES; phase++) {
+    double sum = 0.0;
+    double taps[BLEP_TAPS];
+    for(std::size_t tap = 0; tap < BLEP_TAPS; tap++) {
+      double x = static_cast<double>(tap) - (BLEP_TAPS / 2 - 1)
+          - static_cast<double>(phase) / BLEP_PHASES;
+      double sinc = x == 0.0 ? 1.0 : std::sin(PI * BLEP_CUTOFF * x) / (PI * BLEP_CUTOFF * x);
+      double position = (x + BLEP_TAPS / 2) / BLEP_TAPS;
+      double window = 0.42 - 0.5 * std::cos(2.0 * PI * position)
+          + 0.08 * std::cos(4.0 * PI * position);
+      taps[tap] = sinc * window;
+      sum += taps[tap];
+    }
+    for(std::size_t tap = 0; tap < BLEP_TAPS; tap++) {
+      blepKernels[phase][tap] = static_cast<float>(taps[tap] / sum);
+    }
+  }
+  // Room for the steps of the longest run of cycles before they are dropped,
+  // at most a frame counter step past MAX_UNDRAINED_CYCLES.
+  steps.resize(static_cast<std::size_t>((MAX_UNDRAINED_CYCLES + CYCLES_PER_FRAME / 4)
+      * sampleRate / CPU_CLOCK_RATE) + BLEP_TAPS, 0.0f);
+  // The triangle rests partway up its sequence, which is not a step.
+  output = getMix();
+  cyclesUntilIrq = getCyclesUntilIrq();
+}
+
+void Apu::connect(CpuBus& bus) {
+  this->bus = &bus;
+  for(addr index = 0; index < 0x18; index++) {
+    // $4014 is OAM DMA, $4016 the controllers, and $4017 reads controller 2.
+    if(index == 0x14 || index == 0x16) {
+      continue;
+    }
+    Vaddr vaddr = {static_cast<addr>(0x4000 + index)};
+    bus.setWriteHandler(vaddr, [this](std::size_t reg, byte data) {
+      writeRegister(reg, data);
+    });
+  }
+  bus.setReadHandler({0x4015}, [this](std::size_t reg) {
+    return readRegister(reg);
+  });
+}
+
+void Apu::catchUp() {
+  // Step from each timer clock to the next in time order, so that every
+  // change to the mix is seen with the other channels as they were then.
+  std::size_t target = cycle + pendingCycles;
+  pendingCycles = 0;
+  while(true) {
+    std::size_t next = std::min({pulses[0].nextClock, pulses[1].nextClock,
+        triangle.nextClock, noise.nextClock, dmc.nextClock, nextFrameClock});
+    if(next > target) {
+      break;
+    }
+    cycle = next;
+    if(pulses[0].nextClock == next) {
+      clockPulse(pulses[0]);
+    }
+    if(pulses[1].nextClock == next) {
+      clockPulse(pulses[1]);
+    }
+    if(triangle.nextClock == next) {
+      clockTriangle();
+    }
+    if(noise.nextClock == next) {
+      clockNoise();
+    }
+    if(dmc.nextClock == next) {
+      clockDmc();
+    }
+    if(nextFrameClock == next) {
+      clockFrameCounter();
+    }
+    mix(next);
+    if(cycle >= MAX_UNDRAINED_CYCLES) {
+      target -= dropUndrained();
+    }
+  }
+  cycle = target;
+  if(cycle >= MAX_UNDRAINED_CYCLES) {
+    dropUndrained();
+  }
+  cyclesUntilIrq = getCyclesUntilIrq();
+}
+
+byte Apu::readRegister(std::size_t index) {
+  catchUp();
+  if(index != 0x15) {
+    return 0;
+  }
+  // Reading the status acknowledges the frame IRQ.
+  byte status = (pulses[0].length > 0 ? 0x01 : 0)
+      | (pulses[1].length > 0 ? 0x02 : 0)
+      | (triangle.length > 0 ? 0x04 : 0)
+      | (noise.length > 0 ? 0x08 : 0)
+      | (dmc.bytesRemaining > 0 ? 0x10 : 0)
+      | (frameIrq ? 0x40 : 0)
+      | (dmcIrq ? 0x80 : 0);
+  frameIrq = false;
+  cyclesUntilIrq = getCyclesUntilIrq();
+  return status;
+}
+
+void Apu::writeRegister(std::size_t index, byte data) {
+  catchUp();
+  switch(index) {
+    case 0x00:
+    case 0x04: {
+      Pulse& pulse = pulses[index >> 2];
+      pulse.duty = data >> 6;
+      writeEnvelope(pulse.envelope, data);
+      break;
+    }
+    case 0x01:
+    case 0x05: {
+      Pulse& pulse = pulses[index >> 2];
+      pulse.sweepEnabled = (data & 0x80) != 0;
+      pulse.sweepPeriod = (data >> 4) & 0x07;
+      pulse.sweepNegate = (data & 0x08) != 0;
+      pulse.sweepShift = data & 0x07;
+      pulse.sweepReload = true;
+      break;
+    }
+    case 0x02:
+    case 0x06: {
+      Pulse& pulse = pulses[index >> 2];
+      pulse.period = (pulse.period & 0x0700) | data;
+      break;
+    }
+    case 0x03:
+    case 0x07: {
+      Pulse& pulse = pulses[index >> 2];
+      pulse.period = (pulse.period & 0x00FF) | ((data & 0x07) << 8);
+      if(pulse.enabled) {
+        pulse.length = LENGTH_TABLE[data >> 3];
+      }
+      pulse.sequence = 0;
+      pulse.envelope.start = true;
+      break;
+    }
+    case 0x08:
+      triangle.control = (data & 0x80) != 0;
+      triangle.linearReload = data & 0x7F;
+      break;
+    case 0x0A:
+      triangle.period = (triangle.period & 0x0700) | data;
+      break;
+    case 0x0B:
+      triangle.period = (triangle.period & 0x00FF) | ((data & 0x07) << 8);
+      if(triangle.enabled) {
+        triangle.length = LENGTH_TABLE[data >> 3];
+      }
+      triangle.linearReloadFlag = true;
+      break;
+    case 0x0C:
+      writeEnvelope(noise.envelope, data);
+      break;
+    case 0x0E:
+      noise.mode = (data & 0x80) != 0;
+      noise.period = NOISE_PERIODS[data & 0x0F];
+      break;
+    case 0x0F:
+      if(noise.enabled) {
+        noise.length = LENGTH_TABLE[data >> 3];
+      }
+      noise.envelope.start = true;
+      break;
+    case 0x10:
+      dmc.irqEnabled = (data & 0x80) != 0;
+      dmc.loop = (data & 0x40) != 0;
+      dmc.period = DMC_PERIODS[data & 0x0F];
+      if(!dmc.irqEnabled) {
+        dmcIrq = false;
+      }
+      break;
+    case 0x11:
+      dmc.level = data & 0x7F;
+      break;
+    case 0x12:
+      dmc.sampleAddress = 0xC000 | (data << 6);
+      break;
+    case 0x13:
+      dmc.sampleLength = (data << 4) + 1;
+      break;
+    case 0x15:
+      pulses[0].enabled = (data & 0x01) != 0;
+      pulses[1].enabled = (data & 0x02) != 0;
+      triangle.enabled = (data & 0x04) != 0;
+      noise.enabled = (data & 0x08) != 0;
+      for(Pulse& pulse : pulses) {
+        if(!pulse.enabled) {
+          pulse.length = 0;
+        }
+      }
+      if(!triangle.enabled) {
+        triangle.length = 0;
+      }
+      if(!noise.enabled) {
+        noise.length = 0;
+      }
+      if(!(data & 0x10)) {
+        dmc.bytesRemaining = 0;
+      } else if(dmc.bytesRemaining == 0) {
+        dmc.currentAddress = dmc.sampleAddress;
+        dmc.bytesRemaining = dmc.sampleLength;
+        fetchDmcSample();
+      }
+      dmcIrq = false;
+      break;
+    case 0x17:
+      // The sequence restarts, and the five step sequence clocks its first
+      // quarter and half frame straight away.
+      fiveStepMode = (data & 0x80) != 0;
+      irqInhibit = (data & 0x40) != 0;
+      if(irqInhibit) {
+        frameIrq = false;
+      }
+      frameStep = 0;
+      frameStart = cycle;
+      nextFrameClock = cycle + FRAME_STEPS[fiveStepMode][0];
+      if(fiveStepMode) {
+        clockQuarterFrame();
+        clockHalfFrame();
+      }
+      break;
+    default:
+      break;
+  }
+  startTimers();
+  mix(cycle);
+  cyclesUntilIrq = getCyclesUntilIrq();
+}
+
+std::size_t Apu::endFrame(std::vector<std::int16_t>& samples) {
+  catchUp();
+  std::size_t count = getSampleIndex(cycle);
+  std::size_t first = samples.size();
+  samples.resize(first + count);
+  drain(cycle, samples.data() + first);
+  return count;
+}
+
+std::size_t Apu::dropUndrained() {
+  // Nobody is taking the samples, so keep only the last frame of steps, for
+  // an endFrame that may yet come, and no more.
+  std::size_t end = cycle - CYCLES_PER_FRAME;
+  drain(end, nullptr);
+  return end;
+}
+
+void Apu::drain(std::size_t end, std::int16_t* samples) {
+  std::uint64_t position = sampleOffset + end * timeScale;
+  std::size_t count = static_cast<std::size_t>(position >> 32);
+  // Integrate the steps into the output level, then take out the DC as the
+  // Nes does, with a one pole high pass filter. No step was recorded past
+  // the end of the buffer.
+  std::size_t recorded = std::min(count, steps.size());
+  for(std::size_t sample = 0; sample < count; sample++) {
+    integrator += sample < recorded ? steps[sample] : 0.0f;
+    filtered = integrator - lastIntegrator + highPass * filtered;
+    lastIntegrator = integrator;
+    if(samples != nullptr) {
+      double scaled = std::max(-32768.0, std::min(32767.0, filtered * 32767.0));
+      samples[sample] = static_cast<std::int16_t>(std::lrint(scaled));
+    }
+  }
+  // The steps after the end, and the tails of those before it, move to the
+  // front of the buffer.
+  std::copy(steps.begin() + recorded, steps.end(), steps.begin());
+  std::fill(steps.end() - recorded, steps.end(), 0.0f);
+  sampleOffset = position & FRACTION_MASK;
+
+  // Count cycles from the end.
+  auto rebase = [end](std::size_t& time) {
+    if(time != NEVER) {
+      time -= end;
+    }
+  };
+  for(Pulse& pulse : pulses) {
+    rebase(pulse.nextClock);
+  }
+  rebase(triangle.nextClock);
+  rebase(noise.nextClock);
+  rebase(dmc.nextClock);
+  rebase(nextFrameClock);
+  frameStart -= end;
+  cycle -= end;
+}
+
+void Apu::saveState(Structure::StateWriter& writer) {
+  catchUp();
+  // Channels are saved a field at a time, leaving out the padding of their
+  // structs, so that the same machine always saves the same state.
+  for(const Pulse& pulse : pulses) {
+    saveChannel(writer, pulse);
+  }
+  saveChannel(writer, triangle);
+  saveChannel(writer, noise);
+  saveChannel(writer, dmc);
+  writer.write(fiveStepMode);
+  writer.write(irqInhibit);
+  writer.write(frameIrq);
+  writer.write(dmcIrq);
+  writer.write(frameStep);
+  writer.write(frameStart);
+  writer.write(nextFrameClock);
+  writer.write(cycle);
+  writer.write(sampleOffset);
+  writer.write(output);
+  writer.write(integrator);
+  writer.write(lastIntegrator);
+  writer.write(filtered);
+  // Only the steps of the cycles not yet drained, at most a frame and a
+  // quarter, and their tails can be nonzero. A headless Apu records none,
+  // and the tails left from before are not worth saving.
+  std::size_t stepCount = headless ? 0
+      : std::min(steps.size(), getSampleIndex(cycle) + BLEP_TAPS);
+  writer.write(stepCount);
+  writer.write(steps.data(), stepCount * sizeof(float));
+}
+
+void Apu::loadState(Structure::StateReader& reader) {
+  for(Pulse& pulse : pulses) {
+    loadChannel(reader, pulse);
+  }
+  loadChannel(reader, triangle);
+  loadChannel(reader, noise);
+  loadChannel(reader, dmc);
+  reader.read(fiveStepMode);
+  reader.read(irqInhibit);
+  reader.read(frameIrq);
+  reader.read(dmcIrq);
+  reader.read(frameStep);
+  reader.read(frameStart);
+  reader.read(nextFrameClock);
+  reader.read(cycle);
+  reader.read(sampleOffset);
+  reader.read(output);
+  reader.read(integrator);
+  reader.read(lastIntegrator);
+  reader.read(filtered);
+  std::size_t stepCount = reader.read<std::size_t>();
+  // The steps are checked to be in the state before the buffer grows to
+  // hold them.
+  const byte* saved = reader.view(stepCount * sizeof(float));
+  if(steps.size() < stepCount) {
+    steps.resize(stepCount, 0.0f);
+  }
+  std::memcpy(steps.data(), saved, stepCount * sizeof(float));
+  std::fill(steps.begin() + stepCount, steps.end(), 0.0f);
+  pendingCycles = 0;
+  cyclesUntilIrq = getCyclesUntilIrq();
+}
+
+void Apu::clockPulse(Pulse& pulse) {
+  if(pulse.length == 0) {
+    // A silent pulse has no phase anyone can hear, so its timer stops until
+    // the length counter is loaded.
+    pulse.nextClock = NEVER;
+    return;
+  }
+  pulse.sequence = (pulse.sequence + 7) & 0x07;
+  pulse.nextClock += (pulse.period + 1) * 2;
+}
+
+void Apu::clockTriangle() {
+  if(!isTriangleRunning()) {
+    triangle.nextClock = NEVER;
+    return;
+  }
+  triangle.sequence = (triangle.sequence + 1) & 0x1F;
+  triangle.nextClock += triangle.period + 1;
+}
+
+void Apu::clockNoise() {
+  if(noise.length == 0) {
+    noise.nextClock = NEVER;
+    return;
+  }
+  std::uint16_t feedback = (noise.shift ^ (noise.shift >> (noise.mode ? 6 : 1))) & 0x01;
+  noise.shift = (noise.shift >> 1) | (feedback << 14);
+  noise.nextClock += noise.period;
+}
+
+void Apu::clockDmc() {
+  if(!dmc.silence) {
+    if(dmc.shift & 0x01) {
+      if(dmc.level <= 125) {
+        dmc.level += 2;
+      }
+    } else if(dmc.level >= 2) {
+      dmc.level -= 2;
+    }
+  }
+  dmc.shift >>= 1;
+  if(--dmc.bitsRemaining == 0) {
+    dmc.bitsRemaining = 8;
+    dmc.silence = !dmc.bufferFull;
+    if(dmc.bufferFull) {
+      dmc.shift = dmc.buffer;
+      dmc.bufferFull = false;
+      fetchDmcSample();
+    }
+  }
+  dmc.nextClock += dmc.period;
+}
+
+void Apu::fetchDmcSample() {
+  if(dmc.bufferFull || dmc.bytesRemaining == 0) {
+    return;
+  }
+  if(bus != nullptr) {
+    Vaddr vaddr = {dmc.currentAddress};
+    Memory::Bank<byte>* bank = bus->mapToHardware(vaddr);
+    dmc.buffer = bank->read(bank->getIndex(vaddr));
+  } else {
+    dmc.buffer = 0;
+  }
+  dmc.bufferFull = true;
+  dmc.currentAddress = dmc.currentAddress == 0xFFFF ? 0x8000 : dmc.currentAddress + 1;
+  if(--dmc.bytesRemaining == 0) {
+    if(dmc.loop) {
+      dmc.currentAddress = dmc.sampleAddress;
+      dmc.bytesRemaining = dmc.sampleLength;
+    } else if(dmc.irqEnabled) {
+      dmcIrq = true;
+    }
+  }
+}
+
+void Apu::clockFrameCounter() {
+  // Steps 1 and 3 clock half frames as well as quarter frames, and the four
+  // step sequence raises an IRQ at its end.
+  clockQuarterFrame();
+  if(frameStep & 0x01) {
+    clockHalfFrame();
+  }
+  if(frameStep == 3 && !fiveStepMode && !irqInhibit) {
+    frameIrq = true;
+  }
+  if(++frameStep == 4) {
+    frameStep = 0;
+    frameStart += FRAME_STEPS[fiveStepMode][3];
+  }
+  nextFrameClock = frameStart + FRAME_STEPS[fiveStepMode][frameStep];
+  startTimers();
+}
+
+void Apu::clockQuarterFrame() {
+  clockEnvelope(pulses[0].envelope);
+  clockEnvelope(pulses[1].envelope);
+  clockEnvelope(noise.envelope);
+  if(triangle.linearReloadFlag) {
+    triangle.linearCounter = triangle.linearReload;
+  } else if(triangle.linearCounter > 0) {
+    triangle.linearCounter--;
+  }
+  if(!triangle.control) {
+    triangle.linearReloadFlag = false;
+  }
+}
+
+void Apu::clockHalfFrame() {
+  for(Pulse& pulse : pulses) {
+    if(!pulse.envelope.loop && pulse.length > 0) {
+      pulse.length--;
+    }
+    int target = getSweepTarget(pulse);
+    if(pulse.sweepDivider == 0 && pulse.sweepEnabled && pulse.sweepShift > 0
+        && !isMuted(pulse)) {
+      pulse.period = static_cast<addr>(target);
+    }
+    if(pulse.sweepDivider == 0 || pulse.sweepReload) {
+      pulse.sweepDivider = pulse.sweepPeriod;
+      pulse.sweepReload = false;
+    } else {
+      pulse.sweepDivider--;
+    }
+  }
+  if(!triangle.control && triangle.length > 0) {
+    triangle.length--;
+  }
+  if(!noise.envelope.loop && noise.length > 0) {
+    noise.length--;
+  }
+}
+
+void Apu::startTimers() {
+  for(Pulse& pulse : pulses) {
+    if(pulse.nextClock == NEVER && pulse.length > 0) {
+      pulse.nextClock = cycle + (pulse.period + 1) * 2;
+    }
+  }
+  if(triangle.nextClock == NEVER && isTriangleRunning()) {
+    triangle.nextClock = cycle + triangle.period + 1;
+  }
+  if(noise.nextClock == NEVER && noise.length > 0) {
+    noise.nextClock = cycle + noise.period;
+  }
+}
+
+int Apu::getSweepTarget(const Pulse& pulse) {
+  int change = pulse.period >> pulse.sweepShift;
+  if(pulse.sweepNegate) {
+    return pulse.period - change - (pulse.onesComplement ? 1 : 0);
+  }
+  return pulse.period + change;
+}
+
+bool Apu::isMuted(const Pulse& pulse) {
+  return pulse.period < 8 || getSweepTarget(pulse) > 0x7FF;
+}
+
+byte Apu::getOutput(const Pulse& pulse) {
+  if(pulse.length == 0 || isMuted(pulse)
+      || !((DUTY_TABLE[pulse.duty] >> pulse.sequence) & 0x01)) {
+    return 0;
+  }
+  return pulse.envelope.constant ? pulse.envelope.volume : pulse.envelope.decay;
+}
+
+void Apu::saveChannel(Structure::StateWriter& writer, const Envelope& envelope) {
+  writer.write(envelope.start);
+  writer.write(envelope.loop);
+  writer.write(envelope.constant);
+  writer.write(envelope.volume);
+  writer.write(envelope.divider);
+  writer.write(envelope.decay);
+}
+
+void Apu::saveChannel(Structure::StateWriter& writer, const Pulse& pulse) {
+  saveChannel(writer, pulse.envelope);
+  writer.write(pulse.duty);
+  writer.write(pulse.sequence);
+  writer.write(pulse.period);
+  writer.write(pulse.length);
+  writer.write(pulse.enabled);
+  writer.write(pulse.sweepEnabled);
+  writer.write(pulse.sweepNegate);
+  writer.write(pulse.sweepReload);
+  writer.write(pulse.sweepPeriod);
+  writer.write(pulse.sweepShift);
+  writer.write(pulse.sweepDivider);
+  writer.write(pulse.onesComplement);
+  writer.write(pulse.nextClock);
+}
+
+void Apu::saveChannel(Structure::StateWriter& writer, const Triangle& triangle) {
+  writer.write(triangle.period);
+  writer.write(triangle.sequence);
+  writer.write(triangle.length);
+  writer.write(triangle.enabled);
+  writer.write(triangle.control);
+  writer.write(triangle.linearReload);
+  writer.write(triangle.linearCounter);
+  writer.write(triangle.linearReloadFlag);
+  writer.write(triangle.nextClock);
+}
+
+void Apu::saveChannel(Structure::StateWriter& writer, const Noise& noise) {
+  saveChannel(writer, noise.envelope);
+  writer.write(noise.mode);
+  writer.write(noise.period);
+  writer.write(noise.shift);
+  writer.write(noise.length);
+  writer.write(noise.enabled);
+  writer.write(noise.nextClock);
+}
+
+void Apu::saveChannel(Structure::StateWriter& writer, const Dmc& dmc) {
+  writer.write(dmc.irqEnabled);
+  writer.write(dmc.loop);
+  writer.write(dmc.period);
+  writer.write(dmc.level);
+  writer.write(dmc.sampleAddress);
+  writer.write(dmc.sampleLength);
+  writer.write(dmc.currentAddress);
+  writer.write(dmc.bytesRemaining);
+  writer.write(dmc.buffer);
+  writer.write(dmc.bufferFull);
+  writer.write(dmc.shift);
+  writer.write(dmc.bitsRemaining);
+  writer.write(dmc.silence);
+  writer.write(dmc.nextClock);
+}
+
+void Apu::loadChannel(Structure::StateReader& reader, Envelope& envelope) {
+  reader.read(envelope.start);
+  reader.read(envelope.loop);
+  reader.read(envelope.constant);
+  reader.read(envelope.volume);
+  reader.read(envelope.divider);
+  reader.read(envelope.decay);
+}
+
+void Apu::loadChannel(Structure::StateReader& reader, Pulse& pulse) {
+  loadChannel(reader, pulse.envelope);
+  reader.read(pulse.duty);
+  reader.read(pulse.sequence);
+  reader.read(pulse.period);
+  reader.read(pulse.length);
+  reader.read(pulse.enabled);
+  reader.read(pulse.sweepEnabled);
+  reader.read(pulse.sweepNegate);
+  reader.read(pulse.sweepReload);
+  reader.read(pulse.sweepPeriod);
+  reader.read(pulse.sweepShift);
+  reader.read(pulse.sweepDivider);
+  reader.read(pulse.onesComplement);
+  reader.read(pulse.nextClock);
+}
+
+void Apu::loadChannel(Structure::StateReader& reader, Triangle& triangle) {
+  reader.read(triangle.period);
+  reader.read(triangle.sequence);
+  reader.read(triangle.length);
+  reader.read(triangle.enabled);
+  reader.read(triangle.control);
+  reader.read(triangle.linearReload);
+  reader.read(triangle.linearCounter);
+  reader.read(triangle.linearReloadFlag);
+  reader.read(triangle.nextClock);
+}
+
+void Apu::loadChannel(Structure::StateReader& reader, Noise& noise) {
+  loadChannel(reader, noise.envelope);
+  reader.read(noise.mode);
+  reader.read(noise.period);
+  reader.read(noise.shift);
+  reader.read(noise.length);
+  reader.read(noise.enabled);
+  reader.read(noise.nextClock);
+}
+
+void Apu::loadChannel(Structure::StateReader& reader, Dmc& dmc) {
+  reader.read(dmc.irqEnabled);
+  reader.read(dmc.loop);
+  reader.read(dmc.period);
+  reader.read(dmc.level);
+  reader.read(dmc.sampleAddress);
+  reader.read(dmc.sampleLength);
+  reader.read(dmc.currentAddress);
+  reader.read(dmc.bytesRemaining);
+  reader.read(dmc.buffer);
+  reader.read(dmc.bufferFull);
+  reader.read(dmc.shift);
+  reader.read(dmc.bitsRemaining);
+  reader.read(dmc.silence);
+  reader.read(dmc.nextClock);
+}
+
+byte Apu::getNoiseOutput() const {
+  if(noise.length == 0 || (noise.shift & 0x01)) {
+    return 0;
+  }
+  return noise.envelope.constant ? noise.envelope.volume : noise.envelope.decay;
+}
+
+bool Apu::isTriangleRunning() const {
+  // Periods below 2 are ultrasonic, and halted rather than aliased.
+  return triangle.length > 0 && triangle.linearCounter > 0 && triangle.period >= 2;
+}
+
+void Apu::clockEnvelope(Envelope& envelope) {
+  if(envelope.start) {
+    envelope.start = false;
+    envelope.decay = 15;
+    envelope.divider = envelope.volume;
+  } else if(envelope.divider == 0) {
+    envelope.divider = envelope.volume;
+    if(envelope.decay > 0) {
+      envelope.decay--;
+    } else if(envelope.loop) {
+      envelope.decay = 15;
+    }
+  } else {
+    envelope.divider--;
+  }
+}
+
+void Apu::writeEnvelope(Envelope& envelope, byte data) {
+  envelope.loop = (data & 0x20) != 0;
+  envelope.constant = (data & 0x10) != 0;
+  envelope.volume = data & 0x0F;
+}
+
+float Apu::getMix() const {
+  return pulseMix[getOutput(pulses[0]) + getOutput(pulses[1])]
+      + tndMix[3 * TRIANGLE_TABLE[triangle.sequence] + 2 * getNoiseOutput() + dmc.level];
+}
+
+void Apu::mix(std::size_t time) {
+  if(headless) {
+    return;
+  }
+  float level = getMix();
+  if(level != output) {
+    addStep(time, level - output);
+    output = level;
+  }
+}
+
+void Apu::addStep(std::size_t time, float delta) {
+  std::uint64_t position = sampleOffset + time * timeScale;
+  std::size_t index = static_cast<std::size_t>(position >> 32);
+  // Steps are drained or dropped at least every MAX_UNDRAINED_CYCLES, so
+  // the buffer settles at a little over a frame.
+  const float* kernel =
+      blepKernels[((position & FRACTION_MASK) * BLEP_PHASES) >> 32];
+  if(steps.size() < index + BLEP_TAPS) {
+    steps.resize(index + BLEP_TAPS, 0.0f);
+  }
+  float* step = &steps[index];
+  for(std::size_t tap = 0; tap < BLEP_TAPS; tap++) {
+    step[tap] += delta * kernel[tap];
+  }
+}
+
+std::size_t Apu::getCyclesUntilIrq() const {
+  // The frame IRQ can only be raised by a frame counter step, and the DMC
+  // IRQ by a sample fetch, which happens on a DMC clock.
+  std::size_t next = NEVER;
+  if(!fiveStepMode && !irqInhibit) {
+    next = nextFrameClock;
+  }
+  if(dmc.irqEnabled && dmc.bytesRemaining > 0) {
+    next = std::min(next, dmc.nextClock);
+  }
+  return next == NEVER ? NEVER : next - cycle;
+}
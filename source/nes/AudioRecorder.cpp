@@ -0,0 +1,165 @@
+//===-- source/nes/AudioRecorder.cpp - Audio File Recorder ------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the AudioRecorder class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "common/CommonTypes.h"
+#include "common/CommonException.h"
+#include "nes/AudioRecorder.h"
+
+using namespace Nes;
+
+constexpr const std::size_t AudioRecorder::CHUNK_SAMPLES;
+constexpr const std::size_t AudioRecorder::DEFAULT_RING_CAPACITY;
+constexpr const std::uint64_t AudioRecorder::MAX_WAV_SAMPLES;
+
+/// Alignment of the chunk buffer, one page.
+static const std::size_t CHUNK_ALIGNMENT = 4096;
+/// How long the writer thread sleeps when there is not a chunk to write.
+static const std::chrono::milliseconds POLL_INTERVAL(5);
+/// Size of a WAV header, in bytes.
+static const std::size_t WAV_HEADER_SIZE = 44;
+
+/// Store a 16 bit value little endian.
+static inline void putLittleEndian16(char* bytes, std::uint16_t value) {
+  bytes[0] = static_cast<char>(value);
+  bytes[1] = static_cast<char>(value >> 8);
+}
+
+/// Store a 32 bit value little endian.
+static inline void putLittleEndian32(char* bytes, std::uint32_t value) {
+  putLittleEndian16(bytes, static_cast<std::uint16_t>(value));
+  putLittleEndian16(bytes + 2, static_cast<std::uint16_t>(value >> 16));
+}
+
+AudioRecorder::AudioRecorder(const std::string& path, Format format,
+    std::uint32_t sampleRate, std::size_t ringCapacity) :
+  file(path, std::ios::binary | std::ios::trunc),
+  format(format),
+  sampleRate(sampleRate),
+  ring(ringCapacity),
+  chunk(CHUNK_SAMPLES, CHUNK_ALIGNMENT),
+  writtenCount(0),
+  failed(false),
+  full(false),
+  stopping(false) {
+  if(!file) {
+    throw Exception::RuntimeException("Could not create the audio file " + path + ".");
+  }
+  if(format == Format::WAV) {
+    writeWavHeader();
+    if(!file.good()) {
+      throw Exception::RuntimeException("Could not write the audio file " + path + ".");
+    }
+  }
+  writer = std::thread(&AudioRecorder::run, this);
+}
+
+AudioRecorder::~AudioRecorder() {
+  try {
+    close();
+  } catch(const Exception::RuntimeException&) {
+    // Nothing can be reported from a destructor. Callers wanting to know
+    // call close themselves.
+  }
+}
+
+void AudioRecorder::close() {
+  if(!writer.joinable()) {
+    return;
+  }
+  stopping.store(true, std::memory_order_release);
+  writer.join();
+  // A header claiming samples that never reached the disk would pass for a
+  // whole recording, so it is only rewritten if every chunk was.
+  if(format == Format::WAV && !failed.load(std::memory_order_relaxed)) {
+    file.seekp(0);
+    writeWavHeader();
+  }
+  file.close();
+  if(failed.load(std::memory_order_relaxed) || file.fail()) {
+    failed.store(true, std::memory_order_relaxed);
+    throw Exception::RuntimeException("Could not write the audio file, after "
+        + std::to_string(writtenCount.load(std::memory_order_relaxed)) + " samples.");
+  }
+  if(full.load(std::memory_order_relaxed)) {
+    throw Exception::RuntimeException("The audio file is too large for a WAV header, "
+        "and was cut short after " + std::to_string(MAX_WAV_SAMPLES) + " samples.");
+  }
+}
+
+void AudioRecorder::run() {
+  std::int16_t* data = chunk.at(0);
+  while(!stopping.load(std::memory_order_acquire)) {
+    // Only take whole chunks, so every write to the file is a large one.
+    if(ring.getFillCount() >= CHUNK_SAMPLES) {
+      writeChunk(ring.read(data, CHUNK_SAMPLES));
+    } else {
+      std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+  }
+  // The producer is done, so take whatever is left, without counting the
+  // last short chunk as an underrun.
+  std::size_t count;
+  while((count = ring.read(data, std::min(CHUNK_SAMPLES, ring.getFillCount()))) > 0) {
+    writeChunk(count);
+  }
+}
+
+void AudioRecorder::writeChunk(std::size_t count) {
+  // Once a write has failed the file is cut short, and later chunks are
+  // dropped rather than written after the gap.
+  if(failed.load(std::memory_order_relaxed) || full.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // A WAV header cannot give a longer length, so the recording stops with
+  // the last samples that fit, and the header stays true to the file.
+  std::uint64_t written = writtenCount.load(std::memory_order_relaxed);
+  if(format == Format::WAV && written + count >= MAX_WAV_SAMPLES) {
+    count = static_cast<std::size_t>(MAX_WAV_SAMPLES - written);
+    full.store(true, std::memory_order_relaxed);
+  }
+  std::int16_t* data = chunk.at(0);
+  char* bytes = reinterpret_cast<char*>(data);
+  // Files hold little endian samples, whatever the host.
+  for(std::size_t i = 0; i < count; i++) {
+    std::int16_t sample = data[i];
+    putLittleEndian16(bytes + 2 * i, static_cast<std::uint16_t>(sample));
+  }
+  file.write(bytes, static_cast<std::streamsize>(count * sizeof(std::int16_t)));
+  if(!file.good()) {
+    failed.store(true, std::memory_order_relaxed);
+    return;
+  }
+  writtenCount.fetch_add(count, std::memory_order_relaxed);
+}
+
+void AudioRecorder::writeWavHeader() {
+  std::uint32_t dataSize = static_cast<std::uint32_t>(
+      writtenCount.load(std::memory_order_relaxed) * sizeof(std::int16_t));
+  char header[WAV_HEADER_SIZE] = {'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E',
+      'f', 'm', 't', ' '};
+  putLittleEndian32(header + 4, static_cast<std::uint32_t>(WAV_HEADER_SIZE - 8) + dataSize);
+  // A 16 byte PCM format chunk: one channel of 16 bit samples.
+  putLittleEndian32(header + 16, 16);
+  putLittleEndian16(header + 20, 1);
+  putLittleEndian16(header + 22, 1);
+  putLittleEndian32(header + 24, sampleRate);
+  putLittleEndian32(header + 28, sampleRate * sizeof(std::int16_t));
+  putLittleEndian16(header + 32, sizeof(std::int16_t));
+  putLittleEndian16(header + 34, 16);
+  std::copy_n("data", 4, header + 36);
+  putLittleEndian32(header + 40, dataSize);
+  file.write(header, sizeof(header));
+}
@@ -0,0 +1,72 @@
+//===-- source/nes/AudioRing.cpp - Lock-Free Audio Ring Buffer --*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the AudioRing class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+
+#include "common/CommonTypes.h"
+#include "nes/AudioRing.h"
+
+using namespace Nes;
+
+AudioRing::AudioRing(std::size_t capacity) :
+  head(0),
+  producerTail(0),
+  overrunCount(0),
+  tail(0),
+  consumerHead(0),
+  underrunCount(0) {
+  std::size_t size = 1;
+  while(size < capacity) {
+    size <<= 1;
+  }
+  buffer.resize(size);
+  mask = size - 1;
+}
+
+std::size_t AudioRing::write(const std::int16_t* samples, std::size_t count) {
+  std::size_t headIndex = head.load(std::memory_order_relaxed);
+  std::size_t space = buffer.size() - (headIndex - producerTail);
+  if(space < count) {
+    producerTail = tail.load(std::memory_order_acquire);
+    space = buffer.size() - (headIndex - producerTail);
+  }
+  std::size_t written = std::min(count, space);
+  // Copy in at most two runs, either side of the end of the buffer.
+  std::size_t start = headIndex & mask;
+  std::size_t first = std::min(written, buffer.size() - start);
+  std::copy(samples, samples + first, buffer.begin() + start);
+  std::copy(samples + first, samples + written, buffer.begin());
+  head.store(headIndex + written, std::memory_order_release);
+  if(written < count) {
+    overrunCount.fetch_add(count - written, std::memory_order_relaxed);
+  }
+  return written;
+}
+
+std::size_t AudioRing::read(std::int16_t* samples, std::size_t count) {
+  std::size_t tailIndex = tail.load(std::memory_order_relaxed);
+  std::size_t available = consumerHead - tailIndex;
+  if(available < count) {
+    consumerHead = head.load(std::memory_order_acquire);
+    available = consumerHead - tailIndex;
+  }
+  std::size_t read = std::min(count, available);
+  std::size_t start = tailIndex & mask;
+  std::size_t first = std::min(read, buffer.size() - start);
+  std::copy(buffer.begin() + start, buffer.begin() + start + first, samples);
+  std::copy(buffer.begin(), buffer.begin() + (read - first), samples + first);
+  tail.store(tailIndex + read, std::memory_order_release);
+  if(read < count) {
+    underrunCount.fetch_add(count - read, std::memory_order_relaxed);
+  }
+  return read;
+}
@@ -0,0 +1,215 @@
+//===-- source/nes/BatchRunner.cpp - Batch of Consoles ----------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the BatchRunner class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <chrono>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "common/CommonTypes.h"
+#include "nes/BatchRunner.h"
+
+using namespace Nes;
+
+/// Mask of the first index of a packed block.
+static const std::uint64_t FIRST_MASK = 0xFFFFFFFF;
+
+/// Pin a thread to a core, so that the memory it first touches stays on the
+/// core's NUMA node. Only done where the platform supports it.
+static void pinThread(std::thread& thread, std::size_t core) {
+#ifdef __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(core, &cpus);
+  pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#endif
+}
+
+BatchRunner::BatchRunner(std::size_t consoleCount, const Factory& factory,
+    std::size_t threadCount) :
+  consoles(consoleCount),
+  stealCount(0),
+  frameCount(0),
+  frameTime(0.0),
+  task(nullptr),
+  taskNumber(0),
+  pendingThreads(0),
+  stopping(false) {
+  std::size_t cores = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  if(threadCount == 0) {
+    threadCount = cores;
+  }
+  blocks.reset(new Block[threadCount]);
+  for(std::size_t index = 0; index < threadCount; index++) {
+    blocks[index].range.store(0);
+  }
+  for(std::size_t index = 0; index < threadCount; index++) {
+    threads.emplace_back(&BatchRunner::work, this, index);
+    pinThread(threads.back(), index % cores);
+  }
+  // Each thread builds its own home block.
+  std::function<void(std::size_t)> build = [this, &factory](std::size_t index) {
+    consoles[index] = factory(index);
+  };
+  try {
+    dispatch(build);
+  } catch(...) {
+    // The destructor will not run, so stop the threads here.
+    stop();
+    throw;
+  }
+}
+
+BatchRunner::~BatchRunner() {
+  stop();
+}
+
+void BatchRunner::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  taskStarted.notify_all();
+  for(auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+}
+
+void BatchRunner::runFrame() {
+  auto start = std::chrono::steady_clock::now();
+  std::function<void(std::size_t)> frame = [this](std::size_t index) {
+    consoles[index]->runFrame();
+  };
+  dispatch(frame);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  frameTime += elapsed.count();
+  frameCount++;
+}
+
+void BatchRunner::forEach(const std::function<void(std::size_t)>& task) {
+  dispatch(task);
+}
+
+void BatchRunner::dispatch(const std::function<void(std::size_t)>& task) {
+  std::unique_lock<std::mutex> lock(mutex);
+  // Every thread starts from its home block, the same Consoles each time.
+  std::size_t threadCount = threads.size();
+  for(std::size_t index = 0; index < threadCount; index++) {
+    blocks[index].range.store(pack(index * consoles.size() / threadCount,
+        (index + 1) * consoles.size() / threadCount), std::memory_order_relaxed);
+  }
+  this->task = &task;
+  error = nullptr;
+  pendingThreads = threadCount;
+  taskNumber++;
+  lock.unlock();
+  taskStarted.notify_all();
+  lock.lock();
+  taskDone.wait(lock, [this] { return pendingThreads == 0; });
+  this->task = nullptr;
+  if(error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void BatchRunner::work(std::size_t index) {
+  std::uint64_t tasksRun = 0;
+  while(true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      taskStarted.wait(lock, [this, tasksRun] {
+        return stopping || taskNumber != tasksRun;
+      });
+      if(stopping) {
+        return;
+      }
+      tasksRun = taskNumber;
+    }
+    runTask(index);
+    bool lastThread;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      lastThread = --pendingThreads == 0;
+    }
+    if(lastThread) {
+      taskDone.notify_all();
+    }
+  }
+}
+
+void BatchRunner::runTask(std::size_t index) {
+  Block& own = blocks[index];
+  std::size_t threadCount = threads.size();
+  std::size_t console;
+  while(true) {
+    while(take(own, console)) {
+      try {
+        (*task)(console);
+      } catch(...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    // Out of work, so look for a thread with Consoles left, starting with
+    // the next thread along so that thieves spread out.
+    bool stolen = false;
+    for(std::size_t offset = 1; offset < threadCount && !stolen; offset++) {
+      stolen = steal(blocks[(index + offset) % threadCount], own);
+    }
+    if(!stolen) {
+      return;
+    }
+    stealCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool BatchRunner::take(Block& block, std::size_t& console) {
+  std::uint64_t range = block.range.load(std::memory_order_acquire);
+  while(true) {
+    std::uint64_t first = range & FIRST_MASK;
+    std::uint64_t end = range >> 32;
+    if(first >= end) {
+      return false;
+    }
+    if(block.range.compare_exchange_weak(range, pack(first + 1, end),
+        std::memory_order_acq_rel, std::memory_order_acquire)) {
+      console = first;
+      return true;
+    }
+  }
+}
+
+bool BatchRunner::steal(Block& victim, Block& thief) {
+  std::uint64_t range = victim.range.load(std::memory_order_acquire);
+  while(true) {
+    std::uint64_t first = range & FIRST_MASK;
+    std::uint64_t end = range >> 32;
+    if(first >= end) {
+      return false;
+    }
+    // Leave the victim the front half, which it is working through.
+    std::uint64_t middle = end - (end - first + 1) / 2;
+    if(victim.range.compare_exchange_weak(range, pack(first, middle),
+        std::memory_order_acq_rel, std::memory_order_acquire)) {
+      // The thief's block is empty, so nothing else can take from it until
+      // this store.
+      thief.range.store(pack(middle, end), std::memory_order_release);
+      return true;
+    }
+  }
+}
@@ -17,66 +17,133 @@
 #include "common/CommonException.h"
 #include "nes/Cartridge.h"
 #include "nes/CartridgeMapperBuilder.h"
+#include "nes/RomStore.h"
 
 using namespace Nes;
 using namespace Memory;
 
+// Bank sizes are passed by reference when emplacing banks, so they need
+// definitions.
+constexpr const std::size_t Cartridge::SIZE_512B;
+constexpr const std::size_t Cartridge::SIZE_8KB;
+constexpr const std::size_t Cartridge::SIZE_16KB;
+
 Cartridge& Cartridge::operator=(Cartridge&& otherCartridge) {
   if(this != &otherCartridge) {
+    options = otherCartridge.options;
     mapperPtr = std::move(otherCartridge.mapperPtr);
+    arena = std::move(otherCartridge.arena);
+    prgImage = std::move(otherCartridge.prgImage);
+    chrImage = std::move(otherCartridge.chrImage);
     trainer = std::move(otherCartridge.trainer);
     prgRams = std::move(otherCartridge.prgRams);
     prgRoms = std::move(otherCartridge.prgRoms);
     chrRoms = std::move(otherCartridge.chrRoms);
+    chrRams = std::move(otherCartridge.chrRams);
+    romHash = otherCartridge.romHash;
   }
   return *this;
 }
 
-Cartridge::Cartridge(CartridgeOptions options, const std::vector<byte>& romFile) {
-  // Iterate thourgh the list of options, building the cartridge internals. 
-  // Acquire an iterator to the begining of the romFile.
-  auto romFileItr = std::begin(romFile);
+Cartridge::Cartridge(CartridgeOptions options, const std::vector<byte>& romFile) :
+  options(options) {
+  // The file holds the trainer, then PRG ROM, then CHR ROM.
+  std::size_t prgRomSize = options.num16kRom * SIZE_16KB;
+  std::size_t chrRomSize = options.num8kVRom * SIZE_8KB;
+  std::size_t trainerSize = options.hasTrainer ? SIZE_512B : 0;
+  if(romFile.size() < trainerSize + prgRomSize + chrRomSize) {
+    throw Exception::InvalidFormatException("Input ROM file of "
+        + std::to_string(romFile.size()) + " bytes is too short for its header.");
+  }
+
+  // The ROM banks view shared images of every PRG ROM and CHR ROM bank of
+  // the game, which are never written.
+  const byte* romData = romFile.data() + trainerSize;
+  RomStore& store = RomStore::getInstance();
+  prgImage = store.intern(romData, prgRomSize);
+  if(chrRomSize > 0) {
+    chrImage = store.intern(romData + prgRomSize, chrRomSize);
+  }
+
+  // Hash the ROM images, PRG ROM first.
+  romHash = RomStore::hash(prgImage->at(0), prgRomSize);
+  if(chrImage != nullptr) {
+    romHash = RomStore::hash(chrImage->at(0), chrRomSize, romHash);
+  }
+
+  build(romFile.data());
+}
+
+Cartridge::Cartridge(const Cartridge& source, const byte* trainerData) :
+  options(source.options),
+  prgImage(source.prgImage),
+  chrImage(source.chrImage),
+  romHash(source.romHash) {
+  build(trainerData);
+}
+
+std::unique_ptr<Cartridge> Cartridge::clone() const {
+  return std::unique_ptr<Cartridge>(new Cartridge(*this, trainer.getStorage()));
+}
+
+void Cartridge::build(const byte* trainerData) {
+  // Size a single arena to hold every bank the cartridge writes, so that all
+  // memory of its own is one allocation.
+  std::size_t arenaSize = options.num8kRam * SIZE_8KB
+    + (options.num8kVRom == 0 ? SIZE_8KB : 0)
+    + (options.hasTrainer ? SIZE_512B : 0);
+  arena = Arena<byte>(arenaSize);
+
   // populate the 512 byte trainer if necessary.
   if(options.hasTrainer) {
-    trainer = std::make_shared<Rom<byte>>();
-    trainer->load(romFileItr, romFileItr + SIZE_512B);
-    romFileItr += SIZE_512B;
+    trainer = Rom<byte>(arena.at(arena.allocate(SIZE_512B)), SIZE_512B);
+    trainer.load(trainerData, trainerData + SIZE_512B);
   }
 
-  // resize the number of RAMs, and resize each RAM to 8k.
+  // build the 8k RAMs in the arena. RAMs come first as they are the only
+  // banks that are ever written.
   prgRams.reserve(options.num8kRam);
   for(std::size_t i = 0; i < options.num8kRam; i++) {
-    prgRams.emplace_back(std::make_shared<Ram<byte>>());
-    prgRams.back()->resize(SIZE_8KB);
+    prgRams.emplace_back(arena.at(arena.allocate(SIZE_8KB)), SIZE_8KB);
   }
 
-  // populate all 16k PRG ROMs
   prgRoms.reserve(options.num16kRom);
   for(std::size_t i = 0; i < options.num16kRom; i++) {
-    prgRoms.emplace_back(std::make_shared<Rom<byte>>());
-    prgRoms.back()->load(romFileItr, romFileItr + SIZE_16KB);
-    romFileItr += SIZE_16KB;
+    prgRoms.emplace_back(prgImage->at(i * SIZE_16KB), SIZE_16KB);
   }
-
-  // populate all 8k CHR ROMS
   chrRoms.reserve(options.num8kVRom);
   for(std::size_t i = 0; i < options.num8kVRom; i++) {
-    chrRoms.emplace_back(std::make_shared<Rom<byte>>());
-    chrRoms.back()->load(romFileItr, romFileItr + SIZE_8KB);
-    romFileItr += SIZE_8KB;
+    chrRoms.emplace_back(chrImage->at(i * SIZE_8KB), SIZE_8KB);
   }
 
-  // Check to make sure that the entire romFile was read
-  //if(romFileItr != std::end(romFile)) {
-  //  throw Exception::InvalidFormatException("Input ROM file had an unexpected number of bytes.");
-  //}
+  // Cartridges without CHR ROM have 8k of CHR RAM instead.
+  if(options.num8kVRom == 0) {
+    chrRams.emplace_back(arena.at(arena.allocate(SIZE_8KB)), SIZE_8KB);
+  }
 
   // determine the kind of memory mapper and build it.
   CartridgeMapperBuilder mapperBuilder;
   mapperBuilder.setiNESIndex(options.mapperIndex)
     .setPrgRams(&prgRams)
     .setPrgRoms(&prgRoms)
-    .setChrRoms(&chrRoms);
+    .setChrRoms(&chrRoms)
+    .setChrRams(&chrRams)
+    .setMirroring(options.fourScreenVram ? Mirroring::FOUR_SCREEN
+        : options.isVerticalMirroring ? Mirroring::VERTICAL
+        : Mirroring::HORIZONTAL);
   mapperPtr = mapperBuilder.build();
-  
+}
+
+void Cartridge::saveState(Structure::StateWriter& writer) const {
+  for(const auto& prgRam : prgRams) {
+    writer.write(prgRam.getStorage(), prgRam.getSize());
+  }
+  mapperPtr->saveState(writer);
+}
+
+void Cartridge::loadState(Structure::StateReader& reader) {
+  for(auto& prgRam : prgRams) {
+    prgRam.load(reader.view(prgRam.getSize()));
+  }
+  mapperPtr->loadState(reader);
 }
@@ -21,14 +21,19 @@
 
 using namespace Nes;
 
+constexpr const std::size_t CartridgeBuilder::INES_HEADER_SIZE;
+constexpr const std::array<byte, 4> CartridgeBuilder::NES_TOKEN;
+
 std::unique_ptr<Cartridge> CartridgeBuilder::build() {
   // Open an input stream from the inputFile, and first, read in the file header.
+  // Read through the stream buffer, as formatted input would skip any bytes
+  // that happen to look like whitespace.
   std::ifstream romStream(inputFile, std::ios::binary);
-  std::istream_iterator<byte> romFileItr(romStream);
+  std::istreambuf_iterator<char> romFileItr(romStream);
   std::array<byte, INES_HEADER_SIZE> header;
 
   for(std::size_t i = 0; i < INES_HEADER_SIZE; i++) {
-    header.at(i) = *romFileItr; 
+    header.at(i) = static_cast<byte>(*romFileItr); 
     romFileItr++;
   }
 
@@ -37,7 +42,7 @@ std::unique_ptr<Cartridge> CartridgeBuilder::build() {
 
   // File header is okay, so import the rest of the file, construct the 
   // Cartridge object and wrap it in a unique_ptr.
-  std::vector<byte> romFile(romFileItr, std::istream_iterator<byte>());
+  std::vector<byte> romFile(romFileItr, std::istreambuf_iterator<char>());
   cartridgePtr = std::unique_ptr<Cartridge>(new Cartridge(options, romFile));
 
   // move the unique_ptr out of the builder p
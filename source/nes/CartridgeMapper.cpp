@@ -11,7 +11,10 @@
 ///
 //===----------------------------------------------------------------------===//
 
+#include <string>
+
 #include "common/CommonTypes.h"
+#include "memory/MemoryException.h"
 #include "memory/Ram.h"
 #include "memory/Rom.h"
 #include "nes/CartridgeMapper.h"
@@ -19,56 +22,164 @@
 using namespace Nes;
 using namespace Memory;
 
+constexpr const std::size_t CartridgeMapper::PAGE_BITS;
+constexpr const std::size_t CartridgeMapper::NUM_PAGES;
+constexpr const std::size_t CartridgeMapper::NUM_CHR_PAGES;
+
 CartridgeMapper::CartridgeMapper(
-    std::vector<std::shared_ptr<Ram<byte>>>& prgRams,
-    std::vector<std::shared_ptr<Rom<byte>>>& prgRoms,
-    std::vector<std::shared_ptr<Rom<byte>>>& chrRoms) :
+    std::vector<Ram<byte>>& prgRams,
+    std::vector<Rom<byte>>& prgRoms,
+    std::vector<Rom<byte>>& chrRoms,
+    std::vector<Ram<byte>>& chrRams,
+    Mirroring mirroring) :
+  prgRamWindow(PRG_RAM_SIZE, {PRG_RAM_ADDR}),
+  prgRomWindowSize(0),
+  prgRomBankCount(0),
+  chrWindowSize(0),
+  chrBankCount(0),
+  chrSource(nullptr),
+  chrWritable(false),
+  mirroring(mirroring),
+  chrGeneration(0),
   prgRams(prgRams),
   prgRoms(prgRoms),
-  chrRoms(chrRoms) { }
+  chrRoms(chrRoms),
+  chrRams(chrRams) {
+  // Nothing is mapped until windows are configured.
+  pageTable.fill(nullptr);
+  chrPageTable.fill(nullptr);
+  chrPageOffsets.fill(0);
 
-// Get and Set methods.
-std::weak_ptr<Ram<byte>> CartridgeMapper::getPrgRam() const {
-  return prgRam;
+  // PRG RAM is never bank switched by the supported mappers.
+  if(!prgRams.empty()) {
+    prgRamWindow.map(prgRams.front(), 0, true);
+    std::size_t first = PRG_RAM_ADDR >> PAGE_BITS;
+    for(std::size_t page = 0; page < (PRG_RAM_SIZE >> PAGE_BITS); page++) {
+      pageTable[first + page] = &prgRamWindow;
+    }
+  }
+}
+
+void CartridgeMapper::buildWindows(
+    std::vector<Window<byte>>& windows,
+    Bank<byte>** pages,
+    addr baseAddress,
+    std::size_t spaceSize,
+    std::size_t windowSize,
+    std::size_t regionSize) {
+  if(!windows.empty()) {
+    throw Exception::MemoryException("Windows are already configured.");
+  }
+  if(windowSize < MIN_WINDOW_SIZE || windowSize > spaceSize
+      || (windowSize & (windowSize - 1)) != 0) {
+    throw Exception::MemoryException("Invalid window size "
+        + std::to_string(windowSize) + ".");
+  }
+  if(regionSize < windowSize) {
+    throw Exception::MemoryException("Window of size " + std::to_string(windowSize)
+        + " is larger than the " + std::to_string(regionSize)
+        + " bytes switched through it.");
+  }
+
+  // The windows are never reallocated, so pages can point at them for the
+  // lifetime of the mapper.
+  std::size_t numWindows = spaceSize / windowSize;
+  std::size_t pagesPerWindow = windowSize >> PAGE_BITS;
+  windows.reserve(numWindows);
+  for(std::size_t window = 0; window < numWindows; window++) {
+    Vaddr vaddr;
+    vaddr.val = static_cast<addr>(baseAddress + window * windowSize);
+    windows.emplace_back(windowSize, vaddr);
+    for(std::size_t page = 0; page < pagesPerWindow; page++) {
+      pages[window * pagesPerWindow + page] = &windows.back();
+    }
+  }
 }
 
-void CartridgeMapper::setPrgRam(std::size_t index) {
-  // Set the baseAddress of the Ram to load, then load it.
-  auto prgRamPtr = prgRams.at(index);
-  prgRamPtr->setBaseAddress(PRG_RAM_ADDR);
-  prgRam = prgRamPtr;
+void CartridgeMapper::configurePrgRom(std::size_t windowSize) {
+  std::size_t regionSize = 0;
+  for(const auto& prgRom : prgRoms) {
+    regionSize += prgRom.getSize();
+  }
+  buildWindows(prgRomWindows, &pageTable[PRG_ROM_ADDR >> PAGE_BITS],
+      PRG_ROM_ADDR, PRG_ROM_SPACE, windowSize, regionSize);
+  prgRomWindowSize = windowSize;
+  prgRomBankCount = regionSize / windowSize;
+
+  // Writes to PRG ROM space are mapper register writes.
+  prgBanks.resize(prgRomWindows.size());
+  for(std::size_t window = 0; window < prgRomWindows.size(); window++) {
+    prgRomWindows[window].setWriteHandler([this](Vaddr vaddr, byte data) {
+      writeRegister(vaddr, data);
+    });
+    mapPrgRom(window, 0);
+  }
 }
 
-std::weak_ptr<Rom<byte>> CartridgeMapper::getLowerPrgRom() const {
-  return lowerPrgRom;
+void CartridgeMapper::configureChr(std::size_t windowSize) {
+  // CHR RAM stands in for CHR ROM on cartridges without any.
+  std::size_t regionSize = 0;
+  if(!chrRoms.empty()) {
+    chrSource = &chrRoms.front();
+    chrWritable = false;
+    for(const auto& chrRom : chrRoms) {
+      regionSize += chrRom.getSize();
+    }
+  } else if(!chrRams.empty()) {
+    chrSource = &chrRams.front();
+    chrWritable = true;
+    for(const auto& chrRam : chrRams) {
+      regionSize += chrRam.getSize();
+    }
+  }
+  buildWindows(chrWindows, chrPageTable.data(), 0x0000, CHR_SPACE,
+      windowSize, regionSize);
+  chrWindowSize = windowSize;
+  chrBankCount = regionSize / windowSize;
+  chrBanks.resize(chrWindows.size());
+  for(std::size_t window = 0; window < chrWindows.size(); window++) {
+    mapChr(window, 0);
+  }
 }
 
-void CartridgeMapper::setLowerPrgRom(std::size_t index) {
-  // Set the baseAddress of the Rom to load, then load it.
-  auto lowerPrgRomPtr = prgRoms.at(index);
-  lowerPrgRomPtr->setBaseAddress(LOWER_PRG_ROM_ADDR);
-  lowerPrgRom = lowerPrgRomPtr;
+void CartridgeMapper::saveState(Structure::StateWriter& writer) const {
+  writer.write(mirroring);
+  writer.write(prgBanks.data(), prgBanks.size() * sizeof(std::size_t));
+  writer.write(chrBanks.data(), chrBanks.size() * sizeof(std::size_t));
+  saveRegisters(writer);
 }
 
-std::weak_ptr<Rom<byte>> CartridgeMapper::getUpperPrgRom() const {
-  return upperPrgRom;
+void CartridgeMapper::loadState(Structure::StateReader& reader) {
+  setMirroring(reader.read<Mirroring>());
+  reader.read(prgBanks.data(), prgBanks.size() * sizeof(std::size_t));
+  reader.read(chrBanks.data(), chrBanks.size() * sizeof(std::size_t));
+  for(std::size_t window = 0; window < prgBanks.size(); window++) {
+    mapPrgRom(window, prgBanks[window]);
+  }
+  for(std::size_t window = 0; window < chrBanks.size(); window++) {
+    mapChr(window, chrBanks[window]);
+  }
+  loadRegisters(reader);
 }
 
-void CartridgeMapper::setUpperPrgRom(std::size_t index) {
-  // Set the baseAddress of the Rom to load, then load it.
-  auto upperPrgRomPtr = prgRoms.at(index);
-  upperPrgRomPtr->setBaseAddress(UPPER_PRG_ROM_ADDR);
-  upperPrgRom = prgRoms.at(index);
+void CartridgeMapper::writeRegister(Vaddr vaddr, byte data) {
+  // Mappers without registers only have ROM here.
+  throw Exception::ReadOnlyMemoryException();
 }
 
-std::vector<std::shared_ptr<Ram<byte>>>& CartridgeMapper::getPrgRams() {
+// Get and Set methods.
+std::vector<Ram<byte>>& CartridgeMapper::getPrgRams() {
   return prgRams;
 }
 
-std::vector<std::shared_ptr<Rom<byte>>>& CartridgeMapper::getPrgRoms() {
+std::vector<Rom<byte>>& CartridgeMapper::getPrgRoms() {
   return prgRoms;
 }
 
-std::vector<std::shared_ptr<Rom<byte>>>& CartridgeMapper::getChrRoms() {
+std::vector<Rom<byte>>& CartridgeMapper::getChrRoms() {
   return chrRoms;
 }
+
+std::vector<Ram<byte>>& CartridgeMapper::getChrRams() {
+  return chrRams;
+}
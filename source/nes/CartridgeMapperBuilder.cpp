@@ -16,7 +16,11 @@
 #include "nes/CartridgeMapper.h"
 #include "nes/CartridgeMapperBuilder.h"
 
+#include "nes/mappers/CnRom.h"
+#include "nes/mappers/Mmc1.h"
+#include "nes/mappers/Mmc3.h"
 #include "nes/mappers/NRom.h"
+#include "nes/mappers/UxRom.h"
 
 using namespace Nes;
 using namespace Nes::Mappers;
@@ -30,7 +34,45 @@ std::unique_ptr<CartridgeMapper> CartridgeMapperBuilder::build() {
         std::unique_ptr<CartridgeMapper>(new NRom(
               *prgRamsPtr, 
               *prgRomsPtr, 
-              *chrRomsPtr));
+              *chrRomsPtr,
+              *chrRamsPtr,
+              mirroring));
+      break;
+    case Mmc1::iNesIndex:
+      mapperPtr = 
+        std::unique_ptr<CartridgeMapper>(new Mmc1(
+              *prgRamsPtr, 
+              *prgRomsPtr, 
+              *chrRomsPtr,
+              *chrRamsPtr,
+              mirroring));
+      break;
+    case UxRom::iNesIndex:
+      mapperPtr = 
+        std::unique_ptr<CartridgeMapper>(new UxRom(
+              *prgRamsPtr, 
+              *prgRomsPtr, 
+              *chrRomsPtr,
+              *chrRamsPtr,
+              mirroring));
+      break;
+    case CnRom::iNesIndex:
+      mapperPtr = 
+        std::unique_ptr<CartridgeMapper>(new CnRom(
+              *prgRamsPtr, 
+              *prgRomsPtr, 
+              *chrRomsPtr,
+              *chrRamsPtr,
+              mirroring));
+      break;
+    case Mmc3::iNesIndex:
+      mapperPtr = 
+        std::unique_ptr<CartridgeMapper>(new Mmc3(
+              *prgRamsPtr, 
+              *prgRomsPtr, 
+              *chrRomsPtr,
+              *chrRamsPtr,
+              mirroring));
       break;
     default:
       // mapper is unsupported.
@@ -50,22 +92,35 @@ CartridgeMapperBuilder& CartridgeMapperBuilder::setiNESIndex(std::size_t iNesInd
 }
 
 CartridgeMapperBuilder& CartridgeMapperBuilder::setPrgRams(
-    std::vector<std::shared_ptr<Memory::Ram<byte>>>* prgRamsPtr) { 
+    std::vector<Memory::Ram<byte>>* prgRamsPtr) { 
   // Set the prgRams and return a reference for chaining.
   this->prgRamsPtr = prgRamsPtr;
   return *this;
 }
 
 CartridgeMapperBuilder& CartridgeMapperBuilder::setPrgRoms(
-    std::vector<std::shared_ptr<Memory::Rom<byte>>>* prgRomsPtr) { 
+    std::vector<Memory::Rom<byte>>* prgRomsPtr) { 
   // Set the prgRams and return a reference for chaining.
   this->prgRomsPtr = prgRomsPtr;
   return *this;
 }
 
 CartridgeMapperBuilder& CartridgeMapperBuilder::setChrRoms(
-    std::vector<std::shared_ptr<Memory::Rom<byte>>>* chrRomsPtr) { 
+    std::vector<Memory::Rom<byte>>* chrRomsPtr) { 
   // Set the prgRams and return a reference for chaining.
   this->chrRomsPtr = chrRomsPtr;
   return *this;
 }
+
+CartridgeMapperBuilder& CartridgeMapperBuilder::setChrRams(
+    std::vector<Memory::Ram<byte>>* chrRamsPtr) { 
+  // Set the chrRams and return a reference for chaining.
+  this->chrRamsPtr = chrRamsPtr;
+  return *this;
+}
+
+CartridgeMapperBuilder& CartridgeMapperBuilder::setMirroring(Mirroring mirroring) {
+  // Set the mirroring and return a reference for chaining.
+  this->mirroring = mirroring;
+  return *this;
+}
@@ -0,0 +1,189 @@
+//===-- source/nes/Console.cpp - Nes Console --------------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the Console class.
+///
+//===----------------------------------------------------------------------===//
+#include <array>
+
+#include "common/CommonTypes.h"
+#include "common/CommonException.h"
+#include "common/structures/StateBuffer.h"
+#include "nes/Console.h"
+
+using namespace Nes;
+
+constexpr const std::size_t Console::OAM_DMA_CYCLES;
+constexpr const std::uint32_t Console::STATE_VERSION;
+
+/// Magic number at the start of every saved state.
+static const std::uint32_t STATE_MAGIC = 0x53454E4F;
+
+Console::Console(std::unique_ptr<Cartridge> cartridge) :
+  cartridge(std::move(cartridge)),
+  bus(*this->cartridge),
+  ppu(this->cartridge->getMapper()),
+  cpu(bus),
+  cycle(0),
+  dmaPending(false),
+  stallCycles(0) {
+  ppu.connect(bus);
+  apu.connect(bus);
+  controllers.connect(bus);
+  bus.setWriteHandler({0x4014}, [this](std::size_t reg, byte data) {
+    writeOamDma(data);
+  });
+  reset();
+  // Sized now, so that loading a state does not allocate.
+  saveState(rollbackState);
+}
+
+void Console::reset() {
+  // A DMA under way is abandoned, and the restarted Cpu counts its cycles,
+  // and so the parity a DMA lines up with, from 0.
+  cycle = 0;
+  dmaPending = false;
+  stallCycles = 0;
+  cpu.reset();
+}
+
+void Console::step() {
+  if(dmaPending && cpu.getCycleCount() == 0) {
+    // The Cpu halts once the instruction that wrote $4014 is done, and waits
+    // an extra cycle to line up with the DMA if it halts on an odd cycle.
+    dmaPending = false;
+    stallCycles = OAM_DMA_CYCLES + (cycle & 1);
+  }
+  if(stallCycles > 0) {
+    stallCycles--;
+  } else {
+    if(cpu.getCycleCount() == 0) {
+      // Between instructions, bring the Ppu and Apu up to date if they have
+      // something the Cpu should see, then take any interrupt that is due.
+      if(ppu.isCatchUpDue()) {
+        ppu.catchUp();
+      }
+      if(apu.isCatchUpDue()) {
+        apu.catchUp();
+      }
+      if(ppu.pollNmi()) {
+        cpu.nmi();
+      } else if(cartridge->getMapper().isIrqAsserted() || apu.isIrqAsserted()) {
+        cpu.irq();
+      }
+    }
+    cpu.step();
+  }
+  ppu.advance(Ppu::DOTS_PER_CPU_CYCLE);
+  apu.advance(1);
+  cycle++;
+}
+
+void Console::writeOamDma(byte page) {
+  // Memory pages are copied straight out of their bank. Register pages are
+  // read a byte at a time, for the side effects of the reads.
+  const byte* data = bus.getPageData(page);
+  std::array<byte, 0x100> registers;
+  if(data == nullptr) {
+    for(std::size_t i = 0; i < registers.size(); i++) {
+      Vaddr vaddr = {static_cast<addr>(page << 8 | i)};
+      Memory::Bank<byte>* bank = bus.mapToHardware(vaddr);
+      registers[i] = bank->read(bank->getIndex(vaddr));
+    }
+    data = registers.data();
+  }
+  ppu.writeOamDma(data);
+  dmaPending = true;
+}
+
+void Console::saveState(std::vector<byte>& state) {
+  Structure::StateWriter writer(state);
+  writer.write(STATE_MAGIC);
+  writer.write(STATE_VERSION);
+  writer.write(cartridge->getRomHash());
+  cpu.saveState(writer);
+  writer.write(cycle);
+  writer.write(dmaPending);
+  writer.write(stallCycles);
+  Memory::Ram<byte>& ram = bus.getRam();
+  writer.write(ram.getStorage(), ram.getSize());
+  cartridge->saveState(writer);
+  ppu.saveState(writer);
+  apu.saveState(writer);
+  controllers.saveState(writer);
+}
+
+void Console::loadState(const std::vector<byte>& state) {
+  Structure::StateReader reader(state.data(), state.size());
+  readStateHeader(reader);
+  // The body can still turn out truncated or corrupt partway through, after
+  // some of the machine is overwritten, so the machine is saved first and
+  // put back if it does.
+  saveState(rollbackState);
+  try {
+    readStateBody(reader);
+  } catch(...) {
+    Structure::StateReader rollback(rollbackState.data(), rollbackState.size());
+    readStateHeader(rollback);
+    readStateBody(rollback);
+    throw;
+  }
+}
+
+void Console::readStateHeader(Structure::StateReader& reader) {
+  if(reader.read<std::uint32_t>() != STATE_MAGIC) {
+    throw Exception::InvalidFormatException("Not a saved state.");
+  }
+  std::uint32_t version = reader.read<std::uint32_t>();
+  if(version != STATE_VERSION) {
+    throw Exception::InvalidFormatException("Saved state is version "
+        + std::to_string(version) + ", not " + std::to_string(STATE_VERSION) + ".");
+  }
+  if(reader.read<std::uint64_t>() != cartridge->getRomHash()) {
+    throw Exception::InvalidFormatException("Saved state is for a different ROM.");
+  }
+}
+
+void Console::readStateBody(Structure::StateReader& reader) {
+  cpu.loadState(reader);
+  reader.read(cycle);
+  reader.read(dmaPending);
+  reader.read(stallCycles);
+  Memory::Ram<byte>& ram = bus.getRam();
+  ram.load(reader.view(ram.getSize()));
+  cartridge->loadState(reader);
+  ppu.loadState(reader);
+  apu.loadState(reader);
+  controllers.loadState(reader);
+  if(reader.getRemaining() != 0) {
+    throw Exception::InvalidFormatException("Saved state has "
+        + std::to_string(reader.getRemaining()) + " bytes left over.");
+  }
+}
+
+std::unique_ptr<Console> Console::clone() {
+  // Building the copy wires up its own bus, handlers and Cpu registers, so
+  // only the plain state needs copying.
+  std::unique_ptr<Console> copy(new Console(cartridge->clone()));
+  saveState(cloneState);
+  copy->loadState(cloneState);
+  copy->ppu.setHeadless(ppu.isHeadless());
+  copy->apu.setHeadless(apu.isHeadless());
+  for(std::size_t port = 0; port < Controllers::PORTS; port++) {
+    copy->controllers.setButtons(port, controllers.getButtons(port));
+  }
+  return copy;
+}
+
+void Console::runFrame() {
+  std::uint64_t frame = ppu.getFrameCount();
+  while(ppu.getFrameCount() == frame) {
+    step();
+  }
+}
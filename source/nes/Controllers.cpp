@@ -0,0 +1,75 @@
+//===-- source/nes/Controllers.cpp - Nes Controller Ports -------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the Controllers class.
+///
+//===----------------------------------------------------------------------===//
+#include "common/CommonTypes.h"
+#include "nes/Controllers.h"
+
+using namespace Nes;
+
+constexpr const std::size_t Controllers::PORTS;
+
+/// Bits of a controller read left as they were on the bus, the high byte of
+/// the address.
+static const byte OPEN_BUS_BITS = 0x40;
+
+/// Number of buttons on a standard controller.
+static const byte BUTTON_COUNT = 8;
+
+Controllers::Controllers() :
+  buttons(),
+  shifters(),
+  readCounts(),
+  strobe(false) {
+}
+
+void Controllers::connect(CpuBus& bus) {
+  bus.setWriteHandler({0x4016}, [this](std::size_t reg, byte data) {
+    strobe = (data & 0x01) != 0;
+    if(strobe) {
+      shifters = buttons;
+      readCounts = {};
+    }
+  });
+  bus.setReadHandler({0x4016}, [this](std::size_t reg) {
+    return readPort(0);
+  });
+  bus.setReadHandler({0x4017}, [this](std::size_t reg) {
+    return readPort(1);
+  });
+}
+
+byte Controllers::readPort(std::size_t port) {
+  if(strobe) {
+    // While strobed, the shift register keeps reloading, so reads return A.
+    return OPEN_BUS_BITS | (buttons[port] & Button::A);
+  }
+  // Past the eighth button a standard controller reads 1s.
+  if(readCounts[port] >= BUTTON_COUNT) {
+    return OPEN_BUS_BITS | 0x01;
+  }
+  byte bit = shifters[port] & 0x01;
+  shifters[port] >>= 1;
+  readCounts[port]++;
+  return OPEN_BUS_BITS | bit;
+}
+
+void Controllers::saveState(Structure::StateWriter& writer) {
+  writer.write(shifters);
+  writer.write(readCounts);
+  writer.write(strobe);
+}
+
+void Controllers::loadState(Structure::StateReader& reader) {
+  reader.read(shifters);
+  reader.read(readCounts);
+  reader.read(strobe);
+}
@@ -0,0 +1,19 @@
+//===-- source/nes/Cpu2A03.cpp - Nes Cpu ------------------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file instantiates the Mos6502 core on the Nes CpuBus.
+///
+//===----------------------------------------------------------------------===//
+#include "cpu/interpreter/InterpretedMos6502_Inst.h"
+#include "nes/Cpu2A03.h"
+#include "nes/CpuBus.h"
+
+template class Cpu::Mos6502MmuCore<Nes::CpuBus>;
+template class Cpu::Mos6502Core<Nes::CpuBus>;
+template class Cpu::InterpretedMos6502Core<Nes::CpuBus>;
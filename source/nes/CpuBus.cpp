@@ -0,0 +1,84 @@
+//===-- source/nes/CpuBus.cpp - Nes Cpu Address Bus -------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the CpuBus class.
+///
+//===----------------------------------------------------------------------===//
+#include <string>
+
+#include "common/CommonTypes.h"
+#include "memory/MemoryException.h"
+#include "nes/CpuBus.h"
+
+using namespace Nes;
+using namespace Memory;
+
+constexpr const std::size_t CpuBus::PAGE_BITS;
+constexpr const std::size_t CpuBus::NUM_PAGES;
+
+CpuBus::CpuBus(const Cartridge& cartridge) :
+  ram(RAM_SIZE, {0x0000}),
+  ppuPort(PPU_PORT_SIZE, {PPU_PORT_ADDR}),
+  apuPort(APU_PORT_SIZE, {APU_PORT_ADDR}),
+  openBus(1, {0x0000}),
+  ramSlot(&ram),
+  ppuSlot(&ppuPort),
+  apuSlot(&apuPort),
+  expansionSlot(&cartridge.getMapper().getPageTable()[
+      APU_PORT_END >> CartridgeMapper::PAGE_BITS]) {
+  // Lay out the fixed hardware: RAM and its mirrors, the PPU registers and
+  // their mirrors, then the APU/IO page, whose tail past the registers is
+  // resolved through the expansion slot. Every remaining page watches the
+  // slot of the cartridge page it falls in.
+  const auto& cartridgePages = cartridge.getMapper().getPageTable();
+  for(std::size_t page = 0; page < NUM_PAGES; page++) {
+    std::size_t address = page << PAGE_BITS;
+    if(address < PPU_PORT_ADDR) {
+      pageTable[page] = &ramSlot;
+    } else if(address < APU_PORT_ADDR) {
+      pageTable[page] = &ppuSlot;
+    } else if(address < CARTRIDGE_ADDR) {
+      pageTable[page] = &apuSlot;
+    } else {
+      pageTable[page] = &cartridgePages[address >> CartridgeMapper::PAGE_BITS];
+    }
+  }
+}
+
+void CpuBus::setReadHandler(Vaddr vaddr, IoPort<byte>::ReadHandler handler) {
+  IoPort<byte>& port = getPort(vaddr);
+  port.setReadHandler(port.getIndex(vaddr), std::move(handler));
+}
+
+void CpuBus::setWriteHandler(Vaddr vaddr, IoPort<byte>::WriteHandler handler) {
+  IoPort<byte>& port = getPort(vaddr);
+  port.setWriteHandler(port.getIndex(vaddr), std::move(handler));
+}
+
+const byte* CpuBus::getPageData(byte page) const {
+  Vaddr vaddr = {static_cast<addr>(page << PAGE_BITS)};
+  if(vaddr.val >= PPU_PORT_ADDR && vaddr.val < CARTRIDGE_ADDR) {
+    return nullptr;
+  }
+  // Banks are at least a page long and start on a page, so the page is
+  // contiguous within its bank.
+  Memory::Bank<byte>* bank = *pageTable[page];
+  return bank != nullptr ? bank->getStorage() + bank->getIndex(vaddr) : nullptr;
+}
+
+IoPort<byte>& CpuBus::getPort(Vaddr vaddr) {
+  if(vaddr.val >= PPU_PORT_ADDR && vaddr.val < APU_PORT_ADDR) {
+    return ppuPort;
+  }
+  if(vaddr.val >= APU_PORT_ADDR && vaddr.val < APU_PORT_END) {
+    return apuPort;
+  }
+  throw Exception::MemoryException("No I/O register at address "
+      + std::to_string(vaddr.val));
+}
@@ -0,0 +1,84 @@
+//===-- source/nes/FrameSink.cpp - Triple Buffered Frame Handoff *- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the FrameSink class.
+///
+//===----------------------------------------------------------------------===//
+#include "common/CommonTypes.h"
+#include "nes/FrameSink.h"
+
+using namespace Nes;
+
+constexpr const std::size_t FrameSink::NUM_LATENCY_BUCKETS;
+constexpr const byte FrameSink::FRESH;
+constexpr const byte FrameSink::INDEX;
+
+FrameSink::FrameSink(std::size_t frameSize) :
+  back(0),
+  front(1),
+  holdingFrame(false),
+  middle(2),
+  publishedCount(0),
+  droppedCount(0),
+  duplicatedCount(0) {
+  for(Frame& frame : frames) {
+    frame.pixels.resize(frameSize);
+    frame.number = 0;
+  }
+  for(auto& bucket : latencies) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+void FrameSink::publish() {
+  Frame& frame = frames[back];
+  frame.number = publishedCount.load(std::memory_order_relaxed) + 1;
+  frame.published = Clock::now();
+  // Release the frame to the consumer, and take whatever was in the middle,
+  // which is either a frame the consumer never took or the one it let go of.
+  byte previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+  back = previous & INDEX;
+  publishedCount.store(frame.number, std::memory_order_relaxed);
+  if(previous & FRESH) {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+const FrameSink::Frame* FrameSink::acquire() {
+  if(!(middle.load(std::memory_order_relaxed) & FRESH)) {
+    if(!holdingFrame) {
+      return nullptr;
+    }
+    duplicatedCount.fetch_add(1, std::memory_order_relaxed);
+    return &frames[front];
+  }
+  // Only the consumer clears FRESH, so the middle buffer is still fresh,
+  // though the producer may have swapped a newer frame into it.
+  byte previous = middle.exchange(front, std::memory_order_acq_rel);
+  front = previous & INDEX;
+  holdingFrame = true;
+  const Frame& frame = frames[front];
+  auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      Clock::now() - frame.published).count();
+  std::size_t bucket = 0;
+  while(latency > 0 && bucket < NUM_LATENCY_BUCKETS - 1) {
+    latency >>= 1;
+    bucket++;
+  }
+  latencies[bucket].fetch_add(1, std::memory_order_relaxed);
+  return &frame;
+}
+
+std::array<std::uint64_t, FrameSink::NUM_LATENCY_BUCKETS> FrameSink::getLatencyHistogram() const {
+  std::array<std::uint64_t, NUM_LATENCY_BUCKETS> histogram;
+  for(std::size_t bucket = 0; bucket < NUM_LATENCY_BUCKETS; bucket++) {
+    histogram[bucket] = latencies[bucket].load(std::memory_order_relaxed);
+  }
+  return histogram;
+}
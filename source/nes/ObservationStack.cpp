@@ -0,0 +1,232 @@
+//===-- source/nes/ObservationStack.cpp - Stacked Observations --*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the ObservationStack class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "common/CommonTypes.h"
+#include "common/structures/StructureException.h"
+#include "nes/ObservationStack.h"
+#include "nes/Ppu.h"
+
+using namespace Nes;
+
+constexpr const std::size_t ObservationStack::DEFAULT_SIZE;
+constexpr const std::size_t ObservationStack::DEFAULT_DEPTH;
+constexpr const std::size_t ObservationStack::DEFAULT_CROP;
+
+/// Sum of the weights of the taps of an output row. A gray level times a
+/// weight is at most 255 * 128, so the weighted sum of a column fits a
+/// signed 16 bit word, as pmaddwd takes.
+static const int ROW_WEIGHT_ONE = 128;
+
+/// Sum of the weights of the taps of an output column.
+static const int COLUMN_WEIGHT_ONE = 256;
+
+/// Bits to shift a filtered pixel right by to get a gray level.
+static const int FILTER_SHIFT = 15;
+
+#if defined(__AVX2__)
+/// Number of taps of each output column in the vector path, one SSE register
+/// of 16 bit words.
+static const std::size_t VECTOR_TAPS = 8;
+#else
+/// Number of taps of each output column in the portable path, just enough.
+static const std::size_t VECTOR_TAPS = 0;
+#endif
+
+ObservationStack::ObservationStack(std::size_t width, std::size_t height,
+    std::size_t depth, std::size_t cropTop, std::size_t cropBottom) :
+  width(width),
+  height(height),
+  depth(depth),
+  cropTop(cropTop),
+  rows(cropTop < Ppu::HEIGHT && cropBottom < Ppu::HEIGHT - cropTop
+      ? Ppu::HEIGHT - cropTop - cropBottom : 0),
+  gray(rows * Ppu::WIDTH),
+  rowSum(Ppu::WIDTH),
+  newest(0) {
+  if(width == 0 || height == 0 || depth == 0 || rows == 0) {
+    throw Exception::StructureException("An observation stack needs observations"
+        " of at least one pixel, and a crop leaving some rows of the frame.");
+  }
+  const std::size_t largest = std::numeric_limits<std::size_t>::max();
+  if(height > largest / width || depth > largest / (width * height)) {
+    throw Exception::StructureException("An observation stack of "
+        + std::to_string(width) + "x" + std::to_string(height) + "x"
+        + std::to_string(depth) + " does not fit in memory.");
+  }
+  ring = Memory::Arena<byte>(getStackSize());
+  gray.allocate(rows * Ppu::WIDTH);
+  rowSum.allocate(Ppu::WIDTH);
+  std::memset(ring.at(ring.allocate(getStackSize())), 0, getStackSize());
+  rowFilter = buildFilter(rows, height, ROW_WEIGHT_ONE, 0);
+  columnFilter = buildFilter(Ppu::WIDTH, width, COLUMN_WEIGHT_ONE, VECTOR_TAPS);
+}
+
+ObservationStack::Filter ObservationStack::buildFilter(std::size_t inputs,
+    std::size_t outputs, int one, std::size_t minTaps) {
+  // Measured in units of 1 / (inputs * outputs) of the frame, input line i
+  // spans [i * outputs, (i + 1) * outputs) and output line j spans
+  // [j * inputs, (j + 1) * inputs), so every overlap is a whole number. An
+  // output line overlaps at most this many input lines.
+  Filter filter;
+  filter.taps = (inputs + outputs - 1) / outputs + 1;
+  if(filter.taps <= minTaps) {
+    filter.taps = minTaps;
+  }
+  filter.taps = std::min(filter.taps, inputs);
+  filter.first.resize(outputs);
+  filter.weights.resize(outputs * filter.taps, 0);
+  for(std::size_t output = 0; output < outputs; output++) {
+    std::size_t begin = output * inputs;
+    std::size_t end = begin + inputs;
+    std::size_t first = begin / outputs;
+    std::size_t last = (end - 1) / outputs;
+    // Lines near the end start their taps early, with leading zero weights,
+    // so that no tap reads past the last input line.
+    std::size_t start = std::min(first, inputs - filter.taps);
+    filter.first[output] = start;
+    std::uint16_t* weights = &filter.weights[output * filter.taps];
+    int sum = 0;
+    std::size_t heaviest = first - start;
+    for(std::size_t input = first; input <= last; input++) {
+      std::size_t overlap = std::min((input + 1) * outputs, end)
+          - std::max(input * outputs, begin);
+      std::uint16_t& weight = weights[input - start];
+      weight = static_cast<std::uint16_t>((overlap * one + inputs / 2) / inputs);
+      sum += weight;
+      if(weight > weights[heaviest]) {
+        heaviest = input - start;
+      }
+    }
+    // Rounding may leave the weights a little off one, which the heaviest
+    // tap absorbs, so flat areas keep their level exactly.
+    weights[heaviest] = static_cast<std::uint16_t>(weights[heaviest] + one - sum);
+  }
+  return filter;
+}
+
+void ObservationStack::reset(const byte* frame, byte emphasis) {
+  downsample(frame, emphasis, ring.at(0));
+  for(std::size_t slot = 1; slot < depth; slot++) {
+    std::memcpy(ring.at(slot * width * height), ring.at(0), width * height);
+  }
+  newest = 0;
+}
+
+void ObservationStack::push(const byte* frame, byte emphasis) {
+  newest = (newest + 1) % depth;
+  downsample(frame, emphasis, ring.at(newest * width * height));
+}
+
+void ObservationStack::copyStack(byte* destination) const {
+  // The oldest observation follows the newest in the ring, so the stack is
+  // the ring rotated, two copies at most.
+  std::size_t size = width * height;
+  std::size_t oldest = (newest + 1) % depth;
+  std::memcpy(destination, ring.at(oldest * size), (depth - oldest) * size);
+  std::memcpy(destination + (depth - oldest) * size, ring.at(0), oldest * size);
+}
+
+void ObservationStack::downsample(const byte* frame, byte emphasis, byte* observation) {
+  byte* grayRows = gray.at(0);
+  converter.toGray(frame + cropTop * Ppu::WIDTH, rows * Ppu::WIDTH, emphasis, grayRows);
+  std::uint16_t* sum = rowSum.at(0);
+  for(std::size_t y = 0; y < height; y++) {
+    std::fill(sum, sum + Ppu::WIDTH, 0);
+    const std::uint16_t* rowWeights = &rowFilter.weights[y * rowFilter.taps];
+    for(std::size_t tap = 0; tap < rowFilter.taps; tap++) {
+      std::uint16_t weight = rowWeights[tap];
+      if(weight == 0) {
+        continue;
+      }
+      const byte* line = grayRows + (rowFilter.first[y] + tap) * Ppu::WIDTH;
+      std::size_t x = 0;
+#if defined(__AVX2__)
+      __m256i weights = _mm256_set1_epi16(static_cast<short>(weight));
+      for(; x + 16 <= Ppu::WIDTH; x += 16) {
+        __m256i pixels = _mm256_cvtepu8_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + x)));
+        __m256i* out = reinterpret_cast<__m256i*>(sum + x);
+        _mm256_storeu_si256(out, _mm256_add_epi16(_mm256_loadu_si256(out),
+            _mm256_mullo_epi16(pixels, weights)));
+      }
+#elif defined(__SSE2__)
+      __m128i weights = _mm_set1_epi16(static_cast<short>(weight));
+      for(; x + 8 <= Ppu::WIDTH; x += 8) {
+        __m128i pixels = _mm_unpacklo_epi8(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(line + x)), _mm_setzero_si128());
+        __m128i* out = reinterpret_cast<__m128i*>(sum + x);
+        _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out),
+            _mm_mullo_epi16(pixels, weights)));
+      }
+#endif
+      for(; x < Ppu::WIDTH; x++) {
+        sum[x] = static_cast<std::uint16_t>(sum[x] + line[x] * weight);
+      }
+    }
+    // The output is bytes, which may alias anything, so the filter is read
+    // into locals rather than reloaded after every store.
+    byte* out = observation + y * width;
+    const std::size_t taps = columnFilter.taps;
+    const std::size_t* firsts = columnFilter.first.data();
+    const std::uint16_t* columnWeights = columnFilter.weights.data();
+    std::size_t x = 0;
+#if defined(__AVX2__)
+    if(taps == VECTOR_TAPS) {
+      // Each output is the dot product of the 8 words from its first tap on
+      // with its weights, one pmaddwd to 4 partial sums. Pairing outputs x
+      // and x + 4 in each register makes three rounds of phaddd leave the 8
+      // totals in order.
+      const __m256i round = _mm256_set1_epi32(1 << (FILTER_SHIFT - 1));
+      for(; x + 8 <= width; x += 8) {
+        __m256i partials[4];
+        for(std::size_t pair = 0; pair < 4; pair++) {
+          __m256i inputs = _mm256_inserti128_si256(_mm256_castsi128_si256(
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(sum + firsts[x + pair]))),
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(sum + firsts[x + pair + 4])), 1);
+          __m256i weights = _mm256_inserti128_si256(_mm256_castsi128_si256(
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(columnWeights + (x + pair) * taps))),
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(columnWeights + (x + pair + 4) * taps)), 1);
+          partials[pair] = _mm256_madd_epi16(inputs, weights);
+        }
+        __m256i totals = _mm256_hadd_epi32(_mm256_hadd_epi32(partials[0], partials[1]),
+            _mm256_hadd_epi32(partials[2], partials[3]));
+        totals = _mm256_srli_epi32(_mm256_add_epi32(totals, round), FILTER_SHIFT);
+        __m256i words = _mm256_packs_epi32(totals, totals);
+        __m256i bytes = _mm256_packus_epi16(words, words);
+        std::uint32_t low = static_cast<std::uint32_t>(_mm256_cvtsi256_si32(bytes));
+        std::uint32_t high = static_cast<std::uint32_t>(
+            _mm_cvtsi128_si32(_mm256_extracti128_si256(bytes, 1)));
+        std::memcpy(out + x, &low, sizeof(low));
+        std::memcpy(out + x + 4, &high, sizeof(high));
+      }
+    }
+#endif
+    for(; x < width; x++) {
+      const std::uint16_t* inputs = sum + firsts[x];
+      const std::uint16_t* weights = columnWeights + x * taps;
+      std::uint32_t total = 0;
+      for(std::size_t tap = 0; tap < taps; tap++) {
+        total += static_cast<std::uint32_t>(inputs[tap]) * weights[tap];
+      }
+      out[x] = static_cast<byte>((total + (1u << (FILTER_SHIFT - 1))) >> FILTER_SHIFT);
+    }
+  }
+}
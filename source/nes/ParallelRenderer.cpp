@@ -0,0 +1,113 @@
+//===-- source/nes/ParallelRenderer.cpp - Multithreaded Renderer *- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the ParallelRenderer class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+
+#include "common/CommonTypes.h"
+#include "nes/ParallelRenderer.h"
+
+using namespace Nes;
+
+ParallelRenderer::ParallelRenderer(std::size_t threadCount) :
+  frameLog(nullptr),
+  framebuffer(nullptr),
+  frameNumber(0),
+  pendingBands(0),
+  stopping(false) {
+  threadCount = std::min(std::max<std::size_t>(threadCount, 1), Ppu::HEIGHT);
+  for(std::size_t index = 0; index < threadCount; index++) {
+    workers.emplace_back(new Worker());
+    workers.back()->chrSource = nullptr;
+  }
+  // Start the threads once every worker exists, as they read the size of
+  // the pool.
+  for(std::size_t index = 0; index < threadCount; index++) {
+    workers[index]->thread = std::thread(&ParallelRenderer::work, this, index);
+  }
+}
+
+ParallelRenderer::~ParallelRenderer() {
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  frameStarted.notify_all();
+  for(auto& worker : workers) {
+    worker->thread.join();
+  }
+}
+
+void ParallelRenderer::render(const FrameLog& frameLog, byte* framebuffer) {
+  std::unique_lock<std::mutex> lock(mutex);
+  frameDone.wait(lock, [this] { return pendingBands == 0; });
+  this->frameLog = &frameLog;
+  this->framebuffer = framebuffer;
+  pendingBands = workers.size();
+  frameNumber++;
+  lock.unlock();
+  frameStarted.notify_all();
+}
+
+void ParallelRenderer::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  frameDone.wait(lock, [this] { return pendingBands == 0; });
+}
+
+std::size_t ParallelRenderer::getThreadCount() const {
+  return workers.size();
+}
+
+void ParallelRenderer::work(std::size_t index) {
+  Worker& worker = *workers[index];
+  std::uint64_t framesRendered = 0;
+  while(true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      frameStarted.wait(lock, [this, framesRendered] {
+        return stopping || frameNumber != framesRendered;
+      });
+      if(stopping) {
+        return;
+      }
+      framesRendered = frameNumber;
+    }
+    renderBand(worker, index);
+    bool lastBand;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      lastBand = --pendingBands == 0;
+    }
+    if(lastBand) {
+      frameDone.notify_all();
+    }
+  }
+}
+
+void ParallelRenderer::renderBand(Worker& worker, std::size_t index) {
+  const FrameLog& log = *frameLog;
+  // A new cartridge needs a new Ppu, reading from its CHR memory, or from a
+  // private copy of its CHR RAM.
+  if(worker.ppu == nullptr || worker.chrSource != log.chrMemory) {
+    worker.ppu.reset();
+    worker.chrSource = log.chrMemory;
+    if(log.chrWritable) {
+      worker.chrRam = Memory::Ram<byte>(log.chrSize);
+      worker.ppu.reset(new Ppu(worker.chrRam, log.chrSize, true));
+    } else {
+      worker.ppu.reset(new Ppu(*log.chrMemory, log.chrSize, false));
+    }
+  }
+  std::size_t bands = workers.size();
+  worker.ppu->replay(log, index * Ppu::HEIGHT / bands,
+      (index + 1) * Ppu::HEIGHT / bands, framebuffer);
+}
@@ -0,0 +1,758 @@
+//===-- source/nes/Ppu.cpp - Nes Picture Processing Unit --------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the Ppu class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstring>
+
+#include "common/CommonTypes.h"
+#include "nes/Ppu.h"
+
+using namespace Nes;
+
+constexpr const std::size_t Ppu::WIDTH;
+constexpr const std::size_t Ppu::HEIGHT;
+constexpr const std::size_t Ppu::DOTS_PER_SCANLINE;
+constexpr const std::size_t Ppu::SCANLINES_PER_FRAME;
+constexpr const std::size_t Ppu::DOTS_PER_FRAME;
+constexpr const std::size_t Ppu::DOTS_PER_CPU_CYCLE;
+constexpr const std::size_t Ppu::VBLANK_SCANLINE;
+constexpr const std::size_t Ppu::PRE_RENDER_SCANLINE;
+constexpr const byte Ppu::STATUS_SPRITE_OVERFLOW;
+constexpr const byte Ppu::STATUS_SPRITE_ZERO_HIT;
+constexpr const byte Ppu::STATUS_VBLANK;
+
+/// Dot at which vblank starts and ends.
+static const std::size_t VBLANK_DOT = 1;
+/// Dot at which v moves to the next row of pixels.
+static const std::size_t INCREMENT_Y_DOT = 256;
+/// Dot at which the horizontal scroll is copied from t to v, and sprites for
+/// the next scanline are evaluated.
+static const std::size_t COPY_X_DOT = 257;
+/// Dot at which the mapper sees the sprite fetches clock its scanline counter.
+static const std::size_t SCANLINE_CLOCK_DOT = 260;
+/// Dot at which the vertical scroll is copied from t to v on the pre-render
+/// scanline.
+static const std::size_t COPY_Y_DOT = 280;
+/// Number of sprites in OAM.
+static const std::size_t NUM_SPRITES = 64;
+/// Number of sprites that can be displayed on one scanline.
+static const std::size_t SPRITES_PER_SCANLINE = 8;
+
+Ppu::Ppu(CartridgeMapper& mapper) :
+  Ppu(mapper.getChrMemory(), mapper.getChrSize(), mapper.isChrWritable()) {
+  this->mapper = &mapper;
+  syncChrMapping();
+}
+
+Ppu::Ppu(Memory::Bank<byte>& chrMemory, std::size_t chrSize, bool chrWritable) :
+  mapper(nullptr),
+  chrMemory(chrMemory),
+  chrSize(chrSize),
+  chrWritable(chrWritable),
+  chrGeneration(0),
+  tileCache(chrMemory, chrSize, chrWritable),
+  framebuffer(nullptr),
+  headless(false),
+  frameLog(nullptr),
+  ctrl(0),
+  mask(0),
+  status(0),
+  oamAddr(0),
+  readBuffer(0),
+  ioLatch(0),
+  v(0),
+  t(0),
+  fineX(0),
+  writeToggle(false),
+  nmiPending(false),
+  scanline(0),
+  dot(0),
+  frameCount(0),
+  oddFrame(false),
+  pendingDots(0),
+  scrollX(0),
+  spriteZeroOnScanline(false),
+  spriteZeroX(0) {
+  backgroundPixels.fill(0);
+  spritePixels.fill(0);
+  nametables.fill(0);
+  palette.fill(0);
+  oam.fill(0);
+  for(std::size_t page = 0; page < CartridgeMapper::NUM_CHR_PAGES; page++) {
+    chrMapping.offsets[page] = page << CartridgeMapper::PAGE_BITS;
+  }
+  chrMapping.mirroring = Mirroring::HORIZONTAL;
+  dotsUntilEvent = getDotsUntilEvent();
+}
+
+void Ppu::connect(CpuBus& bus) {
+  // Only the first of the mirrors needs a handler, the bus folds the rest of
+  // $2000-$3FFF onto it.
+  for(addr index = 0; index < 8; index++) {
+    Vaddr vaddr = {static_cast<addr>(0x2000 + index)};
+    bus.setReadHandler(vaddr, [this](std::size_t reg) {
+      return readRegister(reg);
+    });
+    bus.setWriteHandler(vaddr, [this](std::size_t reg, byte data) {
+      writeRegister(reg, data);
+    });
+  }
+}
+
+void Ppu::writeOamDma(const byte* page) {
+  catchUp();
+  if(frameLog != nullptr && scanline < HEIGHT) {
+    // Replays only see register accesses, so a DMA during rendering is
+    // logged as the writes it stands for.
+    for(std::size_t i = 0; i < oam.size(); i++) {
+      logEvent(FrameLog::EventType::WRITE, 4, page[i]);
+    }
+  }
+  // The writes wrap around OAM, leaving OAMADDR where it started.
+  std::size_t first = oam.size() - oamAddr;
+  std::memcpy(&oam[oamAddr], page, first);
+  std::memcpy(&oam[0], page + first, oamAddr);
+  ioLatch = page[oam.size() - 1];
+}
+
+void Ppu::saveState(Structure::StateWriter& writer) {
+  catchUp();
+  writer.write(ctrl);
+  writer.write(mask);
+  writer.write(status);
+  writer.write(oamAddr);
+  writer.write(readBuffer);
+  writer.write(ioLatch);
+  writer.write(v);
+  writer.write(t);
+  writer.write(fineX);
+  writer.write(writeToggle);
+  writer.write(nmiPending);
+  writer.write(scanline);
+  writer.write(dot);
+  writer.write(frameCount);
+  writer.write(oddFrame);
+  writer.write(scrollX);
+  writer.write(backgroundPixels);
+  writer.write(spritePixels);
+  writer.write(spriteZeroOnScanline);
+  writer.write(spriteZeroX);
+  writer.write(nametables);
+  writer.write(palette);
+  writer.write(oam);
+  if(chrWritable) {
+    writer.write(chrMemory.getStorage(), chrSize);
+  }
+}
+
+void Ppu::loadState(Structure::StateReader& reader) {
+  reader.read(ctrl);
+  reader.read(mask);
+  reader.read(status);
+  reader.read(oamAddr);
+  reader.read(readBuffer);
+  reader.read(ioLatch);
+  reader.read(v);
+  reader.read(t);
+  reader.read(fineX);
+  reader.read(writeToggle);
+  reader.read(nmiPending);
+  reader.read(scanline);
+  reader.read(dot);
+  reader.read(frameCount);
+  reader.read(oddFrame);
+  reader.read(scrollX);
+  reader.read(backgroundPixels);
+  reader.read(spritePixels);
+  reader.read(spriteZeroOnScanline);
+  reader.read(spriteZeroX);
+  reader.read(nametables);
+  reader.read(palette);
+  reader.read(oam);
+  if(chrWritable) {
+    // Only tiles that differ are written, so that only they are decoded
+    // again.
+    const byte* chrRam = reader.view(chrSize);
+    const byte* current = chrMemory.getStorage();
+    for(std::size_t tile = 0; tile < chrSize; tile += TileCache::TILE_SIZE) {
+      if(std::memcmp(current + tile, chrRam + tile, TileCache::TILE_SIZE) != 0) {
+        for(std::size_t offset = tile; offset < tile + TileCache::TILE_SIZE; offset++) {
+          chrMemory.write(offset, chrRam[offset]);
+        }
+        tileCache.invalidate(tile);
+      }
+    }
+  }
+  if(mapper != nullptr) {
+    syncChrMapping();
+  }
+  pendingDots = 0;
+  dotsUntilEvent = getDotsUntilEvent();
+}
+
+void Ppu::setFramebuffer(byte* framebuffer) {
+  this->framebuffer = framebuffer;
+}
+
+void Ppu::setHeadless(bool headless) {
+  this->headless = headless;
+}
+
+void Ppu::setFrameLog(FrameLog* frameLog) {
+  this->frameLog = frameLog;
+}
+
+void Ppu::replay(const FrameLog& frameLog, std::size_t firstLine,
+    std::size_t lastLine, byte* output) {
+  restore(frameLog);
+  std::size_t end = lastLine * DOTS_PER_SCANLINE;
+  std::size_t mapping = 0;
+  for(const FrameLog::Event& event : frameLog.events) {
+    if(event.time >= end) {
+      break;
+    }
+    replayUntil(event.time, firstLine, output);
+    switch(event.type) {
+      case FrameLog::EventType::READ:
+        readRegister(event.index);
+        break;
+      case FrameLog::EventType::WRITE:
+        writeRegister(event.index, event.data);
+        break;
+      case FrameLog::EventType::CHR_MAPPING:
+        chrMapping = frameLog.chrMappings[mapping++];
+        break;
+    }
+  }
+  replayUntil(end, firstLine, output);
+  framebuffer = nullptr;
+}
+
+void Ppu::catchUp() {
+  // The mapper may have switched CHR banks since the last catch up. The new
+  // banks apply from here on, which the log must record too.
+  if(mapper != nullptr && mapper->getChrGeneration() != chrGeneration) {
+    syncChrMapping();
+  }
+  // Run whole scanlines, or what is left of them, until every elapsed dot
+  // has been accounted for.
+  while(pendingDots > 0) {
+    std::size_t length = getScanlineLength();
+    std::size_t end = std::min(length, dot + pendingDots);
+    runScanline(dot, end);
+    pendingDots -= end - dot;
+    dot = end;
+    if(dot == length) {
+      dot = 0;
+      if(++scanline == SCANLINES_PER_FRAME) {
+        scanline = 0;
+        oddFrame = !oddFrame;
+        if(frameLog != nullptr) {
+          logFrameStart();
+        }
+      }
+    }
+  }
+  dotsUntilEvent = getDotsUntilEvent();
+}
+
+byte Ppu::readRegister(std::size_t index) {
+  catchUp();
+  logEvent(FrameLog::EventType::READ, index, 0);
+  switch(index & 0x7) {
+    case 2:
+      // PPUSTATUS. Reading acknowledges vblank and resets the write toggle.
+      ioLatch = (status & 0xE0) | (ioLatch & 0x1F);
+      status &= ~STATUS_VBLANK;
+      writeToggle = false;
+      break;
+    case 4:
+      // OAMDATA
+      ioLatch = oam[oamAddr];
+      break;
+    case 7: {
+      // PPUDATA. Reads below the palette come from a one byte buffer, palette
+      // reads are immediate but still refill the buffer with the nametable
+      // byte underneath.
+      addr address = v & 0x3FFF;
+      if(address < 0x3F00) {
+        ioLatch = readBuffer;
+        readBuffer = readVram(address);
+      } else {
+        ioLatch = (ioLatch & 0xC0) | palette[getPaletteIndex(address)];
+        readBuffer = readVram(address - 0x1000);
+      }
+      v = (v + ((ctrl & CTRL_INCREMENT_32) ? 32 : 1)) & 0x7FFF;
+      break;
+    }
+    default:
+      // Write only registers read back the I/O latch.
+      break;
+  }
+  return ioLatch;
+}
+
+void Ppu::writeRegister(std::size_t index, byte data) {
+  catchUp();
+  logEvent(FrameLog::EventType::WRITE, index, data);
+  ioLatch = data;
+  switch(index & 0x7) {
+    case 0:
+      // PPUCTRL. Enabling NMI during vblank raises one straight away.
+      if(!(ctrl & CTRL_NMI) && (data & CTRL_NMI) && (status & STATUS_VBLANK)) {
+        nmiPending = true;
+      }
+      ctrl = data;
+      t = (t & 0xF3FF) | ((data & 0x03) << 10);
+      break;
+    case 1:
+      // PPUMASK
+      mask = data;
+      break;
+    case 3:
+      // OAMADDR
+      oamAddr = data;
+      break;
+    case 4:
+      // OAMDATA
+      oam[oamAddr++] = data;
+      break;
+    case 5:
+      // PPUSCROLL
+      if(!writeToggle) {
+        t = (t & 0xFFE0) | (data >> 3);
+        if(isMidScanline()) {
+          scrollX += static_cast<int>(data & 0x07) - fineX;
+        }
+        fineX = data & 0x07;
+      } else {
+        t = (t & 0x8C1F) | ((data & 0x07) << 12) | ((data & 0xF8) << 2);
+      }
+      writeToggle = !writeToggle;
+      break;
+    case 6:
+      // PPUADDR. The second write lands in v, moving the scroll straight
+      // away even partway through a scanline.
+      if(!writeToggle) {
+        t = (t & 0x00FF) | ((data & 0x3F) << 8);
+      } else {
+        t = (t & 0xFF00) | data;
+        v = t;
+        if(isMidScanline()) {
+          latchScrollX(dot - 1);
+        }
+      }
+      writeToggle = !writeToggle;
+      break;
+    case 7:
+      // PPUDATA
+      writeVram(v, data);
+      v = (v + ((ctrl & CTRL_INCREMENT_32) ? 32 : 1)) & 0x7FFF;
+      break;
+    default:
+      // PPUSTATUS is read only.
+      break;
+  }
+}
+
+void Ppu::runScanline(std::size_t from, std::size_t to) {
+  // Every event on the scanline between from and to happens in dot order:
+  // the run of visible pixels, then the scroll updates, sprite evaluation
+  // and the mapper clock.
+  auto reaches = [from, to](std::size_t eventDot) {
+    return from <= eventDot && eventDot < to;
+  };
+  if(scanline < HEIGHT || scanline == PRE_RENDER_SCANLINE) {
+    if(scanline < HEIGHT) {
+      if(from == 0) {
+        latchScrollX(0);
+      }
+      // Dots 1 to 256 output pixels 0 to 255.
+      std::size_t x0 = std::max<std::size_t>(from, 1) - 1;
+      std::size_t x1 = std::min<std::size_t>(to, WIDTH + 1) - 1;
+      if(x0 < x1) {
+        renderPixels(x0, x1);
+      }
+    }
+    if(isRendering()) {
+      if(reaches(INCREMENT_Y_DOT)) {
+        incrementY();
+      }
+      if(reaches(COPY_X_DOT)) {
+        v = (v & ~0x041F) | (t & 0x041F);
+      }
+      if(reaches(SCANLINE_CLOCK_DOT) && mapper != nullptr) {
+        mapper->clockScanline();
+      }
+      if(scanline == PRE_RENDER_SCANLINE && reaches(COPY_Y_DOT)) {
+        v = (v & 0x041F) | (t & 0x7BE0);
+      }
+    }
+    if(reaches(COPY_X_DOT)) {
+      if(isRendering() && scanline < HEIGHT - 1) {
+        evaluateSprites(scanline + 1);
+      } else {
+        spritePixels.fill(0);
+        spriteZeroOnScanline = false;
+      }
+    }
+    if(scanline == PRE_RENDER_SCANLINE && reaches(VBLANK_DOT)) {
+      status &= ~(STATUS_VBLANK | STATUS_SPRITE_ZERO_HIT | STATUS_SPRITE_OVERFLOW);
+    }
+  } else if(scanline == VBLANK_SCANLINE && reaches(VBLANK_DOT)) {
+    status |= STATUS_VBLANK;
+    if(ctrl & CTRL_NMI) {
+      nmiPending = true;
+    }
+    frameCount++;
+  }
+}
+
+void Ppu::renderPixels(std::size_t x0, std::size_t x1) {
+  if(!isDrawing()) {
+    // The Cpu can only see the background through sprite 0 hits, so only the
+    // pixels under sprite 0 are fetched.
+    if(isRendering() && spriteZeroOnScanline && !(status & STATUS_SPRITE_ZERO_HIT)) {
+      std::size_t first = std::max(x0, spriteZeroX);
+      std::size_t last = std::min(x1, spriteZeroX + 8);
+      if(first < last) {
+        fetchBackground(first, last);
+        checkSpriteZero(first, last);
+      }
+    }
+    return;
+  }
+  byte colorMask = (mask & MASK_GRAYSCALE) ? 0x30 : 0x3F;
+  if(!isRendering()) {
+    // With rendering off the backdrop colour is output.
+    if(framebuffer != nullptr) {
+      std::fill(framebuffer + scanline * WIDTH + x0,
+          framebuffer + scanline * WIDTH + x1, palette[0] & colorMask);
+    }
+    return;
+  }
+  fetchBackground(x0, x1);
+  if(spriteZeroOnScanline && !(status & STATUS_SPRITE_ZERO_HIT)) {
+    checkSpriteZero(x0, x1);
+  }
+  if(framebuffer == nullptr) {
+    return;
+  }
+  byte* row = framebuffer + scanline * WIDTH;
+  for(std::size_t x = x0; x < x1; x++) {
+    byte background = backgroundPixels[x];
+    if(x < 8 && !(mask & MASK_BACKGROUND_LEFT)) {
+      background = 0;
+    }
+    byte sprite = (mask & MASK_SPRITES) ? spritePixels[x] : 0;
+    if(x < 8 && !(mask & MASK_SPRITES_LEFT)) {
+      sprite = 0;
+    }
+    // Sprites in front of the background win, as do sprites behind a
+    // transparent background pixel.
+    std::size_t entry = 0;
+    if((sprite & 0x03) && (!(sprite & SPRITE_BEHIND) || !background)) {
+      entry = 0x10 | (sprite & 0x0F);
+    } else if(background) {
+      entry = background;
+    }
+    row[x] = palette[entry] & colorMask;
+  }
+}
+
+void Ppu::fetchBackground(std::size_t x0, std::size_t x1) {
+  if(!(mask & MASK_BACKGROUND)) {
+    std::fill(backgroundPixels.begin() + x0, backgroundPixels.begin() + x1, 0);
+    return;
+  }
+  addr patternTable = (ctrl & CTRL_BACKGROUND_TABLE) ? 0x1000 : 0x0000;
+  addr fineY = (v >> 12) & 0x07;
+  addr coarseY = (v >> 5) & 0x1F;
+  addr nametableY = (v >> 11) & 0x01;
+  // Decode one tile at a time, starting partway into the first tile.
+  std::size_t x = x0;
+  while(x < x1) {
+    std::size_t position =
+        static_cast<std::size_t>(scrollX + static_cast<int>(x)) & 0x1FF;
+    addr coarseX = (position >> 3) & 0x1F;
+    addr nametable = 0x2000 | (nametableY << 11)
+        | static_cast<addr>((position >> 8) << 10);
+    byte tile = nametables[getNametableIndex(nametable | (coarseY << 5) | coarseX)];
+    byte attribute = nametables[getNametableIndex(
+        nametable | 0x3C0 | ((coarseY >> 2) << 3) | (coarseX >> 2))];
+    byte paletteBits = (attribute >> (((coarseY & 0x02) << 1) | (coarseX & 0x02))) & 0x03;
+    const byte* row =
+        tileCache.getRow(getChrOffset(patternTable + (tile << 4) + fineY));
+    for(std::size_t column = position & 0x7; column < 8 && x < x1; column++, x++) {
+      byte pixel = row[column];
+      backgroundPixels[x] = pixel ? (paletteBits << 2) | pixel : 0;
+    }
+  }
+}
+
+void Ppu::checkSpriteZero(std::size_t x0, std::size_t x1) {
+  if(!(mask & MASK_BACKGROUND) || !(mask & MASK_SPRITES)) {
+    return;
+  }
+  // Sprite 0 never hits at x = 255, nor in a clipped left column.
+  if(!(mask & MASK_BACKGROUND_LEFT) || !(mask & MASK_SPRITES_LEFT)) {
+    x0 = std::max<std::size_t>(x0, 8);
+  }
+  x1 = std::min<std::size_t>(x1, WIDTH - 1);
+  for(std::size_t x = x0; x < x1; x++) {
+    if((spritePixels[x] & SPRITE_ZERO) && backgroundPixels[x]) {
+      status |= STATUS_SPRITE_ZERO_HIT;
+      return;
+    }
+  }
+}
+
+void Ppu::evaluateSprites(std::size_t line) {
+  spritePixels.fill(0);
+  spriteZeroOnScanline = false;
+  int height = (ctrl & CTRL_SPRITE_16) ? 16 : 8;
+  std::size_t count = 0;
+  for(std::size_t sprite = 0; sprite < NUM_SPRITES; sprite++) {
+    const byte* entry = &oam[sprite * 4];
+    // Sprites are drawn one scanline below their OAM Y coordinate.
+    int row = static_cast<int>(line) - 1 - entry[0];
+    if(row < 0 || row >= height) {
+      continue;
+    }
+    if(count == SPRITES_PER_SCANLINE) {
+      status |= STATUS_SPRITE_OVERFLOW;
+      break;
+    }
+    count++;
+    // Other sprites are invisible to the Cpu, so when not drawing they only
+    // need counting.
+    if(!isDrawing() && sprite != 0) {
+      continue;
+    }
+    byte tile = entry[1];
+    byte attributes = entry[2];
+    if(attributes & 0x80) {
+      row = height - 1 - row;
+    }
+    addr pattern;
+    if(height == 16) {
+      // 8x16 sprites take their pattern table from bit 0 of the tile.
+      pattern = ((tile & 0x01) << 12) + ((tile & 0xFE) << 4)
+          + ((row & 0x08) << 1) + (row & 0x07);
+    } else {
+      pattern = ((ctrl & CTRL_SPRITE_TABLE) ? 0x1000 : 0x0000) + (tile << 4) + row;
+    }
+    const byte* tileRow = tileCache.getRow(getChrOffset(pattern));
+    byte flags = ((attributes & 0x03) << 2)
+        | ((attributes & 0x20) ? SPRITE_BEHIND : 0)
+        | (sprite == 0 ? SPRITE_ZERO : 0);
+    for(std::size_t column = 0; column < 8; column++) {
+      std::size_t x = entry[3] + column;
+      if(x >= WIDTH) {
+        break;
+      }
+      byte pixel = tileRow[(attributes & 0x40) ? 7 - column : column];
+      // Lower numbered sprites win, whatever their priority.
+      if(pixel && !(spritePixels[x] & 0x03)) {
+        spritePixels[x] = flags | pixel;
+      }
+    }
+    if(sprite == 0) {
+      spriteZeroOnScanline = true;
+      spriteZeroX = entry[3];
+    }
+  }
+}
+
+void Ppu::syncChrMapping() {
+  for(std::size_t page = 0; page < CartridgeMapper::NUM_CHR_PAGES; page++) {
+    chrMapping.offsets[page] = mapper->getChrOffset(
+        static_cast<addr>(page << CartridgeMapper::PAGE_BITS));
+  }
+  chrMapping.mirroring = mapper->getMirroring();
+  chrGeneration = mapper->getChrGeneration();
+  if(frameLog != nullptr && scanline < HEIGHT) {
+    logEvent(FrameLog::EventType::CHR_MAPPING, 0, 0);
+    frameLog->chrMappings.push_back(chrMapping);
+  }
+}
+
+void Ppu::logFrameStart() {
+  FrameLog& log = *frameLog;
+  log.ctrl = ctrl;
+  log.mask = mask;
+  log.status = status;
+  log.oamAddr = oamAddr;
+  log.readBuffer = readBuffer;
+  log.ioLatch = ioLatch;
+  log.v = v;
+  log.t = t;
+  log.fineX = fineX;
+  log.writeToggle = writeToggle;
+  log.oddFrame = oddFrame;
+  log.chrMapping = chrMapping;
+  log.nametables = nametables;
+  log.palette = palette;
+  log.oam = oam;
+  log.chrMemory = &chrMemory;
+  log.chrSize = chrSize;
+  log.chrWritable = chrWritable;
+  // CHR ROM cannot change under the replaying Ppus, CHR RAM can.
+  log.chrRam.resize(chrWritable ? chrSize : 0);
+  for(std::size_t offset = 0; offset < log.chrRam.size(); offset++) {
+    log.chrRam[offset] = chrMemory.read(offset);
+  }
+  log.events.clear();
+  log.chrMappings.clear();
+}
+
+void Ppu::restore(const FrameLog& frameLog) {
+  ctrl = frameLog.ctrl;
+  mask = frameLog.mask;
+  status = frameLog.status;
+  oamAddr = frameLog.oamAddr;
+  readBuffer = frameLog.readBuffer;
+  ioLatch = frameLog.ioLatch;
+  v = frameLog.v;
+  t = frameLog.t;
+  fineX = frameLog.fineX;
+  writeToggle = frameLog.writeToggle;
+  oddFrame = frameLog.oddFrame;
+  chrMapping = frameLog.chrMapping;
+  nametables = frameLog.nametables;
+  palette = frameLog.palette;
+  oam = frameLog.oam;
+  // Only the CHR RAM written since the last replay needs decoding again.
+  for(std::size_t offset = 0; offset < frameLog.chrRam.size(); offset++) {
+    byte data = frameLog.chrRam[offset];
+    if(chrMemory.read(offset) != data) {
+      chrMemory.write(offset, data);
+      tileCache.invalidate(offset);
+    }
+  }
+  nmiPending = false;
+  scanline = 0;
+  dot = 0;
+  pendingDots = 0;
+  scrollX = 0;
+  backgroundPixels.fill(0);
+  spritePixels.fill(0);
+  spriteZeroOnScanline = false;
+  spriteZeroX = 0;
+  dotsUntilEvent = getDotsUntilEvent();
+}
+
+void Ppu::replayUntil(std::size_t time, std::size_t firstLine, byte* output) {
+  // Scanlines above the band only matter for the state they leave behind.
+  // The scanline just above the band is run in full, as it evaluates the
+  // sprites of the first scanline of the band.
+  std::size_t evaluateFrom = (firstLine > 0 ? firstLine - 1 : 0) * DOTS_PER_SCANLINE;
+  std::size_t drawFrom = firstLine * DOTS_PER_SCANLINE;
+  std::size_t position;
+  while((position = getFrameTime()) < time) {
+    std::size_t until = time;
+    if(position < evaluateFrom) {
+      headless = true;
+      until = std::min(time, evaluateFrom);
+    } else if(position < drawFrom) {
+      headless = false;
+      framebuffer = nullptr;
+      until = std::min(time, drawFrom);
+    } else {
+      headless = false;
+      framebuffer = output;
+    }
+    advance(until - position);
+    catchUp();
+  }
+}
+
+void Ppu::latchScrollX(std::size_t x) {
+  scrollX = static_cast<int>((((v >> 10) & 0x01) << 8) | ((v & 0x1F) << 3) | fineX)
+      - static_cast<int>(x);
+}
+
+void Ppu::incrementY() {
+  if((v & 0x7000) != 0x7000) {
+    v += 0x1000;
+    return;
+  }
+  // Fine Y wraps into coarse Y, which wraps into the vertical nametable at
+  // row 30. Rows 30 and 31 are attribute data, and wrap without switching.
+  v &= ~0x7000;
+  addr coarseY = (v >> 5) & 0x1F;
+  if(coarseY == 29) {
+    coarseY = 0;
+    v ^= 0x0800;
+  } else if(coarseY == 31) {
+    coarseY = 0;
+  } else {
+    coarseY++;
+  }
+  v = (v & ~0x03E0) | (coarseY << 5);
+}
+
+std::size_t Ppu::getScanlineLength() const {
+  if(scanline == PRE_RENDER_SCANLINE && oddFrame && isRendering()) {
+    return DOTS_PER_SCANLINE - 1;
+  }
+  return DOTS_PER_SCANLINE;
+}
+
+std::size_t Ppu::getDotsUntilEvent() const {
+  // The Cpu can observe the mapper scanline clock on every rendered
+  // scanline, and vblank starting, which also completes the frame.
+  bool renderedScanline = scanline < HEIGHT || scanline == PRE_RENDER_SCANLINE;
+  if(renderedScanline && dot <= SCANLINE_CLOCK_DOT) {
+    return SCANLINE_CLOCK_DOT + 1 - dot;
+  }
+  if(scanline == VBLANK_SCANLINE && dot <= VBLANK_DOT) {
+    return VBLANK_DOT + 1 - dot;
+  }
+  std::size_t dots = getScanlineLength() - dot;
+  std::size_t next = scanline + 1;
+  if(next == SCANLINES_PER_FRAME || next < HEIGHT) {
+    return dots + SCANLINE_CLOCK_DOT + 1;
+  }
+  if(next <= VBLANK_SCANLINE) {
+    return dots + (VBLANK_SCANLINE - next) * DOTS_PER_SCANLINE + VBLANK_DOT + 1;
+  }
+  return dots + (PRE_RENDER_SCANLINE - next) * DOTS_PER_SCANLINE
+      + SCANLINE_CLOCK_DOT + 1;
+}
+
+byte Ppu::readVram(addr address) const {
+  address &= 0x3FFF;
+  if(address < 0x2000) {
+    return readChr(address);
+  }
+  if(address < 0x3F00) {
+    return nametables[getNametableIndex(address)];
+  }
+  return palette[getPaletteIndex(address)];
+}
+
+void Ppu::writeVram(addr address, byte data) {
+  address &= 0x3FFF;
+  if(address < 0x2000) {
+    // Writes to CHR ROM go nowhere.
+    if(chrWritable) {
+      std::size_t offset = getChrOffset(address);
+      chrMemory.write(offset, data);
+      tileCache.invalidate(offset);
+    }
+  } else if(address < 0x3F00) {
+    nametables[getNametableIndex(address)] = data;
+  } else {
+    palette[getPaletteIndex(address)] = data & 0x3F;
+  }
+}
@@ -0,0 +1,161 @@
+//===-- source/nes/Resampler.cpp - Polyphase Audio Resampler ----*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the Resampler class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "common/CommonTypes.h"
+#include "nes/Resampler.h"
+
+using namespace Nes;
+
+constexpr const std::size_t Resampler::PHASES;
+constexpr const std::size_t Resampler::ZERO_CROSSINGS;
+constexpr const double Resampler::MAX_RATE_ADJUSTMENT;
+
+/// Cutoff of the filter, as a fraction of the lower Nyquist frequency.
+static const double CUTOFF = 0.9;
+/// The filter length is rounded up to a multiple of this many taps, the
+/// widest vector of floats.
+static const std::size_t TAP_ALIGNMENT = 8;
+/// Pi.
+static const double PI = 3.14159265358979323846;
+/// Mask of the fractional half of a 32.32 fixed point number.
+static const std::uint64_t FRACTION_MASK = 0xFFFFFFFFull;
+
+/// Compute the dot product of two runs of floats.
+/// \param a The first run.
+/// \param b The second run.
+/// \param count The length of the runs, a multiple of TAP_ALIGNMENT.
+static inline float dot(const float* a, const float* b, std::size_t count) {
+#if defined(__AVX2__)
+  // Two accumulators, to hide the latency of the adds.
+  __m256 even = _mm256_setzero_ps();
+  __m256 odd = _mm256_setzero_ps();
+  std::size_t i = 0;
+  for(; i + 16 <= count; i += 16) {
+#if defined(__FMA__)
+    even = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), even);
+    odd = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), odd);
+#else
+    even = _mm256_add_ps(even, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    odd = _mm256_add_ps(odd, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+#endif
+  }
+  if(i < count) {
+    even = _mm256_add_ps(even, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+  }
+  __m256 sum = _mm256_add_ps(even, odd);
+  __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+#elif defined(__SSE2__)
+  __m128 even = _mm_setzero_ps();
+  __m128 odd = _mm_setzero_ps();
+  for(std::size_t i = 0; i < count; i += 8) {
+    even = _mm_add_ps(even, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    odd = _mm_add_ps(odd, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+  }
+  __m128 half = _mm_add_ps(even, odd);
+#endif
+#if defined(__SSE2__)
+  half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+  return _mm_cvtss_f32(half);
+#else
+  float sum = 0.0f;
+  for(std::size_t i = 0; i < count; i++) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+#endif
+}
+
+Resampler::Resampler(double inputRate, double outputRate) :
+  inputRate(inputRate),
+  outputRate(outputRate),
+  position(0),
+  adjustment(0.0) {
+  // The filter passes up to the lower of the two Nyquist frequencies, given
+  // here as a fraction of the input rate.
+  double cutoff = CUTOFF * std::min(inputRate, outputRate) / (2.0 * inputRate);
+  // Zero crossings of the sinc are 1 / (2 * cutoff) input samples apart.
+  double halfWidth = ZERO_CROSSINGS / (2.0 * cutoff);
+  taps = static_cast<std::size_t>(std::ceil(2.0 * halfWidth));
+  taps = (taps + TAP_ALIGNMENT - 1) / TAP_ALIGNMENT * TAP_ALIGNMENT;
+  double centre = taps / 2.0;
+  kernels.resize(PHASES * taps);
+  for(std::size_t phase = 0; phase < PHASES; phase++) {
+    float* kernel = &kernels[phase * taps];
+    double sum = 0.0;
+    for(std::size_t tap = 0; tap < taps; tap++) {
+      // Each phase is the filter shifted back by its fraction of a sample.
+      double x = tap - centre - static_cast<double>(phase) / PHASES;
+      double t = 2.0 * PI * cutoff * x;
+      double sinc = x == 0.0 ? 1.0 : std::sin(t) / t;
+      double u = x / centre;
+      double window = std::abs(u) >= 1.0 ? 0.0
+          : 0.42 + 0.5 * std::cos(PI * u) + 0.08 * std::cos(2.0 * PI * u);
+      kernel[tap] = static_cast<float>(sinc * window);
+      sum += kernel[tap];
+    }
+    // Normalize each phase to unity gain, so that a constant input comes out
+    // unchanged whatever the phase.
+    for(std::size_t tap = 0; tap < taps; tap++) {
+      kernel[tap] = static_cast<float>(kernel[tap] / sum);
+    }
+  }
+  reset();
+  updateStep();
+}
+
+std::size_t Resampler::process(const float* input, std::size_t count, std::vector<float>& output) {
+  history.insert(history.end(), input, input + count);
+  std::size_t produced = 0;
+  std::size_t index = static_cast<std::size_t>(position >> 32);
+  while(index + taps <= history.size()) {
+    std::size_t phase = static_cast<std::size_t>(((position & FRACTION_MASK) * PHASES) >> 32);
+    output.push_back(dot(&history[index], &kernels[phase * taps], taps));
+    produced++;
+    position += step;
+    index = static_cast<std::size_t>(position >> 32);
+  }
+  // Drop the input before the next output's first tap, and move the position
+  // back to match.
+  std::size_t consumed = std::min(index, history.size());
+  history.erase(history.begin(), history.begin() + consumed);
+  position -= static_cast<std::uint64_t>(consumed) << 32;
+  return produced;
+}
+
+void Resampler::reset() {
+  // Start with a filter's worth of silence, so that the first output is of
+  // the first input sample rather than of a filter's worth of input.
+  history.assign(taps / 2, 0.0f);
+  position = 0;
+}
+
+void Resampler::setRateAdjustment(double ppm) {
+  adjustment = std::max(-MAX_RATE_ADJUSTMENT, std::min(MAX_RATE_ADJUSTMENT, ppm));
+  updateStep();
+}
+
+void Resampler::setBufferFill(double fill) {
+  setRateAdjustment((fill - 0.5) * 2.0 * MAX_RATE_ADJUSTMENT);
+}
+
+void Resampler::updateStep() {
+  double ratio = inputRate / outputRate * (1.0 + adjustment / 1000000.0);
+  step = static_cast<std::uint64_t>(std::llround(ratio * 4294967296.0));
+}
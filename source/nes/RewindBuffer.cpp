@@ -0,0 +1,268 @@
+//===-- source/nes/RewindBuffer.cpp - Rewind Buffer -------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the RewindBuffer class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "common/CommonTypes.h"
+#include "common/structures/StructureException.h"
+#include "nes/RewindBuffer.h"
+
+using namespace Nes;
+
+/// Append an unsigned LEB128 varint.
+static inline byte* putVarint(byte* out, std::size_t value) {
+  while(value >= 0x80) {
+    *out++ = static_cast<byte>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<byte>(value);
+  return out;
+}
+
+/// Read an unsigned LEB128 varint.
+static inline std::size_t getVarint(const byte*& in) {
+  std::size_t value = 0;
+  for(unsigned shift = 0; ; shift += 7) {
+    byte part = *in++;
+    value |= static_cast<std::size_t>(part & 0x7F) << shift;
+    if((part & 0x80) == 0) {
+      return value;
+    }
+  }
+}
+
+/// Load 8 bytes, at any alignment.
+static inline std::uint64_t loadWord(const byte* bytes) {
+  std::uint64_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+RewindBuffer::RewindBuffer(std::size_t maxFrames, std::size_t budget,
+    std::size_t keyframeInterval) :
+  ring(budget),
+  writeOffset(0),
+  records(maxFrames),
+  firstRecord(0),
+  frameCount(0),
+  oldestFrame(0),
+  keyframeInterval(keyframeInterval),
+  sinceKeyframe(0),
+  stateBytes(0),
+  storedBytes(0),
+  pushCount(0),
+  pushTime(0.0) {
+  if(maxFrames == 0 || keyframeInterval == 0) {
+    throw Exception::StructureException("A rewind buffer needs room for a frame,"
+        " and a keyframe interval of at least one frame.");
+  }
+}
+
+std::uint64_t RewindBuffer::push(const std::vector<byte>& state) {
+  auto start = std::chrono::steady_clock::now();
+  std::size_t size = state.size();
+  if(size > ring.size()) {
+    throw Exception::StructureException("A state of " + std::to_string(size)
+        + " bytes does not fit in a rewind buffer of " + std::to_string(ring.size()) + ".");
+  }
+  if(frameCount == records.size()) {
+    evictOldest();
+  }
+  bool keyframe = frameCount == 0 || sinceKeyframe >= keyframeInterval;
+  std::size_t recordSize = size;
+  if(!keyframe) {
+    // The scratch buffer only grows, so this only allocates on the first
+    // delta.
+    scratch.resize(std::max(scratch.size(), getMaxDeltaSize(size)));
+    recordSize = encodeDelta(state.data(), size, scratch.data());
+    keyframe = recordSize >= size;
+  }
+  std::size_t offset = allocate(keyframe ? size : recordSize);
+  if(!keyframe && frameCount == 0) {
+    // Making room evicted the keyframe the delta is against, and with it
+    // every other frame, so start again from a keyframe.
+    keyframe = true;
+    offset = allocate(size);
+  }
+  if(keyframe) {
+    recordSize = size;
+    std::copy(state.begin(), state.end(), ring.begin() + offset);
+    reference.assign(state.begin(), state.end());
+    sinceKeyframe = 1;
+  } else {
+    std::copy(scratch.begin(), scratch.begin() + recordSize, ring.begin() + offset);
+    sinceKeyframe++;
+  }
+  records[(firstRecord + frameCount) % records.size()] = {offset, recordSize, size, keyframe};
+  frameCount++;
+  writeOffset = offset + recordSize;
+  stateBytes += size;
+  storedBytes += recordSize;
+
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  pushTime += elapsed.count();
+  pushCount++;
+  return getNewestFrame();
+}
+
+void RewindBuffer::load(std::uint64_t frame, std::vector<byte>& state) const {
+  if(!hasFrame(frame)) {
+    throw Exception::KeyErrorException("Frame " + std::to_string(frame)
+        + " is not held in the rewind buffer.");
+  }
+  const Record& record = getRecord(frame);
+  std::uint64_t keyframe = frame;
+  while(!getRecord(keyframe).keyframe) {
+    keyframe--;
+  }
+  const Record& base = getRecord(keyframe);
+  state.assign(ring.begin() + base.offset, ring.begin() + base.offset + base.size);
+  if(!record.keyframe) {
+    state.resize(record.stateSize, 0);
+    decodeDelta(ring.data() + record.offset, record.size, state.data());
+  }
+}
+
+void RewindBuffer::discardAfter(std::uint64_t frame) {
+  if(!hasFrame(frame)) {
+    throw Exception::KeyErrorException("Frame " + std::to_string(frame)
+        + " is not held in the rewind buffer.");
+  }
+  while(getNewestFrame() > frame) {
+    const Record& record = getRecord(getNewestFrame());
+    stateBytes -= record.stateSize;
+    storedBytes -= record.size;
+    frameCount--;
+  }
+  const Record& record = getRecord(frame);
+  writeOffset = record.offset + record.size;
+  setReference(frame);
+}
+
+void RewindBuffer::clear() {
+  oldestFrame += frameCount;
+  frameCount = 0;
+  firstRecord = 0;
+  writeOffset = 0;
+  sinceKeyframe = 0;
+  stateBytes = 0;
+  storedBytes = 0;
+}
+
+std::size_t RewindBuffer::allocate(std::size_t size) {
+  std::size_t offset = writeOffset;
+  if(offset + size > ring.size()) {
+    // Records do not wrap around the end of the ring, so skip the end. Any
+    // records still there are the oldest.
+    while(frameCount > 0 && records[firstRecord].offset >= offset) {
+      evictOldest();
+    }
+    offset = 0;
+  }
+  // Records are in frame order around the ring, so the oldest is the first
+  // in the way.
+  while(frameCount > 0 && records[firstRecord].offset >= offset
+      && records[firstRecord].offset < offset + size) {
+    evictOldest();
+  }
+  return offset;
+}
+
+void RewindBuffer::evictOldest() {
+  // The deltas against a keyframe go with it.
+  do {
+    const Record& record = records[firstRecord];
+    stateBytes -= record.stateSize;
+    storedBytes -= record.size;
+    firstRecord = (firstRecord + 1) % records.size();
+    frameCount--;
+    oldestFrame++;
+  } while(frameCount > 0 && !records[firstRecord].keyframe);
+}
+
+void RewindBuffer::setReference(std::uint64_t frame) {
+  std::uint64_t keyframe = frame;
+  while(!getRecord(keyframe).keyframe) {
+    keyframe--;
+  }
+  const Record& record = getRecord(keyframe);
+  reference.assign(ring.begin() + record.offset, ring.begin() + record.offset + record.size);
+  sinceKeyframe = frame - keyframe + 1;
+}
+
+std::size_t RewindBuffer::encodeDelta(const byte* state, std::size_t size, byte* delta) const {
+  // The reference is taken to be padded with zeros to the size of the state.
+  const byte* base = reference.data();
+  std::size_t common = std::min(size, reference.size());
+  auto diff = [=](std::size_t i) -> byte {
+    return i < common ? state[i] ^ base[i] : state[i];
+  };
+  // The delta is a list of runs: the number of bytes that are unchanged,
+  // then the number of bytes that changed, and the XOR of those bytes.
+  byte* out = delta;
+  std::size_t pos = 0;
+  while(pos < size) {
+    std::size_t skipStart = pos;
+    for(;;) {
+      // Most of a state is unchanged, so skip it a word at a time.
+      while(pos + sizeof(std::uint64_t) <= common
+          && loadWord(state + pos) == loadWord(base + pos)) {
+        pos += sizeof(std::uint64_t);
+      }
+      if(pos < size && diff(pos) == 0) {
+        pos++;
+      } else {
+        break;
+      }
+    }
+    if(pos == size) {
+      // Unchanged bytes at the end need no run.
+      break;
+    }
+    // A lone unchanged byte costs less to carry in the run than to skip, so
+    // only two unchanged bytes in a row end the run.
+    std::size_t changedStart = pos;
+    while(pos < size && (diff(pos) != 0 || (pos + 1 < size && diff(pos + 1) != 0))) {
+      pos++;
+    }
+    out = putVarint(out, changedStart - skipStart);
+    out = putVarint(out, pos - changedStart);
+    for(std::size_t i = changedStart; i < pos; i++) {
+      *out++ = diff(i);
+    }
+  }
+  return static_cast<std::size_t>(out - delta);
+}
+
+void RewindBuffer::decodeDelta(const byte* delta, std::size_t size, byte* state) {
+  const byte* in = delta;
+  const byte* end = delta + size;
+  std::size_t pos = 0;
+  while(in < end) {
+    pos += getVarint(in);
+    std::size_t count = getVarint(in);
+    for(std::size_t i = 0; i < count; i++) {
+      state[pos + i] ^= in[i];
+    }
+    in += count;
+    pos += count;
+  }
+}
+
+std::size_t RewindBuffer::getMaxDeltaSize(std::size_t size) {
+  // Every run after the first skips at least two bytes, which pays for its
+  // counts, except for a byte of count for every 128 changed bytes.
+  return size + size / 128 + 2 * sizeof(std::size_t) + 2;
+}
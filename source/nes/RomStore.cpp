@@ -0,0 +1,110 @@
+//===-- source/nes/RomStore.cpp - Shared ROM Store --------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the RomStore class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+
+#include "common/CommonTypes.h"
+#include "nes/RomStore.h"
+#include "nes/TileCache.h"
+
+using namespace Nes;
+
+constexpr const std::uint64_t RomStore::HASH_SEED;
+
+/// Alignment of images, one page, as they are only ever read.
+static const std::size_t IMAGE_ALIGNMENT = 4096;
+
+RomStore& RomStore::getInstance() {
+  static RomStore store;
+  return store;
+}
+
+std::shared_ptr<const Memory::Arena<byte>> RomStore::intern(const byte* data,
+    std::size_t size) {
+  std::uint64_t key = hash(data, size);
+  std::lock_guard<std::mutex> lock(mutex);
+  auto matches = images.equal_range(key);
+  for(auto match = matches.first; match != matches.second; ++match) {
+    std::shared_ptr<const Memory::Arena<byte>> image = match->second.image.lock();
+    if(image != nullptr && image->getCapacity() == size
+        && std::equal(data, data + size, image->at(0))) {
+      return image;
+    }
+  }
+  // Cartridges are built rarely, so this is a good time to sweep out the
+  // images of Cartridges since destroyed.
+  prune();
+  std::shared_ptr<Memory::Arena<byte>> image =
+      std::make_shared<Memory::Arena<byte>>(size, IMAGE_ALIGNMENT);
+  std::copy(data, data + size, image->at(image->allocate(size)));
+  images.emplace(key, Entry{image, {}});
+  return image;
+}
+
+std::shared_ptr<const Memory::Arena<byte>> RomStore::getTiles(const byte* data,
+    std::size_t size) {
+  std::lock_guard<std::mutex> lock(mutex);
+  for(auto& entry : images) {
+    std::shared_ptr<const Memory::Arena<byte>> image = entry.second.image.lock();
+    if(image == nullptr || image->at(0) != data || image->getCapacity() != size) {
+      continue;
+    }
+    std::shared_ptr<const Memory::Arena<byte>> tiles = entry.second.tiles.lock();
+    if(tiles == nullptr) {
+      // Decoded with the lock held, so that instances built at once on
+      // several threads still decode the game only once.
+      std::size_t pixels = size / TileCache::TILE_SIZE * TileCache::PIXELS_PER_TILE;
+      std::shared_ptr<Memory::Arena<byte>> decoded =
+          std::make_shared<Memory::Arena<byte>>(pixels, IMAGE_ALIGNMENT);
+      TileCache::decode(data, size, decoded->at(decoded->allocate(pixels)));
+      entry.second.tiles = decoded;
+      tiles = decoded;
+    }
+    return tiles;
+  }
+  return nullptr;
+}
+
+std::size_t RomStore::getImageCount() {
+  std::lock_guard<std::mutex> lock(mutex);
+  prune();
+  return images.size();
+}
+
+std::size_t RomStore::getImageBytes() {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::size_t bytes = 0;
+  for(const auto& entry : images) {
+    std::shared_ptr<const Memory::Arena<byte>> image = entry.second.image.lock();
+    if(image != nullptr) {
+      bytes += image->getCapacity();
+    }
+  }
+  return bytes;
+}
+
+std::uint64_t RomStore::hash(const byte* data, std::size_t size, std::uint64_t hash) {
+  for(std::size_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * 0x100000001B3ull;
+  }
+  return hash;
+}
+
+void RomStore::prune() {
+  for(auto entry = images.begin(); entry != images.end();) {
+    if(entry->second.image.expired()) {
+      entry = images.erase(entry);
+    } else {
+      ++entry;
+    }
+  }
+}
@@ -0,0 +1,55 @@
+//===-- source/nes/RunAhead.cpp - Run-Ahead Frame Scheduler -----*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the RunAhead class.
+///
+//===----------------------------------------------------------------------===//
+#include <chrono>
+
+#include "common/CommonTypes.h"
+#include "nes/RunAhead.h"
+
+using namespace Nes;
+
+RunAhead::RunAhead(Console& console, std::size_t frames) :
+  console(console),
+  frames(frames),
+  frameCount(0),
+  frameTime(0.0),
+  runAheadTime(0.0) {}
+
+void RunAhead::runFrame() {
+  Ppu& ppu = console.getPpu();
+  Apu& apu = console.getApu();
+  bool drawing = !ppu.isHeadless();
+  bool sounding = !apu.isHeadless();
+  auto start = std::chrono::steady_clock::now();
+  // Frames always end in vblank, where switching headless mode only changes
+  // whether the next frame is drawn.
+  if(frames > 0) {
+    ppu.setHeadless(true);
+  }
+  console.runFrame();
+  auto realEnd = std::chrono::steady_clock::now();
+  if(frames > 0) {
+    console.saveState(state);
+    apu.setHeadless(true);
+    for(std::size_t frame = 1; frame < frames; frame++) {
+      console.runFrame();
+    }
+    ppu.setHeadless(!drawing);
+    console.runFrame();
+    apu.setHeadless(!sounding);
+    console.loadState(state);
+  }
+  auto end = std::chrono::steady_clock::now();
+  frameTime += std::chrono::duration<double, std::micro>(realEnd - start).count();
+  runAheadTime += std::chrono::duration<double, std::micro>(end - realEnd).count();
+  frameCount++;
+}
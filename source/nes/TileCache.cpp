@@ -0,0 +1,105 @@
+//===-- source/nes/TileCache.cpp - Decoded CHR Tile Cache -------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the TileCache class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstring>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "common/CommonTypes.h"
+#include "nes/RomStore.h"
+#include "nes/TileCache.h"
+
+using namespace Nes;
+
+constexpr const std::size_t TileCache::BANK_SIZE;
+constexpr const std::size_t TileCache::TILE_SIZE;
+constexpr const std::size_t TileCache::TILES_PER_BANK;
+constexpr const std::size_t TileCache::PIXELS_PER_TILE;
+
+/// Interleave the two bitplanes of a tile row into 8 pixels, leftmost (bit 7)
+/// first.
+static inline void decodeRow(byte low, byte high, byte* row) {
+#if defined(__BMI2__)
+  // Deposit bit n of each plane into byte n, then reverse the bytes so that
+  // bit 7 lands in the leftmost pixel.
+  std::uint64_t spread = _pdep_u64(low, 0x0101010101010101ull)
+      | _pdep_u64(high, 0x0202020202020202ull);
+  spread = __builtin_bswap64(spread);
+  std::memcpy(row, &spread, sizeof(spread));
+#else
+  for(int column = 0; column < 8; column++) {
+    int bit = 7 - column;
+    row[column] = ((low >> bit) & 0x01) | (((high >> bit) & 0x01) << 1);
+  }
+#endif
+}
+
+TileCache::TileCache(const Memory::Bank<byte>& chrMemory, std::size_t chrSize,
+    bool chrWritable) :
+  chrMemory(chrMemory),
+  chrSize(chrSize),
+  sharedTiles(chrWritable ? nullptr
+      : RomStore::getInstance().getTiles(chrMemory.getStorage(), chrSize)),
+  privateBanks(sharedTiles != nullptr ? 0 : (chrSize + BANK_SIZE - 1) / BANK_SIZE),
+  banks((chrSize + BANK_SIZE - 1) / BANK_SIZE, nullptr),
+  dirtyTiles((chrSize / TILE_SIZE + 63) / 64,
+      sharedTiles != nullptr ? 0 : ~std::uint64_t(0)) {
+  if(sharedTiles != nullptr) {
+    for(std::size_t bank = 0; bank < banks.size(); bank++) {
+      banks[bank] = sharedTiles->at(bank * TILES_PER_BANK * PIXELS_PER_TILE);
+    }
+  }
+}
+
+bool TileCache::isBankDecoded(std::size_t bank) const {
+  return banks[bank] != nullptr;
+}
+
+bool TileCache::isShared() const {
+  return sharedTiles != nullptr;
+}
+
+void TileCache::decode(const byte* chr, std::size_t size, byte* pixels) {
+  for(std::size_t offset = 0; offset + TILE_SIZE <= size; offset += TILE_SIZE) {
+    for(std::size_t y = 0; y < 8; y++, pixels += 8) {
+      decodeRow(chr[offset + y], chr[offset + y + 8], pixels);
+    }
+  }
+}
+
+void TileCache::refresh(std::size_t tile) {
+  std::size_t bank = tile / TILES_PER_BANK;
+  if(banks[bank] != nullptr) {
+    decodeTile(tile);
+    return;
+  }
+  std::size_t first = bank * TILES_PER_BANK;
+  std::size_t last = std::min(first + TILES_PER_BANK, chrSize / TILE_SIZE);
+  privateBanks[bank] = Memory::Arena<byte>((last - first) * PIXELS_PER_TILE);
+  privateBanks[bank].allocate(privateBanks[bank].getCapacity());
+  banks[bank] = privateBanks[bank].at(0);
+  for(std::size_t bankTile = first; bankTile < last; bankTile++) {
+    decodeTile(bankTile);
+  }
+}
+
+void TileCache::decodeTile(std::size_t tile) {
+  std::size_t offset = tile * TILE_SIZE;
+  byte* row = privateBanks[tile / TILES_PER_BANK].at((tile % TILES_PER_BANK) * PIXELS_PER_TILE);
+  for(std::size_t y = 0; y < 8; y++, row += 8) {
+    decodeRow(chrMemory.read(offset + y), chrMemory.read(offset + y + 8), row);
+  }
+  dirtyTiles[tile / 64] &= ~(std::uint64_t(1) << (tile % 64));
+}
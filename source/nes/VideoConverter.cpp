@@ -0,0 +1,299 @@
+//===-- source/nes/VideoConverter.cpp - Video Output Conversion -*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the VideoConverter class.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "common/CommonTypes.h"
+#include "nes/VideoConverter.h"
+
+using namespace Nes;
+
+constexpr const std::size_t VideoConverter::PALETTE_SIZE;
+constexpr const std::size_t VideoConverter::NUM_EMPHASES;
+
+/// The colours of the 2C02 palette, as 0xRRGGBB.
+static const std::array<std::uint32_t, VideoConverter::PALETTE_SIZE> PALETTE_2C02 = {{
+  0x666666, 0x002A88, 0x1412A7, 0x3B00A4, 0x5C007E, 0x6E0040, 0x6C0600, 0x561D00,
+  0x333500, 0x0B4800, 0x005200, 0x004F08, 0x00404D, 0x000000, 0x000000, 0x000000,
+  0xADADAD, 0x155FD9, 0x4240FF, 0x7527FE, 0xA01ACC, 0xB71E7B, 0xB53120, 0x994E00,
+  0x6B6D00, 0x388700, 0x0C9300, 0x008F32, 0x007C8D, 0x000000, 0x000000, 0x000000,
+  0xFFFEFF, 0x64B0FF, 0x9290FF, 0xC676FF, 0xF36AFF, 0xFE6ECC, 0xFE8170, 0xEA9E22,
+  0xBCBE00, 0x88D800, 0x5CE430, 0x45E082, 0x48CDDE, 0x4F4F4F, 0x000000, 0x000000,
+  0xFFFEFF, 0xC0DFFF, 0xD3D2FF, 0xE8C8FF, 0xFBC2FF, 0xFEC4EA, 0xFECCC5, 0xF7D8A5,
+  0xE4E594, 0xCFEF96, 0xBDF4AB, 0xB3F3CC, 0xB5EBF2, 0xB8B8B8, 0x000000, 0x000000
+}};
+
+/// Attenuation of a channel by each emphasis bit of another channel, in
+/// 1/1000ths.
+static const int EMPHASIS_ATTENUATION = 816;
+
+/// Average two bytes, rounding up, as pavgb does.
+static inline byte average(byte a, byte b) {
+  return static_cast<byte>((a + b + 1) >> 1);
+}
+
+#if defined(__SSSE3__)
+/// Look up 16 palette indices in a 64 entry table. Each quarter of the table
+/// is one pshufb on the low nibble of the indices, kept where the high bits
+/// of the index select that quarter.
+static inline __m128i lookup(const byte* table, __m128i indices) {
+  __m128i low = _mm_and_si128(indices, _mm_set1_epi8(0x0F));
+  __m128i high = _mm_and_si128(indices, _mm_set1_epi8(0x30));
+  __m128i result = _mm_setzero_si128();
+  for(int quarter = 0; quarter < 4; quarter++) {
+    __m128i entries = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + quarter * 16));
+    __m128i selected = _mm_cmpeq_epi8(high, _mm_set1_epi8(static_cast<char>(quarter << 4)));
+    result = _mm_or_si128(result, _mm_and_si128(_mm_shuffle_epi8(entries, low), selected));
+  }
+  return result;
+}
+#endif
+
+#if defined(__AVX2__)
+/// Look up 32 palette indices in a 64 entry table, as lookup does for 16.
+static inline __m256i lookup32(const byte* table, __m256i indices) {
+  __m256i low = _mm256_and_si256(indices, _mm256_set1_epi8(0x0F));
+  __m256i high = _mm256_and_si256(indices, _mm256_set1_epi8(0x30));
+  __m256i result = _mm256_setzero_si256();
+  for(int quarter = 0; quarter < 4; quarter++) {
+    // pshufb only shuffles within 128 bit lanes, so both lanes get the table.
+    __m256i entries = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + quarter * 16)));
+    __m256i selected = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(static_cast<char>(quarter << 4)));
+    result = _mm256_or_si256(result, _mm256_and_si256(_mm256_shuffle_epi8(entries, low), selected));
+  }
+  return result;
+}
+#endif
+
+VideoConverter::VideoConverter() :
+  VideoConverter(PALETTE_2C02) {}
+
+VideoConverter::VideoConverter(const std::array<std::uint32_t, PALETTE_SIZE>& palette) {
+  for(std::size_t emphasis = 0; emphasis < NUM_EMPHASES; emphasis++) {
+    for(std::size_t index = 0; index < PALETTE_SIZE; index++) {
+      int rgb[3];
+      for(int channel = RED; channel <= BLUE; channel++) {
+        int value = (palette[index] >> (16 - 8 * channel)) & 0xFF;
+        // Emphasis bits 0 to 2 are red, green and blue, and darken the other
+        // two channels.
+        for(int bit = 0; bit < 3; bit++) {
+          if(bit != channel && (emphasis & (1 << bit))) {
+            value = (value * EMPHASIS_ATTENUATION + 500) / 1000;
+          }
+        }
+        rgb[channel] = value;
+        tables[emphasis][channel][index] = static_cast<byte>(value);
+      }
+      int r = rgb[RED];
+      int g = rgb[GREEN];
+      int b = rgb[BLUE];
+      tables[emphasis][LUMA][index] =
+          static_cast<byte>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+      tables[emphasis][BLUE_CHROMA][index] =
+          static_cast<byte>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      tables[emphasis][RED_CHROMA][index] =
+          static_cast<byte>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+      tables[emphasis][GRAY][index] =
+          static_cast<byte>((77 * r + 150 * g + 29 * b + 128) >> 8);
+    }
+  }
+}
+
+std::uint32_t VideoConverter::getRgb(byte index, byte emphasis) const {
+  index &= PALETTE_SIZE - 1;
+  return (getTable(emphasis, RED)[index] << 16)
+      | (getTable(emphasis, GREEN)[index] << 8)
+      | getTable(emphasis, BLUE)[index];
+}
+
+std::array<byte, 3> VideoConverter::getYuv(byte index, byte emphasis) const {
+  index &= PALETTE_SIZE - 1;
+  return {{getTable(emphasis, LUMA)[index], getTable(emphasis, BLUE_CHROMA)[index],
+      getTable(emphasis, RED_CHROMA)[index]}};
+}
+
+byte VideoConverter::getGray(byte index, byte emphasis) const {
+  return getTable(emphasis, GRAY)[index & (PALETTE_SIZE - 1)];
+}
+
+void VideoConverter::toRgba(const byte* indices, std::size_t count, byte emphasis,
+    byte* rgba) const {
+  const byte* red = getTable(emphasis, RED);
+  const byte* green = getTable(emphasis, GREEN);
+  const byte* blue = getTable(emphasis, BLUE);
+  std::size_t pixel = 0;
+#if defined(__AVX2__)
+  for(; pixel + 32 <= count; pixel += 32) {
+    __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + pixel));
+    __m256i r = lookup32(red, index);
+    __m256i g = lookup32(green, index);
+    __m256i b = lookup32(blue, index);
+    __m256i a = _mm256_set1_epi8(static_cast<char>(0xFF));
+    // Interleave within each lane, which leaves the pixels of the low lane in
+    // the low halves and those of the high lane in the high halves.
+    __m256i rgLow = _mm256_unpacklo_epi8(r, g);
+    __m256i rgHigh = _mm256_unpackhi_epi8(r, g);
+    __m256i baLow = _mm256_unpacklo_epi8(b, a);
+    __m256i baHigh = _mm256_unpackhi_epi8(b, a);
+    __m256i quad0 = _mm256_unpacklo_epi16(rgLow, baLow);
+    __m256i quad1 = _mm256_unpackhi_epi16(rgLow, baLow);
+    __m256i quad2 = _mm256_unpacklo_epi16(rgHigh, baHigh);
+    __m256i quad3 = _mm256_unpackhi_epi16(rgHigh, baHigh);
+    __m256i* out = reinterpret_cast<__m256i*>(rgba + pixel * 4);
+    _mm256_storeu_si256(out, _mm256_permute2x128_si256(quad0, quad1, 0x20));
+    _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(quad2, quad3, 0x20));
+    _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(quad0, quad1, 0x31));
+    _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(quad2, quad3, 0x31));
+  }
+#endif
+#if defined(__SSSE3__)
+  for(; pixel + 16 <= count; pixel += 16) {
+    __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + pixel));
+    __m128i r = lookup(red, index);
+    __m128i g = lookup(green, index);
+    __m128i b = lookup(blue, index);
+    __m128i a = _mm_set1_epi8(static_cast<char>(0xFF));
+    __m128i rgLow = _mm_unpacklo_epi8(r, g);
+    __m128i rgHigh = _mm_unpackhi_epi8(r, g);
+    __m128i baLow = _mm_unpacklo_epi8(b, a);
+    __m128i baHigh = _mm_unpackhi_epi8(b, a);
+    __m128i* out = reinterpret_cast<__m128i*>(rgba + pixel * 4);
+    _mm_storeu_si128(out, _mm_unpacklo_epi16(rgLow, baLow));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rgLow, baLow));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rgHigh, baHigh));
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rgHigh, baHigh));
+  }
+#endif
+  for(; pixel < count; pixel++) {
+    byte index = indices[pixel] & (PALETTE_SIZE - 1);
+    byte* out = rgba + pixel * 4;
+    out[0] = red[index];
+    out[1] = green[index];
+    out[2] = blue[index];
+    out[3] = 0xFF;
+  }
+}
+
+void VideoConverter::toYuv420(const byte* indices, std::size_t width,
+    std::size_t height, byte emphasis, byte* yPlane, byte* uPlane, byte* vPlane) const {
+  const byte* luma = getTable(emphasis, LUMA);
+  const byte* blueChroma = getTable(emphasis, BLUE_CHROMA);
+  const byte* redChroma = getTable(emphasis, RED_CHROMA);
+  for(std::size_t y = 0; y < height; y += 2) {
+    const byte* row0 = indices + y * width;
+    const byte* row1 = row0 + width;
+    byte* u = uPlane + (y / 2) * (width / 2);
+    byte* v = vPlane + (y / 2) * (width / 2);
+    std::size_t x = 0;
+#if defined(__SSSE3__)
+    // 16 pixels of each row make 8 chroma samples. The rows are averaged
+    // byte by byte, then the columns as the halves of 16 bit words.
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    for(; x + 16 <= width; x += 16) {
+      __m128i index0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x));
+      __m128i index1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(yPlane + y * width + x),
+          lookup(luma, index0));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(yPlane + (y + 1) * width + x),
+          lookup(luma, index1));
+      __m128i rowsU = _mm_avg_epu8(lookup(blueChroma, index0), lookup(blueChroma, index1));
+      __m128i rowsV = _mm_avg_epu8(lookup(redChroma, index0), lookup(redChroma, index1));
+      __m128i sampleU = _mm_avg_epu16(_mm_and_si128(rowsU, lowBytes), _mm_srli_epi16(rowsU, 8));
+      __m128i sampleV = _mm_avg_epu16(_mm_and_si128(rowsV, lowBytes), _mm_srli_epi16(rowsV, 8));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(u + x / 2), _mm_packus_epi16(sampleU, sampleU));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(v + x / 2), _mm_packus_epi16(sampleV, sampleV));
+    }
+#endif
+    for(; x < width; x += 2) {
+      byte index00 = row0[x] & (PALETTE_SIZE - 1);
+      byte index01 = row0[x + 1] & (PALETTE_SIZE - 1);
+      byte index10 = row1[x] & (PALETTE_SIZE - 1);
+      byte index11 = row1[x + 1] & (PALETTE_SIZE - 1);
+      yPlane[y * width + x] = luma[index00];
+      yPlane[y * width + x + 1] = luma[index01];
+      yPlane[(y + 1) * width + x] = luma[index10];
+      yPlane[(y + 1) * width + x + 1] = luma[index11];
+      u[x / 2] = average(average(blueChroma[index00], blueChroma[index10]),
+          average(blueChroma[index01], blueChroma[index11]));
+      v[x / 2] = average(average(redChroma[index00], redChroma[index10]),
+          average(redChroma[index01], redChroma[index11]));
+    }
+  }
+}
+
+void VideoConverter::toGray(const byte* indices, std::size_t count, byte emphasis,
+    byte* gray) const {
+  const byte* table = getTable(emphasis, GRAY);
+  std::size_t pixel = 0;
+#if defined(__AVX2__)
+  for(; pixel + 32 <= count; pixel += 32) {
+    __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + pixel));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(gray + pixel), lookup32(table, index));
+  }
+#endif
+#if defined(__SSSE3__)
+  for(; pixel + 16 <= count; pixel += 16) {
+    __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + pixel));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(gray + pixel), lookup(table, index));
+  }
+#endif
+  for(; pixel < count; pixel++) {
+    gray[pixel] = table[indices[pixel] & (PALETTE_SIZE - 1)];
+  }
+}
+
+void VideoConverter::scale(const byte* source, std::size_t width,
+    std::size_t height, std::size_t factor, byte* destination) {
+  std::size_t scaledWidth = width * factor;
+  for(std::size_t y = 0; y < height; y++) {
+    const byte* in = source + y * width;
+    byte* out = destination + y * factor * scaledWidth;
+    std::size_t x = 0;
+#if defined(__SSE2__)
+    if(factor == 2) {
+      for(; x + 16 <= width; x += 16) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+        __m128i* scaled = reinterpret_cast<__m128i*>(out + x * 2);
+        _mm_storeu_si128(scaled, _mm_unpacklo_epi8(pixels, pixels));
+        _mm_storeu_si128(scaled + 1, _mm_unpackhi_epi8(pixels, pixels));
+      }
+    }
+#endif
+#if defined(__SSSE3__)
+    if(factor == 3) {
+      const __m128i spread0 = _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5);
+      const __m128i spread1 = _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+      const __m128i spread2 = _mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13, 13, 13, 14, 14, 14, 15, 15, 15);
+      for(; x + 16 <= width; x += 16) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+        __m128i* scaled = reinterpret_cast<__m128i*>(out + x * 3);
+        _mm_storeu_si128(scaled, _mm_shuffle_epi8(pixels, spread0));
+        _mm_storeu_si128(scaled + 1, _mm_shuffle_epi8(pixels, spread1));
+        _mm_storeu_si128(scaled + 2, _mm_shuffle_epi8(pixels, spread2));
+      }
+    }
+#endif
+    for(; x < width; x++) {
+      std::fill(out + x * factor, out + (x + 1) * factor, in[x]);
+    }
+    // The other rows of the scaled row are copies of the first.
+    for(std::size_t copy = 1; copy < factor; copy++) {
+      std::memcpy(out + copy * scaledWidth, out, scaledWidth);
+    }
+  }
+}
@@ -0,0 +1,40 @@
+//===-- source/nes/mappers/CnRom.cpp - CnRom Mapper -------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the CnRom class.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/CommonTypes.h"
+#include "memory/Ram.h"
+#include "memory/Rom.h"
+#include "nes/CartridgeMapper.h"
+#include "nes/mappers/CnRom.h"
+
+using namespace Nes;
+using namespace Memory;
+using namespace Nes::Mappers;
+
+CnRom::CnRom(
+    std::vector<Ram<byte>>& prgRams,
+    std::vector<Rom<byte>>& prgRoms,
+    std::vector<Rom<byte>>& chrRoms,
+    std::vector<Ram<byte>>& chrRams,
+    Mirroring mirroring) :
+  CartridgeMapper(prgRams, prgRoms, chrRoms, chrRams, mirroring) {
+  // PRG ROM is mapped as on NROM, a single 16kB bank wraps into $C000.
+  configurePrgRom(PRG_WINDOW_SIZE);
+  mapPrgRom(1, 1);
+  configureChr(CHR_WINDOW_SIZE);
+}
+
+void CnRom::writeRegister(Vaddr vaddr, byte data) {
+  // Every register write selects the CHR ROM bank.
+  mapChr(0, data);
+}
@@ -0,0 +1,135 @@
+//===-- source/nes/mappers/Mmc1.cpp - MMC1 Mapper ---------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the Mmc1 class.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/CommonTypes.h"
+#include "memory/Ram.h"
+#include "memory/Rom.h"
+#include "nes/CartridgeMapper.h"
+#include "nes/mappers/Mmc1.h"
+
+using namespace Nes;
+using namespace Memory;
+using namespace Nes::Mappers;
+
+Mmc1::Mmc1(
+    std::vector<Ram<byte>>& prgRams,
+    std::vector<Rom<byte>>& prgRoms,
+    std::vector<Rom<byte>>& chrRoms,
+    std::vector<Ram<byte>>& chrRams,
+    Mirroring mirroring) :
+  CartridgeMapper(prgRams, prgRoms, chrRoms, chrRams, mirroring),
+  shift(SHIFT_RESET),
+  control(CONTROL_RESET),
+  chrBank0(0),
+  chrBank1(0),
+  prgBank(0) {
+  configurePrgRom(PRG_WINDOW_SIZE);
+  configureChr(CHR_WINDOW_SIZE);
+  updateBanks();
+}
+
+void Mmc1::writeRegister(Vaddr vaddr, byte data) {
+  // Writing bit 7 clears the shift register and fixes the last PRG ROM bank.
+  if(data & 0x80) {
+    shift = SHIFT_RESET;
+    control |= CONTROL_RESET;
+    updateBanks();
+    return;
+  }
+
+  // Shift the bit in from the top. The shift register is full once the
+  // marker bit has been shifted down to bit 0.
+  bool full = shift & 0x01;
+  shift = (shift >> 1) | ((data & 0x01) << 4);
+  if(!full) {
+    return;
+  }
+
+  // Address bits 13 and 14 select the register loaded from the shift register.
+  switch((vaddr.val >> 13) & 0x03) {
+    case 0:
+      control = shift;
+      break;
+    case 1:
+      chrBank0 = shift;
+      break;
+    case 2:
+      chrBank1 = shift;
+      break;
+    default:
+      prgBank = shift;
+      break;
+  }
+  shift = SHIFT_RESET;
+  updateBanks();
+}
+
+void Mmc1::updateBanks() {
+  switch(control & 0x03) {
+    case 0:
+      setMirroring(Mirroring::SINGLE_SCREEN_LOWER);
+      break;
+    case 1:
+      setMirroring(Mirroring::SINGLE_SCREEN_UPPER);
+      break;
+    case 2:
+      setMirroring(Mirroring::VERTICAL);
+      break;
+    default:
+      setMirroring(Mirroring::HORIZONTAL);
+      break;
+  }
+
+  // PRG ROM is one 32kB bank, or 16kB banks with $8000 or $C000 fixed.
+  std::size_t bank = prgBank & 0x0F;
+  switch((control >> 2) & 0x03) {
+    case 0:
+    case 1:
+      mapPrgRom(0, bank & 0x0E);
+      mapPrgRom(1, bank | 0x01);
+      break;
+    case 2:
+      mapPrgRom(0, 0);
+      mapPrgRom(1, bank);
+      break;
+    default:
+      mapPrgRom(0, bank);
+      mapPrgRom(1, getPrgRomBankCount() - 1);
+      break;
+  }
+
+  // CHR is two 4kB banks, or one 8kB bank ignoring the low bit.
+  if(control & 0x10) {
+    mapChr(0, chrBank0);
+    mapChr(1, chrBank1);
+  } else {
+    mapChr(0, chrBank0 & 0x1E);
+    mapChr(1, chrBank0 | 0x01);
+  }
+}
+
+void Mmc1::saveRegisters(Structure::StateWriter& writer) const {
+  writer.write(shift);
+  writer.write(control);
+  writer.write(chrBank0);
+  writer.write(chrBank1);
+  writer.write(prgBank);
+}
+
+void Mmc1::loadRegisters(Structure::StateReader& reader) {
+  reader.read(shift);
+  reader.read(control);
+  reader.read(chrBank0);
+  reader.read(chrBank1);
+  reader.read(prgBank);
+}
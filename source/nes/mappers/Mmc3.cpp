@@ -0,0 +1,137 @@
+//===-- source/nes/mappers/Mmc3.cpp - MMC3 Mapper ---------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the Mmc3 class.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/CommonTypes.h"
+#include "memory/Ram.h"
+#include "memory/Rom.h"
+#include "nes/CartridgeMapper.h"
+#include "nes/mappers/Mmc3.h"
+
+using namespace Nes;
+using namespace Memory;
+using namespace Nes::Mappers;
+
+Mmc3::Mmc3(
+    std::vector<Ram<byte>>& prgRams,
+    std::vector<Rom<byte>>& prgRoms,
+    std::vector<Rom<byte>>& chrRoms,
+    std::vector<Ram<byte>>& chrRams,
+    Mirroring mirroring) :
+  CartridgeMapper(prgRams, prgRoms, chrRoms, chrRams, mirroring),
+  bankSelect(0),
+  bankRegisters({0, 2, 4, 5, 6, 7, 0, 1}),
+  irqLatch(0),
+  irqCounter(0),
+  irqReload(false),
+  irqEnabled(false),
+  irqAsserted(false) {
+  configurePrgRom(PRG_WINDOW_SIZE);
+  configureChr(CHR_WINDOW_SIZE);
+  updateBanks();
+}
+
+void Mmc3::writeRegister(Vaddr vaddr, byte data) {
+  // Registers are selected by the 8kB region and whether the address is even.
+  bool even = (vaddr.val & 0x01) == 0;
+  switch(vaddr.val & 0xE000) {
+    case 0x8000:
+      if(even) {
+        bankSelect = data;
+      } else {
+        bankRegisters[bankSelect & 0x07] = data;
+      }
+      updateBanks();
+      break;
+    case 0xA000:
+      // Odd addresses protect PRG RAM, which is not emulated.
+      if(even && getMirroring() != Mirroring::FOUR_SCREEN) {
+        setMirroring((data & 0x01) ? Mirroring::HORIZONTAL : Mirroring::VERTICAL);
+      }
+      break;
+    case 0xC000:
+      if(even) {
+        irqLatch = data;
+      } else {
+        irqCounter = 0;
+        irqReload = true;
+      }
+      break;
+    default:
+      if(even) {
+        irqEnabled = false;
+        irqAsserted = false;
+      } else {
+        irqEnabled = true;
+      }
+      break;
+  }
+}
+
+void Mmc3::clockScanline() {
+  if(irqCounter == 0 || irqReload) {
+    irqCounter = irqLatch;
+    irqReload = false;
+  } else {
+    irqCounter--;
+  }
+  if(irqCounter == 0 && irqEnabled) {
+    irqAsserted = true;
+  }
+}
+
+void Mmc3::updateBanks() {
+  // R0 and R1 select 2kB banks ignoring the low bit, R2-R5 select 1kB banks.
+  // CHR inversion swaps the 2kB and 1kB halves of CHR space.
+  std::size_t inversion = (bankSelect & 0x80) ? 4 : 0;
+  mapChr(0 ^ inversion, bankRegisters[0] & 0xFE);
+  mapChr(1 ^ inversion, bankRegisters[0] | 0x01);
+  mapChr(2 ^ inversion, bankRegisters[1] & 0xFE);
+  mapChr(3 ^ inversion, bankRegisters[1] | 0x01);
+  mapChr(4 ^ inversion, bankRegisters[2]);
+  mapChr(5 ^ inversion, bankRegisters[3]);
+  mapChr(6 ^ inversion, bankRegisters[4]);
+  mapChr(7 ^ inversion, bankRegisters[5]);
+
+  // R6 is switched at $8000 or $C000, with the second last bank in the other.
+  // R7 is always at $A000 and the last bank always at $E000.
+  std::size_t lastBank = getPrgRomBankCount() - 1;
+  if(bankSelect & 0x40) {
+    mapPrgRom(0, lastBank - 1);
+    mapPrgRom(2, bankRegisters[6]);
+  } else {
+    mapPrgRom(0, bankRegisters[6]);
+    mapPrgRom(2, lastBank - 1);
+  }
+  mapPrgRom(1, bankRegisters[7]);
+  mapPrgRom(3, lastBank);
+}
+
+void Mmc3::saveRegisters(Structure::StateWriter& writer) const {
+  writer.write(bankSelect);
+  writer.write(bankRegisters);
+  writer.write(irqLatch);
+  writer.write(irqCounter);
+  writer.write(irqReload);
+  writer.write(irqEnabled);
+  writer.write(irqAsserted);
+}
+
+void Mmc3::loadRegisters(Structure::StateReader& reader) {
+  reader.read(bankSelect);
+  reader.read(bankRegisters);
+  reader.read(irqLatch);
+  reader.read(irqCounter);
+  reader.read(irqReload);
+  reader.read(irqEnabled);
+  reader.read(irqAsserted);
+}
@@ -7,7 +7,7 @@
 //===----------------------------------------------------------------------===//
 ///
 /// \file
-/// This file contains the implementation of the CartridgeMapper class.
+/// This file contains the implementation of the NRom class.
 ///
 //===----------------------------------------------------------------------===//
 
@@ -22,29 +22,16 @@ using namespace Memory;
 using namespace Nes::Mappers;
 
 NRom::NRom(
-    std::vector<std::shared_ptr<Ram<byte>>>& prgRams,
-    std::vector<std::shared_ptr<Rom<byte>>>& prgRoms,
-    std::vector<std::shared_ptr<Rom<byte>>>& chrRoms) :
-  CartridgeMapper(prgRams, prgRoms, chrRoms) {
-  // Set the prgRam, lower and upper prgRoms
-  setPrgRam(0);
-  setLowerPrgRom(0);
-  setUpperPrgRom(1);
-}
-
-std::shared_ptr<Bank<byte>> NRom::mapToHardware(Vaddr vaddr) const {
-  addr address = vaddr.val;
-  if(address < 0x6000) {
-    return nullptr;
-  }
-  if(0x6000 <= address && address < 0x8000) {
-    return getPrgRam().lock();
-  }
-  if(0x8000 <= address && address < 0xC000) {
-    return getLowerPrgRom().lock();
-  }
-  if(0xC000 <= address) {
-    return getUpperPrgRom().lock();
-  }
-  return nullptr;
+    std::vector<Ram<byte>>& prgRams,
+    std::vector<Rom<byte>>& prgRoms,
+    std::vector<Rom<byte>>& chrRoms,
+    std::vector<Ram<byte>>& chrRams,
+    Mirroring mirroring) :
+  CartridgeMapper(prgRams, prgRoms, chrRoms, chrRams, mirroring) {
+  // Map the lower and upper PRG ROMs. NROM-128 cartridges only have one PRG
+  // ROM, which wraps around into the upper window.
+  configurePrgRom(PRG_WINDOW_SIZE);
+  mapPrgRom(0, 0);
+  mapPrgRom(1, 1);
+  configureChr(CHR_WINDOW_SIZE);
 }
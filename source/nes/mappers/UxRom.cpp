@@ -0,0 +1,40 @@
+//===-- source/nes/mappers/UxRom.cpp - UxRom Mapper -------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the UxRom class.
+///
+//===----------------------------------------------------------------------===//
+
+#include "common/CommonTypes.h"
+#include "memory/Ram.h"
+#include "memory/Rom.h"
+#include "nes/CartridgeMapper.h"
+#include "nes/mappers/UxRom.h"
+
+using namespace Nes;
+using namespace Memory;
+using namespace Nes::Mappers;
+
+UxRom::UxRom(
+    std::vector<Ram<byte>>& prgRams,
+    std::vector<Rom<byte>>& prgRoms,
+    std::vector<Rom<byte>>& chrRoms,
+    std::vector<Ram<byte>>& chrRams,
+    Mirroring mirroring) :
+  CartridgeMapper(prgRams, prgRoms, chrRoms, chrRams, mirroring) {
+  // The first bank starts out at $8000 and the last bank is fixed at $C000.
+  configurePrgRom(PRG_WINDOW_SIZE);
+  mapPrgRom(1, getPrgRomBankCount() - 1);
+  configureChr(CHR_WINDOW_SIZE);
+}
+
+void UxRom::writeRegister(Vaddr vaddr, byte data) {
+  // Every register write selects the bank at $8000.
+  mapPrgRom(0, data);
+}
@@ -0,0 +1,276 @@
+//===-- source/opennes/OpenNesBatch.cpp - Batched C Interface ---*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the implementation of the batched C interface.
+///
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/BaseException.h"
+#include "common/CommonTypes.h"
+#include "memory/Arena.h"
+#include "nes/BatchRunner.h"
+#include "nes/Cartridge.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Console.h"
+#include "nes/ObservationStack.h"
+#include "nes/Ppu.h"
+#include "opennes/OpenNesBatch.h"
+
+static_assert(OPENNES_FRAME_WIDTH == Nes::Ppu::WIDTH
+    && OPENNES_FRAME_HEIGHT == Nes::Ppu::HEIGHT,
+    "Frames of the C interface must match the Ppu.");
+static_assert(OPENNES_FRAME_SIZE % OPENNES_BUFFER_ALIGNMENT == 0
+    && OPENNES_RAM_SIZE % OPENNES_BUFFER_ALIGNMENT == 0,
+    "Every entry of a buffer must be aligned.");
+
+/// Description of the last failure on each thread.
+static thread_local std::string lastError;
+
+/// A batch of Consoles, and the buffers of the call in progress. The task
+/// run on each Console is built once, so that a step does not allocate.
+struct OpenNesBatch {
+  /// The Consoles and the threads running them.
+  std::unique_ptr<Nes::BatchRunner> runner;
+  /// State of a Console at power on, the same for every Console.
+  std::vector<byte> powerOnState;
+  /// The observation stack of each Console, or none if frames are observed.
+  std::vector<std::unique_ptr<Nes::ObservationStack>> stacks;
+  /// Frames the Consoles draw into, to be stacked.
+  Memory::Arena<byte> frames;
+  /// Bytes from the observation of one instance to the next.
+  std::size_t observationStride;
+  /// Runs a frame of a Console for the call in progress.
+  std::function<void(std::size_t)> frameTask;
+  /// Set if the call in progress resets the Consoles first.
+  bool resetting;
+  /// Buttons held on each Console, or null for none.
+  const uint8_t* actions;
+  /// Buffer receiving the observations, or null.
+  uint8_t* observations;
+  /// Buffer receiving the RAM, or null.
+  uint8_t* ram;
+};
+
+/// Record the failure of a call.
+/// \param status The failure.
+/// \param message Description of the failure.
+/// \returns The failure.
+static OpenNesStatus fail(OpenNesStatus status, std::string message) {
+  lastError = std::move(message);
+  return status;
+}
+
+/// Check that a buffer is aligned as the interface requires.
+/// \param buffer The buffer, or null.
+/// \returns true if the buffer is null or aligned.
+static bool isAligned(const uint8_t* buffer) {
+  return reinterpret_cast<std::uintptr_t>(buffer) % OPENNES_BUFFER_ALIGNMENT == 0;
+}
+
+/// Run a frame of every Console of a batch, with the buffers of a call.
+/// \param batch The batch.
+/// \returns OPENNES_OK, or the failure.
+static OpenNesStatus runFrames(OpenNesBatch* batch) {
+  if(!isAligned(batch->observations) || !isAligned(batch->ram)) {
+    return fail(OPENNES_ERROR_ARGUMENT, "Buffers must be aligned to "
+        + std::to_string(OPENNES_BUFFER_ALIGNMENT) + " bytes.");
+  }
+  try {
+    batch->runner->forEach(batch->frameTask);
+  } catch(const Exception::BaseException& e) {
+    return fail(OPENNES_ERROR_EMULATION, e.printClassName() + ": " + e.printErrorMessage());
+  } catch(const std::exception& e) {
+    return fail(OPENNES_ERROR_EMULATION, e.what());
+  }
+  lastError.clear();
+  return OPENNES_OK;
+}
+
+/// Run a frame of one Console of a batch, with the buffers of the call in
+/// progress.
+/// \param batch The batch.
+/// \param index Index of the Console.
+static void runFrame(OpenNesBatch* batch, std::size_t index) {
+  Nes::Console& console = batch->runner->getConsole(index);
+  if(batch->resetting) {
+    console.loadState(batch->powerOnState);
+  }
+  console.getControllers().setButtons(0,
+      batch->actions != nullptr ? batch->actions[index] : 0);
+  // The Console is between frames, so switching buffers and headless mode
+  // takes effect for the whole of the frame about to run. Frames to be
+  // stacked are drawn aside, and only their stack handed over. A reset
+  // always draws, so that no stack carries frames over from the last
+  // episode.
+  bool stacking = !batch->stacks.empty();
+  byte* frame = nullptr;
+  if(stacking && (batch->observations != nullptr || batch->resetting)) {
+    frame = batch->frames.at(index * OPENNES_FRAME_SIZE);
+  } else if(batch->observations != nullptr) {
+    frame = batch->observations + index * OPENNES_FRAME_SIZE;
+  }
+  if(frame != nullptr) {
+    console.getPpu().setFramebuffer(frame);
+    console.getPpu().setHeadless(false);
+  } else {
+    console.getPpu().setHeadless(true);
+    console.getPpu().setFramebuffer(nullptr);
+  }
+  console.runFrame();
+  if(frame != nullptr && stacking) {
+    Nes::ObservationStack& stack = *batch->stacks[index];
+    if(batch->resetting) {
+      stack.reset(frame, console.getPpu().getEmphasis());
+    } else {
+      stack.push(frame, console.getPpu().getEmphasis());
+    }
+    if(batch->observations != nullptr) {
+      stack.copyStack(batch->observations + index * batch->observationStride);
+    }
+  }
+  if(batch->ram != nullptr) {
+    const Memory::Ram<byte>& ram = console.getBus().getRam();
+    std::copy(ram.getStorage(), ram.getStorage() + ram.getSize(),
+        batch->ram + index * OPENNES_RAM_SIZE);
+  }
+}
+
+OpenNesBatch* opennes_batch_create(const char* romPath, size_t count, size_t threadCount) {
+  if(romPath == nullptr || count == 0) {
+    fail(OPENNES_ERROR_ARGUMENT, "A batch needs a ROM and at least one instance.");
+    return nullptr;
+  }
+  if(!std::ifstream(romPath, std::ios::binary).good()) {
+    fail(OPENNES_ERROR_ROM, std::string("Cannot open ") + romPath + ".");
+    return nullptr;
+  }
+  try {
+    Nes::CartridgeBuilder builder;
+    builder.setInputFile(romPath);
+    std::shared_ptr<const Nes::Cartridge> prototype(builder.build());
+    // Each Console clones the prototype, sharing its ROM images. No audio
+    // is returned, so none is made.
+    std::unique_ptr<OpenNesBatch> batch(new OpenNesBatch());
+    batch->runner.reset(new Nes::BatchRunner(count, [prototype](std::size_t index) {
+      std::unique_ptr<Nes::Console> console(new Nes::Console(prototype->clone()));
+      console->getApu().setHeadless(true);
+      return console;
+    }, threadCount));
+    batch->runner->getConsole(0).saveState(batch->powerOnState);
+    OpenNesBatch* self = batch.get();
+    batch->frameTask = [self](std::size_t index) {
+      runFrame(self, index);
+    };
+    batch->observationStride = OPENNES_FRAME_SIZE;
+    batch->resetting = false;
+    batch->actions = nullptr;
+    batch->observations = nullptr;
+    batch->ram = nullptr;
+    lastError.clear();
+    return batch.release();
+  } catch(const Exception::BaseException& e) {
+    fail(OPENNES_ERROR_ROM, e.printClassName() + ": " + e.printErrorMessage());
+  } catch(const std::exception& e) {
+    fail(OPENNES_ERROR_ROM, e.what());
+  }
+  return nullptr;
+}
+
+void opennes_batch_destroy(OpenNesBatch* batch) {
+  delete batch;
+}
+
+size_t opennes_batch_size(const OpenNesBatch* batch) {
+  if(batch == nullptr) {
+    return 0;
+  }
+  return batch->runner->getConsoleCount();
+}
+
+OpenNesStatus opennes_batch_set_stacking(OpenNesBatch* batch, size_t width,
+    size_t height, size_t depth) {
+  if(batch == nullptr) {
+    return fail(OPENNES_ERROR_ARGUMENT, "No batch given.");
+  }
+  // The observation buffer of the whole batch, padded stacks included, must
+  // fit a size_t.
+  std::size_t count = batch->runner->getConsoleCount();
+  std::size_t largest = std::numeric_limits<std::size_t>::max() / count
+      - OPENNES_BUFFER_ALIGNMENT;
+  if(width != 0 && height != 0 && (height > largest / width
+      || depth > largest / (width * height))) {
+    return fail(OPENNES_ERROR_ARGUMENT, "Stacks of " + std::to_string(width) + "x"
+        + std::to_string(height) + "x" + std::to_string(depth) + " are too large.");
+  }
+  try {
+    std::vector<std::unique_ptr<Nes::ObservationStack>> stacks;
+    for(std::size_t index = 0; index < count; index++) {
+      stacks.emplace_back(new Nes::ObservationStack(width, height, depth));
+    }
+    std::size_t size = stacks.size() * OPENNES_FRAME_SIZE;
+    Memory::Arena<byte> frames(size, OPENNES_BUFFER_ALIGNMENT);
+    frames.allocate(size);
+    batch->stacks = std::move(stacks);
+    batch->frames = std::move(frames);
+    // Each stack starts on an aligned boundary, whatever its size.
+    std::size_t stackSize = batch->stacks[0]->getStackSize();
+    batch->observationStride = (stackSize + OPENNES_BUFFER_ALIGNMENT - 1)
+        / OPENNES_BUFFER_ALIGNMENT * OPENNES_BUFFER_ALIGNMENT;
+  } catch(const Exception::BaseException& e) {
+    return fail(OPENNES_ERROR_ARGUMENT, e.printErrorMessage());
+  } catch(const std::exception& e) {
+    // Out of memory for stacks too large to hold.
+    return fail(OPENNES_ERROR_ARGUMENT, e.what());
+  }
+  lastError.clear();
+  return OPENNES_OK;
+}
+
+size_t opennes_batch_observation_size(const OpenNesBatch* batch) {
+  if(batch == nullptr) {
+    return 0;
+  }
+  return batch->observationStride;
+}
+
+OpenNesStatus opennes_batch_reset(OpenNesBatch* batch, uint8_t* observations, uint8_t* ram) {
+  if(batch == nullptr) {
+    return fail(OPENNES_ERROR_ARGUMENT, "No batch given.");
+  }
+  batch->resetting = true;
+  batch->actions = nullptr;
+  batch->observations = observations;
+  batch->ram = ram;
+  return runFrames(batch);
+}
+
+OpenNesStatus opennes_batch_step(OpenNesBatch* batch, const uint8_t* actions,
+    uint8_t* observations, uint8_t* ram) {
+  if(batch == nullptr || actions == nullptr) {
+    return fail(OPENNES_ERROR_ARGUMENT, "No batch or actions given.");
+  }
+  batch->resetting = false;
+  batch->actions = actions;
+  batch->observations = observations;
+  batch->ram = ram;
+  return runFrames(batch);
+}
+
+const char* opennes_last_error(void) {
+  return lastError.c_str();
+}
@@ -0,0 +1,57 @@
+//===-- tests/common/TestStateBuffer.cpp - StateBuffer Test -----*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the StateWriter and StateReader classes.
+///
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
+#include "common/structures/StructureException.h"
+
+using namespace Structure;
+
+TEST_CASE("States read back the fields written, in order.", "[Common][StateBuffer]") {
+  std::vector<byte> state;
+  StateWriter writer(state);
+  writer.write(static_cast<std::uint32_t>(0xDEADBEEF));
+  writer.write(true);
+  const byte run[] = {1, 2, 3};
+  writer.write(run, sizeof(run));
+  writer.write(static_cast<std::uint16_t>(0x1234));
+  // Fields are packed with no padding.
+  REQUIRE(writer.getSize() == 4 + 1 + 3 + 2);
+
+  StateReader reader(state.data(), state.size());
+  CHECK(reader.read<std::uint32_t>() == 0xDEADBEEF);
+  CHECK(reader.read<bool>() == true);
+  const byte* view = reader.view(3);
+  CHECK(view[0] == 1);
+  CHECK(view[2] == 3);
+  std::uint16_t value;
+  reader.read(value);
+  CHECK(value == 0x1234);
+  CHECK(reader.getRemaining() == 0);
+  CHECK_THROWS_AS(reader.read<byte>(), Exception::StructureException);
+}
+
+TEST_CASE("Writing a state discards the last one.", "[Common][StateBuffer]") {
+  std::vector<byte> state(100, 0xFF);
+  StateWriter writer(state);
+  CHECK(writer.getSize() == 0);
+  writer.write(static_cast<byte>(7));
+  CHECK(state.size() == 1);
+}
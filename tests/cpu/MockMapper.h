@@ -31,7 +31,7 @@ class MockMapper : public Memory::Mapper<byte> {
     inline MockMapper();
     inline ~MockMapper() {}
     inline const std::string getName() const override;
-    inline std::shared_ptr<Memory::Bank<byte>> mapToHardware(Vaddr vaddr) const override;
+    inline Memory::Bank<byte>* mapToHardware(Vaddr vaddr) const override;
   private:
     /// An array of ptrs to Ram banks that can be mapped to
     std::array<std::shared_ptr<Memory::Ram<byte>>, NUM_BANKS> dataBanks;
@@ -50,8 +50,8 @@ const std::string MockMapper::getName() const {
   return "MockMapper";
 }
 
-std::shared_ptr<Memory::Bank<byte>> MockMapper::mapToHardware(Vaddr vaddr) const {
+Memory::Bank<byte>* MockMapper::mapToHardware(Vaddr vaddr) const {
   // mask out the high 4 bits and use as an index into the array
   std::size_t index = (vaddr.val >> 12) & 0xF;
-  return dataBanks[index];
+  return dataBanks[index].get();
 }
@@ -32,7 +32,7 @@ template <uint32 N>
 using range = std::array<uint32, N>;
 
 static void loadRamWithProgram1(
-    std::shared_ptr<Bank<byte>>& ramPtr, 
+    Bank<byte>*& ramPtr, 
     MockMapper& memMap) {
   Vaddr vaddr = {0xFFFC};
   ramPtr = memMap.mapToHardware(vaddr);
@@ -77,7 +77,7 @@ TEST_CASE("Functional test for Mos6502 interpreter.", "[Mos6502][Interpreter]")
   // Add some data to the memory mapper in key locations
   Vaddr vaddr;
   MockMapper memMap;
-  std::shared_ptr<Bank<byte>> ramPtr;
+  Bank<byte>* ramPtr;
   loadRamWithProgram1(ramPtr, memMap);
   // build an interpreter
   InterpretedMos6502 cpu(memMap);
@@ -0,0 +1,286 @@
+//===-- tests/cpu/TestLockstepMos6502.cpp - Lockstep Batch Test -*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the lockstep batch of Mos6502s
+///
+//===----------------------------------------------------------------------===//
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "cpu/CpuException.h"
+#include "cpu/Mos6502.h"
+#include "cpu/interpreter/InterpretedMos6502.h"
+#include "cpu/lockstep/LockstepMos6502.h"
+
+#include "MockMapper.h"
+
+using namespace Cpu;
+using namespace Memory;
+
+/// Address programs are loaded at and reset to.
+static const addr PROGRAM_START = 0x4000;
+
+/// A program using most operations and addressing modes. It loops a number
+/// of times read from $0200, adding $0201 each time, then branches on the
+/// result, so lanes given different data diverge. It ends spinning at $403C.
+static const std::vector<byte> PROGRAM = {
+  Op::LDX_ABS, 0x00, 0x02,
+  Op::LDA_IMMED, 0x00,
+  Op::CLC_IMPL,                 // $4005
+  Op::ADC_ABS, 0x01, 0x02,
+  Op::DEX_IMPL,
+  Op::BNE_REL, 0xF9,            // to $4005
+  Op::STA_ZPG, 0x10,
+  Op::ASL_ACC,
+  Op::ROR_ZPG, 0x10,
+  Op::EOR_IMMED, 0x5A,
+  Op::CMP_IMMED, 0x40,
+  Op::BCC_REL, 0x02,            // to $4019
+  Op::INC_ZPG, 0x11,
+  Op::LSR_ACC,                  // $4019
+  Op::PHA_IMPL,
+  Op::TAY_IMPL,
+  Op::SBC_IMMED, 0x03,
+  Op::BIT_ABS, 0x01, 0x02,
+  Op::PHP_IMPL,
+  Op::PLA_IMPL,
+  Op::STA_ZPG, 0x12,
+  Op::STY_ZPG, 0x13,
+  Op::STX_ZPG, 0x14,
+  Op::TSX_IMPL,
+  Op::STX_ZPG, 0x15,
+  Op::PLA_IMPL,
+  Op::STA_ZPG_X, 0x16,
+  Op::ROL_ACC,
+  Op::STA_IND_Y, 0x20,
+  Op::DEC_ZPG, 0x11,
+  Op::CPX_IMMED, 0x05,
+  Op::CPY_IMMED, 0x05,
+  Op::PHP_IMPL,
+  Op::PLA_IMPL,
+  Op::STA_ZPG, 0x17,
+  Op::JMP_ABS, 0x3C, 0x40       // $403C
+};
+
+/// Write bytes to a memory map.
+static void writeBytes(Mapper<byte>& memMap, addr start, const std::vector<byte>& data) {
+  for(std::size_t i = 0; i < data.size(); i++) {
+    Vaddr vaddr;
+    vaddr.val = static_cast<addr>(start + i);
+    Bank<byte>* bank = memMap.mapToHardware(vaddr);
+    bank->write(vaddr.val - bank->getBaseAddress().val, data[i]);
+  }
+}
+
+/// Read bytes from a memory map.
+static std::vector<byte> readBytes(const Mapper<byte>& memMap, addr start, std::size_t size) {
+  std::vector<byte> data;
+  for(std::size_t i = 0; i < size; i++) {
+    Vaddr vaddr;
+    vaddr.val = static_cast<addr>(start + i);
+    Bank<byte>* bank = memMap.mapToHardware(vaddr);
+    data.push_back(bank->read(vaddr.val - bank->getBaseAddress().val));
+  }
+  return data;
+}
+
+/// Build a memory map holding a program, its reset vector, and the data it
+/// works on.
+static std::unique_ptr<MockMapper> buildMemory(const std::vector<byte>& program,
+    byte count, byte addend) {
+  std::unique_ptr<MockMapper> memMap(new MockMapper());
+  writeBytes(*memMap, 0xFFFC, {PROGRAM_START & 0xFF, PROGRAM_START >> 8});
+  writeBytes(*memMap, PROGRAM_START, program);
+  writeBytes(*memMap, 0x0200, {count, addend});
+  // The pointer STA ($20),Y stores through.
+  writeBytes(*memMap, 0x0020, {0x00, 0x03});
+  return memMap;
+}
+
+/// A lockstep batch with a memory map for each lane.
+template<std::size_t Lanes>
+struct Batch {
+  /// The memory map of each lane.
+  std::vector<std::unique_ptr<MockMapper>> memMaps;
+  /// The batch.
+  std::unique_ptr<LockstepMos6502<Lanes>> cpu;
+
+  /// Build the batch, once the memory maps are filled.
+  void build() {
+    std::array<Mapper<byte>*, Lanes> maps;
+    for(std::size_t lane = 0; lane < Lanes; lane++) {
+      maps[lane] = memMaps[lane].get();
+    }
+    cpu.reset(new LockstepMos6502<Lanes>(maps));
+    cpu->reset();
+  }
+};
+
+/// Build a batch running PROGRAM, with data that differs between lanes if
+/// diverge is set. The data repeats every 8 lanes.
+template<std::size_t Lanes>
+static Batch<Lanes> buildBatch(bool diverge) {
+  Batch<Lanes> batch;
+  for(std::size_t lane = 0; lane < Lanes; lane++) {
+    std::size_t seed = diverge ? lane % 8 : 0;
+    batch.memMaps.push_back(buildMemory(PROGRAM, static_cast<byte>(seed + 1),
+        static_cast<byte>(seed * 0x37 + 0x0B)));
+  }
+  batch.build();
+  return batch;
+}
+
+/// Run PROGRAM on the interpreter, and return the memory it leaves behind.
+static std::vector<byte> interpret(byte count, byte addend, std::size_t cycles) {
+  std::unique_ptr<MockMapper> memMap = buildMemory(PROGRAM, count, addend);
+  InterpretedMos6502 cpu(*memMap);
+  cpu.reset();
+  for(std::size_t cycle = 0; cycle < cycles; cycle++) {
+    cpu.step();
+  }
+  return readBytes(*memMap, 0x0000, 0x400);
+}
+
+TEST_CASE("Every lane runs as the interpreter does.", "[Mos6502][Lockstep]") {
+  const std::size_t cycles = 2000;
+  Batch<8> batch = buildBatch<8>(true);
+  batch.cpu->run(cycles);
+  for(std::size_t lane = 0; lane < 8; lane++) {
+    INFO("Lane " << lane);
+    CHECK(batch.cpu->getRegPC(lane) == 0x403C);
+    CHECK(batch.cpu->getCycles(lane) >= cycles);
+    CHECK(readBytes(*batch.memMaps[lane], 0x0000, 0x400)
+        == interpret(static_cast<byte>(lane + 1), static_cast<byte>(lane * 0x37 + 0x0B), cycles));
+  }
+  // The lanes looped different numbers of times, so they diverged.
+  CHECK(batch.cpu->getUtilization() < 1.0);
+  CHECK(batch.cpu->getUtilization() > 0.0);
+}
+
+TEST_CASE("Lanes with the same data never diverge.", "[Mos6502][Lockstep]") {
+  Batch<32> batch = buildBatch<32>(false);
+  batch.cpu->run(1000);
+  CHECK(batch.cpu->getUtilization() == 1.0);
+  CHECK(batch.cpu->getLaneInstructionCount() == batch.cpu->getIssueCount() * 32);
+  for(std::size_t lane = 1; lane < 32; lane++) {
+    CHECK(readBytes(*batch.memMaps[lane], 0x0000, 0x400)
+        == readBytes(*batch.memMaps[0], 0x0000, 0x400));
+  }
+}
+
+TEST_CASE("A wide batch matches a narrow one.", "[Mos6502][Lockstep]") {
+  Batch<8> narrow = buildBatch<8>(true);
+  Batch<32> wide = buildBatch<32>(true);
+  narrow.cpu->run(2000);
+  wide.cpu->run(2000);
+  for(std::size_t lane = 0; lane < 32; lane++) {
+    INFO("Lane " << lane);
+    CHECK(readBytes(*wide.memMaps[lane], 0x0000, 0x400)
+        == readBytes(*narrow.memMaps[lane % 8], 0x0000, 0x400));
+    CHECK(wide.cpu->getRegAC(lane) == narrow.cpu->getRegAC(lane % 8));
+    CHECK(wide.cpu->getRegSR(lane) == narrow.cpu->getRegSR(lane % 8));
+  }
+}
+
+TEST_CASE("Lanes spinning at a low address do not starve the rest.", "[Mos6502][Lockstep]") {
+  Batch<8> batch;
+  // Lane 0 spins at the reset address, below all of the program.
+  batch.memMaps.push_back(buildMemory({Op::JMP_ABS, 0x00, 0x40}, 1, 1));
+  for(std::size_t lane = 1; lane < 8; lane++) {
+    batch.memMaps.push_back(buildMemory(PROGRAM, 3, 5));
+  }
+  batch.build();
+  batch.cpu->run(2000);
+  CHECK(batch.cpu->getRegPC(0) == 0x4000);
+  for(std::size_t lane = 1; lane < 8; lane++) {
+    CHECK(batch.cpu->getRegPC(lane) == 0x403C);
+  }
+}
+
+TEST_CASE("Subroutines return to their callers.", "[Mos6502][Lockstep]") {
+  Batch<8> batch;
+  for(std::size_t lane = 0; lane < 8; lane++) {
+    batch.memMaps.push_back(buildMemory({
+      Op::JSR_ABS, 0x10, 0x40,
+      Op::STX_ZPG, 0x10,
+      Op::JMP_ABS, 0x05, 0x40,  // $4005
+    }, 0, 0));
+    // $4010: INX; RTS
+    writeBytes(*batch.memMaps[lane], 0x4010, {Op::INX_IMPL, Op::RTS_IMPL});
+  }
+  batch.build();
+  batch.cpu->run(100);
+  for(std::size_t lane = 0; lane < 8; lane++) {
+    CHECK(batch.cpu->getRegPC(lane) == 0x4005);
+    CHECK(batch.cpu->getRegSP(lane) == 0xFF);
+    CHECK(readBytes(*batch.memMaps[lane], 0x0010, 1)[0] == 1);
+    // JSR pushes the address of its last byte.
+    CHECK(readBytes(*batch.memMaps[lane], 0x01FE, 2) == std::vector<byte>({0x02, 0x40}));
+  }
+}
+
+TEST_CASE("Undefined opcodes throw.", "[Mos6502][Lockstep]") {
+  Batch<8> batch;
+  for(std::size_t lane = 0; lane < 8; lane++) {
+    batch.memMaps.push_back(buildMemory({0x02}, 0, 0));
+  }
+  batch.build();
+  CHECK_THROWS_AS(batch.cpu->step(), Exception::InvalidOpcodeException);
+}
+
+/// Run a batch, and report how fast its lanes ran and how well they stayed
+/// together.
+template<std::size_t Lanes>
+static void benchmarkBatch(bool diverge) {
+  Batch<Lanes> batch = buildBatch<Lanes>(diverge);
+  const std::size_t repeats = 200;
+  auto start = std::chrono::steady_clock::now();
+  for(std::size_t repeat = 0; repeat < repeats; repeat++) {
+    batch.cpu->reset();
+    batch.cpu->run(400);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  WARN(Lanes << " lanes" << (diverge ? ", diverging" : "") << ": "
+      << repeats * Lanes * 400 / elapsed.count() / 1e6
+      << "M cycles per second at " << batch.cpu->getUtilization() * 100
+      << "% lane utilization");
+}
+
+TEST_CASE("Benchmark lockstep batches against the interpreter.", "[.][benchmark]") {
+  std::vector<std::unique_ptr<MockMapper>> memMaps;
+  std::vector<std::unique_ptr<InterpretedMos6502>> cpus;
+  for(std::size_t lane = 0; lane < 32; lane++) {
+    memMaps.push_back(buildMemory(PROGRAM, 1, 0x0B));
+    cpus.emplace_back(new InterpretedMos6502(*memMaps.back()));
+  }
+  const std::size_t repeats = 200;
+  auto start = std::chrono::steady_clock::now();
+  for(std::size_t repeat = 0; repeat < repeats; repeat++) {
+    for(auto& cpu : cpus) {
+      cpu->reset();
+      for(std::size_t cycle = 0; cycle < 400; cycle++) {
+        cpu->step();
+      }
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  WARN("Interpreter: " << repeats * 32 * 400 / elapsed.count() / 1e6
+      << "M cycles per second");
+  benchmarkBatch<8>(false);
+  benchmarkBatch<32>(false);
+  benchmarkBatch<32>(true);
+}
@@ -19,7 +19,7 @@
 #include "tests/catch.hpp"
 #include "common/CommonTypes.h"
 #include "cpu/Mos6502.h"
-#include "Mos6502_Inst.h"
+#include "cpu/Mos6502_Inst.h"
 
 #include "MockMapper.h"
 
@@ -29,7 +29,7 @@ static MockMapper memMap;
 /// \brief Class for testing Mos6502 methods.
 class TestMos6502 : public Cpu::Mos6502 {
   public:
-    TestMos6502() : Mos6502(::memMap) {}
+    TestMos6502() : Cpu::Mos6502(::memMap) {}
     ~TestMos6502() {}
   protected:
     void fetchOpcodeImpl() override {}
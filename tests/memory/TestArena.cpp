@@ -0,0 +1,91 @@
+//===-- tests/memory/TestArena.cpp - Arena Test -----------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the Arena class
+///
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "memory/Arena.h"
+#include "memory/MemoryException.h"
+#include "memory/Ram.h"
+#include "memory/Rom.h"
+
+using namespace Memory;
+
+TEST_CASE("Arena allocation functionality.", "[Memory][Arena]") {
+  Arena<byte> arena(0x100);
+  REQUIRE(arena.getCapacity() == 0x100);
+  REQUIRE(arena.getAllocated() == 0);
+
+  SECTION("Arena storage is aligned and zeroed") {
+    auto start = reinterpret_cast<std::uintptr_t>(arena.at(0));
+    CHECK((start % Arena<byte>::DEFAULT_ALIGNMENT) == 0);
+    for(std::size_t i = 0; i < arena.getCapacity(); i++) {
+      CHECK(*arena.at(i) == 0);
+    }
+  }
+
+  SECTION("Allocations are laid out back to back") {
+    CHECK(arena.allocate(0x40) == 0x00);
+    CHECK(arena.allocate(0x80) == 0x40);
+    CHECK(arena.allocate(0x40) == 0xC0);
+    CHECK(arena.getAllocated() == 0x100);
+  }
+
+  SECTION("Allocating past the capacity throws an error") {
+    arena.allocate(0xF0);
+    REQUIRE_THROWS_AS(arena.allocate(0x20), Exception::MemoryException);
+  }
+}
+
+TEST_CASE("Banks viewing an Arena share its storage.", "[Memory][Arena]") {
+  Arena<byte> arena(0x200);
+  Ram<byte> ram(arena.at(arena.allocate(0x100)), 0x100, {0x6000});
+  Rom<byte> rom(arena.at(arena.allocate(0x100)), 0x100, {0x8000});
+  REQUIRE(ram.isView());
+  REQUIRE(ram.getSize() == 0x100);
+  REQUIRE(ram.getBaseAddress().val == 0x6000);
+
+  SECTION("Writes to a Ram view land in the arena") {
+    ram.write(0x10, 0x42);
+    CHECK(*arena.at(0x10) == 0x42);
+    CHECK(ram.read(0x10) == 0x42);
+  }
+
+  SECTION("Loading a Rom view copies into the arena") {
+    std::vector<byte> data = {1, 2, 3, 4};
+    rom.load(std::begin(data), std::end(data));
+    CHECK(rom.getSize() == 0x100);
+    for(std::size_t i = 0; i < data.size(); i++) {
+      CHECK(*arena.at(0x100 + i) == data.at(i));
+      CHECK(rom.read(i) == data.at(i));
+    }
+  }
+
+  SECTION("Copied views share storage, and cannot be resized") {
+    Ram<byte> copy(ram);
+    copy.write(0x20, 0x17);
+    CHECK(ram.read(0x20) == 0x17);
+    REQUIRE_THROWS_AS(copy.resize(0x200), Exception::MemoryException);
+  }
+
+  SECTION("Moving the arena keeps views valid") {
+    Arena<byte> movedArena(std::move(arena));
+    ram.write(0x30, 0x99);
+    CHECK(*movedArena.at(0x30) == 0x99);
+  }
+}
@@ -0,0 +1,66 @@
+//===-- tests/memory/TestIoPort.cpp - IoPort Test ---------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the IoPort class
+///
+//===----------------------------------------------------------------------===//
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/BaseException.h"
+#include "memory/IoPort.h"
+
+using namespace Memory;
+
+TEST_CASE("IoPort registers dispatch to their handlers.", "[Memory][IoPort]") {
+  IoPort<byte> port(8, {0x2000});
+  REQUIRE(port.getSize() == 8);
+
+  SECTION("Registers without handlers latch writes") {
+    port.write(3, 0x42);
+    CHECK(port.read(3) == 0x42);
+    CHECK(port.read(4) == 0x00);
+  }
+
+  SECTION("Read handlers are called with the register index") {
+    std::size_t lastIndex = 0xFF;
+    port.setReadHandler(2, [&lastIndex](std::size_t index) -> byte {
+      lastIndex = index;
+      return 0x80;
+    });
+    port.write(2, 0x11);
+    CHECK(port.read(2) == 0x80);
+    CHECK(lastIndex == 2);
+    // Other registers still latch.
+    port.write(1, 0x11);
+    CHECK(port.read(1) == 0x11);
+  }
+
+  SECTION("Write handlers see the written data") {
+    std::size_t lastIndex = 0xFF;
+    byte lastData = 0;
+    port.setWriteHandler(6, [&](std::size_t index, byte data) {
+      lastIndex = index;
+      lastData = data;
+    });
+    port.write(6, 0x33);
+    CHECK(lastIndex == 6);
+    CHECK(lastData == 0x33);
+    // The write is latched as well.
+    CHECK(port.read(6) == 0x33);
+  }
+
+  SECTION("Handlers can only be set on existing registers") {
+    CHECK_THROWS_AS(port.setReadHandler(8, nullptr), Exception::BaseException);
+    CHECK_THROWS_AS(port.setWriteHandler(8, nullptr), Exception::BaseException);
+  }
+}
@@ -14,6 +14,8 @@
 ///
 //===----------------------------------------------------------------------===//
 
+#include <vector>
+
 #include "tests/catch.hpp"
 #include "common/CommonTypes.h"
 #include "memory/Ram.h"
@@ -57,3 +59,41 @@ TEST_CASE("Rams are correctly resizable.", "[Memory][Ram]") {
   REQUIRE(ram.getSize() == 0x200);
   
 }
+
+TEST_CASE("Rams track the pages written.", "[Memory][Ram]") {
+  Ram<byte> ram(0x2000);
+  REQUIRE(ram.getPageCount() == 0x20);
+  std::vector<std::size_t> pages;
+  // A new Ram is dirty throughout, as no snapshot holds it yet.
+  CHECK(ram.collectDirtyPages(pages) == 0x20);
+  pages.clear();
+  CHECK(ram.collectDirtyPages(pages) == 0);
+
+  ram.write(0x0000, 1);
+  ram.write(0x00FF, 2);
+  ram.write(0x1F00, 3);
+  CHECK(ram.isPageDirty(0x00));
+  CHECK_FALSE(ram.isPageDirty(0x01));
+  CHECK(ram.isPageDirty(0x1F));
+  CHECK(ram.collectDirtyPages(pages) == 2);
+  CHECK(pages == std::vector<std::size_t>({0x00, 0x1F}));
+  CHECK_FALSE(ram.isPageDirty(0x00));
+
+  std::vector<byte> words(0x2000, 0);
+  ram.load(words.data());
+  CHECK(ram.isPageDirty(0x10));
+  ram.clearDirtyPages();
+  CHECK_FALSE(ram.isPageDirty(0x10));
+}
+
+TEST_CASE("Resized Rams track every page.", "[Memory][Ram]") {
+  Ram<byte> ram(0x100);
+  ram.clearDirtyPages();
+  ram.resize(0x10100);
+  REQUIRE(ram.getPageCount() == 0x101);
+  ram.clearDirtyPages();
+  ram.write(0x10000, 1);
+  std::vector<std::size_t> pages;
+  CHECK(ram.collectDirtyPages(pages) == 1);
+  CHECK(pages.front() == 0x100);
+}
@@ -0,0 +1,66 @@
+//===-- tests/memory/TestWindow.cpp - Window Test ---------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the Window class
+///
+//===----------------------------------------------------------------------===//
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/BaseException.h"
+#include "memory/Ram.h"
+#include "memory/Window.h"
+
+using namespace Memory;
+
+TEST_CASE("Windows switch between banks of their source.", "[Memory][Window]") {
+  Ram<byte> source(0x400);
+  for(std::size_t i = 0; i < source.getSize(); i++) {
+    source.write(i, static_cast<byte>(i >> 8));
+  }
+  Window<byte> window(0x100, {0x8000});
+  REQUIRE(window.getSize() == 0x100);
+  REQUIRE(window.isView());
+
+  SECTION("Reads follow the mapped bank") {
+    window.map(source, 0x200, false);
+    CHECK(window.read(window.getIndex({0x80FF})) == 2);
+    window.map(source, 0x300, false);
+    CHECK(window.read(window.getIndex({0x8000})) == 3);
+  }
+
+  SECTION("Writable windows write through to the source") {
+    window.map(source, 0x100, true);
+    window.write(0x10, 0x77);
+    CHECK(source.read(0x110) == 0x77);
+  }
+
+  SECTION("Writes through windows mark the pages of the source dirty") {
+    source.clearDirtyPages();
+    window.map(source, 0x300, true);
+    window.write(0x10, 0x77);
+    CHECK(source.isPageDirty(3));
+    CHECK_FALSE(source.isPageDirty(2));
+  }
+
+  SECTION("Read only windows pass writes to their handler") {
+    window.map(source, 0x100, false);
+    CHECK_THROWS_AS(window.write(0, 0), Exception::BaseException);
+    Vaddr written = {0};
+    window.setWriteHandler([&written](Vaddr vaddr, byte) {
+      written = vaddr;
+    });
+    window.write(0x42, 0x01);
+    CHECK(written.val == 0x8042);
+    CHECK(source.read(0x142) == 1);
+  }
+}
@@ -0,0 +1,141 @@
+//===-- tests/nes/RomFile.h - Synthetic iNES Rom Files ----------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains helpers for writing synthetic iNES files to test with,
+/// the test programs shared between suites, and Cpu bus accessors.
+///
+//===----------------------------------------------------------------------===//
+#ifndef TESTS_NES_ROM_FILE_H
+#define TESTS_NES_ROM_FILE_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/CommonTypes.h"
+#include "cpu/Mos6502.h"
+#include "nes/CpuBus.h"
+#include "tests/TestResource.h"
+
+/// Write an iNES file to the test resource directory. Every 8kB chunk of PRG
+/// ROM is filled with its chunk index, and every 1kB chunk of CHR ROM is
+/// filled with its chunk index, so that tests can tell which bank is mapped
+/// where by reading a single byte.
+/// \param name File name of the rom within the test resource directory.
+/// \param num16kRom Number of 16kB PRG ROM banks.
+/// \param num8kVRom Number of 8kB CHR ROM banks.
+/// \param mapperIndex iNES mapper index.
+/// \returns Path to the written file.
+static inline std::string writeRomFile(
+    const std::string& name,
+    byte num16kRom,
+    byte num8kVRom,
+    byte mapperIndex = 0) {
+  std::string path = GET_RESOURCE_PATH(name);
+  std::ofstream romStream(path, std::ios::binary);
+  // NES^Z, bank counts, mapper index nibbles, and padding.
+  char header[16] = {0x4E, 0x45, 0x53, 0x1A};
+  header[4] = static_cast<char>(num16kRom);
+  header[5] = static_cast<char>(num8kVRom);
+  header[6] = static_cast<char>((mapperIndex & 0x0F) << 4);
+  header[7] = static_cast<char>(mapperIndex & 0xF0);
+  romStream.write(header, sizeof(header));
+  for(std::size_t i = 0; i < num16kRom * 0x4000u; i++) {
+    romStream.put(static_cast<char>(i >> 13));
+  }
+  for(std::size_t i = 0; i < num8kVRom * 0x2000u; i++) {
+    romStream.put(static_cast<char>(i >> 10));
+  }
+  return path;
+}
+
+/// Write an NROM-128 iNES file holding a program. The program is loaded at
+/// $8000, the rest of PRG ROM is zero, and every vector points at $8000.
+/// \param name File name of the rom within the test resource directory.
+/// \param program The machine code to load at $8000.
+/// \returns Path to the written file.
+static inline std::string writeProgramRomFile(
+    const std::string& name,
+    const std::vector<byte>& program) {
+  std::string path = GET_RESOURCE_PATH(name);
+  std::ofstream romStream(path, std::ios::binary);
+  char header[16] = {0x4E, 0x45, 0x53, 0x1A, 0x01, 0x01};
+  romStream.write(header, sizeof(header));
+  std::vector<char> prgRom(0x4000, 0);
+  std::copy(program.begin(), program.end(), prgRom.begin());
+  for(std::size_t vector = 0x3FFA; vector < 0x4000; vector += 2) {
+    prgRom[vector] = 0x00;
+    prgRom[vector + 1] = static_cast<char>(0x80);
+  }
+  romStream.write(prgRom.data(), prgRom.size());
+  std::vector<char> chrRom(0x2000, 0);
+  romStream.write(chrRom.data(), chrRom.size());
+  return path;
+}
+
+/// Write a rom holding a program that enables NMI and rendering, counts NMIs
+/// in $10 and then spins. Every vector points at the program, so each NMI runs
+/// it again.
+/// \param name File name of the rom within the test resource directory.
+/// \returns Path to the written file.
+static inline std::string writeNmiCounterRomFile(const std::string& name) {
+  // LDA #$1E; STA $2001; LDA #$80; STA $2000; INC $10; JMP $800C
+  return writeProgramRomFile(name, {
+    Cpu::Op::LDA_IMMED, 0x1E,
+    Cpu::Op::STA_ABS, 0x01, 0x20,
+    Cpu::Op::LDA_IMMED, 0x80,
+    Cpu::Op::STA_ABS, 0x00, 0x20,
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::JMP_ABS, 0x0C, 0x80
+  });
+}
+
+/// Write a rom holding a program that plays a pulse tone, sweeping its pitch
+/// as fast as it can, and counts loops in $10.
+/// \param name File name of the rom within the test resource directory.
+/// \returns Path to the written file.
+static inline std::string writeToneSweepRomFile(const std::string& name) {
+  // LDA #$01; STA $4015; LDA #$BF; STA $4000; LDA #$00; STA $4003;
+  // INC $10; LDA $10; STA $4002; JMP $800F
+  return writeProgramRomFile(name, {
+    Cpu::Op::LDA_IMMED, 0x01,
+    Cpu::Op::STA_ABS, 0x15, 0x40,
+    Cpu::Op::LDA_IMMED, 0xBF,
+    Cpu::Op::STA_ABS, 0x00, 0x40,
+    Cpu::Op::LDA_IMMED, 0x00,
+    Cpu::Op::STA_ABS, 0x03, 0x40,
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::LDA_ZPG, 0x10,
+    Cpu::Op::STA_ABS, 0x02, 0x40,
+    Cpu::Op::JMP_ABS, 0x0F, 0x80
+  });
+}
+
+/// Read a byte through the bus, as the Cpu would.
+/// \param bus The bus to read.
+/// \param vaddr The address to read.
+/// \returns The byte read.
+static inline byte busRead(const Nes::CpuBus& bus, Vaddr vaddr) {
+  auto bankPtr = bus.mapToHardware(vaddr);
+  return bankPtr->read(bankPtr->getIndex(vaddr));
+}
+
+/// Write a byte through the bus, as the Cpu would.
+/// \param bus The bus to write.
+/// \param vaddr The address to write.
+/// \param data The byte to write.
+static inline void busWrite(const Nes::CpuBus& bus, Vaddr vaddr, byte data) {
+  auto bankPtr = bus.mapToHardware(vaddr);
+  bankPtr->write(bankPtr->getIndex(vaddr), data);
+}
+
+#endif // TESTS_NES_ROM_FILE_H //
@@ -0,0 +1,233 @@
+//===-- tests/nes/TestApu.cpp - Apu Test ------------------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the Apu class
+///
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
+#include "nes/Apu.h"
+#include "nes/Cartridge.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/CpuBus.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Cpu cycles in an NTSC frame.
+static const std::size_t CYCLES_PER_FRAME = 29781;
+
+/// Run the Apu for the given number of cycles, catching up as the Console
+/// would.
+static void run(Apu& apu, std::size_t cycles) {
+  apu.advance(cycles);
+  apu.catchUp();
+}
+
+/// Count the sign changes of a run of samples.
+static std::size_t countCrossings(const std::vector<std::int16_t>& samples,
+    std::size_t first) {
+  std::size_t crossings = 0;
+  for(std::size_t sample = first + 1; sample < samples.size(); sample++) {
+    if((samples[sample - 1] < 0) != (samples[sample] < 0)) {
+      crossings++;
+    }
+  }
+  return crossings;
+}
+
+TEST_CASE("Apu length counters silence channels.", "[Nes][Apu]") {
+  Apu apu;
+  apu.writeRegister(0x15, 0x01);
+  apu.writeRegister(0x00, 0x1F);
+  apu.writeRegister(0x03, 0x00);
+  CHECK((apu.readRegister(0x15) & 0x01) == 0x01);
+
+  SECTION("A length of 10 lasts 10 half frames") {
+    run(apu, 4 * 14915 + 7457 + 100);
+    CHECK((apu.readRegister(0x15) & 0x01) == 0x01);
+    run(apu, 7457);
+    CHECK((apu.readRegister(0x15) & 0x01) == 0x00);
+  }
+
+  SECTION("Halted length counters keep counting") {
+    apu.writeRegister(0x00, 0x3F);
+    run(apu, 10 * 14915);
+    CHECK((apu.readRegister(0x15) & 0x01) == 0x01);
+  }
+
+  SECTION("Disabling the channel clears its length") {
+    apu.writeRegister(0x15, 0x00);
+    CHECK((apu.readRegister(0x15) & 0x01) == 0x00);
+  }
+}
+
+TEST_CASE("Apu frame counter raises an IRQ every four steps.", "[Nes][Apu]") {
+  Apu apu;
+  apu.writeRegister(0x17, 0x00);
+  run(apu, 14914);
+  CHECK_FALSE(apu.isIrqAsserted());
+  apu.advance(1);
+  REQUIRE(apu.isCatchUpDue());
+  apu.catchUp();
+  CHECK(apu.isIrqAsserted());
+  CHECK((apu.readRegister(0x15) & 0x40) == 0x40);
+  CHECK_FALSE(apu.isIrqAsserted());
+
+  SECTION("Inhibiting the IRQ") {
+    apu.writeRegister(0x17, 0x40);
+    run(apu, 3 * 14915);
+    CHECK_FALSE(apu.isIrqAsserted());
+  }
+
+  SECTION("The five step sequence raises none") {
+    apu.writeRegister(0x17, 0x80);
+    run(apu, 3 * 18641);
+    CHECK_FALSE(apu.isIrqAsserted());
+  }
+}
+
+TEST_CASE("Apu DMC fetches samples from the Cpu bus.", "[Nes][Apu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("apuDmc.nes", 2, 1));
+  auto cartridgePtr = builder.build();
+  CpuBus bus(*cartridgePtr);
+  Apu apu;
+  apu.connect(bus);
+  // A 17 byte sample at the fastest rate, with the IRQ enabled.
+  busWrite(bus, {0x4010}, 0x8F);
+  busWrite(bus, {0x4013}, 0x01);
+  busWrite(bus, {0x4015}, 0x10);
+  CHECK((busRead(bus, {0x4015}) & 0x10) == 0x10);
+
+  // One byte is fetched straight away, and one every 8 bits of 54 cycles,
+  // once the timer has run out the 428 cycle period it had at power up.
+  run(apu, 16 * 8 * 54 - 54);
+  CHECK_FALSE(apu.isIrqAsserted());
+  CHECK((busRead(bus, {0x4015}) & 0x10) == 0x10);
+  std::size_t cycles = 0;
+  while(!apu.isIrqAsserted() && cycles < 1000) {
+    apu.advance(1);
+    cycles++;
+    if(apu.isCatchUpDue()) {
+      apu.catchUp();
+    }
+  }
+  CHECK(cycles == 428);
+  CHECK((busRead(bus, {0x4015}) & 0x90) == 0x80);
+  busWrite(bus, {0x4015}, 0x00);
+  CHECK_FALSE(apu.isIrqAsserted());
+}
+
+TEST_CASE("Apu synthesizes pulse tones at their pitch.", "[Nes][Apu]") {
+  Apu apu(48000.0);
+  std::vector<std::int16_t> samples;
+  for(int frame = 0; frame < 6; frame++) {
+    run(apu, CYCLES_PER_FRAME);
+    apu.endFrame(samples);
+  }
+  // Silence is exactly silent.
+  CHECK(std::all_of(samples.begin(), samples.end(),
+      [](std::int16_t sample) { return sample == 0; }));
+
+  // A 50% duty tone at period 253, 1789773 / (16 * 254) = 440.4 Hz.
+  apu.writeRegister(0x15, 0x01);
+  apu.writeRegister(0x00, 0xBF);
+  apu.writeRegister(0x02, 253);
+  apu.writeRegister(0x03, 0x00);
+  samples.clear();
+  std::size_t count = 0;
+  for(int frame = 0; frame < 60; frame++) {
+    run(apu, CYCLES_PER_FRAME);
+    count += apu.endFrame(samples);
+  }
+  CHECK(count == samples.size());
+  // 60 frames are 1786860 Cpu cycles.
+  CHECK(samples.size() == Approx(1786860 * 48000.0 / Apu::CPU_CLOCK_RATE).epsilon(0.001));
+  double seconds = 1786860 / Apu::CPU_CLOCK_RATE;
+  std::size_t skipped = samples.size() / 10;
+  double frequency = countCrossings(samples, skipped) / 2.0
+      / (seconds * (samples.size() - skipped) / samples.size());
+  CHECK(frequency == Approx(440.4).epsilon(0.01));
+  auto peak = *std::max_element(samples.begin(), samples.end());
+  CHECK(peak > 3000);
+}
+
+TEST_CASE("Apu keeps only the last frame of audio nobody takes.", "[Nes][Apu]") {
+  Apu apu(48000.0);
+  apu.writeRegister(0x15, 0x01);
+  apu.writeRegister(0x00, 0xBF);
+  apu.writeRegister(0x02, 253);
+  apu.writeRegister(0x03, 0x00);
+  // Whether the audio was last dropped a while ago or just now, the state
+  // holds less than two frames of steps, and not 600.
+  const double samplesPerFrame = CYCLES_PER_FRAME * 48000.0 / Apu::CPU_CLOCK_RATE;
+  std::vector<byte> state;
+  for(int frame = 0; frame < 600; frame++) {
+    run(apu, CYCLES_PER_FRAME);
+    if(frame == 10 || frame == 599) {
+      Structure::StateWriter writer(state);
+      apu.saveState(writer);
+      CHECK(state.size() < 2 * samplesPerFrame * sizeof(float));
+    }
+  }
+  // The samples of the last frame can still be taken.
+  std::vector<std::int16_t> samples;
+  apu.endFrame(samples);
+  CHECK(samples.size() >= samplesPerFrame);
+  CHECK(samples.size() < 1.5 * samplesPerFrame);
+  CHECK(*std::max_element(samples.begin(), samples.end()) > 3000);
+}
+
+TEST_CASE("Benchmark Apu synthesis per frame.", "[.][benchmark]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("apuBenchmark.nes", 2, 1));
+  auto cartridgePtr = builder.build();
+  CpuBus bus(*cartridgePtr);
+  Apu apu(48000.0);
+  apu.connect(bus);
+  // Every channel sounding: two pulses, the triangle, noise and a looping
+  // DMC sample.
+  const byte writes[][2] = {
+    {0x15, 0x1F}, {0x00, 0xBF}, {0x02, 0xFD}, {0x03, 0x00}, {0x04, 0x7F},
+    {0x06, 0x52}, {0x07, 0x01}, {0x08, 0xFF}, {0x0A, 0x7F}, {0x0B, 0x00},
+    {0x0C, 0x3F}, {0x0E, 0x04}, {0x0F, 0x00}, {0x10, 0x4F}, {0x13, 0xFF},
+    {0x15, 0x1F}
+  };
+  for(const auto& write : writes) {
+    apu.writeRegister(write[0], write[1]);
+  }
+  std::vector<std::int16_t> samples;
+  const int frames = 600;
+  auto start = std::chrono::steady_clock::now();
+  for(int frame = 0; frame < frames; frame++) {
+    // Register writes spread over the frame, as a sound driver would make.
+    for(int write = 0; write < 8; write++) {
+      run(apu, CYCLES_PER_FRAME / 8);
+      apu.writeRegister(0x02, static_cast<byte>(0x80 + frame + write));
+    }
+    samples.clear();
+    apu.endFrame(samples);
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  double perFrame = elapsed.count() / frames;
+  WARN("Apu at 48kHz: " << perFrame << " microseconds per frame, "
+      << perFrame / (1e6 / 60.0988) * 100.0 << "% of a frame");
+}
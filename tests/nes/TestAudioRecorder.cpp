@@ -0,0 +1,101 @@
+//===-- tests/nes/TestAudioRecorder.cpp - AudioRecorder Test ----*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the AudioRecorder class
+///
+//===----------------------------------------------------------------------===//
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "tests/TestResource.h"
+#include "common/CommonTypes.h"
+#include "common/CommonException.h"
+#include "nes/AudioRecorder.h"
+
+using namespace Nes;
+
+/// Read a whole file.
+static std::vector<byte> readFile(const std::string& path) {
+  std::ifstream stream(path, std::ios::binary);
+  return std::vector<byte>(std::istreambuf_iterator<char>(stream),
+      std::istreambuf_iterator<char>());
+}
+
+/// Read a little endian 32 bit value.
+static std::uint32_t readLittleEndian32(const std::vector<byte>& bytes, std::size_t offset) {
+  return bytes[offset] | bytes[offset + 1] << 8 | bytes[offset + 2] << 16
+      | static_cast<std::uint32_t>(bytes[offset + 3]) << 24;
+}
+
+/// Record a ramp, a frame of 800 samples at a time, to the given file.
+static void recordRamp(const std::string& path, AudioRecorder::Format format,
+    std::size_t count) {
+  AudioRecorder recorder(path, format, 48000);
+  std::vector<std::int16_t> frame(800);
+  for(std::size_t next = 0; next < count; next += frame.size()) {
+    for(std::size_t i = 0; i < frame.size(); i++) {
+      frame[i] = static_cast<std::int16_t>(next + i - 0x4000);
+    }
+    std::size_t size = std::min(frame.size(), count - next);
+    REQUIRE(recorder.write(frame.data(), size) == size);
+  }
+  recorder.close();
+  CHECK(recorder.getWrittenCount() == count);
+  CHECK(recorder.getRing().getOverrunCount() == 0);
+  CHECK(recorder.getRing().getUnderrunCount() == 0);
+}
+
+TEST_CASE("The AudioRecorder writes a WAV file.", "[Nes][AudioRecorder]") {
+  // More than a chunk, and not a whole number of them.
+  const std::size_t count = AudioRecorder::CHUNK_SAMPLES * 3 + 123;
+  std::string path = GET_RESOURCE_PATH("recording.wav");
+  recordRamp(path, AudioRecorder::Format::WAV, count);
+  auto bytes = readFile(path);
+  REQUIRE(bytes.size() == 44 + count * 2);
+  CHECK(std::string(bytes.begin(), bytes.begin() + 4) == "RIFF");
+  CHECK(readLittleEndian32(bytes, 4) == 36 + count * 2);
+  CHECK(std::string(bytes.begin() + 8, bytes.begin() + 16) == "WAVEfmt ");
+  CHECK(readLittleEndian32(bytes, 24) == 48000);
+  CHECK(std::string(bytes.begin() + 36, bytes.begin() + 40) == "data");
+  CHECK(readLittleEndian32(bytes, 40) == count * 2);
+  // The first sample is -$4000, and the last is count - 1 - $4000.
+  CHECK(bytes[44] == 0x00);
+  CHECK(bytes[45] == 0xC0);
+  std::int16_t last = static_cast<std::int16_t>(bytes[bytes.size() - 2] | bytes.back() << 8);
+  CHECK(last == static_cast<std::int16_t>(count - 1 - 0x4000));
+}
+
+TEST_CASE("The AudioRecorder writes a raw file.", "[Nes][AudioRecorder]") {
+  std::string path = GET_RESOURCE_PATH("recording.raw");
+  recordRamp(path, AudioRecorder::Format::RAW, 1000);
+  auto bytes = readFile(path);
+  REQUIRE(bytes.size() == 2000);
+  CHECK(bytes[0] == 0x00);
+  CHECK(bytes[1] == 0xC0);
+}
+
+TEST_CASE("The AudioRecorder reports failed writes.", "[Nes][AudioRecorder]") {
+  // Every write to /dev/full fails as if the disk were full.
+  if(!std::ifstream("/dev/full").good()) {
+    WARN("No /dev/full to write to.");
+    return;
+  }
+  AudioRecorder recorder("/dev/full", AudioRecorder::Format::WAV, 48000);
+  std::vector<std::int16_t> samples(AudioRecorder::CHUNK_SAMPLES * 2);
+  REQUIRE(recorder.write(samples.data(), samples.size()) == samples.size());
+  CHECK_THROWS_AS(recorder.close(), Exception::RuntimeException);
+  CHECK(recorder.hasFailed());
+  CHECK(recorder.getWrittenCount() == 0);
+}
@@ -0,0 +1,85 @@
+//===-- tests/nes/TestAudioRing.cpp - AudioRing Test ------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the AudioRing class
+///
+//===----------------------------------------------------------------------===//
+
+#include <thread>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/AudioRing.h"
+
+using namespace Nes;
+
+TEST_CASE("The AudioRing wraps, and counts overruns and underruns.", "[Nes][AudioRing]") {
+  AudioRing ring(100);
+  REQUIRE(ring.getCapacity() == 128);
+  std::vector<std::int16_t> samples(100);
+  for(std::size_t i = 0; i < samples.size(); i++) {
+    samples[i] = static_cast<std::int16_t>(i);
+  }
+  CHECK(ring.write(samples.data(), 100) == 100);
+  CHECK(ring.getFillCount() == 100);
+  CHECK(ring.getFillLevel() == Approx(100.0 / 128.0));
+
+  std::vector<std::int16_t> read(100);
+  CHECK(ring.read(read.data(), 60) == 60);
+  CHECK(read[59] == 59);
+  // This write wraps around the end of the buffer, and 12 samples do not fit.
+  CHECK(ring.write(samples.data(), 100) == 88);
+  CHECK(ring.getOverrunCount() == 12);
+  CHECK(ring.getFillCount() == 128);
+
+  CHECK(ring.read(read.data(), 40) == 40);
+  CHECK(read[39] == 99);
+  CHECK(ring.read(read.data(), 100) == 88);
+  CHECK(read[87] == 87);
+  CHECK(ring.getUnderrunCount() == 12);
+  CHECK(ring.getFillCount() == 0);
+}
+
+TEST_CASE("The AudioRing passes every sample between threads in order.", "[Nes][AudioRing]") {
+  AudioRing ring(1024);
+  const std::size_t total = 1 << 20;
+  std::thread producer([&ring, total]() {
+    std::int16_t block[97];
+    std::size_t next = 0;
+    while(next < total) {
+      std::size_t count = std::min<std::size_t>(97, total - next);
+      for(std::size_t i = 0; i < count; i++) {
+        block[i] = static_cast<std::int16_t>(next + i);
+      }
+      // Retry whatever did not fit, rather than dropping it.
+      std::size_t written = ring.write(block, count);
+      next += written;
+      if(written < count) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::int16_t block[61];
+  std::size_t next = 0;
+  bool inOrder = true;
+  while(next < total) {
+    std::size_t count = ring.read(block, std::min<std::size_t>(61, ring.getFillCount()));
+    for(std::size_t i = 0; i < count; i++) {
+      inOrder &= block[i] == static_cast<std::int16_t>(next + i);
+    }
+    next += count;
+  }
+  producer.join();
+  CHECK(inOrder);
+  CHECK(ring.getUnderrunCount() == 0);
+}
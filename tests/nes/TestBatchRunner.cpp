@@ -0,0 +1,104 @@
+//===-- tests/nes/TestBatchRunner.cpp - BatchRunner Test --------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the BatchRunner class
+///
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/CommonException.h"
+#include "nes/BatchRunner.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Console.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Build a factory of headless Consoles running a ROM.
+static BatchRunner::Factory buildFactory(const std::string& path) {
+  return [path](std::size_t index) {
+    CartridgeBuilder builder;
+    builder.setInputFile(path);
+    std::unique_ptr<Console> console(new Console(builder.build()));
+    console->getPpu().setHeadless(true);
+    console->getApu().setHeadless(true);
+    return console;
+  };
+}
+
+TEST_CASE("Batches run a frame of every Console.", "[Nes][BatchRunner]") {
+  std::string path = writeNmiCounterRomFile("batchNmi.nes");
+  // More Consoles than threads, in uneven blocks.
+  BatchRunner batch(37, buildFactory(path), 4);
+  REQUIRE(batch.getConsoleCount() == 37);
+  REQUIRE(batch.getThreadCount() == 4);
+  for(int frame = 0; frame < 3; frame++) {
+    batch.runFrame();
+  }
+  bool ran = true;
+  for(std::size_t index = 0; index < batch.getConsoleCount(); index++) {
+    Console& console = batch.getConsole(index);
+    ran &= console.getPpu().getFrameCount() == 3;
+    ran &= console.getBus().getRam().read(0x10) == 3;
+  }
+  CHECK(ran);
+  CHECK(batch.getFramesPerSecond() > 0.0);
+
+  SECTION("Fewer Consoles than threads") {
+    BatchRunner small(2, buildFactory(path), 8);
+    small.runFrame();
+    CHECK(small.getConsole(0).getPpu().getFrameCount() == 1);
+    CHECK(small.getConsole(1).getPpu().getFrameCount() == 1);
+  }
+}
+
+TEST_CASE("Batches pass on exceptions from their threads.", "[Nes][BatchRunner]") {
+  std::string path = writeNmiCounterRomFile("batchThrow.nes");
+  BatchRunner::Factory factory = buildFactory(path);
+  auto failing = [&factory](std::size_t index) -> std::unique_ptr<Console> {
+    if(index == 5) {
+      throw Exception::RuntimeException("No Console 5.");
+    }
+    return factory(index);
+  };
+  CHECK_THROWS_AS(BatchRunner(8, failing, 3), Exception::RuntimeException);
+}
+
+TEST_CASE("Benchmark batch scaling across threads.", "[.][benchmark]") {
+  std::string path = writeNmiCounterRomFile("batchBenchmark.nes");
+  const std::size_t consoles = 256;
+  const int frames = 10;
+  std::size_t cores = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  double single = 0.0;
+  for(std::size_t threads = 1; threads <= 64; threads *= 2) {
+    BatchRunner batch(consoles, buildFactory(path), threads);
+    for(int frame = 0; frame < frames; frame++) {
+      batch.runFrame();
+    }
+    double rate = batch.getFramesPerSecond();
+    if(threads == 1) {
+      single = rate;
+    }
+    // Efficiency is measured against the cores actually available.
+    double efficiency = rate / (single * std::min(threads, cores));
+    WARN(threads << " threads: " << rate << " frames per second, "
+        << 100.0 * efficiency << "% efficient, " << batch.getStealCount() << " steals");
+  }
+}
@@ -23,6 +23,8 @@
 #include "nes/Cartridge.h"
 #include "nes/CartridgeBuilder.h"
 
+#include "RomFile.h"
+
 using namespace Nes;
 
 TEST_CASE("Building Cartridges from Rom files works correctly.",
@@ -57,3 +59,40 @@ TEST_CASE("Building Cartridges from Rom files works correctly.",
 
   } 
 }
+
+TEST_CASE("NRom cartridges map their PRG ROMs through the page table.",
+    "[Nes][Cartridge][NRom]") {
+  CartridgeBuilder builder;
+
+  SECTION("NROM-256 maps both PRG ROMs") {
+    builder.setInputFile(writeRomFile("nrom256.nes", 2, 1));
+    auto cartridgePtr = builder.build();
+    auto& mapper = cartridgePtr->getMapper();
+
+    // Nothing on the cartridge is below 0x6000.
+    CHECK(mapper.mapToHardware({0x1000}) == nullptr);
+    // Each 16kB window holds a different bank.
+    auto lowerPtr = mapper.mapToHardware({0x8000});
+    auto upperPtr = mapper.mapToHardware({0xC000});
+    CHECK(lowerPtr != upperPtr);
+    CHECK(mapper.mapToHardware({0xBFFF}) == lowerPtr);
+    CHECK(mapper.mapToHardware({0xFFFF}) == upperPtr);
+    CHECK(lowerPtr->read(lowerPtr->getIndex({0xA000})) == 1);
+    CHECK(upperPtr->read(upperPtr->getIndex({0xE000})) == 3);
+  }
+
+  SECTION("NROM-128 mirrors its PRG ROM into the upper window") {
+    builder.setInputFile(writeRomFile("nrom128.nes", 1, 1));
+    auto cartridgePtr = builder.build();
+    auto& mapper = cartridgePtr->getMapper();
+
+    auto lowerPtr = mapper.mapToHardware({0x8000});
+    auto upperPtr = mapper.mapToHardware({0xC000});
+    CHECK(lowerPtr->getBaseAddress().val == 0x8000);
+    CHECK(upperPtr->getBaseAddress().val == 0xC000);
+    // The same bank is visible through both windows.
+    CHECK(upperPtr->getIndex({0xC123}) == lowerPtr->getIndex({0x8123}));
+    CHECK(lowerPtr->read(lowerPtr->getIndex({0xA000})) == 1);
+    CHECK(upperPtr->read(upperPtr->getIndex({0xE000})) == 1);
+  }
+}
@@ -0,0 +1,317 @@
+//===-- tests/nes/TestConsole.cpp - Console Test ----------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the Console class
+///
+//===----------------------------------------------------------------------===//
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/CommonException.h"
+#include "common/structures/StructureException.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Console.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Build a Console running a program that enables NMI and rendering, counts
+/// NMIs in $10 and then spins. Every vector points at the program, so each
+/// NMI runs it again.
+static std::unique_ptr<Console> buildNmiCounter(const std::string& name) {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeNmiCounterRomFile(name));
+  return std::unique_ptr<Console>(new Console(builder.build()));
+}
+
+TEST_CASE("The Console delivers one NMI per frame.", "[Nes][Console]") {
+  auto consolePtr = buildNmiCounter("consoleNmi.nes");
+  // A frame completes as vblank starts, before the Cpu takes the NMI.
+  consolePtr->runFrame();
+  CHECK(consolePtr->getPpu().getFrameCount() == 1);
+  CHECK(consolePtr->getBus().getRam().read(0x10) == 1);
+  consolePtr->runFrame();
+  consolePtr->runFrame();
+  CHECK(consolePtr->getPpu().getFrameCount() == 3);
+  CHECK(consolePtr->getBus().getRam().read(0x10) == 3);
+}
+
+/// Count the Cpu cycles a program takes to increment $10, after filling
+/// page $02 with a pattern for it to copy to OAM.
+static std::size_t countCyclesToIncrement(const std::string& name,
+    const std::vector<byte>& program) {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeProgramRomFile(name, program));
+  Console console(builder.build());
+  for(std::size_t i = 0; i < 0x100; i++) {
+    console.getBus().getRam().write(0x200 + i, static_cast<byte>(i ^ 0xA5));
+  }
+  std::size_t cycles = 0;
+  while(console.getBus().getRam().read(0x10) == 0 && cycles < 10000) {
+    console.step();
+    cycles++;
+  }
+  // OAMADDR starts at 0, so OAM is a straight copy of the page.
+  bool copied = true;
+  for(std::size_t i = 0; i < 0x100; i++) {
+    copied &= console.getPpu().getOam()[i] == (i ^ 0xA5);
+  }
+  CHECK(copied);
+  return cycles;
+}
+
+TEST_CASE("OAM DMA copies a page and halts the Cpu.", "[Nes][Console]") {
+  // LDA #$02; STA $4014; INC $10; JMP $8007. The DMA starts on an even
+  // cycle, after 2 + 4 cycles, and INC writes in its first cycle here.
+  CHECK(countCyclesToIncrement("consoleDmaEven.nes", {
+    Cpu::Op::LDA_IMMED, 0x02,
+    Cpu::Op::STA_ABS, 0x14, 0x40,
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::JMP_ABS, 0x07, 0x80
+  }) == 6 + Console::OAM_DMA_CYCLES + 1);
+  // LDX #$02; STX $20; STX $4014 ... takes an extra cycle to line up, as it
+  // starts after 2 + 3 + 4 cycles.
+  CHECK(countCyclesToIncrement("consoleDmaOdd.nes", {
+    Cpu::Op::LDX_IMMED, 0x02,
+    Cpu::Op::STX_ZPG, 0x20,
+    Cpu::Op::STX_ABS, 0x14, 0x40,
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::JMP_ABS, 0x09, 0x80
+  }) == 9 + Console::OAM_DMA_CYCLES + 1 + 1);
+}
+
+TEST_CASE("Resetting the Console abandons OAM DMA.", "[Nes][Console]") {
+  // LDA #$02; STA $4014; INC $10; JMP $8007, reset between instructions,
+  // with the DMA pending, and partway through it, on even and odd cycles.
+  // From a reset it always takes the cycles it takes from power on.
+  CartridgeBuilder builder;
+  builder.setInputFile(writeProgramRomFile("consoleDmaReset.nes", {
+    Cpu::Op::LDA_IMMED, 0x02,
+    Cpu::Op::STA_ABS, 0x14, 0x40,
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::JMP_ABS, 0x07, 0x80
+  }));
+  for(std::size_t resetAt : {2, 6, 7, 100, 301}) {
+    Console console(builder.build());
+    for(std::size_t cycle = 0; cycle < resetAt; cycle++) {
+      console.step();
+    }
+    console.reset();
+    std::size_t cycles = 0;
+    while(console.getBus().getRam().read(0x10) == 0 && cycles < 10000) {
+      console.step();
+      cycles++;
+    }
+    CHECK(cycles == 6 + Console::OAM_DMA_CYCLES + 1);
+  }
+}
+
+/// Record what a Console does over a few frames: its RAM after each, and
+/// OAM and the frame count at the end.
+static std::vector<byte> recordFrames(Console& console) {
+  std::vector<byte> trace;
+  for(int frame = 0; frame < 3; frame++) {
+    console.runFrame();
+    const byte* ram = console.getBus().getRam().getStorage();
+    trace.insert(trace.end(), ram, ram + 0x800);
+  }
+  const std::array<byte, 0x100>& oam = console.getPpu().getOam();
+  trace.insert(trace.end(), oam.begin(), oam.end());
+  trace.push_back(static_cast<byte>(console.getPpu().getFrameCount()));
+  return trace;
+}
+
+TEST_CASE("Loading a saved state resumes the machine exactly.", "[Nes][Console]") {
+  auto consolePtr = buildNmiCounter("consoleState.nes");
+  consolePtr->runFrame();
+  // Save mid frame, not just on a frame boundary.
+  for(int i = 0; i < 1000; i++) {
+    consolePtr->step();
+  }
+  std::vector<byte> state;
+  consolePtr->saveState(state);
+  std::vector<byte> expected = recordFrames(*consolePtr);
+  consolePtr->loadState(state);
+  CHECK(recordFrames(*consolePtr) == expected);
+
+  // A state can also be loaded into a new Console with the same ROM.
+  auto otherPtr = buildNmiCounter("consoleState.nes");
+  otherPtr->loadState(state);
+  CHECK(recordFrames(*otherPtr) == expected);
+}
+
+TEST_CASE("Saved states are rejected if they do not match.", "[Nes][Console]") {
+  auto consolePtr = buildNmiCounter("consoleStateA.nes");
+  std::vector<byte> state;
+  consolePtr->saveState(state);
+
+  // A different ROM hashes differently.
+  CartridgeBuilder builder;
+  builder.setInputFile(writeProgramRomFile("consoleStateB.nes", {Cpu::Op::JMP_ABS, 0x00, 0x80}));
+  Console other(builder.build());
+  CHECK_THROWS_AS(other.loadState(state), Exception::InvalidFormatException);
+
+  std::vector<byte> corrupt = state;
+  corrupt[4]++;
+  CHECK_THROWS_AS(consolePtr->loadState(corrupt), Exception::InvalidFormatException);
+  corrupt = state;
+  corrupt.pop_back();
+  CHECK_THROWS_AS(consolePtr->loadState(corrupt), Exception::StructureException);
+  corrupt = state;
+  corrupt.push_back(0);
+  CHECK_THROWS_AS(consolePtr->loadState(corrupt), Exception::InvalidFormatException);
+}
+
+TEST_CASE("A rejected state leaves the machine as it was.", "[Nes][Console]") {
+  auto consolePtr = buildNmiCounter("consoleStateRollback.nes");
+  consolePtr->runFrame();
+  std::vector<byte> earlier;
+  consolePtr->saveState(earlier);
+  for(int frame = 0; frame < 5; frame++) {
+    consolePtr->runFrame();
+  }
+  std::vector<byte> current;
+  consolePtr->saveState(current);
+  REQUIRE(earlier != current);
+
+  // Cut short partway through, and with a byte left over once every part
+  // of the machine has been read.
+  std::vector<byte> truncated(earlier.begin(), earlier.begin() + earlier.size() / 2);
+  CHECK_THROWS_AS(consolePtr->loadState(truncated), Exception::StructureException);
+  std::vector<byte> state;
+  consolePtr->saveState(state);
+  CHECK(state == current);
+  std::vector<byte> overlong = earlier;
+  overlong.push_back(0);
+  CHECK_THROWS_AS(consolePtr->loadState(overlong), Exception::InvalidFormatException);
+  consolePtr->saveState(state);
+  CHECK(state == current);
+  CHECK(consolePtr->getBus().getRam().read(0x10) == 6);
+}
+
+/// Build a Console running a program that plays a pulse tone, sweeping its
+/// pitch as fast as it can.
+static std::unique_ptr<Console> buildToneSweep(const std::string& name) {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeToneSweepRomFile(name));
+  return std::unique_ptr<Console>(new Console(builder.build()));
+}
+
+TEST_CASE("Saved states stay small, and repeat for the same machine.", "[Nes][Console]") {
+  auto consolePtr = buildToneSweep("consoleStateTone.nes");
+  auto otherPtr = buildToneSweep("consoleStateTone.nes");
+  for(int frame = 0; frame < 60; frame++) {
+    consolePtr->runFrame();
+    otherPtr->runFrame();
+  }
+  std::vector<byte> early;
+  consolePtr->saveState(early);
+  std::vector<byte> other;
+  otherPtr->saveState(other);
+  CHECK(early == other);
+
+  // Audio nobody takes is not kept, so the state holds at most a frame and
+  // a bit of it however long the machine runs.
+  for(int frame = 0; frame < 240; frame++) {
+    consolePtr->runFrame();
+  }
+  std::vector<byte> late;
+  consolePtr->saveState(late);
+  CHECK(late.size() < early.size() + 800 * sizeof(float));
+
+  // A headless Apu saves no audio at all.
+  consolePtr->getApu().setHeadless(true);
+  std::vector<byte> headless;
+  consolePtr->saveState(headless);
+  CHECK(headless.size() + 800 * sizeof(float) < late.size());
+}
+
+TEST_CASE("Benchmark saving and loading states.", "[.][benchmark]") {
+  auto consolePtr = buildNmiCounter("consoleStateBenchmark.nes");
+  consolePtr->runFrame();
+  std::vector<byte> state;
+  const int repeats = 1000;
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < repeats; i++) {
+    consolePtr->saveState(state);
+  }
+  std::chrono::duration<double, std::micro> saving = std::chrono::steady_clock::now() - start;
+  start = std::chrono::steady_clock::now();
+  for(int i = 0; i < repeats; i++) {
+    consolePtr->loadState(state);
+  }
+  std::chrono::duration<double, std::micro> loading = std::chrono::steady_clock::now() - start;
+  WARN(state.size() << " byte states: " << saving.count() / repeats << "us to save, "
+      << loading.count() / repeats << "us to load");
+}
+
+TEST_CASE("A cloned Console runs on exactly as the original.", "[Nes][Console]") {
+  auto consolePtr = buildNmiCounter("consoleClone.nes");
+  consolePtr->runFrame();
+  for(int i = 0; i < 1000; i++) {
+    consolePtr->step();
+  }
+  consolePtr->getPpu().setHeadless(true);
+  auto clonePtr = consolePtr->clone();
+  CHECK(clonePtr->getPpu().isHeadless());
+
+  // The clone shares the ROM, but not the RAM.
+  REQUIRE(consolePtr->getBus().getPageData(0x80) != nullptr);
+  CHECK(clonePtr->getBus().getPageData(0x80) == consolePtr->getBus().getPageData(0x80));
+  CHECK(&clonePtr->getBus().getRam() != &consolePtr->getBus().getRam());
+
+  std::vector<byte> cloneFrames = recordFrames(*clonePtr);
+  CHECK(recordFrames(*consolePtr) == cloneFrames);
+
+  // Writes to the clone are not seen by the original.
+  byte count = consolePtr->getBus().getRam().read(0x10);
+  clonePtr->getBus().getRam().write(0x10, count + 1);
+  CHECK(consolePtr->getBus().getRam().read(0x10) == count);
+}
+
+TEST_CASE("Benchmark cloning a Console.", "[.][benchmark]") {
+  auto consolePtr = buildNmiCounter("consoleCloneBenchmark.nes");
+  consolePtr->runFrame();
+  const int repeats = 1000;
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < repeats; i++) {
+    auto clonePtr = consolePtr->clone();
+  }
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  WARN(elapsed.count() / repeats << "us to clone a Console");
+}
+
+/// Run frames as fast as possible, and report the frame rate.
+static void benchmarkFrames(Console& console, const std::string& mode) {
+  const int frames = 600;
+  auto start = std::chrono::steady_clock::now();
+  for(int frame = 0; frame < frames; frame++) {
+    console.runFrame();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  WARN(mode << ": " << frames << " frames at " << frames / elapsed.count()
+      << " frames per second");
+}
+
+TEST_CASE("Benchmark headless frames per second.", "[.][benchmark]") {
+  auto consolePtr = buildNmiCounter("consoleBenchmark.nes");
+  std::vector<byte> framebuffer(Ppu::WIDTH * Ppu::HEIGHT);
+  consolePtr->getPpu().setFramebuffer(framebuffer.data());
+  benchmarkFrames(*consolePtr, "Rendering to memory");
+  consolePtr->getPpu().setHeadless(true);
+  benchmarkFrames(*consolePtr, "Headless mode");
+}
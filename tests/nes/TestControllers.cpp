@@ -0,0 +1,84 @@
+//===-- tests/nes/TestControllers.cpp - Controllers Test --------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the Controllers class
+///
+//===----------------------------------------------------------------------===//
+
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/structures/StateBuffer.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Controllers.h"
+#include "nes/CpuBus.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Read the buttons of a controller out a bit at a time, after a strobe.
+static byte readButtons(const CpuBus& bus, Vaddr vaddr) {
+  byte buttons = 0;
+  for(int button = 0; button < 8; button++) {
+    buttons |= (busRead(bus, vaddr) & 0x01) << button;
+  }
+  return buttons;
+}
+
+TEST_CASE("Controllers shift their buttons out after a strobe.", "[Nes][Controllers]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("controllers.nes", 1, 1));
+  auto cartridgePtr = builder.build();
+  CpuBus bus(*cartridgePtr);
+  Controllers controllers;
+  controllers.connect(bus);
+  controllers.setButtons(0, Controllers::A | Controllers::START | Controllers::RIGHT);
+  controllers.setButtons(1, Controllers::B | Controllers::UP);
+
+  busWrite(bus, {0x4016}, 0x01);
+  busWrite(bus, {0x4016}, 0x00);
+  CHECK(readButtons(bus, {0x4016}) == 0x89);
+  CHECK(readButtons(bus, {0x4017}) == 0x12);
+
+  SECTION("Reads past the eighth button return 1") {
+    CHECK(busRead(bus, {0x4016}) == 0x41);
+  }
+
+  SECTION("Buttons are latched by the strobe") {
+    busWrite(bus, {0x4016}, 0x01);
+    busWrite(bus, {0x4016}, 0x00);
+    controllers.setButtons(0, 0);
+    CHECK(readButtons(bus, {0x4016}) == 0x89);
+  }
+
+  SECTION("Reads while strobed return A") {
+    busWrite(bus, {0x4016}, 0x01);
+    CHECK(busRead(bus, {0x4016}) == 0x41);
+    CHECK(busRead(bus, {0x4016}) == 0x41);
+    CHECK(busRead(bus, {0x4017}) == 0x40);
+  }
+
+  SECTION("The shift registers are saved") {
+    busWrite(bus, {0x4016}, 0x01);
+    busWrite(bus, {0x4016}, 0x00);
+    busRead(bus, {0x4016});
+    std::vector<byte> state;
+    Structure::StateWriter writer(state);
+    controllers.saveState(writer);
+    readButtons(bus, {0x4016});
+    Structure::StateReader reader(state.data(), state.size());
+    controllers.loadState(reader);
+    CHECK(readButtons(bus, {0x4016}) == 0xC4);
+  }
+}
@@ -0,0 +1,55 @@
+//===-- tests/nes/TestCpu2A03.cpp - Cpu2A03 Test ----------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the Cpu2A03 type
+///
+//===----------------------------------------------------------------------===//
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/Cartridge.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Cpu2A03.h"
+#include "nes/CpuBus.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+TEST_CASE("The Cpu2A03 runs cartridge programs through the CpuBus.",
+    "[Nes][Cpu2A03]") {
+  // LDA #$42; STA $0200; LDX #$07; STX $2001; JMP $800A
+  std::vector<byte> program = {
+    Cpu::Op::LDA_IMMED, 0x42,
+    Cpu::Op::STA_ABS, 0x00, 0x02,
+    Cpu::Op::LDX_IMMED, 0x07,
+    Cpu::Op::STX_ABS, 0x01, 0x20,
+    Cpu::Op::JMP_ABS, 0x0A, 0x80
+  };
+  CartridgeBuilder builder;
+  builder.setInputFile(writeProgramRomFile("cpu2A03.nes", program));
+  auto cartridgePtr = builder.build();
+  CpuBus bus(*cartridgePtr);
+  byte ppuMask = 0;
+  bus.setWriteHandler({0x2001}, [&ppuMask](std::size_t, byte data) {
+    ppuMask = data;
+  });
+
+  Cpu2A03 cpu(bus);
+  cpu.reset();
+  // The program takes 13 cycles before it starts looping.
+  for(int cycle = 0; cycle < 13; cycle++) {
+    cpu.step();
+  }
+  CHECK(bus.getRam().read(0x200) == 0x42);
+  CHECK(ppuMask == 0x07);
+}
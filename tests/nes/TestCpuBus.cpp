@@ -0,0 +1,97 @@
+//===-- tests/nes/TestCpuBus.cpp - CpuBus Test ------------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the CpuBus class
+///
+//===----------------------------------------------------------------------===//
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/BaseException.h"
+#include "nes/Cartridge.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/CpuBus.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+TEST_CASE("The CpuBus maps the whole Cpu address space.", "[Nes][CpuBus]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("cpuBus.nes", 2, 1));
+  auto cartridgePtr = builder.build();
+  CpuBus bus(*cartridgePtr);
+  REQUIRE(bus.getName() == "CpuBus");
+
+  SECTION("Internal RAM is mirrored through $0000-$1FFF") {
+    busWrite(bus, {0x0123}, 0x5A);
+    CHECK(busRead(bus, {0x0923}) == 0x5A);
+    CHECK(busRead(bus, {0x1123}) == 0x5A);
+    CHECK(busRead(bus, {0x1923}) == 0x5A);
+    CHECK(bus.getRam().read(0x123) == 0x5A);
+  }
+
+  SECTION("PPU registers are mirrored through $2000-$3FFF") {
+    byte written = 0;
+    bus.setWriteHandler({0x2006}, [&written](std::size_t, byte data) {
+      written = data;
+    });
+    bus.setReadHandler({0x3FFA}, [](std::size_t index) -> byte {
+      return static_cast<byte>(0xA0 + index);
+    });
+    busWrite(bus, {0x3F0E}, 0x77);
+    CHECK(written == 0x77);
+    CHECK(busRead(bus, {0x2002}) == 0xA2);
+    CHECK(bus.mapToHardware({0x2000}) == bus.mapToHardware({0x3FF8}));
+  }
+
+  SECTION("APU/IO registers dispatch through the $4000 page") {
+    std::size_t lastIndex = 0;
+    bus.setWriteHandler({0x4014}, [&lastIndex](std::size_t index, byte) {
+      lastIndex = index;
+    });
+    busWrite(bus, {0x4014}, 0x02);
+    CHECK(lastIndex == 0x14);
+  }
+
+  SECTION("Only I/O registers take handlers") {
+    CHECK_THROWS_AS(bus.setReadHandler({0x0000}, nullptr), Exception::BaseException);
+    CHECK_THROWS_AS(bus.setWriteHandler({0x4020}, nullptr), Exception::BaseException);
+    CHECK_THROWS_AS(bus.setWriteHandler({0x8000}, nullptr), Exception::BaseException);
+  }
+
+  SECTION("Cartridge space is delegated to the CartridgeMapper") {
+    auto& mapper = cartridgePtr->getMapper();
+    CHECK(bus.mapToHardware({0x6000}) == mapper.mapToHardware({0x6000}));
+    CHECK(bus.mapToHardware({0x8000}) == mapper.mapToHardware({0x8000}));
+    CHECK(bus.mapToHardware({0xFFFF}) == mapper.mapToHardware({0xFFFF}));
+    CHECK(busRead(bus, {0xA000}) == 1);
+    CHECK(busRead(bus, {0xE000}) == 3);
+  }
+
+  SECTION("Unmapped addresses read back open bus") {
+    auto bankPtr = bus.mapToHardware({0x5000});
+    REQUIRE(bankPtr != nullptr);
+    busWrite(bus, {0x5000}, 0x40);
+    CHECK(busRead(bus, {0x5800}) == 0x40);
+  }
+
+  SECTION("The APU/IO page past $401F is cartridge space, not registers") {
+    auto& mapper = cartridgePtr->getMapper();
+    CHECK(bus.mapToHardware({0x401F}) != mapper.mapToHardware({0x401F}));
+    CHECK(bus.mapToHardware({0x4020}) != bus.mapToHardware({0x401F}));
+    busWrite(bus, {0x4015}, 0x0F);
+    busWrite(bus, {0x4020}, 0x40);
+    CHECK(busRead(bus, {0x40FF}) == 0x40);
+    CHECK(busRead(bus, {0x4015}) == 0x0F);
+  }
+}
@@ -0,0 +1,92 @@
+//===-- tests/nes/TestFrameSink.cpp - FrameSink Test ------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the FrameSink class
+///
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/FrameSink.h"
+
+using namespace Nes;
+
+TEST_CASE("FrameSink counts dropped and duplicated frames.", "[Nes][FrameSink]") {
+  FrameSink sink(16);
+  CHECK(sink.acquire() == nullptr);
+  CHECK(sink.getDuplicatedCount() == 0);
+
+  sink.getBackBuffer()[0] = 1;
+  sink.publish();
+  sink.getBackBuffer()[0] = 2;
+  sink.publish();
+  CHECK(sink.getPublishedCount() == 2);
+  CHECK(sink.getDroppedCount() == 1);
+
+  const FrameSink::Frame* frame = sink.acquire();
+  REQUIRE(frame != nullptr);
+  CHECK(frame->number == 2);
+  CHECK(frame->pixels[0] == 2);
+  // The producer never draws into the frame the consumer holds.
+  CHECK(sink.getBackBuffer() != frame->pixels.data());
+
+  CHECK(sink.acquire() == frame);
+  CHECK(sink.getDuplicatedCount() == 1);
+
+  sink.getBackBuffer()[0] = 3;
+  sink.publish();
+  CHECK(sink.getBackBuffer() != frame->pixels.data());
+  frame = sink.acquire();
+  CHECK(frame->number == 3);
+  CHECK(frame->pixels[0] == 3);
+  CHECK(sink.getDroppedCount() == 1);
+
+  auto histogram = sink.getLatencyHistogram();
+  CHECK(std::accumulate(histogram.begin(), histogram.end(), std::uint64_t(0)) == 2);
+}
+
+TEST_CASE("FrameSink hands whole frames between threads.", "[Nes][FrameSink]") {
+  const std::uint64_t frames = 20000;
+  FrameSink sink(4096);
+  std::thread producer([&] {
+    for(std::uint64_t number = 1; number <= frames; number++) {
+      std::fill_n(sink.getBackBuffer(), 4096, static_cast<byte>(number));
+      sink.publish();
+    }
+  });
+  std::uint64_t taken = 0;
+  std::uint64_t lastNumber = 0;
+  bool ordered = true;
+  bool whole = true;
+  while(lastNumber < frames) {
+    const FrameSink::Frame* frame = sink.acquire();
+    if(frame == nullptr || frame->number == lastNumber) {
+      continue;
+    }
+    taken++;
+    ordered = ordered && frame->number > lastNumber;
+    lastNumber = frame->number;
+    byte expected = static_cast<byte>(frame->number);
+    whole = whole && std::all_of(frame->pixels.begin(), frame->pixels.end(),
+        [expected](byte pixel) { return pixel == expected; });
+  }
+  producer.join();
+  CHECK(ordered);
+  CHECK(whole);
+  CHECK(taken + sink.getDroppedCount() == frames);
+  auto histogram = sink.getLatencyHistogram();
+  CHECK(std::accumulate(histogram.begin(), histogram.end(), std::uint64_t(0)) == taken);
+}
@@ -0,0 +1,228 @@
+//===-- tests/nes/TestMappers.cpp - Cartridge Mapper Test -------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the bank switching cartridge mappers
+///
+//===----------------------------------------------------------------------===//
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/BaseException.h"
+#include "nes/Cartridge.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/CartridgeMapper.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Read the PRG byte at an address. Synthetic roms hold the index of the 8kB
+/// PRG chunk in every byte of it.
+static byte prgRead(const CartridgeMapper& mapper, Vaddr vaddr) {
+  auto bankPtr = mapper.mapToHardware(vaddr);
+  return bankPtr->read(bankPtr->getIndex(vaddr));
+}
+
+/// Read the CHR byte at an address. Synthetic roms hold the index of the 1kB
+/// CHR chunk in every byte of it.
+static byte chrRead(const CartridgeMapper& mapper, Vaddr vaddr) {
+  auto bankPtr = mapper.mapChrToHardware(vaddr);
+  return bankPtr->read(bankPtr->getIndex(vaddr));
+}
+
+/// Write a mapper register, as the Cpu would.
+static void registerWrite(const CartridgeMapper& mapper, Vaddr vaddr, byte data) {
+  auto bankPtr = mapper.mapToHardware(vaddr);
+  bankPtr->write(bankPtr->getIndex(vaddr), data);
+}
+
+/// Load an MMC1 register through the serial port, low bit first.
+static void mmc1Write(const CartridgeMapper& mapper, Vaddr vaddr, byte data) {
+  for(int bit = 0; bit < 5; bit++) {
+    registerWrite(mapper, vaddr, (data >> bit) & 0x01);
+  }
+}
+
+TEST_CASE("Bank switched windows repoint without touching the page table.",
+    "[Nes][CartridgeMapper]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("uxromWindows.nes", 8, 0, 2));
+  auto cartridgePtr = builder.build();
+  auto& mapper = cartridgePtr->getMapper();
+  auto pageTable = mapper.getPageTable();
+
+  registerWrite(mapper, {0x8000}, 5);
+  CHECK(mapper.getPageTable() == pageTable);
+  CHECK(prgRead(mapper, {0x8000}) == 10);
+}
+
+TEST_CASE("NRom cartridges without CHR ROM get CHR RAM.", "[Nes][NRom]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("nromChrRam.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  auto& mapper = cartridgePtr->getMapper();
+
+  auto bankPtr = mapper.mapChrToHardware({0x1234});
+  REQUIRE(bankPtr->getSize() == 0x2000);
+  bankPtr->write(bankPtr->getIndex({0x1234}), 0x99);
+  CHECK(chrRead(mapper, {0x1234}) == 0x99);
+  // Writing PRG ROM space is still a write to ROM.
+  CHECK_THROWS_AS(registerWrite(mapper, {0x8000}, 0), Exception::BaseException);
+}
+
+TEST_CASE("UxRom switches the 16kB bank at $8000.", "[Nes][UxRom]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("uxrom.nes", 8, 0, 2));
+  auto cartridgePtr = builder.build();
+  auto& mapper = cartridgePtr->getMapper();
+  REQUIRE(mapper.getName() == "UxRom");
+
+  // Bank 0 starts at $8000, the last bank is fixed at $C000.
+  CHECK(prgRead(mapper, {0x8000}) == 0);
+  CHECK(prgRead(mapper, {0xC000}) == 14);
+  CHECK(prgRead(mapper, {0xE000}) == 15);
+
+  registerWrite(mapper, {0xFFF0}, 3);
+  CHECK(prgRead(mapper, {0x8000}) == 6);
+  CHECK(prgRead(mapper, {0xA000}) == 7);
+  CHECK(prgRead(mapper, {0xC000}) == 14);
+
+  // Banks past the end wrap around.
+  registerWrite(mapper, {0x8000}, 9);
+  CHECK(prgRead(mapper, {0x8000}) == 2);
+}
+
+TEST_CASE("CnRom switches the 8kB CHR bank.", "[Nes][CnRom]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("cnrom.nes", 2, 4, 3));
+  auto cartridgePtr = builder.build();
+  auto& mapper = cartridgePtr->getMapper();
+  REQUIRE(mapper.getName() == "CnRom");
+
+  CHECK(chrRead(mapper, {0x0000}) == 0);
+  registerWrite(mapper, {0x8000}, 2);
+  CHECK(chrRead(mapper, {0x0000}) == 16);
+  CHECK(chrRead(mapper, {0x1C00}) == 23);
+  CHECK(mapper.getChrOffset(0x1C10) == 2 * 0x2000 + 0x1C10);
+  CHECK(mapper.getChrSize() == 4 * 0x2000);
+  // PRG ROM is fixed.
+  CHECK(prgRead(mapper, {0xC000}) == 2);
+}
+
+TEST_CASE("Mmc1 loads its registers serially.", "[Nes][Mmc1]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("mmc1.nes", 8, 4, 1));
+  auto cartridgePtr = builder.build();
+  auto& mapper = cartridgePtr->getMapper();
+  REQUIRE(mapper.getName() == "Mmc1");
+
+  SECTION("The last bank starts out fixed at $C000") {
+    CHECK(prgRead(mapper, {0x8000}) == 0);
+    CHECK(prgRead(mapper, {0xC000}) == 14);
+    mmc1Write(mapper, {0xE000}, 2);
+    CHECK(prgRead(mapper, {0x8000}) == 4);
+    CHECK(prgRead(mapper, {0xC000}) == 14);
+  }
+
+  SECTION("Partial writes do not switch banks") {
+    registerWrite(mapper, {0xE000}, 1);
+    registerWrite(mapper, {0xE000}, 1);
+    CHECK(prgRead(mapper, {0x8000}) == 0);
+    // Bit 7 resets the shift register, so a full load still works.
+    registerWrite(mapper, {0xE000}, 0x80);
+    mmc1Write(mapper, {0xE000}, 1);
+    CHECK(prgRead(mapper, {0x8000}) == 2);
+  }
+
+  SECTION("32kB PRG mode switches both windows") {
+    mmc1Write(mapper, {0x8000}, 0x00);
+    mmc1Write(mapper, {0xE000}, 5);
+    CHECK(prgRead(mapper, {0x8000}) == 8);
+    CHECK(prgRead(mapper, {0xC000}) == 10);
+    CHECK(mapper.getMirroring() == Mirroring::SINGLE_SCREEN_LOWER);
+  }
+
+  SECTION("$8000 fixed PRG mode and 4kB CHR mode") {
+    mmc1Write(mapper, {0x8000}, 0x1A);
+    mmc1Write(mapper, {0xE000}, 3);
+    mmc1Write(mapper, {0xA000}, 5);
+    mmc1Write(mapper, {0xC000}, 2);
+    CHECK(prgRead(mapper, {0x8000}) == 0);
+    CHECK(prgRead(mapper, {0xC000}) == 6);
+    CHECK(chrRead(mapper, {0x0000}) == 20);
+    CHECK(chrRead(mapper, {0x1000}) == 8);
+    CHECK(mapper.getMirroring() == Mirroring::VERTICAL);
+  }
+}
+
+TEST_CASE("Mmc3 switches 8kB PRG and 1kB CHR banks and counts scanlines.",
+    "[Nes][Mmc3]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("mmc3.nes", 8, 8, 4));
+  auto cartridgePtr = builder.build();
+  auto& mapper = cartridgePtr->getMapper();
+  REQUIRE(mapper.getName() == "Mmc3");
+
+  SECTION("PRG banks follow R6, R7 and the PRG mode") {
+    registerWrite(mapper, {0x8000}, 6);
+    registerWrite(mapper, {0x8001}, 3);
+    registerWrite(mapper, {0x8000}, 7);
+    registerWrite(mapper, {0x8001}, 9);
+    CHECK(prgRead(mapper, {0x8000}) == 3);
+    CHECK(prgRead(mapper, {0xA000}) == 9);
+    CHECK(prgRead(mapper, {0xC000}) == 14);
+    CHECK(prgRead(mapper, {0xE000}) == 15);
+
+    // Swap the R6 window with the second last bank.
+    registerWrite(mapper, {0x8000}, 0x40);
+    CHECK(prgRead(mapper, {0x8000}) == 14);
+    CHECK(prgRead(mapper, {0xC000}) == 3);
+    CHECK(prgRead(mapper, {0xE000}) == 15);
+  }
+
+  SECTION("CHR banks follow R0-R5 and the CHR inversion") {
+    registerWrite(mapper, {0x8000}, 0);
+    registerWrite(mapper, {0x8001}, 11);
+    registerWrite(mapper, {0x8000}, 5);
+    registerWrite(mapper, {0x8001}, 33);
+    // 2kB banks ignore the low bit.
+    CHECK(chrRead(mapper, {0x0000}) == 10);
+    CHECK(chrRead(mapper, {0x0400}) == 11);
+    CHECK(chrRead(mapper, {0x1C00}) == 33);
+
+    registerWrite(mapper, {0x8000}, 0x80);
+    CHECK(chrRead(mapper, {0x1000}) == 10);
+    CHECK(chrRead(mapper, {0x1400}) == 11);
+    CHECK(chrRead(mapper, {0x0C00}) == 33);
+  }
+
+  SECTION("Mirroring is selected at $A000") {
+    registerWrite(mapper, {0xA000}, 1);
+    CHECK(mapper.getMirroring() == Mirroring::HORIZONTAL);
+    registerWrite(mapper, {0xA000}, 0);
+    CHECK(mapper.getMirroring() == Mirroring::VERTICAL);
+  }
+
+  SECTION("The scanline counter raises an IRQ when it reaches zero") {
+    registerWrite(mapper, {0xC000}, 2);
+    registerWrite(mapper, {0xC001}, 0);
+    registerWrite(mapper, {0xE001}, 0);
+    mapper.clockScanline();
+    mapper.clockScanline();
+    CHECK_FALSE(mapper.isIrqAsserted());
+    mapper.clockScanline();
+    CHECK(mapper.isIrqAsserted());
+    // Disabling acknowledges the IRQ.
+    registerWrite(mapper, {0xE000}, 0);
+    CHECK_FALSE(mapper.isIrqAsserted());
+  }
+}
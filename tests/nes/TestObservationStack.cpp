@@ -0,0 +1,181 @@
+//===-- tests/nes/TestObservationStack.cpp - Observation Test ---*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the ObservationStack class
+///
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/structures/StructureException.h"
+#include "nes/ObservationStack.h"
+#include "nes/Ppu.h"
+#include "nes/VideoConverter.h"
+
+using namespace Nes;
+
+/// Build a frame of one palette index.
+static std::vector<byte> buildFlatFrame(byte index) {
+  return std::vector<byte>(Ppu::WIDTH * Ppu::HEIGHT, index);
+}
+
+/// Build a frame of every palette index in a scrambled order.
+static std::vector<byte> buildFrame() {
+  std::vector<byte> frame(Ppu::WIDTH * Ppu::HEIGHT);
+  for(std::size_t pixel = 0; pixel < frame.size(); pixel++) {
+    frame[pixel] = static_cast<byte>((pixel * 37 + pixel / Ppu::WIDTH * 11) & 0x3F);
+  }
+  return frame;
+}
+
+/// Average the area of a frame under an output pixel, in floating point.
+static double referencePixel(const std::vector<byte>& frame, std::size_t x,
+    std::size_t y, std::size_t width, std::size_t height, std::size_t crop) {
+  VideoConverter converter;
+  std::size_t rows = Ppu::HEIGHT - 2 * crop;
+  double left = static_cast<double>(x) * Ppu::WIDTH / width;
+  double right = static_cast<double>(x + 1) * Ppu::WIDTH / width;
+  double top = static_cast<double>(y) * rows / height;
+  double bottom = static_cast<double>(y + 1) * rows / height;
+  double total = 0.0;
+  for(std::size_t row = static_cast<std::size_t>(top); row < bottom; row++) {
+    double rowWeight = std::min<double>(row + 1, bottom) - std::max<double>(row, top);
+    for(std::size_t column = static_cast<std::size_t>(left); column < right; column++) {
+      double weight = rowWeight
+          * (std::min<double>(column + 1, right) - std::max<double>(column, left));
+      total += weight * converter.getGray(frame[(row + crop) * Ppu::WIDTH + column], 0);
+    }
+  }
+  return total / ((right - left) * (bottom - top));
+}
+
+TEST_CASE("Observations are gray, cropped and downsampled frames.",
+    "[Nes][ObservationStack]") {
+  ObservationStack stack;
+  REQUIRE(stack.getWidth() == 84);
+  REQUIRE(stack.getHeight() == 84);
+  REQUIRE(stack.getDepth() == 4);
+  REQUIRE(stack.getStackSize() == 4 * 84 * 84);
+  VideoConverter converter;
+
+  SECTION("Flat frames keep their level exactly") {
+    for(byte index : {0x0F, 0x00, 0x21, 0x30}) {
+      auto frame = buildFlatFrame(index);
+      stack.push(frame.data(), 0);
+      const byte* observation = stack.getObservation(0);
+      CHECK(std::all_of(observation, observation + 84 * 84, [&](byte gray) {
+        return gray == converter.getGray(index, 0);
+      }));
+    }
+  }
+
+  SECTION("Each pixel is the average of the area under it") {
+    auto frame = buildFrame();
+    stack.push(frame.data(), 0);
+    const byte* observation = stack.getObservation(0);
+    double worst = 0.0;
+    for(std::size_t y = 0; y < 84; y++) {
+      for(std::size_t x = 0; x < 84; x++) {
+        double expected = referencePixel(frame, x, y, 84, 84, ObservationStack::DEFAULT_CROP);
+        worst = std::max(worst, std::abs(observation[y * 84 + x] - expected));
+      }
+    }
+    CHECK(worst <= 1.0);
+  }
+
+  SECTION("Cropped rows are left out") {
+    auto frame = buildFlatFrame(0x0F);
+    std::fill(frame.begin(), frame.begin() + 8 * Ppu::WIDTH, 0x30);
+    std::fill(frame.end() - 8 * Ppu::WIDTH, frame.end(), 0x30);
+    stack.push(frame.data(), 0);
+    const byte* observation = stack.getObservation(0);
+    CHECK(std::all_of(observation, observation + 84 * 84, [](byte gray) {
+      return gray == 0;
+    }));
+  }
+
+  SECTION("Emphasis darkens observations") {
+    auto frame = buildFlatFrame(0x30);
+    stack.push(frame.data(), 0x07);
+    CHECK(stack.getObservation(0)[0] == converter.getGray(0x30, 0x07));
+  }
+}
+
+TEST_CASE("Observations are stacked in a ring.", "[Nes][ObservationStack]") {
+  ObservationStack stack(16, 15, 3, 0, 0);
+  const std::size_t size = 16 * 15;
+  VideoConverter converter;
+  const std::vector<byte> indices = {0x0F, 0x00, 0x10, 0x30};
+  auto first = buildFlatFrame(indices[0]);
+  stack.reset(first.data(), 0);
+  std::vector<byte> copy(stack.getStackSize());
+  stack.copyStack(copy.data());
+  CHECK(std::all_of(copy.begin(), copy.end(), [](byte gray) { return gray == 0; }));
+
+  for(std::size_t push = 1; push < indices.size(); push++) {
+    auto frame = buildFlatFrame(indices[push]);
+    stack.push(frame.data(), 0);
+  }
+  // The newest observation is of the last frame, and the oldest of the one
+  // pushed two before it.
+  for(std::size_t age = 0; age < 3; age++) {
+    CHECK(stack.getObservation(age)[0] == converter.getGray(indices[3 - age], 0));
+  }
+  stack.copyStack(copy.data());
+  for(std::size_t slot = 0; slot < 3; slot++) {
+    CHECK(copy[slot * size] == converter.getGray(indices[slot + 1], 0));
+    CHECK(copy[slot * size + size - 1] == converter.getGray(indices[slot + 1], 0));
+  }
+
+  SECTION("Resetting fills the stack with one observation") {
+    stack.reset(first.data(), 0);
+    stack.copyStack(copy.data());
+    CHECK(std::all_of(copy.begin(), copy.end(), [](byte gray) { return gray == 0; }));
+  }
+}
+
+TEST_CASE("Observation stacks need pixels and rows.", "[Nes][ObservationStack]") {
+  CHECK_THROWS_AS(ObservationStack(0, 84), Exception::StructureException);
+  CHECK_THROWS_AS(ObservationStack(84, 84, 0), Exception::StructureException);
+  CHECK_THROWS_AS(ObservationStack(84, 84, 4, 120, 120), Exception::StructureException);
+  CHECK_THROWS_AS(ObservationStack(84, 84, 4, 8, std::numeric_limits<std::size_t>::max()),
+      Exception::StructureException);
+  // A stack whose size overflows is refused before anything is allocated.
+  std::size_t half = std::size_t(1) << (std::numeric_limits<std::size_t>::digits / 2);
+  CHECK_THROWS_AS(ObservationStack(half, half, 2), Exception::StructureException);
+  // Observations larger than the frame are upsampled.
+  ObservationStack large(512, 480, 1, 0, 0);
+  auto frame = buildFlatFrame(0x30);
+  large.push(frame.data(), 0);
+  CHECK(large.getObservation(0)[512 * 480 - 1] == VideoConverter().getGray(0x30, 0));
+}
+
+TEST_CASE("Benchmark stacking observations.", "[.][benchmark]") {
+  ObservationStack stack;
+  auto frame = buildFrame();
+  std::vector<byte> copy(stack.getStackSize());
+  const int frames = 2000;
+  auto start = std::chrono::steady_clock::now();
+  for(int count = 0; count < frames; count++) {
+    stack.push(frame.data(), 0);
+    stack.copyStack(copy.data());
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  WARN("84x84x4: " << elapsed.count() / frames << " microseconds per frame");
+}
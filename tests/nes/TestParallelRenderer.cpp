@@ -0,0 +1,195 @@
+//===-- tests/nes/TestParallelRenderer.cpp - Renderer Test ------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the ParallelRenderer class
+///
+//===----------------------------------------------------------------------===//
+
+#include <array>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/Cartridge.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/FrameLog.h"
+#include "nes/ParallelRenderer.h"
+#include "nes/Ppu.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Hash a frame with 64 bit FNV-1a.
+static std::uint64_t hashFrame(const std::vector<byte>& frame) {
+  std::uint64_t hash = 0xCBF29CE484222325ull;
+  for(byte pixel : frame) {
+    hash = (hash ^ pixel) * 0x100000001B3ull;
+  }
+  return hash;
+}
+
+/// A deterministic stream of pseudo random bytes.
+class Script {
+  public:
+    Script() : state(12345) {}
+
+    byte next() {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      return static_cast<byte>(state >> 56);
+    }
+
+    std::size_t below(std::size_t limit) {
+      return ((static_cast<std::size_t>(next()) << 8) | next()) % limit;
+    }
+
+  private:
+    std::uint64_t state;
+};
+
+/// Run the Ppu to a dot of the current frame.
+static void runTo(Ppu& ppu, std::size_t time) {
+  std::size_t now = ppu.getScanline() * Ppu::DOTS_PER_SCANLINE + ppu.getDot();
+  ppu.advance(time - now);
+  ppu.catchUp();
+}
+
+/// Write a byte of the Ppu address space through PPUADDR and PPUDATA.
+static void vramWrite(Ppu& ppu, addr address, byte data) {
+  ppu.readRegister(2);
+  ppu.writeRegister(6, address >> 8);
+  ppu.writeRegister(6, address & 0xFF);
+  ppu.writeRegister(7, data);
+}
+
+/// Run a cartridge through frames of pseudo random register accesses, some
+/// of them partway through the visible scanlines, and hash each frame.
+/// Frames are either drawn by the Ppu, or logged and drawn by a renderer.
+/// \param romPath The rom to run.
+/// \param frames Number of frames to hash.
+/// \param renderer The renderer to draw with, or nullptr.
+/// \returns The hash of every frame.
+static std::vector<std::uint64_t> runFrames(const std::string& romPath,
+    std::size_t frames, ParallelRenderer* renderer) {
+  CartridgeBuilder builder;
+  builder.setInputFile(romPath);
+  auto cartridgePtr = builder.build();
+  CartridgeMapper& mapper = cartridgePtr->getMapper();
+  Ppu ppu(mapper);
+  std::array<std::vector<byte>, 2> framebuffers;
+  framebuffers.fill(std::vector<byte>(Ppu::WIDTH * Ppu::HEIGHT));
+  std::array<FrameLog, 2> logs;
+  if(renderer == nullptr) {
+    ppu.setFramebuffer(framebuffers[0].data());
+  }
+  bool switchesChr = mapper.getChrSize() > 0x2000;
+  Script script;
+
+  // Fill CHR RAM, the nametables, palette and OAM with noise.
+  for(addr address = mapper.isChrWritable() ? 0x0000 : 0x2000; address < 0x3000; address++) {
+    vramWrite(ppu, address, script.next());
+  }
+  for(addr address = 0x3F00; address < 0x3F20; address++) {
+    vramWrite(ppu, address, script.next());
+  }
+  ppu.writeRegister(3, 0);
+  for(std::size_t index = 0; index < 0x100; index++) {
+    ppu.writeRegister(4, script.next());
+  }
+  ppu.writeRegister(1, 0x1E);
+
+  std::vector<std::uint64_t> hashes;
+  std::size_t current = 0;
+  // The first frame is not logged.
+  for(std::size_t frame = 0; frame <= frames; frame++) {
+    ppu.writeRegister(0, script.next() & 0x3F);
+    std::vector<std::size_t> times(24);
+    for(auto& time : times) {
+      time = script.below(Ppu::HEIGHT * Ppu::DOTS_PER_SCANLINE);
+    }
+    std::sort(times.begin(), times.end());
+    for(std::size_t time : times) {
+      runTo(ppu, time);
+      byte data = script.next();
+      switch(script.below(switchesChr ? 9 : 8)) {
+        case 0: ppu.writeRegister(5, data); break;
+        case 1: ppu.writeRegister(6, data); break;
+        case 2: ppu.writeRegister(1, (data & 0x17) | 0x08); break;
+        case 3: ppu.writeRegister(0, data & 0x3F); break;
+        case 4: ppu.writeRegister(7, data); break;
+        case 5: ppu.readRegister(2); break;
+        case 6: ppu.readRegister(7); break;
+        case 7: ppu.writeRegister(4, data); break;
+        default: {
+          Memory::Bank<byte>* bank = mapper.mapToHardware({0x8000});
+          bank->write(bank->getIndex({0x8000}), data);
+          break;
+        }
+      }
+    }
+    runTo(ppu, Ppu::VBLANK_SCANLINE * Ppu::DOTS_PER_SCANLINE + 2);
+    if(frame > 0) {
+      if(renderer == nullptr) {
+        hashes.push_back(hashFrame(framebuffers[0]));
+      } else {
+        // Hash the previous frame while this one renders.
+        renderer->render(logs[current], framebuffers[current].data());
+        if(frame > 1) {
+          hashes.push_back(hashFrame(framebuffers[current ^ 1]));
+        }
+        current ^= 1;
+      }
+    }
+    ppu.setFrameLog(renderer != nullptr ? &logs[current] : nullptr);
+    // Reset the scroll for the next frame, then run to its first dot.
+    ppu.readRegister(2);
+    ppu.writeRegister(6, script.next() & 0x0F);
+    ppu.writeRegister(6, script.next());
+    ppu.writeRegister(5, script.next());
+    ppu.writeRegister(5, script.next());
+    ppu.writeRegister(1, 0x1E);
+    runTo(ppu, Ppu::PRE_RENDER_SCANLINE * Ppu::DOTS_PER_SCANLINE);
+    while(ppu.getScanline() != 0) {
+      ppu.advance(1);
+      ppu.catchUp();
+    }
+  }
+  if(renderer != nullptr) {
+    renderer->wait();
+    hashes.push_back(hashFrame(framebuffers[current ^ 1]));
+  }
+  return hashes;
+}
+
+TEST_CASE("Frames rendered in parallel match frames rendered serially.",
+    "[Nes][ParallelRenderer]") {
+  SECTION("CHR ROM, switching banks partway through frames") {
+    std::string romPath = writeRomFile("parallelCnrom.nes", 2, 4, 3);
+    auto serial = runFrames(romPath, 8, nullptr);
+    ParallelRenderer renderer(7);
+    REQUIRE(renderer.getThreadCount() == 7);
+    CHECK(runFrames(romPath, 8, &renderer) == serial);
+    CHECK(std::set<std::uint64_t>(serial.begin(), serial.end()).size() > 1);
+  }
+
+  SECTION("CHR RAM, written partway through frames") {
+    std::string romPath = writeRomFile("parallelNrom.nes", 1, 0);
+    auto serial = runFrames(romPath, 8, nullptr);
+    ParallelRenderer renderer(3);
+    CHECK(runFrames(romPath, 8, &renderer) == serial);
+    ParallelRenderer single(1);
+    CHECK(runFrames(romPath, 8, &single) == serial);
+    CHECK(std::set<std::uint64_t>(serial.begin(), serial.end()).size() > 1);
+  }
+}
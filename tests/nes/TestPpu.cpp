@@ -0,0 +1,347 @@
+//===-- tests/nes/TestPpu.cpp - Ppu Test ------------------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the Ppu class
+///
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/Cartridge.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Ppu.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Write a byte of the Ppu address space through PPUADDR and PPUDATA.
+static void vramWrite(Ppu& ppu, addr address, byte data) {
+  ppu.readRegister(2);
+  ppu.writeRegister(6, address >> 8);
+  ppu.writeRegister(6, address & 0xFF);
+  ppu.writeRegister(7, data);
+}
+
+/// Point v and t back at the top left of the first nametable.
+static void resetScroll(Ppu& ppu) {
+  ppu.readRegister(2);
+  ppu.writeRegister(6, 0x00);
+  ppu.writeRegister(6, 0x00);
+  ppu.writeRegister(5, 0x00);
+  ppu.writeRegister(5, 0x00);
+}
+
+/// Fill CHR RAM tile 1 with colour 1 and tile 2 with colour 3, set up the
+/// palette, and tile the top left nametable with tile 2.
+static void loadTestPattern(Ppu& ppu) {
+  for(addr row = 0; row < 8; row++) {
+    vramWrite(ppu, 0x0010 + row, 0xFF);
+    vramWrite(ppu, 0x0020 + row, 0xFF);
+    vramWrite(ppu, 0x0028 + row, 0xFF);
+  }
+  vramWrite(ppu, 0x3F00, 0x0F);
+  vramWrite(ppu, 0x3F01, 0x16);
+  vramWrite(ppu, 0x3F03, 0x2A);
+  vramWrite(ppu, 0x3F11, 0x30);
+  vramWrite(ppu, 0x2000 + 32 + 2, 0x02);
+}
+
+TEST_CASE("The Ppu raises vblank and NMI at dot 1 of scanline 241.",
+    "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuVblank.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  Ppu ppu(cartridgePtr->getMapper());
+  ppu.writeRegister(0, 0x80);
+
+  // Dots are only counted until the Ppu is caught up.
+  ppu.advance(Ppu::VBLANK_SCANLINE * Ppu::DOTS_PER_SCANLINE + 1);
+  CHECK(ppu.getScanline() == 0);
+  CHECK((ppu.readRegister(2) & Ppu::STATUS_VBLANK) == 0);
+  CHECK(ppu.getScanline() == Ppu::VBLANK_SCANLINE);
+  CHECK_FALSE(ppu.pollNmi());
+
+  ppu.advance(1);
+  CHECK(ppu.isCatchUpDue());
+  ppu.catchUp();
+  CHECK(ppu.pollNmi());
+  CHECK_FALSE(ppu.pollNmi());
+  // Reading PPUSTATUS acknowledges vblank.
+  CHECK((ppu.readRegister(2) & Ppu::STATUS_VBLANK) != 0);
+  CHECK((ppu.readRegister(2) & Ppu::STATUS_VBLANK) == 0);
+}
+
+TEST_CASE("Enabling NMI during vblank raises an NMI.", "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuNmi.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  Ppu ppu(cartridgePtr->getMapper());
+  ppu.advance((Ppu::VBLANK_SCANLINE + 1) * Ppu::DOTS_PER_SCANLINE);
+  ppu.catchUp();
+  CHECK_FALSE(ppu.pollNmi());
+  ppu.writeRegister(0, 0x80);
+  CHECK(ppu.pollNmi());
+}
+
+TEST_CASE("Odd frames are one dot shorter while rendering.", "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuOddFrame.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  Ppu ppu(cartridgePtr->getMapper());
+
+  ppu.advance(Ppu::DOTS_PER_FRAME);
+  ppu.catchUp();
+  CHECK(ppu.getFrameCount() == 1);
+  CHECK(ppu.getScanline() == 0);
+  CHECK(ppu.getDot() == 0);
+
+  ppu.writeRegister(1, 0x08);
+  ppu.advance(Ppu::DOTS_PER_FRAME);
+  ppu.catchUp();
+  CHECK(ppu.getFrameCount() == 2);
+  CHECK(ppu.getDot() == 1);
+}
+
+TEST_CASE("PPUDATA reads are buffered except for the palette.", "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuData.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  Ppu ppu(cartridgePtr->getMapper());
+  vramWrite(ppu, 0x2400, 0x11);
+  vramWrite(ppu, 0x2401, 0x22);
+  vramWrite(ppu, 0x3F10, 0x05);
+
+  ppu.readRegister(2);
+  ppu.writeRegister(6, 0x24);
+  ppu.writeRegister(6, 0x00);
+  ppu.readRegister(7);
+  CHECK(ppu.readRegister(7) == 0x11);
+  CHECK(ppu.readRegister(7) == 0x22);
+
+  // Horizontal mirroring puts $2400 over $2000, and $3F10 mirrors $3F00.
+  ppu.writeRegister(6, 0x20);
+  ppu.writeRegister(6, 0x00);
+  ppu.readRegister(7);
+  CHECK(ppu.readRegister(7) == 0x11);
+  ppu.writeRegister(6, 0x3F);
+  ppu.writeRegister(6, 0x00);
+  CHECK((ppu.readRegister(7) & 0x3F) == 0x05);
+}
+
+TEST_CASE("The Ppu renders the background into the framebuffer.",
+    "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuBackground.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  Ppu ppu(cartridgePtr->getMapper());
+  std::vector<byte> framebuffer(Ppu::WIDTH * Ppu::HEIGHT, 0xFF);
+  ppu.setFramebuffer(framebuffer.data());
+  loadTestPattern(ppu);
+  resetScroll(ppu);
+  ppu.writeRegister(1, 0x0A);
+
+  ppu.advance(Ppu::DOTS_PER_FRAME);
+  ppu.catchUp();
+  // Tile 2 covers pixels (16, 8) to (23, 15), everything else is backdrop.
+  CHECK(framebuffer[8 * Ppu::WIDTH + 16] == 0x2A);
+  CHECK(framebuffer[15 * Ppu::WIDTH + 23] == 0x2A);
+  CHECK(framebuffer[8 * Ppu::WIDTH + 24] == 0x0F);
+  CHECK(framebuffer[7 * Ppu::WIDTH + 16] == 0x0F);
+  CHECK(framebuffer[239 * Ppu::WIDTH + 255] == 0x0F);
+
+  // Scrolling right by 4 pixels moves the tile left.
+  ppu.readRegister(2);
+  ppu.writeRegister(5, 0x04);
+  ppu.writeRegister(5, 0x00);
+  ppu.advance(Ppu::DOTS_PER_FRAME);
+  ppu.catchUp();
+  CHECK(framebuffer[8 * Ppu::WIDTH + 12] == 0x2A);
+  CHECK(framebuffer[8 * Ppu::WIDTH + 20] == 0x0F);
+
+  // Rewriting a row of the tile in CHR RAM shows up in the next frame.
+  vramWrite(ppu, 0x0020, 0x00);
+  vramWrite(ppu, 0x0028, 0x00);
+  resetScroll(ppu);
+  ppu.advance(Ppu::DOTS_PER_FRAME);
+  ppu.catchUp();
+  CHECK(framebuffer[8 * Ppu::WIDTH + 16] == 0x0F);
+  CHECK(framebuffer[9 * Ppu::WIDTH + 16] == 0x2A);
+}
+
+TEST_CASE("Sprite 0 hit is caught up lazily when PPUSTATUS is read.",
+    "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuSpriteZero.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  Ppu ppu(cartridgePtr->getMapper());
+  std::vector<byte> framebuffer(Ppu::WIDTH * Ppu::HEIGHT);
+  ppu.setFramebuffer(framebuffer.data());
+  loadTestPattern(ppu);
+  resetScroll(ppu);
+  // Sprite 0 is drawn from scanline 10 at x = 20, over tile 2.
+  byte sprite[] = {9, 0x01, 0x00, 20};
+  ppu.writeRegister(3, 0x00);
+  for(byte data : sprite) {
+    ppu.writeRegister(4, data);
+  }
+  ppu.writeRegister(1, 0x1E);
+
+  // Dot 21 of scanline 10 outputs pixel 20.
+  ppu.advance(10 * Ppu::DOTS_PER_SCANLINE + 21);
+  CHECK((ppu.readRegister(2) & Ppu::STATUS_SPRITE_ZERO_HIT) == 0);
+  ppu.advance(1);
+  CHECK((ppu.readRegister(2) & Ppu::STATUS_SPRITE_ZERO_HIT) != 0);
+  CHECK(framebuffer[10 * Ppu::WIDTH + 20] == 0x30);
+  CHECK(framebuffer[9 * Ppu::WIDTH + 20] == 0x2A);
+
+  // The flag is cleared on the pre-render scanline.
+  ppu.advance(Ppu::DOTS_PER_FRAME - 10 * Ppu::DOTS_PER_SCANLINE);
+  CHECK((ppu.readRegister(2) & Ppu::STATUS_SPRITE_ZERO_HIT) == 0);
+}
+
+TEST_CASE("More than eight sprites on a scanline set sprite overflow.",
+    "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuOverflow.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  Ppu ppu(cartridgePtr->getMapper());
+  ppu.writeRegister(3, 0x00);
+  for(int sprite = 0; sprite < 64; sprite++) {
+    ppu.writeRegister(4, sprite < 9 ? 50 : 0xF0);
+    ppu.writeRegister(4, 0x01);
+    ppu.writeRegister(4, 0x00);
+    ppu.writeRegister(4, static_cast<byte>(sprite * 8));
+  }
+  ppu.writeRegister(1, 0x10);
+  ppu.advance(50 * Ppu::DOTS_PER_SCANLINE);
+  CHECK((ppu.readRegister(2) & Ppu::STATUS_SPRITE_OVERFLOW) == 0);
+  ppu.advance(Ppu::DOTS_PER_SCANLINE);
+  CHECK((ppu.readRegister(2) & Ppu::STATUS_SPRITE_OVERFLOW) != 0);
+}
+
+TEST_CASE("Catching up in runs renders the same frame as catching up every dot.",
+    "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuRuns.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  std::vector<byte> eager(Ppu::WIDTH * Ppu::HEIGHT);
+  std::vector<byte> lazy(Ppu::WIDTH * Ppu::HEIGHT);
+
+  // Split the screen partway through scanline 100 and again partway through
+  // its pixels, then run a frame catching up every dot, and a frame catching
+  // up only at the writes.
+  auto renderFrame = [&cartridgePtr](std::vector<byte>& framebuffer,
+      std::size_t step) {
+    Ppu ppu(cartridgePtr->getMapper());
+    ppu.setFramebuffer(framebuffer.data());
+    loadTestPattern(ppu);
+    resetScroll(ppu);
+    ppu.writeRegister(1, 0x1E);
+    std::size_t splits[] = {
+      100 * Ppu::DOTS_PER_SCANLINE + 300,
+      120 * Ppu::DOTS_PER_SCANLINE + 100
+    };
+    std::size_t elapsed = 0;
+    for(std::size_t split : splits) {
+      while(elapsed < split) {
+        std::size_t dots = std::min(step, split - elapsed);
+        ppu.advance(dots);
+        ppu.catchUp();
+        elapsed += dots;
+      }
+      ppu.writeRegister(5, 0x0C);
+      ppu.writeRegister(5, 0x00);
+      ppu.readRegister(2);
+      ppu.writeRegister(6, 0x00);
+      ppu.writeRegister(6, 0x01);
+    }
+    ppu.advance(Ppu::DOTS_PER_FRAME - elapsed);
+    ppu.catchUp();
+  };
+  renderFrame(eager, 1);
+  renderFrame(lazy, Ppu::DOTS_PER_FRAME);
+  CHECK(eager == lazy);
+}
+
+TEST_CASE("Headless mode shows the Cpu exactly what rendering does.",
+    "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuHeadless.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+
+  // Sample PPUSTATUS and NMIs through two frames with sprite 0 hits, sprite
+  // overflow and a mid-frame scroll change, rendering every other frame.
+  auto observe = [&cartridgePtr](bool headless, std::vector<byte>& framebuffer) {
+    Ppu ppu(cartridgePtr->getMapper());
+    ppu.setFramebuffer(framebuffer.data());
+    loadTestPattern(ppu);
+    resetScroll(ppu);
+    ppu.writeRegister(3, 0x00);
+    byte spriteZero[] = {9, 0x01, 0x00, 18};
+    for(byte data : spriteZero) {
+      ppu.writeRegister(4, data);
+    }
+    for(int sprite = 1; sprite < 64; sprite++) {
+      ppu.writeRegister(4, sprite < 10 ? 100 : static_cast<byte>(sprite * 3));
+      ppu.writeRegister(4, static_cast<byte>(sprite % 3));
+      ppu.writeRegister(4, 0x00);
+      ppu.writeRegister(4, static_cast<byte>(sprite * 5));
+    }
+    ppu.writeRegister(0, 0x80);
+    ppu.writeRegister(1, 0x1E);
+    std::vector<int> observed;
+    for(std::size_t frame = 0; frame < 4; frame++) {
+      ppu.setHeadless(headless && frame % 2 == 0);
+      for(std::size_t step = 0; step < Ppu::DOTS_PER_FRAME; step += 97) {
+        ppu.advance(97);
+        observed.push_back(ppu.readRegister(2));
+        observed.push_back(ppu.pollNmi());
+        if(step == 150 * 97) {
+          ppu.writeRegister(5, 0x05);
+          ppu.writeRegister(5, 0x00);
+        }
+      }
+    }
+    return observed;
+  };
+  std::vector<byte> rendered(Ppu::WIDTH * Ppu::HEIGHT, 0xFF);
+  std::vector<byte> headless(Ppu::WIDTH * Ppu::HEIGHT, 0xFF);
+  auto renderedObservations = observe(false, rendered);
+  auto headlessObservations = observe(true, headless);
+  int flags = Ppu::STATUS_SPRITE_ZERO_HIT | Ppu::STATUS_SPRITE_OVERFLOW;
+  CHECK(std::count_if(renderedObservations.begin(), renderedObservations.end(),
+      [flags](int status) { return (status & flags) == flags; }) > 0);
+  CHECK(renderedObservations == headlessObservations);
+  // The last frame was drawn in both.
+  CHECK(rendered == headless);
+}
+
+TEST_CASE("Headless mode produces no pixels.", "[Nes][Ppu]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeRomFile("ppuNoPixels.nes", 1, 0));
+  auto cartridgePtr = builder.build();
+  Ppu ppu(cartridgePtr->getMapper());
+  std::vector<byte> framebuffer(Ppu::WIDTH * Ppu::HEIGHT, 0xFF);
+  ppu.setFramebuffer(framebuffer.data());
+  loadTestPattern(ppu);
+  resetScroll(ppu);
+  ppu.writeRegister(1, 0x1E);
+  ppu.setHeadless(true);
+  ppu.advance(Ppu::DOTS_PER_FRAME);
+  ppu.catchUp();
+  CHECK(std::count(framebuffer.begin(), framebuffer.end(), 0xFF)
+      == static_cast<long>(framebuffer.size()));
+}
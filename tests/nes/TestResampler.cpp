@@ -0,0 +1,123 @@
+//===-- tests/nes/TestResampler.cpp - Resampler Test ------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the Resampler class
+///
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/Resampler.h"
+
+using namespace Nes;
+
+/// Cpu cycles in an NTSC frame.
+static const std::size_t CYCLES_PER_FRAME = 29781;
+
+/// Generate a sine wave at the Cpu clock rate.
+static std::vector<float> sine(double frequency, double amplitude, std::size_t count) {
+  std::vector<float> samples(count);
+  for(std::size_t i = 0; i < count; i++) {
+    samples[i] = static_cast<float>(amplitude
+        * std::sin(2.0 * 3.14159265358979323846 * frequency * i / Apu::CPU_CLOCK_RATE));
+  }
+  return samples;
+}
+
+/// Compute the RMS level of samples, skipping the filter's start up.
+static double rms(const std::vector<float>& samples, std::size_t skipped) {
+  double sum = 0.0;
+  for(std::size_t i = skipped; i < samples.size(); i++) {
+    sum += samples[i] * samples[i];
+  }
+  return std::sqrt(sum / (samples.size() - skipped));
+}
+
+TEST_CASE("The Resampler passes audible tones and rejects aliases.", "[Nes][Resampler]") {
+  Resampler resampler(Apu::CPU_CLOCK_RATE, 48000.0);
+  REQUIRE(resampler.getTapCount() % 8 == 0);
+  std::vector<float> output;
+  auto tone = sine(1000.0, 0.5, CYCLES_PER_FRAME * 6);
+  resampler.process(tone.data(), tone.size(), output);
+  CHECK(output.size() == Approx(tone.size() * 48000.0 / Apu::CPU_CLOCK_RATE).epsilon(0.01));
+  CHECK(rms(output, 100) == Approx(0.5 / std::sqrt(2.0)).epsilon(0.01));
+
+  // A 40kHz tone would fold back to 8kHz.
+  resampler.reset();
+  output.clear();
+  auto alias = sine(40000.0, 0.5, CYCLES_PER_FRAME * 6);
+  resampler.process(alias.data(), alias.size(), output);
+  CHECK(rms(output, 100) < 0.001);
+}
+
+TEST_CASE("The Resampler keeps its phase between calls.", "[Nes][Resampler]") {
+  auto tone = sine(3000.0, 0.5, CYCLES_PER_FRAME * 3);
+  Resampler whole;
+  std::vector<float> wholeOutput;
+  whole.process(tone.data(), tone.size(), wholeOutput);
+  Resampler pieces;
+  std::vector<float> piecesOutput;
+  // Pieces of awkward sizes, some smaller than the filter.
+  std::size_t sizes[] = {1, 37, 500, 1000, 12345};
+  std::size_t offset = 0;
+  for(std::size_t piece = 0; offset < tone.size(); piece++) {
+    std::size_t size = std::min(sizes[piece % 5], tone.size() - offset);
+    pieces.process(tone.data() + offset, size, piecesOutput);
+    offset += size;
+  }
+  CHECK(piecesOutput == wholeOutput);
+}
+
+TEST_CASE("The Resampler rate can be nudged.", "[Nes][Resampler]") {
+  std::vector<float> silence(static_cast<std::size_t>(Apu::CPU_CLOCK_RATE), 0.0f);
+  Resampler resampler;
+  std::vector<float> output;
+  resampler.process(silence.data(), silence.size(), output);
+  // The first output is of the first input sample, so the last half a
+  // filter of input is still waiting for more.
+  CHECK(output.size() == Approx(48000).margin(resampler.getTapCount() / 2 / 37 + 1));
+
+  resampler.setRateAdjustment(1000.0);
+  output.clear();
+  resampler.process(silence.data(), silence.size(), output);
+  CHECK(static_cast<double>(output.size()) == Approx(48000 / 1.001).margin(1));
+
+  // Adjustments are limited, and follow the fill level of a buffer.
+  resampler.setRateAdjustment(1e6);
+  CHECK(resampler.getRateAdjustment() == Resampler::MAX_RATE_ADJUSTMENT);
+  resampler.setBufferFill(0.5);
+  CHECK(resampler.getRateAdjustment() == 0.0);
+  resampler.setBufferFill(0.25);
+  CHECK(resampler.getRateAdjustment() < 0.0);
+}
+
+TEST_CASE("Benchmark resampling a frame of Cpu rate audio.", "[.][benchmark]") {
+  auto tone = sine(1000.0, 0.5, CYCLES_PER_FRAME);
+  Resampler resampler;
+  std::vector<float> output;
+  const int frames = 600;
+  auto start = std::chrono::steady_clock::now();
+  for(int frame = 0; frame < frames; frame++) {
+    output.clear();
+    resampler.process(tone.data(), tone.size(), output);
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  double perFrame = elapsed.count() / frames;
+  WARN("Resampler with " << resampler.getTapCount() << " taps: " << perFrame
+      << " microseconds per frame, " << perFrame / (1e6 / 60.0988) * 100.0
+      << "% of a frame");
+}
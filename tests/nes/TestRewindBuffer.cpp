@@ -0,0 +1,158 @@
+//===-- tests/nes/TestRewindBuffer.cpp - RewindBuffer Test ------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the RewindBuffer class
+///
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "common/structures/StructureException.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Console.h"
+#include "nes/RewindBuffer.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Build a fake state for a frame, mostly the same from frame to frame, with
+/// a few bytes changed and a length that varies.
+static std::vector<byte> buildState(std::uint64_t frame) {
+  std::vector<byte> state(4096 + frame % 3);
+  for(std::size_t i = 0; i < state.size(); i++) {
+    state[i] = static_cast<byte>(i * 7);
+  }
+  state[frame % state.size()] ^= 0xFF;
+  state[100] = static_cast<byte>(frame);
+  state[101] = static_cast<byte>(frame >> 8);
+  return state;
+}
+
+TEST_CASE("Rewind buffers restore every frame held.", "[Nes][RewindBuffer]") {
+  RewindBuffer rewind(60, 64 * 1024, 10);
+  for(std::uint64_t frame = 0; frame < 25; frame++) {
+    REQUIRE(rewind.push(buildState(frame)) == frame);
+  }
+  REQUIRE(rewind.getFrameCount() == 25);
+  std::vector<byte> state;
+  bool restored = true;
+  for(std::uint64_t frame = 0; frame < 25; frame++) {
+    rewind.load(frame, state);
+    restored &= state == buildState(frame);
+  }
+  CHECK(restored);
+  // Deltas of a few changed bytes are far smaller than the states.
+  CHECK(rewind.getCompressionRatio() > 5.0);
+  CHECK_THROWS_AS(rewind.load(25, state), Exception::KeyErrorException);
+}
+
+TEST_CASE("Rewind buffers evict the oldest frames to stay in budget.", "[Nes][RewindBuffer]") {
+  SECTION("When the budget runs out") {
+    // Room for about three keyframes and their deltas.
+    RewindBuffer rewind(1000, 16 * 1024, 8);
+    for(std::uint64_t frame = 0; frame < 500; frame++) {
+      rewind.push(buildState(frame));
+      REQUIRE(rewind.getStoredBytes() <= 16 * 1024);
+    }
+    CHECK(rewind.getNewestFrame() == 499);
+    CHECK(rewind.getFrameCount() < 500);
+    // Whole keyframe groups are evicted, so the oldest frame is a keyframe.
+    CHECK(rewind.getOldestFrame() % 8 == 0);
+    std::vector<byte> state;
+    bool restored = true;
+    for(std::uint64_t frame = rewind.getOldestFrame(); frame < 500; frame++) {
+      rewind.load(frame, state);
+      restored &= state == buildState(frame);
+    }
+    CHECK(restored);
+  }
+
+  SECTION("When the frames run out") {
+    RewindBuffer rewind(20, 1024 * 1024, 5);
+    for(std::uint64_t frame = 0; frame < 100; frame++) {
+      rewind.push(buildState(frame));
+      REQUIRE(rewind.getFrameCount() <= 20);
+    }
+    CHECK(rewind.hasFrame(99));
+    CHECK_FALSE(rewind.hasFrame(79));
+    std::vector<byte> state;
+    rewind.load(rewind.getOldestFrame(), state);
+    CHECK(state == buildState(rewind.getOldestFrame()));
+  }
+}
+
+TEST_CASE("Rewind buffers resume from a rewound frame.", "[Nes][RewindBuffer]") {
+  RewindBuffer rewind(60, 64 * 1024, 4);
+  for(std::uint64_t frame = 0; frame < 10; frame++) {
+    rewind.push(buildState(frame));
+  }
+  rewind.discardAfter(5);
+  CHECK(rewind.getNewestFrame() == 5);
+  // Frames pushed after rewinding replace the discarded ones.
+  std::vector<byte> replaced = buildState(1000);
+  CHECK(rewind.push(replaced) == 6);
+  CHECK(rewind.push(buildState(7)) == 7);
+  std::vector<byte> state;
+  rewind.load(6, state);
+  CHECK(state == replaced);
+  rewind.load(7, state);
+  CHECK(state == buildState(7));
+  rewind.load(5, state);
+  CHECK(state == buildState(5));
+}
+
+TEST_CASE("Rewind buffers restore Console states.", "[Nes][RewindBuffer]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeProgramRomFile("rewindConsole.nes", {
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::JMP_ABS, 0x00, 0x80
+  }));
+  Console console(builder.build());
+  RewindBuffer rewind(600, 1024 * 1024, 30);
+  std::vector<byte> state;
+  std::vector<std::vector<byte>> states;
+  for(int frame = 0; frame < 40; frame++) {
+    console.runFrame();
+    console.saveState(state);
+    states.push_back(state);
+    rewind.push(state);
+  }
+  rewind.load(35, state);
+  CHECK(state == states[35]);
+  console.loadState(state);
+  CHECK(console.getPpu().getFrameCount() == 36);
+}
+
+TEST_CASE("Benchmark rewind buffer pushes.", "[.][benchmark]") {
+  CartridgeBuilder builder;
+  builder.setInputFile(writeProgramRomFile("rewindBenchmark.nes", {
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::JMP_ABS, 0x00, 0x80
+  }));
+  Console console(builder.build());
+  // Ten seconds at 60 frames per second.
+  RewindBuffer rewind(600, 4 * 1024 * 1024, 60);
+  std::vector<byte> state;
+  for(int frame = 0; frame < 1200; frame++) {
+    console.runFrame();
+    console.saveState(state);
+    rewind.push(state);
+  }
+  WARN(rewind.getFrameCount() << " frames in " << rewind.getStoredBytes() << " bytes, "
+      << rewind.getCompressionRatio() << " times smaller, at "
+      << rewind.getMeanPushTime() << "us per frame");
+}
@@ -0,0 +1,84 @@
+//===-- tests/nes/TestRomStore.cpp - RomStore Test --------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the RomStore class
+///
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Console.h"
+#include "nes/RomStore.h"
+#include "nes/TileCache.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+TEST_CASE("The RomStore interns images by content.", "[Nes][RomStore]") {
+  RomStore& store = RomStore::getInstance();
+  std::size_t imageCount = store.getImageCount();
+  std::vector<byte> first(0x4000, 0x11);
+  std::vector<byte> same(0x4000, 0x11);
+  std::vector<byte> other(0x4000, 0x11);
+  other.back() = 0x22;
+  {
+    auto firstImage = store.intern(first.data(), first.size());
+    auto sameImage = store.intern(same.data(), same.size());
+    auto otherImage = store.intern(other.data(), other.size());
+    CHECK(firstImage == sameImage);
+    CHECK(firstImage != otherImage);
+    CHECK(otherImage->at(0)[0x3FFF] == 0x22);
+    CHECK(store.getImageCount() == imageCount + 2);
+  }
+  // Images go once nothing holds them.
+  CHECK(store.getImageCount() == imageCount);
+}
+
+TEST_CASE("Cartridges of the same game share their ROM.", "[Nes][RomStore]") {
+  std::string path = writeRomFile("romStoreShared.nes", 2, 1);
+  CartridgeBuilder builder;
+  builder.setInputFile(path);
+  Console first(builder.build());
+  Console second(builder.build());
+  // PRG ROM is shared, while RAM is not.
+  CHECK(first.getBus().getPageData(0x80) == second.getBus().getPageData(0x80));
+  CHECK(first.getBus().getPageData(0xC0) == second.getBus().getPageData(0xC0));
+  CHECK(first.getBus().getPageData(0x00) != second.getBus().getPageData(0x00));
+  CHECK(first.getCartridge().getRomHash() == second.getCartridge().getRomHash());
+  // The second 16kB bank still reads as its own chunk of the file.
+  CHECK(first.getBus().getPageData(0xC0)[0] == 2);
+}
+
+TEST_CASE("Cartridges of the same game share their decoded tiles.", "[Nes][RomStore]") {
+  std::string path = writeRomFile("romStoreTiles.nes", 1, 2);
+  CartridgeBuilder builder;
+  builder.setInputFile(path);
+  auto firstPtr = builder.build();
+  auto secondPtr = builder.build();
+  const CartridgeMapper& first = firstPtr->getMapper();
+  const CartridgeMapper& second = secondPtr->getMapper();
+  TileCache firstCache(first.getChrMemory(), first.getChrSize(), false);
+  TileCache secondCache(second.getChrMemory(), second.getChrSize(), false);
+  CHECK(firstCache.isShared());
+  CHECK(firstCache.isBankDecoded(1));
+  CHECK(firstCache.getRow(0x400) == secondCache.getRow(0x400));
+  // Every byte of the second 1kB chunk is 1, so both planes are set in the
+  // rightmost pixel only.
+  CHECK(secondCache.getRow(0x400)[6] == 0);
+  CHECK(secondCache.getRow(0x400)[7] == 3);
+  CHECK(secondCache.getRow(0x2000)[7] == 0);
+}
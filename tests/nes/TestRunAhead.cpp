@@ -0,0 +1,107 @@
+//===-- tests/nes/TestRunAhead.cpp - RunAhead Test --------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the RunAhead class
+///
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Console.h"
+#include "nes/RunAhead.h"
+
+#include "RomFile.h"
+
+using namespace Nes;
+
+/// Build a Console running a program that counts NMIs in $10, and sets the
+/// backdrop colour to the count, so that every frame looks different.
+static std::unique_ptr<Console> buildBackdropCounter(const std::string& name) {
+  // INC $10; LDA #$3F; STA $2006; LDA #$00; STA $2006; LDA $10; AND #$3F;
+  // STA $2007; LDA #$1E; STA $2001; LDA #$80; STA $2000; JMP $801D
+  std::vector<byte> program = {
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::LDA_IMMED, 0x3F,
+    Cpu::Op::STA_ABS, 0x06, 0x20,
+    Cpu::Op::LDA_IMMED, 0x00,
+    Cpu::Op::STA_ABS, 0x06, 0x20,
+    Cpu::Op::LDA_ZPG, 0x10,
+    Cpu::Op::AND_IMMED, 0x3F,
+    Cpu::Op::STA_ABS, 0x07, 0x20,
+    Cpu::Op::LDA_IMMED, 0x1E,
+    Cpu::Op::STA_ABS, 0x01, 0x20,
+    Cpu::Op::LDA_IMMED, 0x80,
+    Cpu::Op::STA_ABS, 0x00, 0x20,
+    Cpu::Op::JMP_ABS, 0x1D, 0x80
+  };
+  CartridgeBuilder builder;
+  builder.setInputFile(writeProgramRomFile(name, program));
+  return std::unique_ptr<Console>(new Console(builder.build()));
+}
+
+TEST_CASE("Running ahead shows frames ahead of the game.", "[Nes][RunAhead]") {
+  const std::size_t ahead = 2;
+  auto plainPtr = buildBackdropCounter("runAheadPlain.nes");
+  auto consolePtr = buildBackdropCounter("runAhead.nes");
+  std::vector<byte> plainFrame(Ppu::WIDTH * Ppu::HEIGHT);
+  std::vector<byte> frame(Ppu::WIDTH * Ppu::HEIGHT);
+  plainPtr->getPpu().setFramebuffer(plainFrame.data());
+  consolePtr->getPpu().setFramebuffer(frame.data());
+  RunAhead runAhead(*consolePtr, ahead);
+  for(std::size_t i = 0; i < ahead; i++) {
+    plainPtr->runFrame();
+  }
+  for(int i = 0; i < 10; i++) {
+    runAhead.runFrame();
+    plainPtr->runFrame();
+    // The game is where it would be, but the picture is ahead of it.
+    CHECK(consolePtr->getPpu().getFrameCount() + ahead == plainPtr->getPpu().getFrameCount());
+    CHECK(frame == plainFrame);
+  }
+  CHECK_FALSE(consolePtr->getPpu().isHeadless());
+  CHECK_FALSE(consolePtr->getApu().isHeadless());
+
+  // With no frames ahead, the picture is the game's.
+  runAhead.setFrames(0);
+  runAhead.runFrame();
+  runAhead.runFrame();
+  CHECK(frame == plainFrame);
+}
+
+TEST_CASE("Running ahead leaves a headless Apu headless.", "[Nes][RunAhead]") {
+  auto consolePtr = buildBackdropCounter("runAheadHeadless.nes");
+  consolePtr->getApu().setHeadless(true);
+  RunAhead runAhead(*consolePtr, 2);
+  for(int i = 0; i < 3; i++) {
+    runAhead.runFrame();
+    CHECK(consolePtr->getApu().isHeadless());
+  }
+}
+
+TEST_CASE("Benchmark the cost of running ahead.", "[.][benchmark]") {
+  auto consolePtr = buildBackdropCounter("runAheadBenchmark.nes");
+  std::vector<byte> frame(Ppu::WIDTH * Ppu::HEIGHT);
+  consolePtr->getPpu().setFramebuffer(frame.data());
+  for(std::size_t ahead = 0; ahead <= 3; ahead++) {
+    RunAhead runAhead(*consolePtr, ahead);
+    for(int i = 0; i < 120; i++) {
+      runAhead.runFrame();
+    }
+    WARN(ahead << " frames ahead: " << runAhead.getMeanFrameTime() << "us per real frame, "
+        << runAhead.getMeanRunAheadTime() << "us added");
+  }
+}
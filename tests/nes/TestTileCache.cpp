@@ -0,0 +1,76 @@
+//===-- tests/nes/TestTileCache.cpp - TileCache Test ------------*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the TileCache class
+///
+//===----------------------------------------------------------------------===//
+
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "memory/Ram.h"
+#include "nes/TileCache.h"
+
+using namespace Nes;
+
+TEST_CASE("The TileCache interleaves bitplanes, leftmost pixel first.",
+    "[Nes][TileCache]") {
+  Memory::Ram<byte> chr(2 * TileCache::BANK_SIZE);
+  // Row 3 of tile 5: low plane 10000001, high plane 11000000.
+  chr.write(5 * TileCache::TILE_SIZE + 3, 0x81);
+  chr.write(5 * TileCache::TILE_SIZE + 3 + 8, 0xC0);
+  TileCache cache(chr, chr.getSize(), true);
+
+  const byte* row = cache.getRow(5 * TileCache::TILE_SIZE + 3);
+  std::vector<byte> pixels(row, row + 8);
+  CHECK(pixels == std::vector<byte>({3, 2, 0, 0, 0, 0, 0, 1}));
+}
+
+TEST_CASE("The TileCache decodes a whole bank on first use.",
+    "[Nes][TileCache]") {
+  Memory::Ram<byte> chr(2 * TileCache::BANK_SIZE);
+  chr.write(TileCache::BANK_SIZE + 0x100, 0xFF);
+  TileCache cache(chr, chr.getSize(), true);
+  CHECK_FALSE(cache.isShared());
+  CHECK_FALSE(cache.isBankDecoded(0));
+  CHECK_FALSE(cache.isBankDecoded(1));
+
+  cache.getRow(0x10);
+  CHECK(cache.isBankDecoded(0));
+  CHECK_FALSE(cache.isBankDecoded(1));
+  CHECK(cache.getRow(TileCache::BANK_SIZE + 0x100)[0] == 1);
+  CHECK(cache.isBankDecoded(1));
+}
+
+TEST_CASE("The TileCache only redecodes tiles marked dirty.",
+    "[Nes][TileCache]") {
+  Memory::Ram<byte> chr(TileCache::BANK_SIZE);
+  TileCache cache(chr, chr.getSize(), true);
+  CHECK(cache.getRow(0x20)[7] == 0);
+
+  // Unreported writes are not seen.
+  chr.write(0x20, 0x01);
+  CHECK(cache.getRow(0x20)[7] == 0);
+  cache.invalidate(0x28);
+  CHECK(cache.getRow(0x20)[7] == 1);
+}
+
+TEST_CASE("The TileCache decodes CHR ROM itself if the RomStore lacks it.",
+    "[Nes][TileCache]") {
+  Memory::Ram<byte> chr(TileCache::BANK_SIZE);
+  chr.write(0x30, 0x80);
+  TileCache cache(chr, chr.getSize(), false);
+  CHECK_FALSE(cache.isShared());
+  CHECK_FALSE(cache.isBankDecoded(0));
+  CHECK(cache.getRow(0x30)[0] == 1);
+}
@@ -0,0 +1,177 @@
+//===-- tests/nes/TestVideoConverter.cpp - VideoConverter Test --*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the VideoConverter class
+///
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "nes/Ppu.h"
+#include "nes/VideoConverter.h"
+
+using namespace Nes;
+
+/// Build a frame of every palette index in a scrambled order.
+static std::vector<byte> buildFrame(std::size_t width, std::size_t height) {
+  std::vector<byte> frame(width * height);
+  for(std::size_t pixel = 0; pixel < frame.size(); pixel++) {
+    frame[pixel] = static_cast<byte>((pixel * 37 + pixel / width * 11) & 0x3F);
+  }
+  return frame;
+}
+
+TEST_CASE("VideoConverter converts palette indices to RGBA.",
+    "[Nes][VideoConverter]") {
+  VideoConverter converter;
+  CHECK(converter.getRgb(0x30, 0) == 0xFFFEFF);
+  CHECK(converter.getRgb(0x0F, 0) == 0x000000);
+
+  SECTION("Emphasis darkens the other channels") {
+    std::uint32_t red = converter.getRgb(0x30, 0x01);
+    CHECK((red >> 16) == 0xFF);
+    CHECK(((red >> 8) & 0xFF) < 0xFE);
+    CHECK((red & 0xFF) < 0xFF);
+    CHECK(converter.getRgb(0x30, 0x07) < converter.getRgb(0x30, 0x01));
+  }
+
+  SECTION("Whole vectors and the pixels left over convert alike") {
+    // 1000 pixels leave 8 after the last run of 32 and the last run of 16.
+    auto frame = buildFrame(1000, 1);
+    std::vector<byte> rgba(frame.size() * 4);
+    converter.toRgba(frame.data(), frame.size(), 0x02, rgba.data());
+    bool matches = true;
+    for(std::size_t pixel = 0; pixel < frame.size(); pixel++) {
+      std::uint32_t rgb = converter.getRgb(frame[pixel], 0x02);
+      matches = matches && rgba[pixel * 4] == (rgb >> 16)
+          && rgba[pixel * 4 + 1] == ((rgb >> 8) & 0xFF)
+          && rgba[pixel * 4 + 2] == (rgb & 0xFF)
+          && rgba[pixel * 4 + 3] == 0xFF;
+    }
+    CHECK(matches);
+  }
+}
+
+TEST_CASE("VideoConverter converts palette indices to gray.",
+    "[Nes][VideoConverter]") {
+  VideoConverter converter;
+  CHECK(converter.getGray(0x30, 0) == 0xFE);
+  CHECK(converter.getGray(0x0F, 0) == 0x00);
+  CHECK(converter.getGray(0x30, 0x07) < converter.getGray(0x30, 0));
+
+  auto frame = buildFrame(1000, 1);
+  std::vector<byte> gray(frame.size());
+  converter.toGray(frame.data(), frame.size(), 0x04, gray.data());
+  bool matches = true;
+  for(std::size_t pixel = 0; pixel < frame.size(); pixel++) {
+    matches = matches && gray[pixel] == converter.getGray(frame[pixel], 0x04);
+  }
+  CHECK(matches);
+}
+
+TEST_CASE("VideoConverter scales frames up by nearest neighbour.",
+    "[Nes][VideoConverter]") {
+  // 37 pixels leave 5 after the last run of 16.
+  std::size_t width = 37;
+  std::size_t height = 3;
+  auto frame = buildFrame(width, height);
+  for(std::size_t factor = 1; factor <= 4; factor++) {
+    std::vector<byte> scaled(frame.size() * factor * factor);
+    VideoConverter::scale(frame.data(), width, height, factor, scaled.data());
+    bool matches = true;
+    for(std::size_t y = 0; y < height * factor; y++) {
+      for(std::size_t x = 0; x < width * factor; x++) {
+        matches = matches
+            && scaled[y * width * factor + x] == frame[(y / factor) * width + x / factor];
+      }
+    }
+    CHECK(matches);
+  }
+}
+
+TEST_CASE("VideoConverter converts frames to YUV 4:2:0.",
+    "[Nes][VideoConverter]") {
+  VideoConverter converter;
+  // Greys have no chroma.
+  CHECK(converter.getYuv(0x00, 0)[1] == 128);
+  CHECK(converter.getYuv(0x00, 0)[2] == 128);
+  CHECK(converter.getYuv(0x0F, 0)[0] == 16);
+
+  std::size_t width = 40;
+  std::size_t height = 4;
+  auto frame = buildFrame(width, height);
+  std::vector<byte> yPlane(width * height);
+  std::vector<byte> uPlane(width * height / 4);
+  std::vector<byte> vPlane(width * height / 4);
+  converter.toYuv420(frame.data(), width, height, 0, yPlane.data(),
+      uPlane.data(), vPlane.data());
+  auto average = [](int a, int b) { return (a + b + 1) / 2; };
+  bool matches = true;
+  for(std::size_t y = 0; y < height; y++) {
+    for(std::size_t x = 0; x < width; x++) {
+      matches = matches && yPlane[y * width + x] == converter.getYuv(frame[y * width + x], 0)[0];
+    }
+  }
+  for(std::size_t y = 0; y < height / 2; y++) {
+    for(std::size_t x = 0; x < width / 2; x++) {
+      for(std::size_t component = 1; component <= 2; component++) {
+        auto sample = [&](std::size_t dy, std::size_t dx) {
+          return converter.getYuv(frame[(y * 2 + dy) * width + x * 2 + dx], 0)[component];
+        };
+        int expected = average(average(sample(0, 0), sample(1, 0)),
+            average(sample(0, 1), sample(1, 1)));
+        const auto& plane = component == 1 ? uPlane : vPlane;
+        matches = matches && plane[y * width / 2 + x] == expected;
+      }
+    }
+  }
+  CHECK(matches);
+}
+
+/// Convert frames as fast as possible, and report the time per frame.
+template<class Conversion>
+static void benchmarkConversion(const std::string& mode, Conversion convert) {
+  const int frames = 600;
+  auto start = std::chrono::steady_clock::now();
+  for(int frame = 0; frame < frames; frame++) {
+    convert();
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  WARN(mode << ": " << elapsed.count() / frames << " microseconds per frame");
+}
+
+TEST_CASE("Benchmark video conversion per frame.", "[.][benchmark]") {
+  VideoConverter converter;
+  auto frame = buildFrame(Ppu::WIDTH, Ppu::HEIGHT);
+  std::vector<byte> scaled(frame.size() * 9);
+  std::vector<byte> rgba(scaled.size() * 4);
+  std::vector<byte> chroma(scaled.size() / 4 * 2);
+  benchmarkConversion("RGBA", [&] {
+    converter.toRgba(frame.data(), frame.size(), 0, rgba.data());
+  });
+  for(std::size_t factor = 2; factor <= 3; factor++) {
+    std::size_t pixels = frame.size() * factor * factor;
+    benchmarkConversion("RGBA at " + std::to_string(factor) + "x", [&] {
+      VideoConverter::scale(frame.data(), Ppu::WIDTH, Ppu::HEIGHT, factor, scaled.data());
+      converter.toRgba(scaled.data(), pixels, 0, rgba.data());
+    });
+    benchmarkConversion("YUV 4:2:0 at " + std::to_string(factor) + "x", [&] {
+      VideoConverter::scale(frame.data(), Ppu::WIDTH, Ppu::HEIGHT, factor, scaled.data());
+      converter.toYuv420(scaled.data(), Ppu::WIDTH * factor, Ppu::HEIGHT * factor, 0,
+          rgba.data(), chroma.data(), chroma.data() + pixels / 4);
+    });
+  }
+}
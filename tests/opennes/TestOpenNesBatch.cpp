@@ -0,0 +1,354 @@
+//===-- tests/opennes/TestOpenNesBatch.cpp - C Interface Test ---*- C++ -*-===//
+//
+//                           The OpenNES Project
+//
+// This file is distributed under GPL v2. See LICENSE.md for details. The Catch
+// framework IS NOT distributed under LICENSE.md.
+// The Catch framework is included in this project under the Boost License
+// simply as a matter of convenience.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// Test cases for the batched C interface
+///
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "tests/catch.hpp"
+#include "common/CommonTypes.h"
+#include "cpu/Mos6502.h"
+#include "memory/Arena.h"
+#include "nes/CartridgeBuilder.h"
+#include "nes/Console.h"
+#include "nes/ObservationStack.h"
+#include "opennes/OpenNesBatch.h"
+
+#include "RomFile.h"
+
+/// Number of allocations made while they are counted.
+static std::atomic<std::size_t> allocationCount(0);
+/// Set while allocations are counted.
+static std::atomic<bool> countingAllocations(false);
+
+/// Allocate through malloc, counting allocations made while counting is on,
+/// on any thread, including those of the library.
+void* operator new(std::size_t size) {
+  if(countingAllocations.load(std::memory_order_relaxed)) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if(memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+/// Free memory from operator new.
+void operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+/// Free memory from operator new.
+void operator delete(void* memory, std::size_t size) noexcept {
+  std::free(memory);
+}
+
+/// Write a program that enables NMI and rendering, counts NMIs in $10, and
+/// then keeps reading controller 1 into $11, A in bit 0. Every vector points
+/// at the program.
+static std::string writeControllerReader(const std::string& name) {
+  return writeProgramRomFile(name, {
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::LDA_IMMED, 0x1E,
+    Cpu::Op::STA_ABS, 0x01, 0x20,
+    Cpu::Op::LDA_IMMED, 0x80,
+    Cpu::Op::STA_ABS, 0x00, 0x20,
+    Cpu::Op::LDA_IMMED, 0x01,     // $800C
+    Cpu::Op::STA_ABS, 0x16, 0x40,
+    Cpu::Op::LDA_IMMED, 0x00,
+    Cpu::Op::STA_ABS, 0x16, 0x40,
+    Cpu::Op::LDX_IMMED, 0x08,
+    Cpu::Op::LDA_ABS, 0x16, 0x40, // $8018
+    Cpu::Op::LSR_ACC,
+    Cpu::Op::ROR_ZPG, 0x12,
+    Cpu::Op::DEX_IMPL,
+    Cpu::Op::BNE_REL, 0xF7,       // to $8018
+    Cpu::Op::LDA_ZPG, 0x12,
+    Cpu::Op::STA_ZPG, 0x11,
+    Cpu::Op::JMP_ABS, 0x0C, 0x80
+  });
+}
+
+/// Write a program that counts NMIs in $10 and draws each frame with the
+/// colour emphasis given by the low bits of the count, so that frames in a
+/// row differ. Every vector points at the program.
+static std::string writeEmphasisCycler(const std::string& name) {
+  return writeProgramRomFile(name, {
+    Cpu::Op::INC_ZPG, 0x10,
+    Cpu::Op::LDA_ZPG, 0x10,
+    Cpu::Op::ASL_ACC,
+    Cpu::Op::ASL_ACC,
+    Cpu::Op::ASL_ACC,
+    Cpu::Op::ASL_ACC,
+    Cpu::Op::ASL_ACC,
+    Cpu::Op::ORA_IMMED, 0x1E,
+    Cpu::Op::STA_ABS, 0x01, 0x20,
+    Cpu::Op::LDA_IMMED, 0x80,
+    Cpu::Op::STA_ABS, 0x00, 0x20,
+    Cpu::Op::JMP_ABS, 0x13, 0x80  // $8013
+  });
+}
+
+/// Buffers for a batch, aligned as the interface requires.
+struct Buffers {
+  /// Storage of the frames.
+  Memory::Arena<byte> frameArena;
+  /// Storage of the RAM snapshots.
+  Memory::Arena<byte> ramArena;
+  /// The frames.
+  uint8_t* observations;
+  /// The RAM snapshots.
+  uint8_t* ram;
+
+  /// Build the buffers of a batch.
+  explicit Buffers(std::size_t count) :
+    frameArena(count * OPENNES_FRAME_SIZE, OPENNES_BUFFER_ALIGNMENT),
+    ramArena(count * OPENNES_RAM_SIZE, OPENNES_BUFFER_ALIGNMENT),
+    observations(frameArena.at(frameArena.allocate(count * OPENNES_FRAME_SIZE))),
+    ram(ramArena.at(ramArena.allocate(count * OPENNES_RAM_SIZE))) {
+  }
+};
+
+TEST_CASE("Batches write each instance's frame and RAM.", "[OpenNes][Batch]") {
+  std::string path = writeControllerReader("batchController.nes");
+  const std::size_t count = 5;
+  OpenNesBatch* batch = opennes_batch_create(path.c_str(), count, 2);
+  REQUIRE(batch != nullptr);
+  REQUIRE(opennes_batch_size(batch) == count);
+  Buffers buffers(count);
+  REQUIRE(opennes_batch_reset(batch, buffers.observations, buffers.ram) == OPENNES_OK);
+
+  // The same frames, run on a Console directly.
+  Nes::CartridgeBuilder builder;
+  builder.setInputFile(path);
+  Nes::Console console(builder.build());
+  std::vector<byte> frame(OPENNES_FRAME_SIZE);
+  console.getPpu().setFramebuffer(frame.data());
+  console.runFrame();
+  CHECK(std::equal(frame.begin(), frame.end(), buffers.observations));
+
+  const std::vector<uint8_t> actions = {0x00, 0x01, 0x80, 0x5A, 0xFF};
+  for(int step = 0; step < 3; step++) {
+    REQUIRE(opennes_batch_step(batch, actions.data(), buffers.observations, buffers.ram)
+        == OPENNES_OK);
+  }
+  console.getControllers().setButtons(0, actions[3]);
+  for(int step = 0; step < 3; step++) {
+    console.runFrame();
+  }
+  for(std::size_t index = 0; index < count; index++) {
+    INFO("Instance " << index);
+    const uint8_t* ram = buffers.ram + index * OPENNES_RAM_SIZE;
+    CHECK(ram[0x11] == actions[index]);
+    CHECK(ram[0x10] == 4);
+  }
+  CHECK(std::equal(frame.begin(), frame.end(),
+      buffers.observations + 3 * OPENNES_FRAME_SIZE));
+  CHECK(std::equal(console.getBus().getRam().getStorage(),
+      console.getBus().getRam().getStorage() + OPENNES_RAM_SIZE,
+      buffers.ram + 3 * OPENNES_RAM_SIZE));
+
+  SECTION("Resetting returns every instance to power on") {
+    Buffers reset(count);
+    REQUIRE(opennes_batch_reset(batch, reset.observations, reset.ram) == OPENNES_OK);
+    for(std::size_t index = 0; index < count; index++) {
+      CHECK(reset.ram[index * OPENNES_RAM_SIZE + 0x10] == 1);
+      CHECK(reset.ram[index * OPENNES_RAM_SIZE + 0x11] == 0);
+    }
+  }
+
+  SECTION("Frames are skipped without a frame buffer") {
+    REQUIRE(opennes_batch_step(batch, actions.data(), nullptr, buffers.ram) == OPENNES_OK);
+    CHECK(buffers.ram[0x10] == 5);
+    REQUIRE(opennes_batch_step(batch, actions.data(), nullptr, nullptr) == OPENNES_OK);
+  }
+
+  SECTION("Misaligned buffers are refused") {
+    CHECK(opennes_batch_step(batch, actions.data(), buffers.observations + 1, nullptr)
+        == OPENNES_ERROR_ARGUMENT);
+    CHECK(std::string(opennes_last_error()).find("aligned") != std::string::npos);
+    CHECK(opennes_batch_step(batch, nullptr, nullptr, nullptr) == OPENNES_ERROR_ARGUMENT);
+  }
+  opennes_batch_destroy(batch);
+}
+
+TEST_CASE("Batches stack preprocessed observations.", "[OpenNes][Batch]") {
+  std::string path = writeControllerReader("batchController.nes");
+  const std::size_t count = 3;
+  OpenNesBatch* batch = opennes_batch_create(path.c_str(), count, 2);
+  REQUIRE(batch != nullptr);
+  CHECK(opennes_batch_observation_size(batch) == OPENNES_FRAME_SIZE);
+  REQUIRE(opennes_batch_set_stacking(batch, 84, 84, 4) == OPENNES_OK);
+  const std::size_t size = opennes_batch_observation_size(batch);
+  REQUIRE(size == 4 * 84 * 84);
+  Memory::Arena<byte> arena(count * size, OPENNES_BUFFER_ALIGNMENT);
+  uint8_t* observations = arena.at(arena.allocate(count * size));
+  REQUIRE(opennes_batch_reset(batch, observations, nullptr) == OPENNES_OK);
+
+  // The same frames, stacked from a Console run directly.
+  Nes::CartridgeBuilder builder;
+  builder.setInputFile(path);
+  Nes::Console console(builder.build());
+  std::vector<byte> frame(OPENNES_FRAME_SIZE);
+  console.getPpu().setFramebuffer(frame.data());
+  console.runFrame();
+  Nes::ObservationStack stack;
+  stack.reset(frame.data(), console.getPpu().getEmphasis());
+  std::vector<byte> expected(size);
+  const std::vector<uint8_t> actions(count, 0x08);
+  console.getControllers().setButtons(0, 0x08);
+  for(int step = 0; step < 2; step++) {
+    REQUIRE(opennes_batch_step(batch, actions.data(), observations, nullptr) == OPENNES_OK);
+    console.runFrame();
+    stack.push(frame.data(), console.getPpu().getEmphasis());
+  }
+  // A skipped frame is not stacked.
+  REQUIRE(opennes_batch_step(batch, actions.data(), nullptr, nullptr) == OPENNES_OK);
+  console.runFrame();
+  stack.copyStack(expected.data());
+  for(std::size_t index = 0; index < count; index++) {
+    CHECK(std::equal(expected.begin(), expected.end(), observations + index * size));
+  }
+  CHECK(opennes_batch_set_stacking(batch, 0, 84, 4) == OPENNES_ERROR_ARGUMENT);
+  // Sizes whose product overflows, and sizes too large to allocate, fail
+  // rather than throwing out of the library.
+  const size_t half = size_t(1) << (std::numeric_limits<size_t>::digits / 2);
+  CHECK(opennes_batch_set_stacking(batch, half, half, 1) == OPENNES_ERROR_ARGUMENT);
+  CHECK(std::string(opennes_last_error()).find("too large") != std::string::npos);
+  CHECK(opennes_batch_set_stacking(batch, size_t(1) << 20, size_t(1) << 20, 1024)
+      == OPENNES_ERROR_ARGUMENT);
+  CHECK(opennes_batch_observation_size(batch) == size);
+
+  SECTION("Stacks are padded to stay aligned") {
+    REQUIRE(opennes_batch_set_stacking(batch, 84, 84, 3) == OPENNES_OK);
+    const std::size_t stride = opennes_batch_observation_size(batch);
+    CHECK(stride == 3 * 84 * 84 + 16);
+    Memory::Arena<byte> padded(count * stride, OPENNES_BUFFER_ALIGNMENT);
+    uint8_t* stacks = padded.at(padded.allocate(count * stride));
+    REQUIRE(opennes_batch_reset(batch, stacks, nullptr) == OPENNES_OK);
+    // Every instance starts from power on, so each stack is the same.
+    for(std::size_t index = 1; index < count; index++) {
+      CHECK(std::equal(stacks, stacks + 3 * 84 * 84, stacks + index * stride));
+    }
+    CHECK(std::any_of(stacks, stacks + 3 * 84 * 84, [](byte gray) { return gray != 0; }));
+  }
+  opennes_batch_destroy(batch);
+}
+
+TEST_CASE("Batches reset without an observation buffer start the stacks over.", "[OpenNes][Batch]") {
+  std::string path = writeEmphasisCycler("batchEmphasis.nes");
+  const std::size_t count = 2;
+  OpenNesBatch* batch = opennes_batch_create(path.c_str(), count, 2);
+  REQUIRE(batch != nullptr);
+  REQUIRE(opennes_batch_set_stacking(batch, 84, 84, 4) == OPENNES_OK);
+  const std::size_t size = opennes_batch_observation_size(batch);
+  Memory::Arena<byte> arena(count * size, OPENNES_BUFFER_ALIGNMENT);
+  uint8_t* observations = arena.at(arena.allocate(count * size));
+  const std::vector<uint8_t> actions(count, 0);
+  REQUIRE(opennes_batch_reset(batch, observations, nullptr) == OPENNES_OK);
+  for(int step = 0; step < 3; step++) {
+    REQUIRE(opennes_batch_step(batch, actions.data(), observations, nullptr) == OPENNES_OK);
+  }
+  REQUIRE(opennes_batch_reset(batch, nullptr, nullptr) == OPENNES_OK);
+  REQUIRE(opennes_batch_step(batch, actions.data(), observations, nullptr) == OPENNES_OK);
+
+  // The stack of a new episode, one step in, from a Console run directly.
+  Nes::CartridgeBuilder builder;
+  builder.setInputFile(path);
+  Nes::Console console(builder.build());
+  std::vector<byte> frame(OPENNES_FRAME_SIZE);
+  console.getPpu().setFramebuffer(frame.data());
+  console.runFrame();
+  Nes::ObservationStack stack;
+  stack.reset(frame.data(), console.getPpu().getEmphasis());
+  console.runFrame();
+  stack.push(frame.data(), console.getPpu().getEmphasis());
+  std::vector<byte> expected(size);
+  stack.copyStack(expected.data());
+  for(std::size_t index = 0; index < count; index++) {
+    CHECK(std::equal(expected.begin(), expected.end(), observations + index * size));
+  }
+  opennes_batch_destroy(batch);
+}
+
+TEST_CASE("Batches step without allocating, however long they run.", "[OpenNes][Batch]") {
+  std::string path = writeToneSweepRomFile("batchTone.nes");
+  const std::size_t count = 1;
+  OpenNesBatch* batch = opennes_batch_create(path.c_str(), count, 1);
+  REQUIRE(batch != nullptr);
+  Buffers buffers(count);
+  REQUIRE(opennes_batch_reset(batch, buffers.observations, buffers.ram) == OPENNES_OK);
+  const std::vector<uint8_t> actions(count, 0x00);
+  // Thousands of frames of a game playing sound, drawing now and then.
+  allocationCount = 0;
+  countingAllocations = true;
+  bool stepped = true;
+  for(int step = 0; step < 3000; step++) {
+    stepped &= opennes_batch_step(batch, actions.data(),
+        step % 500 == 0 ? buffers.observations : nullptr, buffers.ram) == OPENNES_OK;
+  }
+  // Catch allocates in its checks, so they wait until counting is off.
+  OpenNesStatus reset = opennes_batch_reset(batch, buffers.observations, buffers.ram);
+  countingAllocations = false;
+  CHECK(stepped);
+  CHECK(reset == OPENNES_OK);
+  CHECK(allocationCount == 0);
+  opennes_batch_destroy(batch);
+}
+
+TEST_CASE("Batches are not built without a ROM.", "[OpenNes][Batch]") {
+  std::string missing = GET_RESOURCE_PATH("missing.nes");
+  CHECK(opennes_batch_create(missing.c_str(), 4, 1) == nullptr);
+  CHECK(std::string(opennes_last_error()).find("missing.nes") != std::string::npos);
+  CHECK(opennes_batch_create(nullptr, 4, 1) == nullptr);
+  std::string path = writeControllerReader("batchController.nes");
+  CHECK(opennes_batch_create(path.c_str(), 0, 1) == nullptr);
+  CHECK(opennes_batch_size(nullptr) == 0);
+  CHECK(opennes_batch_observation_size(nullptr) == 0);
+}
+
+TEST_CASE("Benchmark stepping a batch through the C interface.", "[.][benchmark]") {
+  std::string path = writeControllerReader("batchController.nes");
+  const std::size_t count = 16;
+  OpenNesBatch* batch = opennes_batch_create(path.c_str(), count, 0);
+  REQUIRE(batch != nullptr);
+  Buffers buffers(count);
+  std::vector<uint8_t> actions(count, 0x01);
+  opennes_batch_reset(batch, buffers.observations, buffers.ram);
+  // Stacks are smaller than frames, so the frame buffer holds either.
+  for(std::string mode : {"frames", "not drawing", "stacked 84x84x4"}) {
+    uint8_t* observations = mode == "not drawing" ? nullptr : buffers.observations;
+    if(mode == "stacked 84x84x4") {
+      opennes_batch_set_stacking(batch, 84, 84, 4);
+    }
+    const int steps = 30;
+    auto start = std::chrono::steady_clock::now();
+    for(int step = 0; step < steps; step++) {
+      opennes_batch_step(batch, actions.data(), observations, buffers.ram);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    WARN(count << " instances, " << mode << ": "
+        << steps * count / elapsed.count() << " frames per second");
+  }
+  opennes_batch_destroy(batch);
+}